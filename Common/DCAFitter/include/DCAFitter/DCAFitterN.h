@@ -69,6 +69,9 @@ struct TrackDeriv {
   }
 };
 
+template <int N, typename... Args>
+class DCAFitterNBatch;
+
 template <int N, typename... Args>
 class DCAFitterN
 {
@@ -217,6 +220,10 @@ class DCAFitterN
   size_t getCallID() const { return mCallID; }
 
  protected:
+  friend class DCAFitterNBatch<N, Args...>;
+
+  bool prepareSeeds();
+  void orderCandidates();
   bool calcPCACoefs();
   bool calcInverseWeight();
   void calcResidDerivatives();
@@ -231,6 +238,8 @@ class DCAFitterN
   double calcChi2() const;
   double calcChi2NoErr() const;
   bool correctTracks(const VecND& corrX);
+  bool prepareChi2();
+  bool prepareChi2NoErr();
   bool minimizeChi2();
   bool minimizeChi2NoErr();
   bool roughDZCut() const;
@@ -351,27 +360,8 @@ int DCAFitterN<N, Args...>::process(const Tr&... args)
   mCallID++;
   static_assert(sizeof...(args) == N, "incorrect number of input tracks");
   assign(0, args...);
-  clear();
-  for (int i = 0; i < N; i++) {
-    mTrAux[i].set(*mOrigTrPtr[i], mBz);
-  }
-  if (!mCrossings.set(mTrAux[0], *mOrigTrPtr[0], mTrAux[1], *mOrigTrPtr[1], mMaxDXYIni)) { // even for N>2 it should be enough to test just 1 loop
-    return 0;                                                                              // no crossing
-  }
-  for (int ih = 0; ih < MAXHYP; ih++) {
-    mPropFailed[ih] = false;
-  }
-  if (mUseAbsDCA) {
-    calcRMatrices(); // needed for fast residuals derivatives calculation in case of abs. distance minimization
-  }
-  if (mCrossings.nDCA == MAXHYP) { // if there are 2 candidates and they are too close, chose their mean as a starting point
-    auto dst2 = (mCrossings.xDCA[0] - mCrossings.xDCA[1]) * (mCrossings.xDCA[0] - mCrossings.xDCA[1]) +
-                (mCrossings.yDCA[0] - mCrossings.yDCA[1]) * (mCrossings.yDCA[0] - mCrossings.yDCA[1]);
-    if (dst2 < mMaxDist2ToMergeSeeds) {
-      mCrossings.nDCA = 1;
-      mCrossings.xDCA[0] = 0.5 * (mCrossings.xDCA[0] + mCrossings.xDCA[1]);
-      mCrossings.yDCA[0] = 0.5 * (mCrossings.yDCA[0] + mCrossings.yDCA[1]);
-    }
+  if (!prepareSeeds()) {
+    return 0; // no crossing
   }
   // check all crossings
   for (int ic = 0; ic < mCrossings.nDCA; ic++) {
@@ -395,7 +385,44 @@ int DCAFitterN<N, Args...>::process(const Tr&... args)
       mCurHyp++;
     }
   }
+  orderCandidates();
+  return mCurHyp;
+}
 
+//__________________________________________________________________________
+template <int N, typename... Args>
+bool DCAFitterN<N, Args...>::prepareSeeds()
+{
+  //< find the crossings of the first 2 tracks which serve as seeds for the PCA candidates
+  clear();
+  for (int i = 0; i < N; i++) {
+    mTrAux[i].set(*mOrigTrPtr[i], mBz);
+  }
+  if (!mCrossings.set(mTrAux[0], *mOrigTrPtr[0], mTrAux[1], *mOrigTrPtr[1], mMaxDXYIni)) { // even for N>2 it should be enough to test just 1 loop
+    return false;                                                                          // no crossing
+  }
+  for (int ih = 0; ih < MAXHYP; ih++) {
+    mPropFailed[ih] = false;
+  }
+  if (mUseAbsDCA) {
+    calcRMatrices(); // needed for fast residuals derivatives calculation in case of abs. distance minimization
+  }
+  if (mCrossings.nDCA == MAXHYP) { // if there are 2 candidates and they are too close, chose their mean as a starting point
+    auto dst2 = (mCrossings.xDCA[0] - mCrossings.xDCA[1]) * (mCrossings.xDCA[0] - mCrossings.xDCA[1]) +
+                (mCrossings.yDCA[0] - mCrossings.yDCA[1]) * (mCrossings.yDCA[0] - mCrossings.yDCA[1]);
+    if (dst2 < mMaxDist2ToMergeSeeds) {
+      mCrossings.nDCA = 1;
+      mCrossings.xDCA[0] = 0.5 * (mCrossings.xDCA[0] + mCrossings.xDCA[1]);
+      mCrossings.yDCA[0] = 0.5 * (mCrossings.yDCA[0] + mCrossings.yDCA[1]);
+    }
+  }
+  return true;
+}
+
+//__________________________________________________________________________
+template <int N, typename... Args>
+void DCAFitterN<N, Args...>::orderCandidates()
+{
   for (int i = mCurHyp; i--;) { // order in quality
     for (int j = i; j--;) {
       if (mChi2[mOrder[i]] < mChi2[mOrder[j]]) {
@@ -408,7 +435,6 @@ int DCAFitterN<N, Args...>::process(const Tr&... args)
       recalculatePCAWithErrors(i);
     }
   }
-  return mCurHyp;
 }
 
 //__________________________________________________________________________
@@ -862,9 +888,9 @@ inline double DCAFitterN<N, Args...>::getAbsMax(const VecND& v)
 
 //___________________________________________________________________
 template <int N, typename... Args>
-bool DCAFitterN<N, Args...>::minimizeChi2()
+bool DCAFitterN<N, Args...>::prepareChi2()
 {
-  // find best chi2 (weighted DCA) of N tracks in the vicinity of the seed PCA
+  // bring tracks to the seed PCA and calculate the starting point of the weighted DCA minimization
   for (int i = N; i--;) {
     mCandTr[mCurHyp][i] = *mOrigTrPtr[i];
     auto x = mTrAux[i].c * mPCA[mCurHyp][0] + mTrAux[i].s * mPCA[mCurHyp][1]; // X of PCA in the track frame
@@ -884,6 +910,17 @@ bool DCAFitterN<N, Args...>::minimizeChi2()
   }
   calcPCA();            // current PCA
   calcTrackResiduals(); // current track residuals
+  return true;
+}
+
+//___________________________________________________________________
+template <int N, typename... Args>
+bool DCAFitterN<N, Args...>::minimizeChi2()
+{
+  // find best chi2 (weighted DCA) of N tracks in the vicinity of the seed PCA
+  if (!prepareChi2()) {
+    return false;
+  }
   float chi2Upd, chi2 = calcChi2();
   do {
     calcTrackDerivatives(); // current track derivatives (1st and 2nd)
@@ -919,10 +956,9 @@ bool DCAFitterN<N, Args...>::minimizeChi2()
 
 //___________________________________________________________________
 template <int N, typename... Args>
-bool DCAFitterN<N, Args...>::minimizeChi2NoErr()
+bool DCAFitterN<N, Args...>::prepareChi2NoErr()
 {
-  // find best chi2 (absolute DCA) of N tracks in the vicinity of the PCA seed
-
+  // bring tracks to the seed PCA and calculate the starting point of the absolute DCA minimization
   for (int i = N; i--;) {
     mCandTr[mCurHyp][i] = *mOrigTrPtr[i];
     auto x = mTrAux[i].c * mPCA[mCurHyp][0] + mTrAux[i].s * mPCA[mCurHyp][1]; // X of PCA in the track frame
@@ -937,6 +973,17 @@ bool DCAFitterN<N, Args...>::minimizeChi2NoErr()
 
   calcPCANoErr();       // current PCA
   calcTrackResiduals(); // current track residuals
+  return true;
+}
+
+//___________________________________________________________________
+template <int N, typename... Args>
+bool DCAFitterN<N, Args...>::minimizeChi2NoErr()
+{
+  // find best chi2 (absolute DCA) of N tracks in the vicinity of the PCA seed
+  if (!prepareChi2NoErr()) {
+    return false;
+  }
   float chi2Upd, chi2 = calcChi2NoErr();
   do {
     calcTrackDerivatives();      // current track derivatives (1st and 2nd)
@@ -0,0 +1,465 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DCAFitterNBatch.h
+/// \brief Fit of many N-prong candidates with the Newton iterations vectorized over the candidates
+
+#ifndef _ALICEO2_DCA_FITTERN_BATCH_
+#define _ALICEO2_DCA_FITTERN_BATCH_
+
+#include "DCAFitter/DCAFitterN.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace o2
+{
+namespace vertexing
+{
+
+///< Runs the DCAFitterN minimization for a batch of candidates (e.g. all V0 partners of a track).
+///  The seeding (track crossings, propagation to the seed) and the final propagation to the PCA are done
+///  per candidate by the scalar fitter. During the Newton-Raphson iterations the tracks are not propagated,
+///  so the track derivatives and the residual derivatives stay constant and each iteration is a short
+///  sequence of arithmetic operations on the positions: these are done for LaneWidth seeds at once, with the
+///  data laid out lane-innermost so that the compiler vectorizes the loops over the lanes.
+///  The results are accessed via the per-candidate fitters, which are in the same state as after
+///  DCAFitterN::process (up to the rounding of the explicit Hessian inversion).
+template <int N, typename... Args>
+class DCAFitterNBatch
+{
+  static_assert(N == 2 || N == 3, "batched fit is implemented for 2 and 3 prongs");
+
+ public:
+  using Fitter = DCAFitterN<N, Args...>;
+  static constexpr int LaneWidth = 8;
+
+  ///< fitter whose settings are used for the candidates added afterwards
+  Fitter& getConfig() { return mConfig; }
+  const Fitter& getConfig() const { return mConfig; }
+
+  ///< add candidate to fit, the tracks must stay valid until process() is called. Returns candidate index
+  template <class... Tr>
+  int add(const Tr&... args);
+
+  ///< fit all added candidates, the results stay available until clear() is called
+  void process();
+
+  ///< fitter holding the results of candidate i
+  Fitter& getFitter(int i) { return mFitters[i]; }
+  const Fitter& getFitter(int i) const { return mFitters[i]; }
+  int getNCandidates(int i) const { return mFitters[i].getNCandidates(); }
+  int size() const { return mNCand; }
+  size_t getCallID() const { return mCallID; }
+
+  void clear()
+  {
+    mNCand = 0;
+    mNLanes = 0;
+  }
+
+ private:
+  static constexpr int MAXHYP = Fitter::MAXHYP;
+  enum LaneStatus : int { Active,
+                          Converged,
+                          Failed,
+                          AltCloser };
+
+  ///< LaneWidth seeds in structure of arrays layout, lane index innermost
+  struct Block {
+    // constant during the iterations
+    double c[N][LaneWidth], s[N][LaneWidth];   // track frames
+    double tcf[N][3][3][LaneWidth];            // track contributions to the PCA
+    double pcaScale[LaneWidth];                // 1 for weighted PCA, 1/N for abs. DCA
+    double covI[N][4][LaneWidth];              // sxx, syy, syz, szz
+    double der[N][4][LaneWidth];               // dydx, dzdx, d2ydx2, d2zdx2
+    double gradCoef[N][N][3][LaneWidth];       // dchi2/dx_i = sum_j res_j * gradCoef[i][j]
+    double hessConst[N][N][LaneWidth];         // residuals independent part of d2chi2/dx_i/dx_j, j <= i
+    double hessRes[N][N][3][LaneWidth];        // coefficient of the residuals in d2chi2/dx_i/dx_j, j <= i
+    bool resOfI[LaneWidth];                    // hessRes[i][j] multiplies res_i (abs. DCA) or res_j (weighted)
+    double seedX[LaneWidth], seedY[LaneWidth]; // seed being tested
+    double altX[LaneWidth], altY[LaneWidth];   // alternative seed
+    bool hasAlt[LaneWidth];                    // alternative seed check requested
+    double minParamChange[LaneWidth];          // stopping conditions of the lane fitter
+    float minRelChi2Change[LaneWidth];
+    int maxIter[LaneWidth];
+    // state
+    double pos[N][3][LaneWidth];
+    double res[N][3][LaneWidth];
+    double pca[3][LaneWidth];
+    float chi2[LaneWidth];
+    int nIter[LaneWidth];
+    int status[LaneWidth];
+  };
+
+  int addLane(Fitter& f, int ic);
+  void runBlock(Block& b, int nLanes);
+  void finalize(int icand);
+
+  Fitter mConfig;
+  std::vector<Fitter> mFitters;
+  std::vector<std::array<int, MAXHYP>> mCandLanes; // lane of each seed of the candidate, -1 if not fitted
+  std::vector<Block> mBlocks;
+  int mNCand = 0;
+  int mNLanes = 0;
+  size_t mCallID = 0;
+};
+
+//__________________________________________________________________________
+template <int N, typename... Args>
+template <class... Tr>
+int DCAFitterNBatch<N, Args...>::add(const Tr&... args)
+{
+  static_assert(sizeof...(args) == N, "incorrect number of input tracks");
+  int icand = mNCand++;
+  if (icand < int(mFitters.size())) {
+    mFitters[icand] = mConfig;
+  } else {
+    mFitters.push_back(mConfig);
+    mCandLanes.emplace_back();
+  }
+  auto& f = mFitters[icand];
+  auto& lanes = mCandLanes[icand];
+  lanes.fill(-1);
+  f.mCallID = ++mCallID;
+  f.assign(0, args...);
+  if (!f.prepareSeeds()) {
+    return icand; // no crossing
+  }
+  for (int ic = 0; ic < f.mCrossings.nDCA; ic++) {
+    if (f.mCrossings.xDCA[ic] * f.mCrossings.xDCA[ic] + f.mCrossings.yDCA[ic] * f.mCrossings.yDCA[ic] > f.mMaxR2) {
+      continue;
+    }
+    // every seed gets its own slot, the alternative seed preference is resolved in finalize
+    f.mCurHyp = ic;
+    f.mCrossIDCur = ic;
+    f.mCrossIDAlt = f.mCrossings.nDCA == 2 ? 1 - ic : -1;
+    f.mNIters[ic] = 0;
+    f.mTrPropDone[ic] = false;
+    f.mChi2[ic] = -1.;
+    f.mPCA[ic][0] = f.mCrossings.xDCA[ic];
+    f.mPCA[ic][1] = f.mCrossings.yDCA[ic];
+    if (!(f.mUseAbsDCA ? f.prepareChi2NoErr() : f.prepareChi2())) {
+      continue;
+    }
+    f.calcTrackDerivatives();
+    if (f.mUseAbsDCA) {
+      f.calcResidDerivativesNoErr();
+    } else {
+      f.calcResidDerivatives();
+    }
+    lanes[ic] = addLane(f, ic);
+  }
+  f.mCurHyp = 0;
+  return icand;
+}
+
+//__________________________________________________________________________
+template <int N, typename... Args>
+int DCAFitterNBatch<N, Args...>::addLane(Fitter& f, int ic)
+{
+  // copy the seed ic of fitter f (prepared and with the residual derivatives calculated) to the next free lane
+  int lane = mNLanes++;
+  if (lane / LaneWidth >= int(mBlocks.size())) {
+    mBlocks.emplace_back();
+  }
+  auto& b = mBlocks[lane / LaneWidth];
+  int l = lane % LaneWidth;
+  bool absDCA = f.mUseAbsDCA;
+  for (int i = 0; i < N; i++) {
+    const auto& taux = f.mTrAux[i];
+    b.c[i][l] = taux.c;
+    b.s[i][l] = taux.s;
+    for (int r = 0; r < 3; r++) {
+      for (int k = 0; k < 3; k++) {
+        b.tcf[i][r][k][l] = absDCA ? 0. : f.mTrCFVT[ic][i](r, k);
+      }
+    }
+    if (absDCA) { // pure rotation to global frame
+      b.tcf[i][0][0][l] = b.tcf[i][1][1][l] = taux.c;
+      b.tcf[i][0][1][l] = -taux.s;
+      b.tcf[i][1][0][l] = taux.s;
+      b.tcf[i][2][2][l] = 1.;
+    }
+    const auto& covI = f.mTrcEInv[ic][i];
+    b.covI[i][0][l] = absDCA ? 1. : covI.sxx;
+    b.covI[i][1][l] = absDCA ? 1. : covI.syy;
+    b.covI[i][2][l] = absDCA ? 0. : covI.syz;
+    b.covI[i][3][l] = absDCA ? 1. : covI.szz;
+    const auto& der = f.mTrDer[ic][i];
+    b.der[i][0][l] = der.dydx;
+    b.der[i][1][l] = der.dzdx;
+    b.der[i][2][l] = der.d2ydx2;
+    b.der[i][3][l] = der.d2zdx2;
+    for (int k = 0; k < 3; k++) {
+      b.pos[i][k][l] = f.mTrPos[ic][i][k];
+      b.res[i][k][l] = f.mTrRes[ic][i][k];
+    }
+  }
+  // chi2 derivatives coefficients, see calcChi2Derivatives and calcChi2DerivativesNoErr
+  auto covIDr = [&b, l](int j, const auto& dr, int k) {
+    switch (k) {
+      case 0:
+        return b.covI[j][0][l] * dr[0];
+      case 1:
+        return b.covI[j][1][l] * dr[1] + b.covI[j][2][l] * dr[2];
+      default:
+        return b.covI[j][2][l] * dr[1] + b.covI[j][3][l] * dr[2];
+    }
+  };
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      for (int k = 0; k < 3; k++) {
+        b.gradCoef[i][j][k][l] = covIDr(j, f.mDResidDx[j][i], k);
+      }
+    }
+    for (int j = 0; j <= i; j++) {
+      double h = 0;
+      for (int k = N; k--;) {
+        for (int m = 0; m < 3; m++) {
+          h += f.mDResidDx[k][j][m] * b.gradCoef[i][k][m][l];
+        }
+      }
+      b.hessConst[i][j][l] = h;
+      for (int k = 0; k < 3; k++) {
+        b.hessRes[i][j][k][l] = absDCA ? f.mD2ResidDx2[i][j][k] : covIDr(j, f.mD2ResidDx2[j][j], k);
+      }
+    }
+  }
+  b.resOfI[l] = absDCA;
+  b.pcaScale[l] = absDCA ? Fitter::NInv : 1.;
+  for (int k = 0; k < 3; k++) {
+    b.pca[k][l] = f.mPCA[ic][k];
+  }
+  b.chi2[l] = absDCA ? f.calcChi2NoErr() : f.calcChi2();
+  b.seedX[l] = f.mCrossings.xDCA[ic];
+  b.seedY[l] = f.mCrossings.yDCA[ic];
+  b.hasAlt[l] = f.mCrossIDAlt >= 0;
+  b.altX[l] = b.hasAlt[l] ? f.mCrossings.xDCA[f.mCrossIDAlt] : 0.;
+  b.altY[l] = b.hasAlt[l] ? f.mCrossings.yDCA[f.mCrossIDAlt] : 0.;
+  b.minParamChange[l] = f.mMinParamChange;
+  b.minRelChi2Change[l] = f.mMinRelChi2Change;
+  b.maxIter[l] = f.mMaxIter;
+  b.nIter[l] = 0;
+  b.status[l] = Active;
+  return lane;
+}
+
+//__________________________________________________________________________
+template <int N, typename... Args>
+void DCAFitterNBatch<N, Args...>::process()
+{
+  for (int ib = 0; ib * LaneWidth < mNLanes; ib++) {
+    runBlock(mBlocks[ib], std::min(LaneWidth, mNLanes - ib * LaneWidth));
+  }
+  for (int icand = 0; icand < mNCand; icand++) {
+    finalize(icand);
+  }
+}
+
+//__________________________________________________________________________
+template <int N, typename... Args>
+void DCAFitterNBatch<N, Args...>::runBlock(Block& b, int nLanes)
+{
+  // Newton-Raphson iterations of minimizeChi2 / minimizeChi2NoErr for all lanes of the block in lockstep,
+  // the lanes which have stopped keep being computed but their state is not updated
+  constexpr int W = LaneWidth;
+  for (int l = nLanes; l < W; l++) {
+    b.status[l] = Failed;
+  }
+  for (int iter = 0;; iter++) {
+    double grad[N][W], hess[N][N][W], hinv[N][N][W], dx[N][W], dxMax[W];
+    double pos[N][3][W], pca[3][W], res[N][3][W], chi2New[W];
+    bool invOK[W];
+
+    // chi2 derivatives
+    for (int i = 0; i < N; i++) {
+      for (int l = 0; l < W; l++) {
+        double g = 0;
+        for (int j = N; j--;) {
+          g += b.res[j][0][l] * b.gradCoef[i][j][0][l] + b.res[j][1][l] * b.gradCoef[i][j][1][l] + b.res[j][2][l] * b.gradCoef[i][j][2][l];
+        }
+        grad[i][l] = g;
+      }
+      for (int j = 0; j <= i; j++) {
+        for (int l = 0; l < W; l++) {
+          int r = b.resOfI[l] ? i : j;
+          hess[i][j][l] = hess[j][i][l] = b.hessConst[i][j][l] + b.res[r][0][l] * b.hessRes[i][j][0][l] +
+                                          b.res[r][1][l] * b.hessRes[i][j][1][l] + b.res[r][2][l] * b.hessRes[i][j][2][l];
+        }
+      }
+    }
+
+    // inverse of the symmetric Hessian
+    for (int l = 0; l < W; l++) {
+      double det;
+      if constexpr (N == 2) {
+        det = hess[0][0][l] * hess[1][1][l] - hess[1][0][l] * hess[1][0][l];
+        double detI = det != 0. ? 1. / det : 0.;
+        hinv[0][0][l] = hess[1][1][l] * detI;
+        hinv[1][1][l] = hess[0][0][l] * detI;
+        hinv[0][1][l] = hinv[1][0][l] = -hess[1][0][l] * detI;
+      } else {
+        double c00 = hess[1][1][l] * hess[2][2][l] - hess[2][1][l] * hess[2][1][l];
+        double c10 = hess[2][1][l] * hess[2][0][l] - hess[1][0][l] * hess[2][2][l];
+        double c20 = hess[1][0][l] * hess[2][1][l] - hess[1][1][l] * hess[2][0][l];
+        det = hess[0][0][l] * c00 + hess[1][0][l] * c10 + hess[2][0][l] * c20;
+        double detI = det != 0. ? 1. / det : 0.;
+        hinv[0][0][l] = c00 * detI;
+        hinv[1][0][l] = hinv[0][1][l] = c10 * detI;
+        hinv[2][0][l] = hinv[0][2][l] = c20 * detI;
+        hinv[1][1][l] = (hess[0][0][l] * hess[2][2][l] - hess[2][0][l] * hess[2][0][l]) * detI;
+        hinv[2][1][l] = hinv[1][2][l] = (hess[1][0][l] * hess[2][0][l] - hess[0][0][l] * hess[2][1][l]) * detI;
+        hinv[2][2][l] = (hess[0][0][l] * hess[1][1][l] - hess[1][0][l] * hess[1][0][l]) * detI;
+      }
+      invOK[l] = det != 0.;
+      dxMax[l] = -1.;
+    }
+    for (int i = 0; i < N; i++) {
+      for (int l = 0; l < W; l++) {
+        double d = 0;
+        for (int j = 0; j < N; j++) {
+          d += hinv[i][j][l] * grad[j][l];
+        }
+        dx[i][l] = d;
+        dxMax[l] = std::max(dxMax[l], std::abs(d));
+      }
+    }
+
+    // corrected track positions, PCA, residuals and chi2
+    for (int i = 0; i < N; i++) {
+      for (int l = 0; l < W; l++) {
+        double dx2h = 0.5 * dx[i][l] * dx[i][l];
+        pos[i][0][l] = b.pos[i][0][l] - dx[i][l];
+        pos[i][1][l] = b.pos[i][1][l] - (b.der[i][0][l] * dx[i][l] - dx2h * b.der[i][2][l]);
+        pos[i][2][l] = b.pos[i][2][l] - (b.der[i][1][l] * dx[i][l] - dx2h * b.der[i][3][l]);
+      }
+    }
+    for (int k = 0; k < 3; k++) {
+      for (int l = 0; l < W; l++) {
+        double v = 0;
+        for (int i = N; i--;) {
+          v += b.tcf[i][k][0][l] * pos[i][0][l] + b.tcf[i][k][1][l] * pos[i][1][l] + b.tcf[i][k][2][l] * pos[i][2][l];
+        }
+        pca[k][l] = v * b.pcaScale[l];
+      }
+    }
+    for (int l = 0; l < W; l++) {
+      chi2New[l] = 0.;
+    }
+    for (int i = N; i--;) {
+      for (int l = 0; l < W; l++) {
+        res[i][0][l] = pos[i][0][l] - (b.c[i][l] * pca[0][l] + b.s[i][l] * pca[1][l]);
+        res[i][1][l] = pos[i][1][l] - (b.c[i][l] * pca[1][l] - b.s[i][l] * pca[0][l]);
+        res[i][2][l] = pos[i][2][l] - pca[2][l];
+        chi2New[l] += res[i][0][l] * res[i][0][l] * b.covI[i][0][l] + res[i][1][l] * res[i][1][l] * b.covI[i][1][l] +
+                      res[i][2][l] * res[i][2][l] * b.covI[i][3][l] + 2. * res[i][1][l] * res[i][2][l] * b.covI[i][2][l];
+      }
+    }
+
+    // update the active lanes
+    bool anyActive = false;
+    for (int l = 0; l < W; l++) {
+      if (b.status[l] != Active) {
+        continue;
+      }
+      if (!invOK[l]) {
+        LOG(error) << "InversionFailed";
+        b.status[l] = Failed;
+        continue;
+      }
+      for (int k = 0; k < 3; k++) {
+        b.pca[k][l] = pca[k][l];
+        for (int i = 0; i < N; i++) {
+          b.pos[i][k][l] = pos[i][k][l];
+          b.res[i][k][l] = res[i][k][l];
+        }
+      }
+      if (b.hasAlt[l]) {
+        double dxCur = pca[0][l] - b.seedX[l], dyCur = pca[1][l] - b.seedY[l];
+        double dxAlt = pca[0][l] - b.altX[l], dyAlt = pca[1][l] - b.altY[l];
+        if (dxCur * dxCur + dyCur * dyCur > dxAlt * dxAlt + dyAlt * dyAlt) {
+          b.status[l] = AltCloser;
+          continue;
+        }
+      }
+      float chi2Upd = chi2New[l];
+      bool converged = dxMax[l] < b.minParamChange[l] || chi2Upd > b.chi2[l] * b.minRelChi2Change[l];
+      b.chi2[l] = chi2Upd;
+      if (converged) {
+        b.status[l] = Converged;
+      } else if (++b.nIter[l] >= b.maxIter[l]) {
+        b.status[l] = Converged;
+      } else {
+        anyActive = true;
+      }
+    }
+    if (!anyActive) {
+      break;
+    }
+  }
+}
+
+//__________________________________________________________________________
+template <int N, typename... Args>
+void DCAFitterNBatch<N, Args...>::finalize(int icand)
+{
+  // collect the fitted seeds of the candidate in the order DCAFitterN::process would have tried them
+  auto& f = mFitters[icand];
+  const auto& lanes = mCandLanes[icand];
+  int nAcc = 0;
+  for (int ic = 0; ic < MAXHYP; ic++) {
+    if (lanes[ic] < 0) {
+      continue;
+    }
+    const auto& b = mBlocks[lanes[ic] / LaneWidth];
+    int l = lanes[ic] % LaneWidth;
+    bool ok = false;
+    f.mCurHyp = ic;
+    if (b.status[l] == AltCloser && !f.mAllowAltPreference) {
+      // the other seed was abandoned already, hence the scalar fitter would not check this one against it: refit
+      f.mCrossIDCur = ic;
+      f.mCrossIDAlt = -1;
+      f.mNIters[ic] = 0;
+      f.mPCA[ic][0] = f.mCrossings.xDCA[ic];
+      f.mPCA[ic][1] = f.mCrossings.yDCA[ic];
+      ok = f.mUseAbsDCA ? f.minimizeChi2NoErr() : f.minimizeChi2();
+    } else if (b.status[l] == AltCloser) {
+      f.mAllowAltPreference = false;
+    } else if (b.status[l] == Converged) {
+      for (int k = 0; k < 3; k++) {
+        f.mPCA[ic][k] = b.pca[k][l];
+        for (int i = 0; i < N; i++) {
+          f.mTrPos[ic][i][k] = b.pos[i][k][l];
+          f.mTrRes[ic][i][k] = b.res[i][k][l];
+        }
+      }
+      f.mNIters[ic] = b.nIter[l];
+      f.mChi2[ic] = b.chi2[l] * Fitter::NInv;
+      ok = f.mChi2[ic] < f.mMaxChi2;
+    }
+    if (!ok) {
+      continue;
+    }
+    f.mOrder[nAcc] = ic;
+    if (f.mPropagateToPCA && !f.propagateTracksToVertex(nAcc)) {
+      continue; // discard candidate if failed to propagate to it
+    }
+    nAcc++;
+  }
+  f.mCurHyp = nAcc;
+  f.orderCandidates();
+}
+
+} // namespace vertexing
+} // namespace o2
+#endif // _ALICEO2_DCA_FITTERN_BATCH_
@@ -0,0 +1,109 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// Fits the same set of V0-like track pairs with DCAFitterN::process one by one
+/// and with DCAFitterNBatch, in abs. and weighted distance minimization modes.
+
+#include <benchmark/benchmark.h>
+#include "DCAFitter/DCAFitterN.h"
+#include "DCAFitter/DCAFitterNBatch.h"
+#include "MathUtils/Utils.h"
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr float Bz = 5.;
+
+using Track = o2::track::TrackParCov;
+
+/// pairs of opposite charge tracks from a common vertex at R < 40 cm, smeared and moved away from it
+const std::vector<std::array<Track, 2>>& pairs()
+{
+  static std::vector<std::array<Track, 2>> prs = [] {
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> uni(0., 1.);
+    std::normal_distribution<float> gaus(0., 1.);
+    const float errYZ = 1e-2, errSlp = 1e-3, errQPT = 2e-2;
+    std::vector<std::array<Track, 2>> res;
+    while (res.size() < 4096) {
+      float rdec = 1. + 39. * uni(gen), phiV = 2. * M_PI * uni(gen), zV = 20. * (uni(gen) - 0.5);
+      float xV = rdec * std::cos(phiV), yV = rdec * std::sin(phiV);
+      std::array<Track, 2> pr;
+      bool ok = true;
+      for (int i = 0; i < 2; i++) {
+        float phi = phiV + 0.3 * (uni(gen) - 0.5), pt = 0.2 + 2. * uni(gen), s, c, x;
+        std::array<float, 5> params;
+        o2::math_utils::sincos(phi, s, c);
+        o2::math_utils::rotateZInv(xV, yV, x, params[0], s, c);
+        params[0] += gaus(gen) * errYZ;
+        params[1] = zV + gaus(gen) * errYZ;
+        params[2] = gaus(gen) * errSlp;
+        params[3] = 0.5 * (uni(gen) - 0.5);
+        params[4] = (i ? -1. : 1.) / pt;
+        std::array<float, 15> covm = {errYZ * errYZ, 0., errYZ * errYZ, 0, 0., errSlp * errSlp, 0., 0., 0., errSlp * errSlp,
+                                      0., 0., 0., 0., errQPT * errQPT * params[4] * params[4]};
+        pr[i] = Track(x, phi, params, covm);
+        ok &= pr[i].propagateTo(x + 5. * uni(gen), Bz);
+      }
+      if (ok) {
+        res.push_back(pr);
+      }
+    }
+    return res;
+  }();
+  return prs;
+}
+
+void BM_Scalar(benchmark::State& state)
+{
+  o2::vertexing::DCAFitterN<2> ft;
+  ft.setBz(Bz);
+  ft.setUseAbsDCA(state.range(0));
+  const auto& prs = pairs();
+  for (auto _ : state) {
+    int nc = 0;
+    for (const auto& pr : prs) {
+      nc += ft.process(pr[0], pr[1]);
+    }
+    benchmark::DoNotOptimize(nc);
+  }
+  state.SetItemsProcessed(state.iterations() * prs.size());
+}
+
+void BM_Batch(benchmark::State& state)
+{
+  o2::vertexing::DCAFitterNBatch<2> batch;
+  batch.getConfig().setBz(Bz);
+  batch.getConfig().setUseAbsDCA(state.range(0));
+  const auto& prs = pairs();
+  for (auto _ : state) {
+    batch.clear();
+    for (const auto& pr : prs) {
+      batch.add(pr[0], pr[1]);
+    }
+    batch.process();
+    int nc = 0;
+    for (int i = 0; i < batch.size(); i++) {
+      nc += batch.getNCandidates(i);
+    }
+    benchmark::DoNotOptimize(nc);
+  }
+  state.SetItemsProcessed(state.iterations() * prs.size());
+}
+} // namespace
+
+BENCHMARK(BM_Scalar)->Arg(1)->Arg(0);
+BENCHMARK(BM_Batch)->Arg(1)->Arg(0);
+
+BENCHMARK_MAIN();
@@ -28,6 +28,7 @@ struct StackParam : public o2::conf::ConfigurableParamHelper<StackParam> {
   std::string transportPrimaryFileName = "";
   std::string transportPrimaryFuncName = "";
   bool transportPrimaryInvert = false;
+  int hitIndexUpdateThreads = 1; // number of threads updating the hit track indices of the detectors at the end of an event
 
   // boilerplate stuff + make principal key "Stack"
   O2ParamDef(StackParam, "Stack");
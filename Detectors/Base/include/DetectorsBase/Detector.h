@@ -16,6 +16,7 @@
 #define ALICEO2_BASE_DETECTOR_H_
 
 #include <map>
+#include <gsl/span>
 #include <tbb/concurrent_unordered_map.h>
 #include <vector>
 #include <initializer_list>
@@ -160,8 +161,10 @@ class Detector : public FairDetector
   // interface to update track indices of data objects
   // usually called by the Stack, at the end of an event, which might have changed
   // the track indices due to filtering
+  // the mapping is indexed by the old track index and may be used concurrently
+  // for different detectors
   // FIXME: make private friend of stack?
-  virtual void updateHitTrackIndices(std::map<int, int> const&) = 0;
+  virtual void updateHitTrackIndices(gsl::span<const int> indexmapping) = 0;
 
   // interfaces to attach properly encoded hit information to a FairMQ message
   // and to decode it
@@ -322,14 +325,15 @@ class DetImpl : public o2::base::Detector
   // generic implementation for the updateHitTrackIndices interface
   // assumes Detectors have a GetHits(int) function that return some iterable
   // hits which are o2::BaseHits
-  void updateHitTrackIndices(std::map<int, int> const& indexmapping) override
+  void updateHitTrackIndices(gsl::span<const int> indexmapping) override
   {
     int probe = 0; // some Detectors have multiple hit vectors and we are probing
                    // them via a probe integer until we get a nullptr
     while (auto hits = static_cast<Det*>(this)->Det::getHits(probe++)) {
       for (auto& hit : *hits) {
-        auto iter = indexmapping.find(hit.GetTrackID());
-        hit.SetTrackID(iter->second);
+        // hits are only produced by tracks which are kept
+        assert(hit.GetTrackID() >= 0 && hit.GetTrackID() < (int)indexmapping.size());
+        hit.SetTrackID(indexmapping[hit.GetTrackID()]);
       }
     }
   }
@@ -55,6 +55,9 @@ class GPUTPCGMPolynomialField;
 namespace base
 {
 
+template <typename value_T>
+struct TrackParCovBatch;
+
 template <typename value_T>
 class PropagatorImpl
 {
@@ -119,6 +122,20 @@ class PropagatorImpl
                                    gpu::gpustd::array<value_type, 2>* dca = nullptr, track::TrackLTIntegral* tofInfo = nullptr,
                                    int signCorr = 0, value_type maxD = 999.f) const;
 
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+  // Batch versions of propagateToX and propagateToDCA with constant field: the tracks are advanced in lock-step, the helix
+  // steps of all tracks are done in vectorizable loops and the material budgets of a step are queried together.
+  // The tracks whose propagation fails are flagged in tracks.ok and left as the scalar version leaves them,
+  // true is returned if all tracks were propagated. The dcaInfo of propagateToDCA, if given, must have tracks.size() entries.
+  bool propagateToX(TrackParCovBatch<value_type>& tracks, value_type x, value_type bZ,
+                    value_type maxSnp = MAX_SIN_PHI, value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
+                    int signCorr = 0) const;
+
+  bool propagateToDCA(const o2::dataformats::VertexBase& vtx, TrackParCovBatch<value_type>& tracks, value_type bZ,
+                      value_type maxStep = MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
+                      o2::dataformats::DCA* dcaInfo = nullptr, int signCorr = 0, value_type maxD = 999.f) const;
+#endif
+
   PropagatorImpl(PropagatorImpl const&) = delete;
   PropagatorImpl(PropagatorImpl&&) = delete;
   PropagatorImpl& operator=(PropagatorImpl const&) = delete;
@@ -165,6 +182,10 @@ class PropagatorImpl
   static constexpr value_type Epsilon = 0.00001; // precision of propagation to X
   template <typename T>
   GPUd() void getFieldXYZImpl(const math_utils::Point3D<T> xyz, T* bxyz) const;
+#if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
+  bool propagateBatchToX(TrackParCovBatch<value_type>& tracks, const value_type* xToGo, value_type bZ, value_type maxSnp, value_type maxStep,
+                         MatCorrType matCorr, int signCorr) const;
+#endif
 
   const o2::field::MagFieldFast* mFieldFast = nullptr; ///< External fast field map (barrel only for the moment)
   o2::field::MagneticField* mField = nullptr;          ///< External nominal field map
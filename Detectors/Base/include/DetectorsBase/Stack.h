@@ -25,7 +25,7 @@
 #include "Rtypes.h"
 #include "TParticle.h"
 
-#include <map>
+#include <vector>
 #include <memory>
 #include <stack>
 #include <utility>
@@ -182,6 +182,7 @@ class Stack : public FairGenericStack
 
   // methods concerning track references
   void addTrackReference(const o2::TrackReference& p);
+  std::vector<o2::TrackReference> const* const getTrackRefs() const { return mTrackRefs; }
 
   // get primaries
   const std::vector<TParticle>& getPrimaries() const { return mPrimaryParticles; }
@@ -261,8 +262,9 @@ class Stack : public FairGenericStack
   /// vector of reduced/pruned tracks written to the output
   std::vector<o2::MCTrack>* mTracks;
 
-  /// STL map from particle index to persistent track index
-  std::map<Int_t, Int_t> mIndexMap; //!
+  /// O(1) mapping from particle index to persistent track index (-1 if the track is not kept);
+  /// particle indices are contiguous within an event
+  std::vector<int> mIndexMap; //!
 
   /// cache active O2 detectors
   std::vector<o2::base::Detector*> mActiveDetectors; //!
@@ -0,0 +1,117 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file TrackParCovBatch.h
+/// \brief Tracks with covariance in struct-of-arrays layout, for the batch propagation
+
+#ifndef ALICEO2_BASE_TRACKPARCOVBATCH_
+#define ALICEO2_BASE_TRACKPARCOVBATCH_
+
+#include "ReconstructionDataFormats/Track.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace o2
+{
+namespace base
+{
+
+/// Each parameter and each covariance element of the tracks is stored in its own array, so that the
+/// same operation can be applied to all tracks of the batch in vectorizable loops.
+/// The tracks are copied in and out of the batch, their user field is not stored.
+template <typename value_T>
+struct TrackParCovBatch {
+  using value_type = value_T;
+  using TrackParCov_t = track::TrackParametrizationWithError<value_type>;
+
+  std::vector<value_type> x;
+  std::vector<value_type> alpha;
+  std::array<std::vector<value_type>, track::kNParams> par;
+  std::array<std::vector<value_type>, track::kCovMatSize> cov;
+  std::vector<uint8_t> absCharge;
+  std::vector<track::PID> pid;
+  std::vector<uint8_t> ok; // cleared for the tracks whose propagation failed, they are not propagated further
+
+  size_t size() const { return x.size(); }
+
+  void reserve(size_t n)
+  {
+    forEachArray([n](auto& v) { v.reserve(n); });
+  }
+
+  void clear()
+  {
+    forEachArray([](auto& v) { v.clear(); });
+  }
+
+  void add(const TrackParCov_t& trc)
+  {
+    x.push_back(trc.getX());
+    alpha.push_back(trc.getAlpha());
+    for (int i = 0; i < track::kNParams; i++) {
+      par[i].push_back(trc.getParam(i));
+    }
+    for (int i = 0; i < track::kCovMatSize; i++) {
+      cov[i].push_back(trc.getCov()[i]);
+    }
+    absCharge.push_back(trc.getAbsCharge());
+    pid.push_back(trc.getPID());
+    ok.push_back(1);
+  }
+
+  /// copy the parameters and covariance of track i to trc, the user field of trc is kept
+  void get(size_t i, TrackParCov_t& trc) const
+  {
+    value_type p[track::kNParams], c[track::kCovMatSize];
+    for (int j = 0; j < track::kNParams; j++) {
+      p[j] = par[j][i];
+    }
+    for (int j = 0; j < track::kCovMatSize; j++) {
+      c[j] = cov[j][i];
+    }
+    trc.set(x[i], alpha[i], p, c, absCharge[i], pid[i]);
+  }
+
+  void set(size_t i, const TrackParCov_t& trc)
+  {
+    x[i] = trc.getX();
+    alpha[i] = trc.getAlpha();
+    for (int j = 0; j < track::kNParams; j++) {
+      par[j][i] = trc.getParam(j);
+    }
+    for (int j = 0; j < track::kCovMatSize; j++) {
+      cov[j][i] = trc.getCov()[j];
+    }
+  }
+
+ private:
+  template <typename F>
+  void forEachArray(F&& f)
+  {
+    f(x);
+    f(alpha);
+    for (auto& v : par) {
+      f(v);
+    }
+    for (auto& v : cov) {
+      f(v);
+    }
+    f(absCharge);
+    f(pid);
+    f(ok);
+  }
+};
+
+} // namespace base
+} // namespace o2
+
+#endif
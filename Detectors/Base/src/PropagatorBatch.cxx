@@ -0,0 +1,341 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PropagatorBatch.cxx
+/// \brief Propagation of batches of tracks in struct-of-arrays layout
+
+#include "DetectorsBase/Propagator.h"
+#include "DetectorsBase/TrackParCovBatch.h"
+#include "CommonConstants/MathConstants.h"
+#include "ReconstructionDataFormats/Vertex.h"
+#include <cmath>
+#include <vector>
+
+using namespace o2::base;
+
+namespace
+{
+
+// Same as TrackParametrizationWithError::checkCovariance for the covariance elements of one track,
+// written with selections instead of branches to allow the vectorization of the loop over the tracks.
+template <typename value_T>
+inline void checkCovariance(value_T* c)
+{
+  using namespace o2::track;
+  auto limit = [c](int diag, value_T max, int o0, int o1, int o2, int o3) {
+    c[diag] = std::abs(c[diag]);
+    value_T scl = c[diag] > max ? std::sqrt(max / c[diag]) : value_T(1);
+    c[diag] = c[diag] > max ? max : c[diag];
+    c[o0] *= scl;
+    c[o1] *= scl;
+    c[o2] *= scl;
+    c[o3] *= scl;
+  };
+  limit(kSigY2, kCY2max, kSigZY, kSigSnpY, kSigTglY, kSigQ2PtY);
+  limit(kSigZ2, kCZ2max, kSigZY, kSigSnpZ, kSigTglZ, kSigQ2PtZ);
+  limit(kSigSnp2, kCSnp2max, kSigSnpY, kSigSnpZ, kSigTglSnp, kSigQ2PtSnp);
+  limit(kSigTgl2, kCTgl2max, kSigTglY, kSigTglZ, kSigTglSnp, kSigQ2PtTgl);
+  limit(kSigQ2Pt2, kC1Pt2max, kSigQ2PtY, kSigQ2PtZ, kSigQ2PtSnp, kSigQ2PtTgl);
+}
+
+// Same as TrackParametrizationWithError::propagateTo(xk, b) for all active tracks of the batch. All tracks go through the
+// same arithmetics and the results are selected at the end: the tracks which cannot be propagated are left unchanged and
+// flagged as failed, the inactive ones are just left unchanged.
+template <typename value_T>
+void propagateHelix(TrackParCovBatch<value_T>& tracks, const value_T* __restrict__ xk, const uint8_t* __restrict__ active, value_T b)
+{
+  using namespace o2::track;
+  using value_t = value_T;
+  namespace cmath = o2::constants::math;
+  const size_t n = tracks.size();
+  value_t* __restrict__ tx = tracks.x.data();
+  value_t* __restrict__ ty = tracks.par[kY].data();
+  value_t* __restrict__ tz = tracks.par[kZ].data();
+  value_t* __restrict__ tsnp = tracks.par[kSnp].data();
+  const value_t* __restrict__ ttgl = tracks.par[kTgl].data();
+  const value_t* __restrict__ tq2pt = tracks.par[kQ2Pt].data();
+  const uint8_t* __restrict__ tcharge = tracks.absCharge.data();
+  uint8_t* __restrict__ tok = tracks.ok.data();
+  value_t* __restrict__ tc[kCovMatSize];
+  for (int j = 0; j < kCovMatSize; j++) {
+    tc[j] = tracks.cov[j].data();
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    value_t dx = xk[i] - tx[i];
+    bool move = active[i] && std::abs(dx) >= cmath::Almost0;
+    value_t crv = tcharge[i] ? tq2pt[i] * b * cmath::B2C : 0.;
+    value_t x2r = crv * dx;
+    value_t f1 = tsnp[i], f2 = f1 + x2r;
+    value_t r1 = std::sqrt((1.f - f1) * (1.f + f1));
+    value_t r2 = std::sqrt((1.f - f2) * (1.f + f2));
+    bool good = std::abs(f1) <= cmath::Almost1 && std::abs(f2) <= cmath::Almost1 && std::abs(r1) >= cmath::Almost0 && std::abs(r2) >= cmath::Almost0;
+    double dy2dx = (f1 + f2) / (r1 + r2);
+    bool arcz = std::abs(x2r) > 0.05f;
+    value_t arg = r1 * f2 - r2 * f1;
+    good = good && (!arcz || std::abs(arg) <= cmath::Almost1);
+    value_t rot = std::asin(arg);
+    if (f1 * f1 + f2 * f2 > 1.f && f1 * f2 < 0.f) { // special cases of large rotations or large abs angles
+      rot = f2 > 0.f ? cmath::PI - rot : -cmath::PI - rot;
+    }
+    value_t dz = arcz ? value_t(ttgl[i] / crv * rot) : value_t(dx * (r2 + f2 * dy2dx) * ttgl[i]);
+    value_t dy = dx * dy2dx;
+
+    value_t y = ty[i] + dy, z = tz[i] + dz, snp = tsnp[i] + x2r;
+    snp = snp > cmath::Almost1 ? cmath::Almost1 : (snp < -cmath::Almost1 ? -cmath::Almost1 : snp);
+
+    value_t c[kCovMatSize];
+    for (int j = 0; j < kCovMatSize; j++) {
+      c[j] = tc[j][i];
+    }
+    value_t &c00 = c[kSigY2], &c10 = c[kSigZY], &c11 = c[kSigZ2], &c20 = c[kSigSnpY], &c21 = c[kSigSnpZ],
+            &c22 = c[kSigSnp2], &c30 = c[kSigTglY], &c31 = c[kSigTglZ], &c32 = c[kSigTglSnp], &c33 = c[kSigTgl2],
+            &c40 = c[kSigQ2PtY], &c41 = c[kSigQ2PtZ], &c42 = c[kSigQ2PtSnp], &c43 = c[kSigQ2PtTgl],
+            &c44 = c[kSigQ2Pt2];
+
+    // evaluate matrix in double prec.
+    double rinv = 1. / r1;
+    double r3inv = rinv * rinv * rinv;
+    double f24 = dx * b * cmath::B2C; // x2r/mP[kQ2Pt];
+    double f02 = dx * r3inv;
+    double f04 = 0.5 * f24 * f02;
+    double f12 = f02 * ttgl[i] * f1;
+    double f14 = 0.5 * f24 * f12; // 0.5*f24*f02*getTgl()*f1;
+    double f13 = dx * rinv;
+
+    // b = C*ft
+    double b00 = f02 * c20 + f04 * c40, b01 = f12 * c20 + f14 * c40 + f13 * c30;
+    double b02 = f24 * c40;
+    double b10 = f02 * c21 + f04 * c41, b11 = f12 * c21 + f14 * c41 + f13 * c31;
+    double b12 = f24 * c41;
+    double b20 = f02 * c22 + f04 * c42, b21 = f12 * c22 + f14 * c42 + f13 * c32;
+    double b22 = f24 * c42;
+    double b40 = f02 * c42 + f04 * c44, b41 = f12 * c42 + f14 * c44 + f13 * c43;
+    double b42 = f24 * c44;
+    double b30 = f02 * c32 + f04 * c43, b31 = f12 * c32 + f14 * c43 + f13 * c33;
+    double b32 = f24 * c43;
+
+    // a = f*b = f*C*ft
+    double a00 = f02 * b20 + f04 * b40, a01 = f02 * b21 + f04 * b41, a02 = f02 * b22 + f04 * b42;
+    double a11 = f12 * b21 + f14 * b41 + f13 * b31, a12 = f12 * b22 + f14 * b42 + f13 * b32;
+    double a22 = f24 * b42;
+
+    // F*C*Ft = C + (b + bt + a)
+    c00 += b00 + b00 + a00;
+    c10 += b10 + b01 + a01;
+    c20 += b20 + b02 + a02;
+    c30 += b30;
+    c40 += b40;
+    c11 += b11 + b11 + a11;
+    c21 += b21 + b12 + a12;
+    c31 += b31;
+    c41 += b41;
+    c22 += b22 + b22 + a22;
+    c32 += b32;
+    c42 += b42;
+
+    checkCovariance(c);
+
+    bool update = move && good;
+    tx[i] = update ? xk[i] : tx[i];
+    ty[i] = update ? y : ty[i];
+    tz[i] = update ? z : tz[i];
+    tsnp[i] = update ? snp : tsnp[i];
+    for (int j = 0; j < kCovMatSize; j++) {
+      tc[j][i] = update ? c[j] : tc[j][i];
+    }
+    tok[i] = move && !good ? 0 : tok[i];
+  }
+}
+
+} // namespace
+
+//_______________________________________________________________________
+template <typename value_T>
+bool PropagatorImpl<value_T>::propagateBatchToX(TrackParCovBatch<value_type>& tracks, const value_type* xToGo, value_type bZ, value_type maxSnp, value_type maxStep,
+                                                PropagatorImpl<value_T>::MatCorrType matCorr, int signCorr) const
+{
+  // propagate each track of the batch to its own X, the steps are done by all tracks together, as in propagateToX
+  const size_t n = tracks.size();
+  std::vector<value_type> xStep(n), sina(n), cosa(n);
+  std::vector<int> dirs(n);
+  std::vector<uint8_t> active(n);
+  std::vector<math_utils::Point3D<value_type>> xyz0(n);
+  std::vector<size_t> toCorrect;
+  std::vector<MatBudget> budgets;
+  for (size_t i = 0; i < n; i++) {
+    dirs[i] = xToGo[i] - tracks.x[i] > 0.f ? 1 : -1;
+    sina[i] = std::sin(tracks.alpha[i]);
+    cosa[i] = std::cos(tracks.alpha[i]);
+  }
+  auto getXYZGlo = [&tracks, &sina, &cosa](size_t i) {
+    value_type x = tracks.x[i], y = tracks.par[o2::track::kY][i];
+    return math_utils::Point3D<value_type>(x * cosa[i] - y * sina[i], x * sina[i] + y * cosa[i], tracks.par[o2::track::kZ][i]);
+  };
+
+  TrackParCov_t track;
+  while (true) {
+    size_t nActive = 0;
+    for (size_t i = 0; i < n; i++) {
+      auto dx = xToGo[i] - tracks.x[i];
+      auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
+      xStep[i] = tracks.x[i] + (dirs[i] < 0 ? -step : step);
+      active[i] = tracks.ok[i] && math_utils::detail::abs<value_type>(dx) > Epsilon;
+      nActive += active[i];
+    }
+    if (!nActive) {
+      break;
+    }
+    if (matCorr != MatCorrType::USEMatCorrNONE) {
+      for (size_t i = 0; i < n; i++) {
+        if (active[i]) {
+          xyz0[i] = getXYZGlo(i);
+        }
+      }
+    }
+
+    propagateHelix(tracks, xStep.data(), active.data(), bZ);
+
+    // the material budgets of all steps are queried before the corrections are applied.
+    // the query itself is still scalar: MatLayerCylSet::getMatBudget (or TGeo) is called for each track
+    toCorrect.clear();
+    for (size_t i = 0; i < n; i++) {
+      if (active[i] && tracks.ok[i]) {
+        toCorrect.push_back(i);
+      }
+    }
+    if (matCorr != MatCorrType::USEMatCorrNONE) {
+      budgets.resize(toCorrect.size());
+      for (size_t k = 0; k < toCorrect.size(); k++) {
+        budgets[k] = getMatBudget(matCorr, xyz0[toCorrect[k]], getXYZGlo(toCorrect[k]));
+      }
+    }
+    for (size_t k = 0; k < toCorrect.size(); k++) {
+      auto i = toCorrect[k];
+      // as in propagateToX, the track exceeding maxSnp is still corrected for the material before being abandoned
+      bool snpOK = maxSnp <= 0 || math_utils::detail::abs<value_type>(tracks.par[o2::track::kSnp][i]) < maxSnp;
+      if (matCorr != MatCorrType::USEMatCorrNONE) {
+        tracks.get(i, track);
+        const auto& mb = budgets[k];
+        if (!track.correctForMaterial(mb.meanX2X0, mb.getXRho(signCorr ? signCorr : -dirs[i]))) {
+          snpOK = false;
+        }
+        tracks.set(i, track);
+      }
+      tracks.ok[i] = snpOK;
+    }
+  }
+
+  bool res = true;
+  for (size_t i = 0; i < n; i++) {
+    if (tracks.ok[i]) {
+      tracks.x[i] = xToGo[i];
+    } else {
+      res = false;
+    }
+  }
+  return res;
+}
+
+//_______________________________________________________________________
+template <typename value_T>
+bool PropagatorImpl<value_T>::propagateToX(TrackParCovBatch<value_type>& tracks, value_type x, value_type bZ, value_type maxSnp, value_type maxStep,
+                                           PropagatorImpl<value_T>::MatCorrType matCorr, int signCorr) const
+{
+  std::vector<value_type> xToGo(tracks.size(), x);
+  return propagateBatchToX(tracks, xToGo.data(), bZ, maxSnp, maxStep, matCorr, signCorr);
+}
+
+//_______________________________________________________________________
+template <typename value_T>
+bool PropagatorImpl<value_T>::propagateToDCA(const o2::dataformats::VertexBase& vtx, TrackParCovBatch<value_type>& tracks, value_type bZ,
+                                             value_type maxStep, PropagatorImpl<value_T>::MatCorrType matCorr,
+                                             o2::dataformats::DCA* dca, int signCorr, value_type maxD) const
+{
+  // propagate the tracks to their DCA to the vertex, the rotations to the DCA frames are done track by track
+  const size_t n = tracks.size();
+  std::vector<size_t> savedIdx; // the tracks sent to the propagation, to recover them after a failure
+  std::vector<TrackParCov_t> saved;
+  std::vector<value_type> xToGo(n), yToGo(n);
+  value_type zv = vtx.getZ();
+  TrackParCov_t track;
+  for (size_t i = 0; i < n; i++) {
+    if (!tracks.ok[i]) {
+      continue;
+    }
+    tracks.get(i, track);
+    value_type sn, cs, alp = track.getAlpha();
+    math_utils::detail::sincos<value_type>(alp, sn, cs);
+    value_type x = track.getX(), y = track.getY(), snp = track.getSnp(), csp = math_utils::detail::sqrt<value_type>((1.f - snp) * (1.f + snp));
+    value_type xv = vtx.getX() * cs + vtx.getY() * sn, yv = -vtx.getX() * sn + vtx.getY() * cs;
+    x -= xv;
+    y -= yv;
+    // Estimate the impact parameter neglecting the track curvature
+    value_type d = math_utils::detail::abs<value_type>(x * snp - y * csp);
+    if (d > maxD) {
+      tracks.ok[i] = 0;
+      continue;
+    }
+    value_type crv = track.getCurvature(bZ);
+    value_type tgfv = -(crv * x - snp) / (crv * y + csp);
+    sn = tgfv / math_utils::detail::sqrt<value_type>(1.f + tgfv * tgfv);
+    cs = math_utils::detail::sqrt<value_type>((1. - sn) * (1. + sn));
+    cs = (math_utils::detail::abs<value_type>(tgfv) > o2::constants::math::Almost0) ? sn / tgfv : o2::constants::math::Almost1;
+
+    x = xv * cs + yv * sn;
+    yv = -xv * sn + yv * cs;
+    xv = x;
+
+    alp += math_utils::detail::asin<value_type>(sn);
+    if (!track.rotate(alp)) {
+      tracks.ok[i] = 0;
+      continue;
+    }
+    savedIdx.push_back(i);
+    tracks.get(i, saved.emplace_back());
+    tracks.set(i, track);
+    xToGo[i] = xv;
+    yToGo[i] = yv;
+  }
+
+  propagateBatchToX(tracks, xToGo.data(), bZ, 0.85, maxStep, matCorr, signCorr);
+
+  bool res = true;
+  for (size_t i = 0, k = 0; i < n; i++) {
+    bool wasSaved = k < savedIdx.size() && savedIdx[k] == i;
+    k += wasSaved;
+    if (!tracks.ok[i]) {
+      if (wasSaved) {
+        tracks.set(i, saved[k - 1]);
+      }
+      res = false;
+      continue;
+    }
+    if (dca) {
+      value_type sn, cs;
+      math_utils::detail::sincos<value_type>(tracks.alpha[i], sn, cs);
+      auto s2ylocvtx = vtx.getSigmaX2() * sn * sn + vtx.getSigmaY2() * cs * cs - 2. * vtx.getSigmaXY() * cs * sn;
+      dca[i].set(tracks.par[o2::track::kY][i] - yToGo[i], tracks.par[o2::track::kZ][i] - zv,
+                 tracks.cov[o2::track::kSigY2][i] + s2ylocvtx, tracks.cov[o2::track::kSigZY][i], tracks.cov[o2::track::kSigZ2][i] + vtx.getSigmaZ2());
+    }
+  }
+  return res;
+}
+
+namespace o2::base
+{
+template bool PropagatorImpl<float>::propagateBatchToX(TrackParCovBatch<float>&, const float*, float, float, float, PropagatorImpl<float>::MatCorrType, int) const;
+template bool PropagatorImpl<float>::propagateToX(TrackParCovBatch<float>&, float, float, float, float, PropagatorImpl<float>::MatCorrType, int) const;
+template bool PropagatorImpl<float>::propagateToDCA(const o2::dataformats::VertexBase&, TrackParCovBatch<float>&, float, float, PropagatorImpl<float>::MatCorrType, o2::dataformats::DCA*, int, float) const;
+template bool PropagatorImpl<double>::propagateBatchToX(TrackParCovBatch<double>&, const double*, double, double, double, PropagatorImpl<double>::MatCorrType, int) const;
+template bool PropagatorImpl<double>::propagateToX(TrackParCovBatch<double>&, double, double, double, double, PropagatorImpl<double>::MatCorrType, int) const;
+template bool PropagatorImpl<double>::propagateToDCA(const o2::dataformats::VertexBase&, TrackParCovBatch<double>&, double, double, PropagatorImpl<double>::MatCorrType, o2::dataformats::DCA*, int, double) const;
+} // namespace o2::base
@@ -239,7 +239,7 @@ void Stack::PushTrack(Int_t toBeDone, Int_t parentId, Int_t pdgCode, Double_t px
     // while the particle will still be treated as a primary given its bit settings
     p.SetUniqueID(proc2);
 
-    mIndexMap[trackId] = trackId;
+    insertInVector(mIndexMap, trackId, trackId);
     p.SetBit(ParticleStatus::kKeep, 1);
     if (p.TestBit(ParticleStatus::kToBeDone)) {
       mNumberOfPrimariesforTracking++;
@@ -278,7 +278,7 @@ void Stack::PushTrack(int toBeDone, TParticle& p)
   // - during parallel simulation to push primary particles (called by the stack itself)
   if (p.TestBit(ParticleStatus::kPrimary)) {
     // one to one mapping for primaries
-    mIndexMap[mNumberOfPrimaryParticles] = mNumberOfPrimaryParticles;
+    insertInVector(mIndexMap, mNumberOfPrimaryParticles, mNumberOfPrimaryParticles);
     mNumberOfPrimaryParticles++;
     mPrimaryParticles.push_back(p);
     // Push particle on the stack
@@ -512,7 +512,7 @@ void Stack::FinishPrimary()
       continue;
     }
     Int_t index3 = (mIsG4Like) ? invreOrderedIndices[index2] : index2;
-    mIndexMap[idTrack] = index3 + indexoffset;
+    insertInVector(mIndexMap, idTrack, index3 + indexoffset);
   }
 
   // we can now clear the particles buffer!
@@ -559,13 +559,11 @@ void Stack::UpdateTrackIndex(TRefArray* detList)
   // use some caching since repeated trackIDs
   for (auto& ref : *mTrackRefs) {
     const auto id = ref.getTrackID();
-    auto iter = mIndexMap.find(id);
-    if (iter == mIndexMap.end()) {
+    const auto newid = (id >= 0 && id < (int)mIndexMap.size()) ? mIndexMap[id] : -1;
+    if (newid == -1) {
       LOG(info) << "Invalid trackref ... needs to be rmoved \n";
-      ref.setTrackID(-1);
-    } else {
-      ref.setTrackID(iter->second);
     }
+    ref.setTrackID(newid);
   }
 
   // sort trackrefs according to new track index
@@ -577,9 +575,16 @@ void Stack::UpdateTrackIndex(TRefArray* detList)
     return a.getTrackID() < b.getTrackID();
   });
 
-  for (auto det : mActiveDetectors) {
-    // update the track indices by delegating to specialized detector functions
-    det->updateHitTrackIndices(mIndexMap);
+  // update the track indices by delegating to specialized detector functions;
+  // the hits of different detectors are independent and can be updated concurrently
+  const gsl::span<const int> indexmapping(mIndexMap);
+  const int nDetectors = mActiveDetectors.size();
+#ifdef WITH_OPENMP
+  const int nThreads = std::max(1, std::min(o2::sim::StackParam::Instance().hitIndexUpdateThreads, nDetectors));
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads) if (nThreads > 1)
+#endif
+  for (int idet = 0; idet < nDetectors; ++idet) {
+    mActiveDetectors[idet]->updateHitTrackIndices(indexmapping);
   } // List of active detectors
 
   LOG(debug) << "Stack::UpdateTrackIndex: ...stack and " << nColl << " collections updated.";
@@ -605,6 +610,7 @@ void Stack::Reset()
   mPrimaryParticles.clear();
   mTrackRefs->clear();
   mTrackIDtoParticlesEntry.clear();
+  mIndexMap.clear();
   mHitCounter = 0;
 }
 
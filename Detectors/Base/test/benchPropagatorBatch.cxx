@@ -0,0 +1,116 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// Propagation of the same tracks to a common X and to the DCA to a vertex, track by track with the
+/// scalar Propagator and all together in a TrackParCovBatch, without material corrections.
+
+#include <benchmark/benchmark.h>
+#include "DetectorsBase/Propagator.h"
+#include "DetectorsBase/TrackParCovBatch.h"
+#include "ReconstructionDataFormats/DCA.h"
+#include "ReconstructionDataFormats/Vertex.h"
+#include <random>
+#include <vector>
+
+using TrackParCov = o2::track::TrackParCov;
+using MatCorrType = o2::base::Propagator::MatCorrType;
+
+namespace
+{
+constexpr float Bz = -5.f;
+constexpr float MaxStep = 2.f;
+
+std::vector<TrackParCov> generateTracks(int n)
+{
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<float> flat(-1.f, 1.f);
+  std::vector<TrackParCov> tracks;
+  for (int i = 0; i < n; i++) {
+    TrackParCov::params_t par{flat(gen) * 0.1f, flat(gen) * 5.f, flat(gen) * 0.5f, flat(gen), flat(gen) * 3.f};
+    TrackParCov::covMat_t cov{1e-3, 1e-5, 1e-3, 1e-5, 1e-6, 1e-4, 1e-6, 1e-5, 1e-6, 1e-4, 1e-5, 1e-6, 1e-5, 1e-6, 1e-2};
+    tracks.emplace_back(3.f, flat(gen) * 3.f, par, cov, 1);
+  }
+  return tracks;
+}
+
+o2::base::TrackParCovBatch<float> toBatch(const std::vector<TrackParCov>& tracks)
+{
+  o2::base::TrackParCovBatch<float> batch;
+  batch.reserve(tracks.size());
+  for (const auto& trc : tracks) {
+    batch.add(trc);
+  }
+  return batch;
+}
+} // namespace
+
+static void BM_PropagateToXScalar(benchmark::State& state)
+{
+  auto prop = o2::base::Propagator::Instance(true);
+  const auto input = generateTracks(state.range(0));
+  for (auto _ : state) {
+    auto tracks = input;
+    for (auto& trc : tracks) {
+      benchmark::DoNotOptimize(prop->propagateToX(trc, 40.f, Bz, 0.85f, MaxStep, MatCorrType::USEMatCorrNONE));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PropagateToXBatch(benchmark::State& state)
+{
+  auto prop = o2::base::Propagator::Instance(true);
+  const auto input = toBatch(generateTracks(state.range(0)));
+  for (auto _ : state) {
+    auto tracks = input;
+    benchmark::DoNotOptimize(prop->propagateToX(tracks, 40.f, Bz, 0.85f, MaxStep, MatCorrType::USEMatCorrNONE));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PropagateToDCAScalar(benchmark::State& state)
+{
+  auto prop = o2::base::Propagator::Instance(true);
+  const auto input = generateTracks(state.range(0));
+  o2::dataformats::VertexBase vtx({0.01f, -0.02f, 0.5f}, {1e-4f, 0.f, 1e-4f, 0.f, 0.f, 1e-3f});
+  std::vector<o2::dataformats::DCA> dca(input.size());
+  for (auto _ : state) {
+    auto tracks = input;
+    for (size_t i = 0; i < tracks.size(); i++) {
+      benchmark::DoNotOptimize(prop->propagateToDCA(vtx, tracks[i], Bz, MaxStep, MatCorrType::USEMatCorrNONE, &dca[i]));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PropagateToDCABatch(benchmark::State& state)
+{
+  auto prop = o2::base::Propagator::Instance(true);
+  const auto input = toBatch(generateTracks(state.range(0)));
+  o2::dataformats::VertexBase vtx({0.01f, -0.02f, 0.5f}, {1e-4f, 0.f, 1e-4f, 0.f, 0.f, 1e-3f});
+  std::vector<o2::dataformats::DCA> dca(input.size());
+  for (auto _ : state) {
+    auto tracks = input;
+    benchmark::DoNotOptimize(prop->propagateToDCA(vtx, tracks, Bz, MaxStep, MatCorrType::USEMatCorrNONE, dca.data()));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PropagateToXScalar)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(BM_PropagateToXBatch)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(BM_PropagateToDCAScalar)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(BM_PropagateToDCABatch)->RangeMultiplier(8)->Range(64, 32768);
+
+BENCHMARK_MAIN();
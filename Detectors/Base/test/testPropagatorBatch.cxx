@@ -0,0 +1,116 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test PropagatorBatch class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "DetectorsBase/Propagator.h"
+#include "DetectorsBase/TrackParCovBatch.h"
+#include "ReconstructionDataFormats/DCA.h"
+#include "ReconstructionDataFormats/Vertex.h"
+
+namespace o2
+{
+namespace
+{
+using TrackParCov = o2::track::TrackParCov;
+using MatCorrType = o2::base::Propagator::MatCorrType;
+
+std::vector<TrackParCov> generateTracks(int n)
+{
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<float> flat(-1.f, 1.f);
+  std::vector<TrackParCov> tracks;
+  for (int i = 0; i < n; i++) {
+    TrackParCov::params_t par{flat(gen) * 0.1f, flat(gen) * 5.f, flat(gen) * 0.5f, flat(gen), flat(gen) * (i % 10 ? 3.f : 20.f)};
+    TrackParCov::covMat_t cov{1e-3, 1e-5, 1e-3, 1e-5, 1e-6, 1e-4, 1e-6, 1e-5, 1e-6, 1e-4, 1e-5, 1e-6, 1e-5, 1e-6, 1e-2};
+    tracks.emplace_back(3.f, flat(gen) * 3.f, par, cov, i % 7 ? 1 : 0);
+  }
+  return tracks;
+}
+
+void compareTracks(const TrackParCov& scalar, const TrackParCov& batch)
+{
+  const float tol = 1e-3; // in percent, the helix steps may be contracted differently by the compiler
+  BOOST_CHECK_CLOSE(scalar.getX(), batch.getX(), tol);
+  BOOST_CHECK_CLOSE(scalar.getAlpha(), batch.getAlpha(), tol);
+  for (int j = 0; j < o2::track::kNParams; j++) {
+    BOOST_CHECK_SMALL(scalar.getParam(j) - batch.getParam(j), 1e-4f * (1.f + std::abs(scalar.getParam(j))));
+  }
+  for (int j = 0; j < o2::track::kCovMatSize; j++) {
+    BOOST_CHECK_SMALL(scalar.getCov()[j] - batch.getCov()[j], 1e-4f * (1.f + std::abs(scalar.getCov()[j])));
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(PropagatorBatchToX)
+{
+  const float bz = -5.f;
+  auto prop = o2::base::Propagator::Instance(true);
+  auto tracks = generateTracks(1000);
+  o2::base::TrackParCovBatch<float> batch;
+  batch.reserve(tracks.size());
+  for (const auto& trc : tracks) {
+    batch.add(trc);
+  }
+  for (float x : {40.f, 120.f, 250.f}) {
+    std::vector<bool> okScalar(tracks.size());
+    for (size_t i = 0; i < tracks.size(); i++) {
+      okScalar[i] = prop->propagateToX(tracks[i], x, bz, 0.85f, 2.f, MatCorrType::USEMatCorrNONE);
+    }
+    batch.ok.assign(batch.size(), 1);
+    prop->propagateToX(batch, x, bz, 0.85f, 2.f, MatCorrType::USEMatCorrNONE);
+    int nFailed = 0;
+    for (size_t i = 0; i < tracks.size(); i++) {
+      BOOST_CHECK_EQUAL(okScalar[i], bool(batch.ok[i]));
+      TrackParCov trc;
+      batch.get(i, trc);
+      compareTracks(tracks[i], trc);
+      nFailed += !okScalar[i];
+    }
+    BOOST_CHECK(nFailed > 0 && nFailed < int(tracks.size())); // both branches must be exercised
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PropagatorBatchToDCA)
+{
+  const float bz = 5.f;
+  auto prop = o2::base::Propagator::Instance(true);
+  auto tracks = generateTracks(1000);
+  o2::dataformats::VertexBase vtx({0.01f, -0.02f, 0.5f}, {1e-4f, 0.f, 1e-4f, 0.f, 0.f, 1e-3f});
+  o2::base::TrackParCovBatch<float> batch;
+  for (const auto& trc : tracks) {
+    batch.add(trc);
+  }
+  std::vector<o2::dataformats::DCA> dcaScalar(tracks.size()), dcaBatch(tracks.size());
+  std::vector<bool> okScalar(tracks.size());
+  for (size_t i = 0; i < tracks.size(); i++) {
+    okScalar[i] = prop->propagateToDCA(vtx, tracks[i], bz, 2.f, MatCorrType::USEMatCorrNONE, &dcaScalar[i]);
+  }
+  prop->propagateToDCA(vtx, batch, bz, 2.f, MatCorrType::USEMatCorrNONE, dcaBatch.data());
+  for (size_t i = 0; i < tracks.size(); i++) {
+    BOOST_CHECK_EQUAL(okScalar[i], bool(batch.ok[i]));
+    TrackParCov trc;
+    batch.get(i, trc);
+    compareTracks(tracks[i], trc);
+    if (okScalar[i]) {
+      BOOST_CHECK_SMALL(dcaScalar[i].getY() - dcaBatch[i].getY(), 1e-4f);
+      BOOST_CHECK_SMALL(dcaScalar[i].getZ() - dcaBatch[i].getZ(), 1e-4f);
+    }
+  }
+}
+
+} // namespace o2
@@ -0,0 +1,134 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test PropagatorBatch class with material corrections
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <unistd.h>
+#include <vector>
+
+#include "buildMatBudLUT.C"
+#include "DetectorsBase/Propagator.h"
+#include "DetectorsBase/TrackParCovBatch.h"
+#include "ReconstructionDataFormats/DCA.h"
+#include "ReconstructionDataFormats/Vertex.h"
+
+namespace o2
+{
+namespace
+{
+using TrackParCov = o2::track::TrackParCov;
+using MatCorrType = o2::base::Propagator::MatCorrType;
+
+std::vector<TrackParCov> generateTracks(int n)
+{
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<float> flat(-1.f, 1.f);
+  std::vector<TrackParCov> tracks;
+  for (int i = 0; i < n; i++) {
+    TrackParCov::params_t par{flat(gen) * 0.1f, flat(gen) * 5.f, flat(gen) * 0.5f, flat(gen), flat(gen) * (i % 10 ? 3.f : 20.f)};
+    TrackParCov::covMat_t cov{1e-3, 1e-5, 1e-3, 1e-5, 1e-6, 1e-4, 1e-6, 1e-5, 1e-6, 1e-4, 1e-5, 1e-6, 1e-5, 1e-6, 1e-2};
+    tracks.emplace_back(3.f, flat(gen) * 3.f, par, cov, i % 7 ? 1 : 0);
+  }
+  return tracks;
+}
+
+void compareTracks(const TrackParCov& scalar, const TrackParCov& batch)
+{
+  const float tol = 1e-3; // in percent, the helix steps may be contracted differently by the compiler
+  BOOST_CHECK_CLOSE(scalar.getX(), batch.getX(), tol);
+  BOOST_CHECK_CLOSE(scalar.getAlpha(), batch.getAlpha(), tol);
+  for (int j = 0; j < o2::track::kNParams; j++) {
+    BOOST_CHECK_SMALL(scalar.getParam(j) - batch.getParam(j), 1e-4f * (1.f + std::abs(scalar.getParam(j))));
+  }
+  for (int j = 0; j < o2::track::kCovMatSize; j++) {
+    BOOST_CHECK_SMALL(scalar.getCov()[j] - batch.getCov()[j], 1e-4f * (1.f + std::abs(scalar.getCov()[j])));
+  }
+}
+
+void compareToX(MatCorrType matCorr)
+{
+  const float bz = -5.f;
+  auto prop = o2::base::Propagator::Instance(true);
+  auto tracks = generateTracks(200);
+  o2::base::TrackParCovBatch<float> batch;
+  for (const auto& trc : tracks) {
+    batch.add(trc);
+  }
+  for (float x : {10.f, 45.f}) { // through the ITS inner and outer barrels
+    std::vector<bool> okScalar(tracks.size());
+    for (size_t i = 0; i < tracks.size(); i++) {
+      okScalar[i] = prop->propagateToX(tracks[i], x, bz, 0.85f, 2.f, matCorr);
+    }
+    batch.ok.assign(batch.size(), 1);
+    prop->propagateToX(batch, x, bz, 0.85f, 2.f, matCorr);
+    for (size_t i = 0; i < tracks.size(); i++) {
+      BOOST_CHECK_EQUAL(okScalar[i], bool(batch.ok[i]));
+      TrackParCov trc;
+      batch.get(i, trc);
+      compareTracks(tracks[i], trc);
+    }
+  }
+}
+
+void compareToDCA(MatCorrType matCorr)
+{
+  const float bz = 5.f;
+  auto prop = o2::base::Propagator::Instance(true);
+  auto tracks = generateTracks(200);
+  for (auto& trc : tracks) { // start outside of the beam pipe, to cross material on the way to the vertex
+    prop->propagateToX(trc, 10.f, bz, 0.85f, 2.f, MatCorrType::USEMatCorrNONE);
+  }
+  o2::dataformats::VertexBase vtx({0.01f, -0.02f, 0.5f}, {1e-4f, 0.f, 1e-4f, 0.f, 0.f, 1e-3f});
+  o2::base::TrackParCovBatch<float> batch;
+  for (const auto& trc : tracks) {
+    batch.add(trc);
+  }
+  std::vector<o2::dataformats::DCA> dcaScalar(tracks.size()), dcaBatch(tracks.size());
+  std::vector<bool> okScalar(tracks.size());
+  for (size_t i = 0; i < tracks.size(); i++) {
+    okScalar[i] = prop->propagateToDCA(vtx, tracks[i], bz, 2.f, matCorr, &dcaScalar[i]);
+  }
+  prop->propagateToDCA(vtx, batch, bz, 2.f, matCorr, dcaBatch.data());
+  for (size_t i = 0; i < tracks.size(); i++) {
+    BOOST_CHECK_EQUAL(okScalar[i], bool(batch.ok[i]));
+    TrackParCov trc;
+    batch.get(i, trc);
+    compareTracks(tracks[i], trc);
+    if (okScalar[i]) {
+      BOOST_CHECK_SMALL(dcaScalar[i].getY() - dcaBatch[i].getY(), 1e-4f);
+      BOOST_CHECK_SMALL(dcaScalar[i].getZ() - dcaBatch[i].getZ(), 1e-4f);
+    }
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(PropagatorBatchMaterial)
+{
+  // using process specific geometry names in order
+  // to avoid race/conditions with other tests accessing geometry
+  std::string geomPrefix("matBudGeomBatch");
+  std::string matBudFile("matbudBatch");
+  matBudFile += std::to_string(getpid()) + ".root";
+  BOOST_REQUIRE(buildMatBudLUT(2, 20, matBudFile, geomPrefix + std::to_string(getpid()), "align-geom.mDetectors=none")); // generate LUT and load the geometry
+
+  o2::base::Propagator::Instance(true)->setMatLUT(&mbLUT);
+  compareToX(MatCorrType::USEMatCorrLUT);
+  compareToDCA(MatCorrType::USEMatCorrLUT);
+
+  compareToX(MatCorrType::USEMatCorrTGeo);
+  compareToDCA(MatCorrType::USEMatCorrTGeo);
+}
+
+} // namespace o2
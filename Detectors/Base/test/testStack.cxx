@@ -13,9 +13,12 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
+#include <map>
 #include "DetectorsBase/Stack.h"
+#include "SimulationDataFormat/TrackReference.h"
 #include "TFile.h"
 #include "TMCProcess.h"
+#include "TRefArray.h"
 
 using namespace o2;
 
@@ -44,3 +47,84 @@ BOOST_AUTO_TEST_CASE(Stack_test)
     BOOST_CHECK(inst->getPrimaries().size() == 2);
   }
 }
+
+// the track references are remapped with the dense index vector of the stack;
+// compare with the lookup in a std::map from the original to the kept track index
+BOOST_AUTO_TEST_CASE(Stack_indexmap_test)
+{
+  o2::data::Stack st;
+  st.pruneKinematics(true);
+  const int nPrim = 3, nSec = 4, nTer = 3;
+  int ntr, nPushed = 0;
+  std::map<int, int> pxToTrackID; // every track gets a unique px to be identified in the output
+  auto push = [&](int parent, TMCProcess proc) {
+    nPushed++;
+    st.PushTrack(1, parent, 211, nPushed, 0., 10., 20., 0., 0., 0., 0., 0., 0., 0., proc, ntr, 1., 1);
+    pxToTrackID[nPushed] = ntr;
+  };
+  // the length of the reference identifies it after the sorting by UpdateTrackIndex
+  std::vector<int> refTrackIDs;
+  auto addRef = [&](int trackID) {
+    st.addTrackReference(o2::TrackReference(0., 0., 0., 0., 0., 0., refTrackIDs.size(), 0., trackID, 0));
+    refTrackIDs.push_back(trackID);
+  };
+  auto pop = [&]() {
+    int id = -1;
+    BOOST_REQUIRE(st.PopNextTrack(id) != nullptr);
+    return id;
+  };
+
+  for (int i = 0; i < nPrim; i++) {
+    push(-1, kPPrimary);
+  }
+  for (int i = 0; i < nPrim; i++) {
+    int prim = pop();
+    addRef(prim);
+    if (i == 0) {
+      // a reference to an unknown track
+      addRef(100000);
+    }
+    for (int j = 0; j < nSec; j++) {
+      push(prim, kPHadronic);
+    }
+    for (int j = 0; j < nSec; j++) {
+      int sec = pop();
+      if (sec % 2) {
+        addRef(sec);
+      }
+      for (int k = 0; k < nTer; k++) {
+        push(sec, kPHadronic);
+      }
+      // tertiaries without references are not kept
+      for (int k = 0; k < nTer; k++) {
+        int ter = pop();
+        if (ter % 3 == 0) {
+          addRef(ter);
+        }
+      }
+    }
+    st.FinishPrimary();
+  }
+
+  // old index map, built from the kept tracks
+  const auto& tracks = *st.getMCTracks();
+  BOOST_CHECK(int(tracks.size()) < nPushed);
+  std::map<int, int> indexMap;
+  for (int i = 0; i < (int)tracks.size(); i++) {
+    indexMap[pxToTrackID.at(int(tracks[i].GetStartVertexMomentumX()))] = i;
+  }
+
+  // no detectors are active, only the track references are updated
+  TRefArray detList;
+  st.UpdateTrackIndex(&detList);
+  const auto& refs = *st.getTrackRefs();
+  BOOST_REQUIRE_EQUAL(refs.size(), refTrackIDs.size());
+  int nInvalid = 0;
+  for (const auto& ref : refs) {
+    auto iter = indexMap.find(refTrackIDs[int(ref.getLength())]);
+    int expected = iter == indexMap.end() ? -1 : iter->second;
+    nInvalid += expected == -1;
+    BOOST_CHECK_EQUAL(ref.getTrackID(), expected);
+  }
+  BOOST_CHECK_EQUAL(nInvalid, 1);
+}
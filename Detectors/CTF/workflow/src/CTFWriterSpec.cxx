@@ -56,7 +56,15 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TRandom.h>
+#include <TROOT.h>
 #include <filesystem>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <ctime>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -90,6 +98,12 @@ size_t appendToTree(TTree& tree, const std::string brname, T& ptr)
   return s;
 }
 
+template <typename C>
+size_t appendImageToTree(TTree& tree, const std::string& brname, const o2::ctf::BufferType* buffer)
+{
+  return C::getImage(buffer).appendToTree(tree, brname);
+}
+
 using DetID = o2::detectors::DetID;
 using FTrans = o2::rans::DenseHistogram<int32_t>;
 
@@ -106,17 +120,38 @@ class CTFWriterSpec : public o2::framework::Task
   bool isPresent(DetID id) const { return mDets[id]; }
 
  private:
+  // CTF of a TF to be written: encoded images of the detectors and the TF information needed for the output file
+  struct PendingCTF {
+    struct DetImage {
+      DetID det;
+      gsl::span<const o2::ctf::BufferType> data;
+      std::vector<o2::ctf::BufferType> copy; // owns the data once the CTF is queued for the writer thread
+      size_t (*append)(TTree&, const std::string&, const o2::ctf::BufferType*) = nullptr;
+    };
+    CTFHeader header;
+    std::vector<DetImage> images;
+    o2::framework::TimingInfo timingInfo{};
+    o2::framework::DataTakingContext dataTakingContext{};
+    std::string metaDataType{};
+    size_t estimatedSize = 0;
+    size_t nCTF = 0;
+  };
+
   void updateTimeDependentParams(ProcessingContext& pc);
   template <typename C>
-  size_t processDet(o2::framework::ProcessingContext& pc, DetID det, CTFHeader& header, TTree* tree);
+  size_t processDet(o2::framework::ProcessingContext& pc, DetID det, PendingCTF& ctf);
   template <typename C>
   void storeDictionary(DetID det, CTFHeader& header);
   void storeDictionaries();
+  void writeCTF(PendingCTF& ctf, const std::function<void(unsigned int)>& wait);
+  void queueCTF(std::unique_ptr<PendingCTF> ctf);
+  void runWriter();
+  void stopWriter();
   void closeTFTreeAndFile();
-  void prepareTFTreeAndFile();
+  void prepareTFTreeAndFile(const PendingCTF& ctf);
   size_t estimateCTFSize(ProcessingContext& pc);
   size_t getAvailableDiskSpace(const std::string& path, int level);
-  void createLockFile(int level);
+  void createLockFile(int level, const o2::framework::TimingInfo& timingInfo);
   void removeLockFile();
   void finalize();
 
@@ -138,7 +173,6 @@ class CTFWriterSpec : public o2::framework::Task
   size_t mMaxSize = 0;             // if > MinSize, and accumulated size will exceed this value, stop accumulation (even if mMinSize is not reached)
   size_t mChkSize = 0;             // if > 0 and fallback storage provided, reserve this size per CTF file in production on primary storage
   size_t mAccCTFSize = 0;          // so far accumulated size (if any)
-  size_t mCurrCTFSize = 0;         // size of currently processed CTF
   size_t mNCTF = 0;                // total number of CTFs written
   size_t mNCTFPrevDict = 0;        // total number of CTFs used for previous dictionary version
   size_t mNAccCTF = 0;             // total number of CTFs accumulated in the current file
@@ -150,6 +184,7 @@ class CTFWriterSpec : public o2::framework::Task
   int mMaxCTFPerFile = 0;          // max CTFs per files to store
   int mRejRate = 0;                // CTF rejection rule (>0: percentage to reject randomly, <0: reject if timeslice%|value|!=0)
   int mCTFFileCompression = 0;     // CTF file compression level (if >= 0)
+  size_t mWriterQueueSize = 0;     // if > 0, CTFs are written by a separate thread, with at most this number of CTFs pending
   bool mFillMD5 = false;
   std::vector<uint32_t> mTFOrbits{}; // 1st orbits of TF accumulated in current file
   o2::framework::DataTakingContext mDataTakingContext{};
@@ -169,6 +204,17 @@ class CTFWriterSpec : public o2::framework::Task
   int mLockFD = -1;
   std::unique_ptr<TFile> mCTFFileOut;
   std::unique_ptr<TTree> mCTFTreeOut;
+  o2::framework::DataTakingContext mFileDataTakingContext{}; // data taking context of the CTFs in the current file
+  std::string mFileMetaDataType{};
+
+  // The writer thread fills the CTF tree and rotates the files, the processing thread only queues the encoded images.
+  // When the queue is full the processing is blocked, which delays the TFs and throttles the input via the rate limiting.
+  std::thread mWriterThread;
+  std::mutex mWriterMutex;
+  std::condition_variable mWriterCondition;
+  std::deque<std::unique_ptr<PendingCTF>> mWriterQueue; // the CTF being written stays in the queue until it is done
+  std::exception_ptr mWriterError;
+  bool mStopWriter = false;
 
   std::unique_ptr<TFile> mDictFileOut; // file to store dictionary
   std::unique_ptr<TTree> mDictTreeOut; // tree to store dictionary
@@ -221,6 +267,7 @@ void CTFWriterSpec::init(InitContext& ic)
   mSaveDictAfter = ic.options().get<int>("save-dict-after");
   mCTFAutoSave = ic.options().get<long>("save-ctf-after");
   mCTFFileCompression = ic.options().get<int>("ctf-file-compression");
+  mWriterQueueSize = std::max(0, ic.options().get<int>("writer-queue-size"));
   mCTFMetaFileDir = ic.options().get<std::string>("meta-output-dir");
   if (mCTFMetaFileDir != "/dev/null") {
     mCTFMetaFileDir = o2::utils::Str::rectifyDirectory(mCTFMetaFileDir);
@@ -258,6 +305,9 @@ void CTFWriterSpec::init(InitContext& ic)
         LOG(info) << "but does not exceed " << mMaxSize << " bytes";
       }
     }
+    if (mWriterQueueSize) {
+      LOGP(info, "CTFs will be written by a separate thread, with up to {} CTFs pending", mWriterQueueSize);
+    }
   }
 
   mCheckDiskFull = ic.options().get<float>("require-free-disk");
@@ -296,7 +346,7 @@ void CTFWriterSpec::updateTimeDependentParams(ProcessingContext& pc)
 //___________________________________________________________________
 // process data of particular detector
 template <typename C>
-size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det, CTFHeader& header, TTree* tree)
+size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det, PendingCTF& ctf)
 {
   static bool warnedEmpty = false;
   size_t sz = 0;
@@ -313,11 +363,10 @@ size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det
     const auto ctfImage = C::getImage(bdata);
     ctfImage.print(o2::utils::Str::concat_string(det.getName(), ": "), mVerbosity);
     if (mWriteCTF && !mRejectCurrentTF) {
-      sz = ctfImage.appendToTree(*tree, det.getName());
-      header.detectors.set(det);
-    } else {
-      sz = ctfBuffer.size();
+      ctf.images.push_back({det, {bdata, ctfBuffer.size()}, {}, &appendImageToTree<C>});
+      ctf.header.detectors.set(det);
     }
+    sz = ctfBuffer.size();
     if (mCreateDict) {
       if (mFreqsAccumulation[det].empty()) {
         mFreqsAccumulation[det].resize(C::getNBlocks());
@@ -431,110 +480,201 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   if (pc.services().get<o2::framework::TimingInfo>().globalRunNumberChanged) {
     mTimer.Reset();
   }
-  auto cput = mTimer.CpuTime();
   mTimer.Start(false);
   updateTimeDependentParams(pc);
   mRejectCurrentTF = (mRejRate > 0 && int(gRandom->Rndm() * 100) < mRejRate) || (mRejRate < -1 && mTimingInfo.timeslice % (-mRejRate));
-  mCurrCTFSize = estimateCTFSize(pc);
+  // create header
+  auto ctf = std::make_unique<PendingCTF>();
+  ctf->header = CTFHeader{mTimingInfo.runNumber, mTimingInfo.creation, mTimingInfo.firstTForbit, mTimingInfo.tfCounter};
+  ctf->timingInfo = mTimingInfo;
+  ctf->dataTakingContext = mDataTakingContext;
+  ctf->metaDataType = mMetaDataType;
+  ctf->estimatedSize = estimateCTFSize(pc);
+  ctf->nCTF = mNCTF;
+  size_t szCTF = 0;
+  mSizeReport = "";
+  szCTF += processDet<o2::itsmft::CTF>(pc, DetID::ITS, *ctf);
+  szCTF += processDet<o2::tpc::CTF>(pc, DetID::TPC, *ctf);
+  szCTF += processDet<o2::trd::CTF>(pc, DetID::TRD, *ctf);
+  szCTF += processDet<o2::tof::CTF>(pc, DetID::TOF, *ctf);
+  szCTF += processDet<o2::phos::CTF>(pc, DetID::PHS, *ctf);
+  szCTF += processDet<o2::cpv::CTF>(pc, DetID::CPV, *ctf);
+  szCTF += processDet<o2::emcal::CTF>(pc, DetID::EMC, *ctf);
+  szCTF += processDet<o2::hmpid::CTF>(pc, DetID::HMP, *ctf);
+  szCTF += processDet<o2::itsmft::CTF>(pc, DetID::MFT, *ctf);
+  szCTF += processDet<o2::mch::CTF>(pc, DetID::MCH, *ctf);
+  szCTF += processDet<o2::mid::CTF>(pc, DetID::MID, *ctf);
+  szCTF += processDet<o2::zdc::CTF>(pc, DetID::ZDC, *ctf);
+  szCTF += processDet<o2::ft0::CTF>(pc, DetID::FT0, *ctf);
+  szCTF += processDet<o2::fv0::CTF>(pc, DetID::FV0, *ctf);
+  szCTF += processDet<o2::fdd::CTF>(pc, DetID::FDD, *ctf);
+  szCTF += processDet<o2::ctp::CTF>(pc, DetID::CTP, *ctf);
+  if (mReportInterval > 0 && (mTimingInfo.tfCounter % mReportInterval) == 0) {
+    LOGP(important, "CTF {} size report:{} - Total:{}", mTimingInfo.tfCounter, mSizeReport, fmt::group_digits(szCTF));
+  }
+
   if (mWriteCTF && !mRejectCurrentTF) {
-    prepareTFTreeAndFile();
+    if (mWriterQueueSize) {
+      queueCTF(std::move(ctf));
+    } else {
+      writeCTF(*ctf, [&pc](unsigned int ms) { pc.services().get<RawDeviceService>().waitFor(ms); });
+    }
+  } else {
+    LOG(info) << "TF#" << mNCTF << " {" << ctf->header << "} CTF writing is disabled, size was " << szCTF << " bytes";
+  }
+  mTimer.Stop();
 
-    int totalWait = 0, nwaitCycles = 0;
-    while ((mFallBackDirUsed || !mFallBackDirProvided) && mCheckDiskFull) { // we are on the physical disk and not on the RAM disk
-      constexpr size_t MB = 1024 * 1024;
-      constexpr int showFirstN = 10, prsecaleWarnings = 50;
-      try {
-        const auto si = std::filesystem::space(mCTFFileOut->GetName());
-        std::string wmsg{};
-        if (mCheckDiskFull > 0.f && si.available < mCheckDiskFull) {
-          nwaitCycles++;
-          wmsg = fmt::format("Disk has {} MB available while at least {} MB is requested, wait for {} ms (on top of {} ms)", si.available / MB, size_t(mCheckDiskFull) / MB, mWaitDiskFull, totalWait);
-        } else if (mCheckDiskFull < 0.f && float(si.available) / si.capacity < -mCheckDiskFull) { // relative margin requested
-          nwaitCycles++;
-          wmsg = fmt::format("Disk has {:.3f}% available while at least {:.3f}% is requested, wait for {} ms (on top of {} ms)", si.capacity ? float(si.available) / si.capacity * 100.f : 0., -mCheckDiskFull, mWaitDiskFull, totalWait);
-        } else {
-          nwaitCycles = 0;
+  mNCTF++;
+  if (mCreateDict && mSaveDictAfter > 0 && (mNCTF % mSaveDictAfter) == 0) {
+    storeDictionaries();
+  }
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::writeCTF(PendingCTF& ctf, const std::function<void(unsigned int)>& wait)
+{
+  // fill the CTF to the tree, opening and closing the files as needed. Called from the writer thread if there is one
+  TStopwatch timer;
+  prepareTFTreeAndFile(ctf);
+
+  int totalWait = 0, nwaitCycles = 0;
+  while ((mFallBackDirUsed || !mFallBackDirProvided) && mCheckDiskFull) { // we are on the physical disk and not on the RAM disk
+    constexpr size_t MB = 1024 * 1024;
+    constexpr int showFirstN = 10, prsecaleWarnings = 50;
+    try {
+      const auto si = std::filesystem::space(mCTFFileOut->GetName());
+      std::string wmsg{};
+      if (mCheckDiskFull > 0.f && si.available < mCheckDiskFull) {
+        nwaitCycles++;
+        wmsg = fmt::format("Disk has {} MB available while at least {} MB is requested, wait for {} ms (on top of {} ms)", si.available / MB, size_t(mCheckDiskFull) / MB, mWaitDiskFull, totalWait);
+      } else if (mCheckDiskFull < 0.f && float(si.available) / si.capacity < -mCheckDiskFull) { // relative margin requested
+        nwaitCycles++;
+        wmsg = fmt::format("Disk has {:.3f}% available while at least {:.3f}% is requested, wait for {} ms (on top of {} ms)", si.capacity ? float(si.available) / si.capacity * 100.f : 0., -mCheckDiskFull, mWaitDiskFull, totalWait);
+      } else {
+        nwaitCycles = 0;
+      }
+      if (nwaitCycles) {
+        if (mWaitDiskFullMax > 0 && totalWait > mWaitDiskFullMax) {
+          closeTFTreeAndFile(); // try to save whatever we have
+          LOGP(fatal, "Disk has {} MB available out of {} MB after waiting for {} ms", si.available / MB, si.capacity / MB, mWaitDiskFullMax);
         }
-        if (nwaitCycles) {
-          if (mWaitDiskFullMax > 0 && totalWait > mWaitDiskFullMax) {
-            closeTFTreeAndFile(); // try to save whatever we have
-            LOGP(fatal, "Disk has {} MB available out of {} MB after waiting for {} ms", si.available / MB, si.capacity / MB, mWaitDiskFullMax);
-          }
-          if (nwaitCycles < showFirstN + 1 || (prsecaleWarnings && (nwaitCycles % prsecaleWarnings) == 0)) {
-            LOG(alarm) << wmsg;
-          }
-          pc.services().get<RawDeviceService>().waitFor((unsigned int)(mWaitDiskFull));
-          totalWait += mWaitDiskFull;
-          continue;
+        if (nwaitCycles < showFirstN + 1 || (prsecaleWarnings && (nwaitCycles % prsecaleWarnings) == 0)) {
+          LOG(alarm) << wmsg;
         }
-      } catch (std::exception const& e) {
-        LOG(fatal) << "unable to query disk space info for path " << mCurrentCTFFileNameFull << ", reason: " << e.what();
+        wait((unsigned int)(mWaitDiskFull));
+        totalWait += mWaitDiskFull;
+        continue;
       }
-      break;
+    } catch (std::exception const& e) {
+      LOG(fatal) << "unable to query disk space info for path " << mCurrentCTFFileNameFull << ", reason: " << e.what();
     }
+    break;
   }
-  // create header
-  CTFHeader header{mTimingInfo.runNumber, mTimingInfo.creation, mTimingInfo.firstTForbit, mTimingInfo.tfCounter};
+
   size_t szCTF = 0;
-  mSizeReport = "";
-  szCTF += processDet<o2::itsmft::CTF>(pc, DetID::ITS, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::tpc::CTF>(pc, DetID::TPC, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::trd::CTF>(pc, DetID::TRD, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::tof::CTF>(pc, DetID::TOF, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::phos::CTF>(pc, DetID::PHS, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::cpv::CTF>(pc, DetID::CPV, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::emcal::CTF>(pc, DetID::EMC, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::hmpid::CTF>(pc, DetID::HMP, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::itsmft::CTF>(pc, DetID::MFT, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::mch::CTF>(pc, DetID::MCH, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::mid::CTF>(pc, DetID::MID, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::zdc::CTF>(pc, DetID::ZDC, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::ft0::CTF>(pc, DetID::FT0, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::fv0::CTF>(pc, DetID::FV0, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::fdd::CTF>(pc, DetID::FDD, header, mCTFTreeOut.get());
-  szCTF += processDet<o2::ctp::CTF>(pc, DetID::CTP, header, mCTFTreeOut.get());
-  if (mReportInterval > 0 && (mTimingInfo.tfCounter % mReportInterval) == 0) {
-    LOGP(important, "CTF {} size report:{} - Total:{}", mTimingInfo.tfCounter, mSizeReport, fmt::group_digits(szCTF));
+  for (const auto& image : ctf.images) {
+    szCTF += image.append(*mCTFTreeOut.get(), image.det.getName(), image.data.data());
+  }
+  szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", ctf.header);
+  size_t prevSizeMB = mAccCTFSize / (1 << 20);
+  mAccCTFSize += szCTF;
+  mCTFTreeOut->SetEntries(++mNAccCTF);
+  mTFOrbits.push_back(ctf.timingInfo.firstTForbit);
+  mFileDataTakingContext = ctf.dataTakingContext;
+  mFileMetaDataType = ctf.metaDataType;
+  LOG(info) << "TF#" << ctf.nCTF << ": wrote CTF{" << ctf.header << "} of size " << szCTF << " to " << mCurrentCTFFileNameFull << " in " << timer.CpuTime() << " s";
+  if (mNAccCTF > 1) {
+    LOG(info) << "Current CTF tree has " << mNAccCTF << " entries with total size of " << mAccCTFSize << " bytes";
+  }
+  if (mLockFD != -1) {
+    lseek(mLockFD, 0, SEEK_SET);
+    auto nwr = write(mLockFD, &mAccCTFSize, sizeof(size_t));
+    if (nwr != sizeof(size_t)) {
+      LOG(error) << "Failed to write current CTF size " << mAccCTFSize << " to lock file, bytes written: " << nwr;
+    }
   }
 
-  mTimer.Stop();
+  if (mAccCTFSize >= mMinSize || (mMaxCTFPerFile > 0 && mNAccCTF >= mMaxCTFPerFile)) {
+    closeTFTreeAndFile();
+  } else if ((mCTFAutoSave > 0 && mNAccCTF % mCTFAutoSave == 0) || (mCTFAutoSave < 0 && int(prevSizeMB / (-mCTFAutoSave)) != size_t(mAccCTFSize / (1 << 20)) / (-mCTFAutoSave))) {
+    mCTFTreeOut->AutoSave("override");
+  }
+}
 
-  if (mWriteCTF && !mRejectCurrentTF) {
-    szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
-    size_t prevSizeMB = mAccCTFSize / (1 << 20);
-    mAccCTFSize += szCTF;
-    mCTFTreeOut->SetEntries(++mNAccCTF);
-    mTFOrbits.push_back(mTimingInfo.firstTForbit);
-    LOG(info) << "TF#" << mNCTF << ": wrote CTF{" << header << "} of size " << szCTF << " to " << mCurrentCTFFileNameFull << " in " << mTimer.CpuTime() - cput << " s";
-    if (mNAccCTF > 1) {
-      LOG(info) << "Current CTF tree has " << mNAccCTF << " entries with total size of " << mAccCTFSize << " bytes";
-    }
-    if (mLockFD != -1) {
-      lseek(mLockFD, 0, SEEK_SET);
-      auto nwr = write(mLockFD, &mAccCTFSize, sizeof(size_t));
-      if (nwr != sizeof(size_t)) {
-        LOG(error) << "Failed to write current CTF size " << mAccCTFSize << " to lock file, bytes written: " << nwr;
+//___________________________________________________________________
+void CTFWriterSpec::queueCTF(std::unique_ptr<PendingCTF> ctf)
+{
+  // the input messages are released after the processing and DPL does not let us keep them,
+  // so the writer thread needs its own copy of the images: up to mWriterQueueSize + 1 CTFs in memory
+  for (auto& image : ctf->images) {
+    image.copy.assign(image.data.begin(), image.data.end());
+    image.data = image.copy;
+  }
+  std::unique_lock<std::mutex> lock(mWriterMutex);
+  if (!mWriterThread.joinable()) {
+    ROOT::EnableThreadSafety(); // the dictionaries may be stored by the processing thread concurrently
+    mStopWriter = false;
+    mWriterThread = std::thread(&CTFWriterSpec::runWriter, this);
+  }
+  if (mWriterQueue.size() >= mWriterQueueSize) {
+    LOGP(warning, "{} CTFs are waiting to be written, blocking the processing", mWriterQueue.size());
+    mWriterCondition.wait(lock, [this]() { return mWriterQueue.size() < mWriterQueueSize || mWriterError; });
+  }
+  if (mWriterError) {
+    std::rethrow_exception(mWriterError);
+  }
+  mWriterQueue.push_back(std::move(ctf));
+  lock.unlock();
+  mWriterCondition.notify_all();
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::runWriter()
+{
+  auto wait = [](unsigned int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); };
+  while (true) {
+    PendingCTF* ctf = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mWriterMutex);
+      mWriterCondition.wait(lock, [this]() { return !mWriterQueue.empty() || mStopWriter; });
+      if (mWriterQueue.empty()) {
+        return;
       }
+      ctf = mWriterQueue.front().get();
     }
-
-    if (mAccCTFSize >= mMinSize || (mMaxCTFPerFile > 0 && mNAccCTF >= mMaxCTFPerFile)) {
-      closeTFTreeAndFile();
-    } else if ((mCTFAutoSave > 0 && mNAccCTF % mCTFAutoSave == 0) || (mCTFAutoSave < 0 && int(prevSizeMB / (-mCTFAutoSave)) != size_t(mAccCTFSize / (1 << 20)) / (-mCTFAutoSave))) {
-      mCTFTreeOut->AutoSave("override");
+    try {
+      writeCTF(*ctf, wait);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mWriterMutex);
+      mWriterError = std::current_exception();
     }
-  } else {
-    LOG(info) << "TF#" << mNCTF << " {" << header << "} CTF writing is disabled, size was " << szCTF << " bytes";
+    {
+      std::lock_guard<std::mutex> lock(mWriterMutex);
+      mWriterQueue.pop_front();
+    }
+    mWriterCondition.notify_all();
   }
+}
 
-  mNCTF++;
-  if (mCreateDict && mSaveDictAfter > 0 && (mNCTF % mSaveDictAfter) == 0) {
-    storeDictionaries();
+//___________________________________________________________________
+void CTFWriterSpec::stopWriter()
+{
+  // write the pending CTFs and stop the writer thread
+  if (!mWriterThread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mWriterMutex);
+    mStopWriter = true;
   }
+  mWriterCondition.notify_all();
+  mWriterThread.join();
 }
 
 //___________________________________________________________________
 void CTFWriterSpec::finalize()
 {
+  stopWriter(); // write the pending CTFs
   if (mFinalized) {
     return;
   }
@@ -542,6 +682,14 @@ void CTFWriterSpec::finalize()
     storeDictionaries();
   }
   if (mWriteCTF) {
+    if (mWriterError) {
+      try {
+        std::rethrow_exception(mWriterError);
+      } catch (std::exception const& e) {
+        LOG(error) << "CTF writing failed, reason: " << e.what();
+      }
+      mWriterError = nullptr;
+    }
     closeTFTreeAndFile();
   }
   LOGF(info, "CTF writing total timing: Cpu: %.3e Real: %.3e s in %d slots",
@@ -552,7 +700,7 @@ void CTFWriterSpec::finalize()
 }
 
 //___________________________________________________________________
-void CTFWriterSpec::prepareTFTreeAndFile()
+void CTFWriterSpec::prepareTFTreeAndFile(const PendingCTF& ctf)
 {
   if (!mWriteCTF) {
     return;
@@ -562,10 +710,10 @@ void CTFWriterSpec::prepareTFTreeAndFile()
     needToOpen = true;
   } else {
     if ((mAccCTFSize >= mMinSize) ||                                                         // min size exceeded, may close the file.
-        (mAccCTFSize && mMaxSize > mMinSize && ((mAccCTFSize + mCurrCTFSize) > mMaxSize))) { // this is not the 1st CTF in the file and the new size will exceed allowed max
+        (mAccCTFSize && mMaxSize > mMinSize && ((mAccCTFSize + ctf.estimatedSize) > mMaxSize))) { // this is not the 1st CTF in the file and the new size will exceed allowed max
       needToOpen = true;
     } else {
-      LOGP(info, "Will add new CTF of estimated size {} to existing file of size {}", mCurrCTFSize, mAccCTFSize);
+      LOGP(info, "Will add new CTF of estimated size {} to existing file of size {}", ctf.estimatedSize, mAccCTFSize);
     }
   }
   if (needToOpen) {
@@ -573,7 +721,7 @@ void CTFWriterSpec::prepareTFTreeAndFile()
     mFallBackDirUsed = false;
     auto ctfDir = mCTFDir.empty() ? o2::utils::Str::rectifyDirectory("./") : mCTFDir;
     if (mChkSize > 0 && mFallBackDirProvided) {
-      createLockFile(0);
+      createLockFile(0, ctf.timingInfo);
       auto sz = getAvailableDiskSpace(ctfDir, 0); // check main storage
       if (sz < mChkSize) {
         removeLockFile();
@@ -582,14 +730,15 @@ void CTFWriterSpec::prepareTFTreeAndFile()
         mFallBackDirUsed = true;
       }
     }
-    if (mCreateRunEnvDir && !mDataTakingContext.envId.empty() && (mDataTakingContext.envId != o2::framework::DataTakingContext::UNKNOWN)) {
-      ctfDir += fmt::format("{}_{}/", mDataTakingContext.envId, mDataTakingContext.runNumber);
+    const auto& dataTakingContext = ctf.dataTakingContext;
+    if (mCreateRunEnvDir && !dataTakingContext.envId.empty() && (dataTakingContext.envId != o2::framework::DataTakingContext::UNKNOWN)) {
+      ctfDir += fmt::format("{}_{}/", dataTakingContext.envId, dataTakingContext.runNumber);
       if (!ctfDir.empty()) {
         o2::utils::createDirectoriesIfAbsent(ctfDir);
         LOGP(info, "Created {} directory for CTFs output", ctfDir);
       }
     }
-    mCurrentCTFFileName = o2::base::NameConf::getCTFFileName(mTimingInfo.runNumber, mTimingInfo.firstTForbit, mTimingInfo.tfCounter, mHostName);
+    mCurrentCTFFileName = o2::base::NameConf::getCTFFileName(ctf.timingInfo.runNumber, ctf.timingInfo.firstTForbit, ctf.timingInfo.tfCounter, mHostName);
     mCurrentCTFFileNameFull = fmt::format("{}{}", ctfDir, mCurrentCTFFileName);
     mCTFFileOut.reset(TFile::Open(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding).c_str(), "recreate")); // to prevent premature external usage, use temporary name
     if (mCTFFileCompression >= 0) {
@@ -618,8 +767,8 @@ void CTFWriterSpec::closeTFTreeAndFile()
         if (!ctfMetaData.fillFileData(actualFileName, mFillMD5, TMPFileEnding)) {
           throw std::runtime_error("metadata file was requested but not created");
         }
-        ctfMetaData.setDataTakingContext(mDataTakingContext);
-        ctfMetaData.type = mMetaDataType;
+        ctfMetaData.setDataTakingContext(mFileDataTakingContext);
+        ctfMetaData.type = mFileMetaDataType;
         ctfMetaData.priority = mFallBackDirUsed ? "low" : "high";
         ctfMetaData.tfOrbits.swap(mTFOrbits);
         auto metaFileNameTmp = fmt::format("{}{}.tmp", mCTFMetaFileDir, mCurrentCTFFileName);
@@ -701,11 +850,11 @@ void CTFWriterSpec::storeDictionaries()
 }
 
 //___________________________________________________________________
-void CTFWriterSpec::createLockFile(int level)
+void CTFWriterSpec::createLockFile(int level, const o2::framework::TimingInfo& timingInfo)
 {
   // create lock file for the CTF to be written to the storage of given level
   while (1) {
-    mLockFileName = fmt::format("{}/ctfs{}-{}_{}_{}_{}.lock", LOCKFileDir, level, o2::utils::Str::getRandomString(8), mTimingInfo.runNumber, mTimingInfo.firstTForbit, mTimingInfo.tfCounter);
+    mLockFileName = fmt::format("{}/ctfs{}-{}_{}_{}_{}.lock", LOCKFileDir, level, o2::utils::Str::getRandomString(8), timingInfo.runNumber, timingInfo.firstTForbit, timingInfo.tfCounter);
     if (!std::filesystem::exists(mLockFileName)) {
       break;
     }
@@ -810,6 +959,7 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, const std::string& outTyp
             {"max-ctf-per-file", VariantType::Int, 0, {"if > 0, avoid storing more than requested CTFs per file"}},
             {"ctf-rejection", VariantType::Int, 0, {">0: percentage to reject randomly, <0: reject if timeslice%|value|!=0"}},
             {"ctf-file-compression", VariantType::Int, 0, {"if >= 0: impose CTF file compression level"}},
+            {"writer-queue-size", VariantType::Int, 0, {"if > 0: write CTFs in a separate thread, blocking the processing when this number of CTFs is pending; each pending CTF holds a copy of the encoded data, costing up to (N+1) x CTF size of memory"}},
             {"require-free-disk", VariantType::Float, 0.f, {"pause writing op. if available disk space is below this margin, in bytes if >0, as a fraction of total if <0"}},
             {"wait-for-free-disk", VariantType::Float, 10.f, {"if paused due to the low disk space, recheck after this time (in s)"}},
             {"max-wait-for-free-disk", VariantType::Float, 60.f, {"produce fatal if paused due to the low disk space for more than this amount in s."}},
@@ -0,0 +1,253 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DPIDFlatMap.h
+/// \brief Open-addressing hash map keyed by DataPointIdentifier
+
+#ifndef O2_DCS_DPID_FLAT_MAP_H
+#define O2_DCS_DPID_FLAT_MAP_H
+
+#include "DetectorsDCS/DataPointIdentifier.h"
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace dcs
+{
+
+/**
+ * Hash map from DataPointIdentifier to T for the lookups done per data point
+ * by the DCS processors. The entries are kept in a single array with linear
+ * probing; the hash code of every key is computed once on insertion and
+ * stored next to it, so that probing compares 64-bit hashes first and the
+ * 64-byte identifiers only on a hash match, and growing never rehashes the
+ * aliases. The load factor is kept at or below 1/2.
+ *
+ * The interface follows the subset of std::unordered_map used by the
+ * processors (find, operator[], emplace, erase, range-for). Iterators and
+ * references are invalidated by any insertion that grows the table and by
+ * erase. The key of an entry must not be modified through an iterator.
+ */
+template <typename T>
+class DPIDFlatMap
+{
+  static constexpr uint64_t EMPTY = 0;
+
+  struct Slot {
+    uint64_t hash = EMPTY;
+    std::pair<DataPointIdentifier, T> entry{};
+  };
+
+  template <bool IsConst>
+  class Iterator
+  {
+    using SlotPtr = std::conditional_t<IsConst, const Slot*, Slot*>;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<DataPointIdentifier, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    Iterator() = default;
+    Iterator(SlotPtr slot, SlotPtr end) : mSlot(slot), mEnd(end) { skipEmpty(); }
+    operator Iterator<true>() const { return {mSlot, mEnd}; }
+
+    reference operator*() const { return mSlot->entry; }
+    pointer operator->() const { return &mSlot->entry; }
+    Iterator& operator++()
+    {
+      ++mSlot;
+      skipEmpty();
+      return *this;
+    }
+    Iterator operator++(int)
+    {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    bool operator==(const Iterator& other) const { return mSlot == other.mSlot; }
+    bool operator!=(const Iterator& other) const { return mSlot != other.mSlot; }
+
+   private:
+    friend class DPIDFlatMap;
+    void skipEmpty()
+    {
+      while (mSlot != mEnd && mSlot->hash == EMPTY) {
+        ++mSlot;
+      }
+    }
+    SlotPtr mSlot = nullptr;
+    SlotPtr mEnd = nullptr;
+  };
+
+ public:
+  using key_type = DataPointIdentifier;
+  using mapped_type = T;
+  using value_type = std::pair<DataPointIdentifier, T>;
+  using size_type = std::size_t;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  DPIDFlatMap() = default;
+  explicit DPIDFlatMap(size_type n) { reserve(n); }
+
+  size_type size() const noexcept { return mSize; }
+  bool empty() const noexcept { return mSize == 0; }
+  size_type capacity() const noexcept { return mSlots.size() / 2; }
+
+  iterator begin() noexcept { return {mSlots.data(), mSlots.data() + mSlots.size()}; }
+  iterator end() noexcept { return {mSlots.data() + mSlots.size(), mSlots.data() + mSlots.size()}; }
+  const_iterator begin() const noexcept { return {mSlots.data(), mSlots.data() + mSlots.size()}; }
+  const_iterator end() const noexcept { return {mSlots.data() + mSlots.size(), mSlots.data() + mSlots.size()}; }
+
+  /// make room for n entries without growing
+  void reserve(size_type n)
+  {
+    size_type needed = 16;
+    while (needed < 2 * n) {
+      needed <<= 1;
+    }
+    if (needed > mSlots.size()) {
+      rehash(needed);
+    }
+  }
+
+  void clear() noexcept
+  {
+    for (auto& slot : mSlots) {
+      slot = Slot{};
+    }
+    mSize = 0;
+  }
+
+  iterator find(const DataPointIdentifier& key) noexcept
+  {
+    auto pos = lookup(key, hashOf(key));
+    return pos == npos ? end() : iterator{mSlots.data() + pos, mSlots.data() + mSlots.size()};
+  }
+
+  const_iterator find(const DataPointIdentifier& key) const noexcept
+  {
+    auto pos = lookup(key, hashOf(key));
+    return pos == npos ? end() : const_iterator{mSlots.data() + pos, mSlots.data() + mSlots.size()};
+  }
+
+  size_type count(const DataPointIdentifier& key) const noexcept { return lookup(key, hashOf(key)) == npos ? 0 : 1; }
+  bool contains(const DataPointIdentifier& key) const noexcept { return count(key) != 0; }
+
+  T& operator[](const DataPointIdentifier& key) { return emplace(key, T{}).first->second; }
+
+  /// insert (key, value) unless key is present, returns the entry and whether it was inserted
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(const DataPointIdentifier& key, Args&&... args)
+  {
+    auto hash = hashOf(key);
+    auto pos = lookup(key, hash);
+    if (pos != npos) {
+      return {iterator{mSlots.data() + pos, mSlots.data() + mSlots.size()}, false};
+    }
+    if (2 * (mSize + 1) > mSlots.size()) {
+      rehash(mSlots.empty() ? 16 : 2 * mSlots.size());
+    }
+    pos = freeSlot(hash);
+    auto& slot = mSlots[pos];
+    slot.hash = hash;
+    slot.entry.first = key;
+    slot.entry.second = T(std::forward<Args>(args)...);
+    ++mSize;
+    return {iterator{mSlots.data() + pos, mSlots.data() + mSlots.size()}, true};
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) { return emplace(value.first, value.second); }
+
+  /// remove key, returns the number of removed entries
+  size_type erase(const DataPointIdentifier& key)
+  {
+    auto pos = lookup(key, hashOf(key));
+    if (pos == npos) {
+      return 0;
+    }
+    // backward-shift deletion: pull following entries of the probe sequence into the hole
+    const size_type mask = mSlots.size() - 1;
+    auto hole = pos;
+    for (auto next = (pos + 1) & mask; mSlots[next].hash != EMPTY; next = (next + 1) & mask) {
+      auto home = mSlots[next].hash & mask;
+      if (((next - home) & mask) >= ((next - hole) & mask)) {
+        mSlots[hole] = std::move(mSlots[next]);
+        hole = next;
+      }
+    }
+    mSlots[hole] = Slot{};
+    --mSize;
+    return 1;
+  }
+
+ private:
+  static constexpr size_type npos = ~size_type(0);
+
+  static uint64_t hashOf(const DataPointIdentifier& key) noexcept
+  {
+    uint64_t hash = key.hash_code();
+    return hash == EMPTY ? 1 : hash;
+  }
+
+  size_type lookup(const DataPointIdentifier& key, uint64_t hash) const noexcept
+  {
+    if (mSize == 0) {
+      return npos;
+    }
+    const size_type mask = mSlots.size() - 1;
+    for (auto pos = hash & mask;; pos = (pos + 1) & mask) {
+      const auto& slot = mSlots[pos];
+      if (slot.hash == EMPTY) {
+        return npos;
+      }
+      if (slot.hash == hash && slot.entry.first == key) {
+        return pos;
+      }
+    }
+  }
+
+  size_type freeSlot(uint64_t hash) const noexcept
+  {
+    const size_type mask = mSlots.size() - 1;
+    auto pos = hash & mask;
+    while (mSlots[pos].hash != EMPTY) {
+      pos = (pos + 1) & mask;
+    }
+    return pos;
+  }
+
+  void rehash(size_type nSlots)
+  {
+    std::vector<Slot> old(nSlots);
+    old.swap(mSlots);
+    for (auto& slot : old) {
+      if (slot.hash != EMPTY) {
+        mSlots[freeSlot(slot.hash)] = std::move(slot);
+      }
+    }
+  }
+
+  std::vector<Slot> mSlots;
+  size_type mSize = 0;
+};
+
+} // namespace dcs
+} // namespace o2
+
+#endif // O2_DCS_DPID_FLAT_MAP_H
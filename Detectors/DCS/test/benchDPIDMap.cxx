@@ -0,0 +1,144 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// Replays a stream of data points over a few thousand aliases through the
+/// per-DP lookup done by the DCS processors (find the DPID, flag it as seen),
+/// comparing std::unordered_map with the previous string-based hash, with the
+/// current hash, and DPIDFlatMap.
+
+#include <benchmark/benchmark.h>
+#include "DetectorsDCS/AliasExpander.h"
+#include "DetectorsDCS/DataPointCompositeObject.h"
+#include "DetectorsDCS/DPIDFlatMap.h"
+#include "DetectorsDCS/StringUtils.h"
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using DPID = o2::dcs::DataPointIdentifier;
+
+namespace
+{
+/// hashing as done before hash_code() worked on the DPID words
+struct StringHash {
+  size_t operator()(const DPID& dpid) const { return o2::dcs::hash_code(std::string(dpid.get_alias())); }
+};
+
+const std::vector<DPID>& configuredIds()
+{
+  static std::vector<DPID> ids = [] {
+    std::vector<DPID> res;
+    auto aliases = o2::dcs::expandAliases({"tof_hv_vp_[00..89]", "tof_hv_vn_[00..89]", "tof_hv_ip_[00..89]", "tof_hv_in_[00..89]",
+                                           "TOF_FEACSTATUS_[00..71]",
+                                           "MchHvLvLeft/Chamber[00..09]Left/Slat[00..12].actual.[vMon,iMon]",
+                                           "MchHvLvRight/Chamber[00..09]Right/Slat[00..12].actual.[vMon,iMon]",
+                                           "MchHvLvLeft/Chamber[00..03]Left/Quad[0..3]Sect[0..2].actual.[vMon,iMon]",
+                                           "ITS_L[0..6]_[00..47]_TEMP", "ITS_L[0..6]_[00..47]_[VDD,IDD,VDDA,IDDA]",
+                                           "TRD_CHAMBER_HV_[000..539].[vMon,iMon]", "TRD_CHAMBER_ANODE_[000..539].vMon",
+                                           "MFT_PSU_ZONE/H[0..1]/D[0..4]/F[0..1]/Z[0..3]/[Current,Voltage]/[Analog,Digital,BackBias]"});
+    for (size_t i = 0; i < aliases.size(); i++) {
+      res.emplace_back(aliases[i], (i % 3) ? o2::dcs::DPVAL_DOUBLE : o2::dcs::DPVAL_INT);
+    }
+    return res;
+  }();
+  return ids;
+}
+
+/// stream of DPs: every configured alias a few times in random order, plus 5% not configured
+const std::vector<DPID>& stream()
+{
+  static std::vector<DPID> dps = [] {
+    const auto& ids = configuredIds();
+    std::vector<DPID> res;
+    for (int rep = 0; rep < 4; rep++) {
+      res.insert(res.end(), ids.begin(), ids.end());
+    }
+    for (size_t i = 0; i < ids.size() / 5; i++) {
+      res.emplace_back("DCS_UNKNOWN_ALIAS_" + std::to_string(i), o2::dcs::DPVAL_DOUBLE);
+    }
+    std::shuffle(res.begin(), res.end(), std::mt19937(12345));
+    return res;
+  }();
+  return dps;
+}
+
+template <typename Map>
+void replay(benchmark::State& state, Map& pids)
+{
+  const auto& dps = stream();
+  for (const auto& id : configuredIds()) {
+    pids[id] = false;
+  }
+  for (auto _ : state) {
+    size_t found = 0;
+    for (const auto& id : dps) {
+      auto el = pids.find(id);
+      if (el != pids.end()) {
+        el->second = true;
+        found++;
+      }
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * dps.size());
+  state.counters["aliases"] = pids.size();
+}
+} // namespace
+
+static void BM_HashLegacy(benchmark::State& state)
+{
+  StringHash hasher;
+  const auto& dps = stream();
+  for (auto _ : state) {
+    for (const auto& id : dps) {
+      benchmark::DoNotOptimize(hasher(id));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * dps.size());
+}
+
+static void BM_HashCode(benchmark::State& state)
+{
+  const auto& dps = stream();
+  for (auto _ : state) {
+    for (const auto& id : dps) {
+      benchmark::DoNotOptimize(id.hash_code());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * dps.size());
+}
+
+static void BM_UnorderedMapLegacyHash(benchmark::State& state)
+{
+  std::unordered_map<DPID, bool, StringHash> pids;
+  replay(state, pids);
+}
+
+static void BM_UnorderedMap(benchmark::State& state)
+{
+  std::unordered_map<DPID, bool> pids;
+  replay(state, pids);
+}
+
+static void BM_FlatMap(benchmark::State& state)
+{
+  o2::dcs::DPIDFlatMap<bool> pids;
+  replay(state, pids);
+}
+
+BENCHMARK(BM_HashLegacy);
+BENCHMARK(BM_HashCode);
+BENCHMARK(BM_UnorderedMapLegacyHash);
+BENCHMARK(BM_UnorderedMap);
+BENCHMARK(BM_FlatMap);
+
+BENCHMARK_MAIN();
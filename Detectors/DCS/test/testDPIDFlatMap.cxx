@@ -0,0 +1,88 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test DetectorsDCS DPIDFlatMap
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "DetectorsDCS/DPIDFlatMap.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using DPID = o2::dcs::DataPointIdentifier;
+
+BOOST_AUTO_TEST_CASE(HashCodeIsConsistentWithEquality)
+{
+  DPID a("TOF_FEACSTATUS_00", o2::dcs::DPVAL_INT);
+  DPID b("TOF_FEACSTATUS_00", o2::dcs::DPVAL_INT);
+  DPID c("TOF_FEACSTATUS_01", o2::dcs::DPVAL_INT);
+  DPID d("TOF_FEACSTATUS_00", o2::dcs::DPVAL_DOUBLE);
+  BOOST_CHECK(a == b);
+  BOOST_CHECK_EQUAL(a.hash_code(), b.hash_code());
+  BOOST_CHECK_NE(a.hash_code(), c.hash_code());
+  BOOST_CHECK_NE(a.hash_code(), d.hash_code());
+}
+
+BOOST_AUTO_TEST_CASE(FlatMapBasics)
+{
+  o2::dcs::DPIDFlatMap<int> map;
+  DPID a("tof_hv_vp_00", o2::dcs::DPVAL_DOUBLE);
+  DPID b("tof_hv_vp_01", o2::dcs::DPVAL_DOUBLE);
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.find(a) == map.end());
+  map[a] = 1;
+  BOOST_CHECK(map.emplace(b, 2).second);
+  BOOST_CHECK(!map.emplace(b, 3).second);
+  BOOST_CHECK_EQUAL(map.size(), 2);
+  BOOST_CHECK_EQUAL(map.find(a)->second, 1);
+  BOOST_CHECK_EQUAL(map[b], 2);
+  BOOST_CHECK_EQUAL(map.erase(a), 1);
+  BOOST_CHECK_EQUAL(map.erase(a), 0);
+  BOOST_CHECK(!map.contains(a));
+  BOOST_CHECK(map.contains(b));
+  map.clear();
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.begin() == map.end());
+}
+
+BOOST_AUTO_TEST_CASE(FlatMapMatchesUnorderedMap)
+{
+  o2::dcs::DPIDFlatMap<int> flat;
+  std::unordered_map<DPID, int> reference;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> aliasDist(0, 2999), opDist(0, 9);
+  for (int i = 0; i < 100000; i++) {
+    DPID id("MchHvLvLeft/Chamber" + std::to_string(aliasDist(gen)) + ".actual.vMon", o2::dcs::DPVAL_DOUBLE);
+    auto op = opDist(gen);
+    if (op < 6) {
+      flat[id] = i;
+      reference[id] = i;
+    } else if (op < 8) {
+      BOOST_REQUIRE_EQUAL(flat.erase(id), reference.erase(id));
+    } else {
+      auto el = flat.find(id);
+      auto ref = reference.find(id);
+      BOOST_REQUIRE_EQUAL(el == flat.end(), ref == reference.end());
+      if (ref != reference.end()) {
+        BOOST_REQUIRE_EQUAL(el->second, ref->second);
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(flat.size(), reference.size());
+  size_t visited = 0;
+  for (const auto& [id, value] : flat) {
+    BOOST_REQUIRE_EQUAL(reference.at(id), value);
+    visited++;
+  }
+  BOOST_CHECK_EQUAL(visited, reference.size());
+}
@@ -151,10 +151,18 @@ class Clusterizer
   /// \param[out] column Topological column
   void getTopologicalRowColumn(const InputType& input, int& row, int& column);
 
+  /// \brief Reset the topology arrays
+  ///
+  /// Only the entries filled in the previous event (listed in the seed array) are reset,
+  /// all other entries are still in the initial state.
+  void resetTopologyMaps();
+
   Geometry* mEMCALGeometry = nullptr;                             //!<! pointer to geometry for utilities
   std::array<cellWithE, NROWS * NCOLS> mSeedList;                 //!<! seed array
+  int mNSeedCells = 0;                                            //!<! number of entries in the seed array filled in the last event
   std::array<std::array<InputwithIndex, NCOLS>, NROWS> mInputMap; //!<! topology arrays
   std::array<std::array<bool, NCOLS>, NROWS> mCellMask;           //!<! topology arrays
+  std::vector<InputwithIndex> mClusterInputs;                     //!<! cells/digits of the cluster being formed
 
   std::vector<Cluster> mFoundClusters;     ///<  vector of cluster objects
   std::vector<ClusterIndex> mInputIndices; ///<  vector of associated cell/digit tower ID, ordered by cluster
@@ -0,0 +1,124 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ClusterizerPool.h
+/// \brief Definition of a pool of EMCAL clusterizers processing the triggers of a timeframe in parallel
+#ifndef ALICEO2_EMCAL_CLUSTERIZERPOOL_H
+#define ALICEO2_EMCAL_CLUSTERIZERPOOL_H
+
+#include <memory>
+#include <vector>
+#include <gsl/span>
+#include "DataFormatsEMCAL/Cluster.h"
+#include "DataFormatsEMCAL/TriggerRecord.h"
+#include "EMCALBase/Geometry.h"
+#include "EMCALReconstruction/Clusterizer.h"
+
+namespace o2
+{
+
+namespace emcal
+{
+
+/// \class ClusterizerPool
+/// \brief Pool of clusterizers running on the triggers of a timeframe
+/// \ingroup EMCALreconstruction
+///
+/// The triggers of a timeframe are independent, therefore they are distributed
+/// to one clusterizer per thread. The clusters and cell/digit indices of each
+/// trigger are collected in per-trigger buffers and concatenated in the order
+/// of the input trigger records, so the output does not depend on the number
+/// of threads and is identical to running a single clusterizer trigger by trigger.
+template <class InputType>
+class ClusterizerPool
+{
+ public:
+  /// \brief Default constructor
+  ClusterizerPool() = default;
+
+  /// \brief Destructor
+  ~ClusterizerPool() = default;
+
+  /// \brief Initialize the clusterizers of the pool
+  /// \param timeCut Max. time difference of cells in cluster in ns
+  /// \param timeMin Min. accepted cell time in ns
+  /// \param timeMax Max. accepted cell time in ns
+  /// \param gradientCut Min. gradient value allowed in cluster splitting
+  /// \param doEnergyGradientCut Apply gradient cut
+  /// \param thresholdSeedE Min. energy of seed cells in GeV
+  /// \param thresholdCellE Min. energy of associated cells in GeV
+  void initialize(double timeCut, double timeMin, double timeMax, double gradientCut, bool doEnergyGradientCut, double thresholdSeedE, double thresholdCellE);
+
+  /// \brief Set number of threads (clusterizers) used to process the triggers
+  /// \param nThreads Number of threads, requests > 1 are ignored without OpenMP support
+  void setNThreads(int nThreads);
+
+  /// \brief Get number of threads used to process the triggers
+  /// \return Number of threads
+  int getNThreads() const { return mNThreads; }
+
+  /// \brief Set EMCAL geometry
+  /// \param geometry Geometry pointer
+  void setGeometry(Geometry* geometry);
+
+  /// \brief Get pointer to geometry
+  /// \return EMCAL geometry
+  Geometry* getGeometry() { return mGeometry; }
+
+  /// \brief Find clusters in all triggers of a timeframe
+  ///
+  /// Output containers are cleared. For each input trigger record one trigger
+  /// record is added to the cluster and the index trigger records. As for the
+  /// Clusterizer, cell/digit indices are relative to the first entry of the
+  /// trigger and cell index ranges of the clusters are relative to the first
+  /// index of the trigger.
+  ///
+  /// \param inputs Cells/digits of the timeframe
+  /// \param triggers Trigger records of the cells/digits
+  /// \param[out] clusters Clusters of all triggers
+  /// \param[out] inputIndices Cell/digit indices of the clusters of all triggers
+  /// \param[out] clusterTriggers Trigger records for the clusters
+  /// \param[out] indexTriggers Trigger records for the cell/digit indices
+  void findClusters(gsl::span<const InputType> inputs, gsl::span<const TriggerRecord> triggers,
+                    std::vector<Cluster>& clusters, std::vector<ClusterIndex>& inputIndices,
+                    std::vector<TriggerRecord>& clusterTriggers, std::vector<TriggerRecord>& indexTriggers);
+
+ private:
+  /// \struct TriggerOutput
+  /// \brief Output of the clusterizer for a single trigger
+  struct TriggerOutput {
+    std::vector<Cluster> mClusters;          ///< clusters of the trigger
+    std::vector<ClusterIndex> mInputIndices; ///< cell/digit indices of the clusters
+  };
+
+  /// \brief Create the missing clusterizers for the current number of threads
+  void createClusterizers();
+
+  std::vector<std::unique_ptr<Clusterizer<InputType>>> mClusterizers; ///< one clusterizer per thread
+  std::vector<TriggerOutput> mTriggerOutputs;                         ///< per-trigger output buffers, kept between timeframes
+  Geometry* mGeometry = nullptr;                                      ///< pointer to geometry
+  int mNThreads = 1;                                                  ///< number of threads
+
+  double mTimeCut = 0;               ///< maximum time difference between the cells/digits inside EMC cluster
+  double mTimeMin = 0;               ///< minimum time of physical signal in a cell/digit
+  double mTimeMax = 0;               ///< maximum time of physical signal in a cell/digit
+  double mGradientCut = 0;           ///< minimum energy difference to distinguish local maxima in a cluster
+  bool mDoEnergyGradientCut = false; ///< cut on energy gradient
+  double mThresholdSeedEnergy = 0;   ///< minimum energy to seed a EC digit/cell in a cluster
+  double mThresholdCellEnergy = 0;   ///< minimum energy for a digit/cell to be a member of a cluster
+};
+
+using ClusterizerPoolDigits = ClusterizerPool<Digit>;
+using ClusterizerPoolCells = ClusterizerPool<Cell>;
+
+} // namespace emcal
+} // namespace o2
+#endif /* ALICEO2_EMCAL_CLUSTERIZERPOOL_H */
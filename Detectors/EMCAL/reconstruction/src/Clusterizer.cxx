@@ -43,6 +43,20 @@ void Clusterizer<InputType>::initialize(double timeCut, double timeMin, double t
   mThresholdCellEnergy = thresholdCellE;
 }
 
+//____________________________________________________________________________
+template <class InputType>
+void Clusterizer<InputType>::resetTopologyMaps()
+{
+  // Cells are only masked during clustering if they were put to the input map before,
+  // therefore the seed list contains all modified entries of both maps
+  for (int i = 0; i < mNSeedCells; i++) {
+    int row = mSeedList[i].row, column = mSeedList[i].column;
+    mCellMask[row][column] = kFALSE;
+    mInputMap[row][column] = {nullptr, -1};
+  }
+  mNSeedCells = 0;
+}
+
 //____________________________________________________________________________
 template <class InputType>
 void Clusterizer<InputType>::getClusterFromNeighbours(std::vector<InputwithIndex>& clusterInputs, int row, int column)
@@ -127,11 +141,8 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
   // --> Seed cell and all neighbours belonging to cluster will be put in 2D bitmap
 
   // Reset cell/digit maps and cell masks
-  // Loop over one array dim, then reset each array
-  for (auto iArr = 0; iArr < NROWS; iArr++) {
-    mCellMask[iArr].fill(kFALSE);
-    mInputMap[iArr].fill({nullptr, -1});
-  }
+  // Only the cells/digits of the previous event need to be removed
+  resetTopologyMaps();
 
   // Calibrate cells/digits and fill the maps/arrays
   int nCells = 0;
@@ -163,6 +174,7 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
     mSeedList[nCells].column = column;
     nCells++;
   }
+  mNSeedCells = nCells;
 
   // Sort struct arrays with ascending energy
   std::sort(mSeedList.begin(), std::next(std::begin(mSeedList), nCells));
@@ -180,12 +192,12 @@ void Clusterizer<InputType>::findClusters(const gsl::span<InputType const>& inpu
     }
 
     // Seed is found, form cluster recursively
-    std::vector<InputwithIndex> clusterInputs;
-    getClusterFromNeighbours(clusterInputs, row, column);
+    mClusterInputs.clear();
+    getClusterFromNeighbours(mClusterInputs, row, column);
 
     // Add cells/digits for current cluster to cell/digit index vector
     int inputIndexStart = mInputIndices.size();
-    for (auto dig : clusterInputs) {
+    for (auto dig : mClusterInputs) {
       mInputIndices.emplace_back(dig.mIndex);
     }
     int inputIndexSize = mInputIndices.size() - inputIndexStart;
@@ -0,0 +1,134 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ClusterizerPool.cxx
+/// \brief Implementation of the pool of EMCAL clusterizers
+#include <algorithm>
+#include <fairlogger/Logger.h> // for LOG
+#include "EMCALReconstruction/ClusterizerPool.h"
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+using namespace o2::emcal;
+
+//____________________________________________________________________________
+template <class InputType>
+void ClusterizerPool<InputType>::initialize(double timeCut, double timeMin, double timeMax, double gradientCut, bool doEnergyGradientCut, double thresholdSeedE, double thresholdCellE)
+{
+  mTimeCut = timeCut;
+  mTimeMin = timeMin;
+  mTimeMax = timeMax;
+  mGradientCut = gradientCut;
+  mDoEnergyGradientCut = doEnergyGradientCut;
+  mThresholdSeedEnergy = thresholdSeedE;
+  mThresholdCellEnergy = thresholdCellE;
+  for (auto& clusterizer : mClusterizers) {
+    clusterizer->initialize(mTimeCut, mTimeMin, mTimeMax, mGradientCut, mDoEnergyGradientCut, mThresholdSeedEnergy, mThresholdCellEnergy);
+  }
+}
+
+//____________________________________________________________________________
+template <class InputType>
+void ClusterizerPool<InputType>::setNThreads(int nThreads)
+{
+#ifdef WITH_OPENMP
+  mNThreads = std::max(1, nThreads);
+#else
+  if (nThreads > 1) {
+    LOG(warning) << "Multithreading is not supported, imposing single thread";
+  }
+  mNThreads = 1;
+#endif
+}
+
+//____________________________________________________________________________
+template <class InputType>
+void ClusterizerPool<InputType>::setGeometry(Geometry* geometry)
+{
+  mGeometry = geometry;
+  for (auto& clusterizer : mClusterizers) {
+    clusterizer->setGeometry(mGeometry);
+  }
+}
+
+//____________________________________________________________________________
+template <class InputType>
+void ClusterizerPool<InputType>::createClusterizers()
+{
+  while (mClusterizers.size() < static_cast<size_t>(mNThreads)) {
+    // The topology maps of a clusterizer take several 100 kB, therefore they are kept on the heap
+    auto& clusterizer = mClusterizers.emplace_back(std::make_unique<Clusterizer<InputType>>(mTimeCut, mTimeMin, mTimeMax, mGradientCut, mDoEnergyGradientCut, mThresholdSeedEnergy, mThresholdCellEnergy));
+    clusterizer->setGeometry(mGeometry);
+  }
+}
+
+//____________________________________________________________________________
+template <class InputType>
+void ClusterizerPool<InputType>::findClusters(gsl::span<const InputType> inputs, gsl::span<const TriggerRecord> triggers,
+                                              std::vector<Cluster>& clusters, std::vector<ClusterIndex>& inputIndices,
+                                              std::vector<TriggerRecord>& clusterTriggers, std::vector<TriggerRecord>& indexTriggers)
+{
+  createClusterizers();
+  int nTriggers = triggers.size();
+  if (mTriggerOutputs.size() < triggers.size()) {
+    mTriggerOutputs.resize(nTriggers);
+  }
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iTrg = 0; iTrg < nTriggers; iTrg++) {
+#ifdef WITH_OPENMP
+    auto& clusterizer = *mClusterizers[omp_get_thread_num()];
+#else
+    auto& clusterizer = *mClusterizers[0];
+#endif
+    const auto& trigger = triggers[iTrg];
+    auto& output = mTriggerOutputs[iTrg];
+    output.mClusters.clear();
+    output.mInputIndices.clear();
+    if (inputs.size() && trigger.getNumberOfObjects()) {
+      clusterizer.findClusters(inputs.subspan(trigger.getFirstEntry(), trigger.getNumberOfObjects()));
+      const auto& foundClusters = *clusterizer.getFoundClusters();
+      const auto& foundIndices = *clusterizer.getFoundClustersInputIndices();
+      output.mClusters.insert(output.mClusters.end(), foundClusters.begin(), foundClusters.end());
+      output.mInputIndices.insert(output.mInputIndices.end(), foundIndices.begin(), foundIndices.end());
+    }
+  }
+
+  // Concatenate the per-trigger outputs in the order of the trigger records
+  clusters.clear();
+  inputIndices.clear();
+  clusterTriggers.clear();
+  indexTriggers.clear();
+  size_t nClusters = 0, nIndices = 0;
+  for (int iTrg = 0; iTrg < nTriggers; iTrg++) {
+    nClusters += mTriggerOutputs[iTrg].mClusters.size();
+    nIndices += mTriggerOutputs[iTrg].mInputIndices.size();
+  }
+  clusters.reserve(nClusters);
+  inputIndices.reserve(nIndices);
+  clusterTriggers.reserve(nTriggers);
+  indexTriggers.reserve(nTriggers);
+  for (int iTrg = 0; iTrg < nTriggers; iTrg++) {
+    const auto& output = mTriggerOutputs[iTrg];
+    clusterTriggers.emplace_back(triggers[iTrg].getBCData(), clusters.size(), output.mClusters.size());
+    indexTriggers.emplace_back(triggers[iTrg].getBCData(), inputIndices.size(), output.mInputIndices.size());
+    clusters.insert(clusters.end(), output.mClusters.begin(), output.mClusters.end());
+    inputIndices.insert(inputIndices.end(), output.mInputIndices.begin(), output.mInputIndices.end());
+  }
+  LOG(debug) << clusters.size() << " clusters found in " << nTriggers << " triggers using " << mNThreads << " thread(s)";
+}
+
+template class o2::emcal::ClusterizerPool<o2::emcal::Cell>;
+template class o2::emcal::ClusterizerPool<o2::emcal::Digit>;
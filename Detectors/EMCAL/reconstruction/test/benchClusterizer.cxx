@@ -0,0 +1,136 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// Processing time of the EMCAL clusterizer per timeframe for a synthetic cell occupancy:
+/// pp (many triggers with few cells) and Pb-Pb (fewer triggers with high occupancy).
+/// The timeframe is processed by a single clusterizer trigger by trigger and by the
+/// clusterizer pool with different numbers of threads.
+
+#include <benchmark/benchmark.h>
+#include "DataFormatsEMCAL/Cell.h"
+#include "DataFormatsEMCAL/Cluster.h"
+#include "DataFormatsEMCAL/TriggerRecord.h"
+#include "EMCALBase/Geometry.h"
+#include "EMCALReconstruction/Clusterizer.h"
+#include "EMCALReconstruction/ClusterizerPool.h"
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace o2::emcal;
+
+namespace
+{
+struct Timeframe {
+  std::vector<Cell> cells;
+  std::vector<TriggerRecord> triggers;
+};
+
+/// Timeframe with showers spread over the 3x3 neighbourhood of random towers plus noise cells
+Timeframe createTimeframe(int nTriggers, double nShowers, double nNoise)
+{
+  auto geo = Geometry::GetInstanceFromRunNumber(300000);
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int> towerDist(0, geo->GetNCells() - 1);
+  std::uniform_real_distribution<float> timeDist(550., 650.);
+  std::exponential_distribution<float> energyDist(1.);
+  std::poisson_distribution<int> showerDist(nShowers), noiseDist(nNoise);
+  Timeframe tf;
+  for (int iTrg = 0; iTrg < nTriggers; iTrg++) {
+    std::map<int, Cell> event;
+    int nShowersTrg = showerDist(gen);
+    for (int iShower = 0; iShower < nShowersTrg; iShower++) {
+      auto [seedRow, seedCol] = geo->GlobalRowColFromIndex(towerDist(gen));
+      float energy = 0.5 + 3. * energyDist(gen), time = timeDist(gen);
+      for (int dRow = -1; dRow <= 1; dRow++) {
+        for (int dCol = -1; dCol <= 1; dCol++) {
+          int tower = -1;
+          try {
+            auto [supermodule, module, phiInModule, etaInModule] = geo->GetCellIndexFromGlobalRowCol(seedRow + dRow, seedCol + dCol);
+            tower = geo->GetAbsCellId(supermodule, module, phiInModule, etaInModule);
+          } catch (...) {
+            continue;
+          }
+          float fraction = (dRow == 0 && dCol == 0) ? 0.6 : ((dRow == 0 || dCol == 0) ? 0.07 : 0.03);
+          auto [cell, isNew] = event.try_emplace(tower, tower, 0.f, time + 2. * (dRow + dCol), ChannelType_t::HIGH_GAIN);
+          cell->second.setEnergy(cell->second.getEnergy() + fraction * energy);
+        }
+      }
+    }
+    int nNoiseTrg = noiseDist(gen);
+    for (int iNoise = 0; iNoise < nNoiseTrg; iNoise++) {
+      int tower = towerDist(gen);
+      event.try_emplace(tower, tower, 0.08f + 0.1f * energyDist(gen), timeDist(gen), ChannelType_t::HIGH_GAIN);
+    }
+    tf.triggers.emplace_back(o2::InteractionRecord(iTrg * 4, 0), tf.cells.size(), event.size());
+    for (const auto& [tower, cell] : event) {
+      tf.cells.push_back(cell);
+    }
+  }
+  return tf;
+}
+
+/// pp: 1000 triggers with ~3 showers and ~20 noise cells
+/// Pb-Pb: 50 triggers with ~150 showers and ~500 noise cells
+const Timeframe& getTimeframe(int system)
+{
+  static const Timeframe pp = createTimeframe(1000, 3., 20.);
+  static const Timeframe pbpb = createTimeframe(50, 150., 500.);
+  return system == 0 ? pp : pbpb;
+}
+} // namespace
+
+static void BM_Clusterizer(benchmark::State& state)
+{
+  const auto& tf = getTimeframe(state.range(0));
+  ClusterizerCells clusterizer(10000, 0, 10000, 0.03, true, 0.1, 0.05);
+  clusterizer.setGeometry(Geometry::GetInstanceFromRunNumber(300000));
+  size_t nClusters = 0;
+  for (auto _ : state) {
+    for (const auto& trigger : tf.triggers) {
+      clusterizer.findClusters(gsl::span<const Cell>(tf.cells.data() + trigger.getFirstEntry(), trigger.getNumberOfObjects()));
+      nClusters += clusterizer.getFoundClusters()->size();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * tf.triggers.size());
+  state.counters["clusters/trigger"] = double(nClusters) / (state.iterations() * tf.triggers.size());
+}
+
+static void BM_ClusterizerPool(benchmark::State& state)
+{
+  const auto& tf = getTimeframe(state.range(0));
+  ClusterizerPoolCells pool;
+  pool.initialize(10000, 0, 10000, 0.03, true, 0.1, 0.05);
+  pool.setGeometry(Geometry::GetInstanceFromRunNumber(300000));
+  pool.setNThreads(state.range(1));
+  std::vector<Cluster> clusters;
+  std::vector<ClusterIndex> indices;
+  std::vector<TriggerRecord> clusterTriggers, indexTriggers;
+  for (auto _ : state) {
+    pool.findClusters(tf.cells, tf.triggers, clusters, indices, clusterTriggers, indexTriggers);
+    benchmark::DoNotOptimize(clusters.data());
+  }
+  state.SetItemsProcessed(state.iterations() * tf.triggers.size());
+}
+
+static void SystemAndThreads(benchmark::internal::Benchmark* bench)
+{
+  for (int system = 0; system < 2; system++) {
+    for (int nThreads : {1, 2, 4, 8}) {
+      bench->Args({system, nThreads});
+    }
+  }
+}
+
+BENCHMARK(BM_Clusterizer)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ClusterizerPool)->Apply(SystemAndThreads)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,166 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test EMCAL Reconstruction
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "DataFormatsEMCAL/Cell.h"
+#include "DataFormatsEMCAL/Cluster.h"
+#include "DataFormatsEMCAL/TriggerRecord.h"
+#include "EMCALBase/Geometry.h"
+#include "EMCALReconstruction/Clusterizer.h"
+#include "EMCALReconstruction/ClusterizerPool.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace o2
+{
+
+namespace emcal
+{
+
+/// \brief Create cells of a timeframe with showers spread over the 3x3 neighbourhood of random towers
+/// \param geo EMCAL geometry
+/// \param gen Random generator
+/// \param nTriggers Number of triggers in the timeframe
+/// \param nShowers Mean number of showers per trigger
+/// \param nNoise Mean number of noise cells per trigger
+/// \param[out] cells Cells of all triggers
+/// \param[out] triggers Trigger records of the cells
+void createTimeframe(const Geometry& geo, std::mt19937& gen, int nTriggers, double nShowers, double nNoise, std::vector<Cell>& cells, std::vector<TriggerRecord>& triggers)
+{
+  std::uniform_int_distribution<int> towerDist(0, geo.GetNCells() - 1);
+  std::uniform_real_distribution<float> timeDist(550., 650.);
+  std::exponential_distribution<float> energyDist(1.);
+  std::poisson_distribution<int> showerDist(nShowers), noiseDist(nNoise);
+  cells.clear();
+  triggers.clear();
+  for (int iTrg = 0; iTrg < nTriggers; iTrg++) {
+    std::map<int, Cell> event;
+    int nShowersTrg = showerDist(gen);
+    for (int iShower = 0; iShower < nShowersTrg; iShower++) {
+      auto [seedRow, seedCol] = geo.GlobalRowColFromIndex(towerDist(gen));
+      float energy = 0.5 + 3. * energyDist(gen), time = timeDist(gen);
+      for (int dRow = -1; dRow <= 1; dRow++) {
+        for (int dCol = -1; dCol <= 1; dCol++) {
+          int tower = -1;
+          try {
+            auto [supermodule, module, phiInModule, etaInModule] = geo.GetCellIndexFromGlobalRowCol(seedRow + dRow, seedCol + dCol);
+            tower = geo.GetAbsCellId(supermodule, module, phiInModule, etaInModule);
+          } catch (...) {
+            continue; // outside of the acceptance
+          }
+          float fraction = (dRow == 0 && dCol == 0) ? 0.6 : ((dRow == 0 || dCol == 0) ? 0.07 : 0.03);
+          auto [cell, isNew] = event.try_emplace(tower, tower, 0.f, time + 2. * (dRow + dCol), ChannelType_t::HIGH_GAIN);
+          cell->second.setEnergy(cell->second.getEnergy() + fraction * energy);
+        }
+      }
+    }
+    int nNoiseTrg = noiseDist(gen);
+    for (int iNoise = 0; iNoise < nNoiseTrg; iNoise++) {
+      int tower = towerDist(gen);
+      event.try_emplace(tower, tower, 0.08f + 0.1f * energyDist(gen), timeDist(gen), ChannelType_t::HIGH_GAIN);
+    }
+    triggers.emplace_back(InteractionRecord(iTrg * 4, 0), cells.size(), event.size());
+    for (const auto& [tower, cell] : event) {
+      cells.push_back(cell);
+    }
+  }
+}
+
+/// \brief Check that two cluster collections are identical
+void compareClusters(gsl::span<const Cluster> clusters, gsl::span<const ClusterIndex> indices, gsl::span<const Cluster> refClusters, gsl::span<const ClusterIndex> refIndices)
+{
+  BOOST_REQUIRE_EQUAL(clusters.size(), refClusters.size());
+  BOOST_REQUIRE_EQUAL(indices.size(), refIndices.size());
+  for (size_t iCluster = 0; iCluster < clusters.size(); iCluster++) {
+    BOOST_REQUIRE_EQUAL(clusters[iCluster].getCellIndexFirst(), refClusters[iCluster].getCellIndexFirst());
+    BOOST_REQUIRE_EQUAL(clusters[iCluster].getNCells(), refClusters[iCluster].getNCells());
+    BOOST_REQUIRE_EQUAL(clusters[iCluster].getTimeStamp(), refClusters[iCluster].getTimeStamp());
+  }
+  for (size_t iIndex = 0; iIndex < indices.size(); iIndex++) {
+    BOOST_REQUIRE_EQUAL(indices[iIndex], refIndices[iIndex]);
+  }
+}
+
+/// \brief Clusterizer reused for many triggers gives the same result as a new clusterizer for each trigger
+BOOST_AUTO_TEST_CASE(ClusterizerReuse_test)
+{
+  auto geo = Geometry::GetInstanceFromRunNumber(300000);
+  std::mt19937 gen(1234);
+  std::vector<Cell> cells;
+  std::vector<TriggerRecord> triggers;
+  createTimeframe(*geo, gen, 50, 20., 100., cells, triggers);
+
+  ClusterizerCells clusterizer(10000, 0, 10000, 0.03, true, 0.1, 0.05);
+  clusterizer.setGeometry(geo);
+  size_t nClusters = 0;
+  for (const auto& trigger : triggers) {
+    gsl::span<const Cell> event(cells.data() + trigger.getFirstEntry(), trigger.getNumberOfObjects());
+    clusterizer.findClusters(event);
+    auto fresh = std::make_unique<ClusterizerCells>(10000, 0, 10000, 0.03, true, 0.1, 0.05);
+    fresh->setGeometry(geo);
+    fresh->findClusters(event);
+    compareClusters(*clusterizer.getFoundClusters(), *clusterizer.getFoundClustersInputIndices(), *fresh->getFoundClusters(), *fresh->getFoundClustersInputIndices());
+    nClusters += clusterizer.getFoundClusters()->size();
+  }
+  BOOST_CHECK_GT(nClusters, 0);
+}
+
+/// \brief Clusterizer pool gives the same result as a single clusterizer processing the triggers one by one
+BOOST_AUTO_TEST_CASE(ClusterizerPool_test)
+{
+  auto geo = Geometry::GetInstanceFromRunNumber(300000);
+  std::mt19937 gen(4321);
+  std::vector<Cell> cells;
+  std::vector<TriggerRecord> triggers;
+
+  ClusterizerCells clusterizer(10000, 0, 10000, 0.03, true, 0.1, 0.05);
+  clusterizer.setGeometry(geo);
+  ClusterizerPoolCells pool;
+  pool.initialize(10000, 0, 10000, 0.03, true, 0.1, 0.05);
+  pool.setGeometry(geo);
+
+  std::vector<Cluster> clusters;
+  std::vector<ClusterIndex> indices;
+  std::vector<TriggerRecord> clusterTriggers, indexTriggers;
+  for (int nThreads : {1, 4, 2}) {
+    pool.setNThreads(nThreads);
+    createTimeframe(*geo, gen, 200, 5., 30., cells, triggers);
+    // add triggers without cells
+    triggers.emplace(triggers.begin() + 7, InteractionRecord(30, 0), triggers[7].getFirstEntry(), 0);
+    triggers.emplace_back(InteractionRecord(0, 1), cells.size(), 0);
+    pool.findClusters(cells, triggers, clusters, indices, clusterTriggers, indexTriggers);
+    BOOST_REQUIRE_EQUAL(clusterTriggers.size(), triggers.size());
+    BOOST_REQUIRE_EQUAL(indexTriggers.size(), triggers.size());
+
+    for (size_t iTrg = 0; iTrg < triggers.size(); iTrg++) {
+      const auto& trigger = triggers[iTrg];
+      clusterizer.clear();
+      if (trigger.getNumberOfObjects()) {
+        clusterizer.findClusters(gsl::span<const Cell>(cells.data() + trigger.getFirstEntry(), trigger.getNumberOfObjects()));
+      }
+      BOOST_CHECK(clusterTriggers[iTrg].getBCData() == trigger.getBCData());
+      BOOST_CHECK(indexTriggers[iTrg].getBCData() == trigger.getBCData());
+      gsl::span<const Cluster> trgClusters(clusters.data() + clusterTriggers[iTrg].getFirstEntry(), clusterTriggers[iTrg].getNumberOfObjects());
+      gsl::span<const ClusterIndex> trgIndices(indices.data() + indexTriggers[iTrg].getFirstEntry(), indexTriggers[iTrg].getNumberOfObjects());
+      compareClusters(trgClusters, trgIndices, *clusterizer.getFoundClusters(), *clusterizer.getFoundClustersInputIndices());
+    }
+  }
+}
+
+} // namespace emcal
+
+} // namespace o2
@@ -18,6 +18,7 @@
 #include "DataFormatsEMCAL/TriggerRecord.h"
 #include "EMCALBase/Geometry.h"
 #include "EMCALReconstruction/Clusterizer.h"
+#include "EMCALReconstruction/ClusterizerPool.h"
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/Task.h"
 #include "TStopwatch.h"
@@ -68,7 +69,7 @@ class ClusterizerSpec : public framework::Task
   void endOfStream(framework::EndOfStreamContext& ec) final;
 
  private:
-  o2::emcal::Clusterizer<InputType> mClusterizer;                               ///< Clusterizer object
+  o2::emcal::ClusterizerPool<InputType> mClusterizer;                           ///< Clusterizers processing the triggers of the timeframe
   o2::emcal::Geometry* mGeometry = nullptr;                                     ///< Pointer to geometry object
   std::vector<o2::emcal::Cluster>* mOutputClusters = nullptr;                   ///< Container with output clusters (pointer)
   std::vector<o2::emcal::ClusterIndex>* mOutputCellDigitIndices = nullptr;      ///< Container with indices of cluster digits (pointer)
@@ -46,6 +46,7 @@ void ClusterizerSpec<InputType>::init(framework::InitContext& ctx)
   // Initialize clusterizer and link geometry
   mClusterizer.initialize(timeCut, timeMin, timeMax, gradientCut, doEnergyGradientCut, thresholdSeedEnergy, thresholdCellEnergy);
   mClusterizer.setGeometry(mGeometry);
+  mClusterizer.setNThreads(ctx.options().get<int>("nthreads"));
 
   mOutputClusters = new std::vector<o2::emcal::Cluster>();
   mOutputCellDigitIndices = new std::vector<o2::emcal::ClusterIndex>();
@@ -77,35 +78,11 @@ void ClusterizerSpec<InputType>::run(framework::ProcessingContext& ctx)
   auto InputTriggerRecord = ctx.inputs().get<gsl::span<TriggerRecord>>(TrigName.c_str());
   LOG(debug) << "[EMCALClusterizer - run]  Received " << InputTriggerRecord.size() << " Trigger Records, running clusterizer ...";
 
-  mOutputClusters->clear();
-  mOutputCellDigitIndices->clear();
-  mOutputTriggerRecord->clear();
-  mOutputTriggerRecordIndices->clear();
-
-  int currentStartClusters = mOutputClusters->size();
-  int currentStartIndices = mOutputCellDigitIndices->size();
-  for (auto iTrgRcrd : InputTriggerRecord) {
-    if (Inputs.size() && iTrgRcrd.getNumberOfObjects()) {
-      mClusterizer.findClusters(gsl::span<const InputType>(&Inputs[iTrgRcrd.getFirstEntry()], iTrgRcrd.getNumberOfObjects())); // Find clusters on cells/digits (pass by ref)
-    } else {
-      mClusterizer.clear();
-    }
-    // Get found clusters + cell/digit indices for output
-    // * A cluster contains a range that correspond to the vector of cell/digit indices
-    // * The cell/digit index vector contains the indices of the clusterized cells/digits wrt to the original cell/digit array
-
-    auto outputClustersTemp = mClusterizer.getFoundClusters();
-    auto outputCellDigitIndicesTemp = mClusterizer.getFoundClustersInputIndices();
-
-    std::copy(outputClustersTemp->begin(), outputClustersTemp->end(), std::back_inserter(*mOutputClusters));
-    std::copy(outputCellDigitIndicesTemp->begin(), outputCellDigitIndicesTemp->end(), std::back_inserter(*mOutputCellDigitIndices));
-
-    mOutputTriggerRecord->emplace_back(iTrgRcrd.getBCData(), currentStartClusters, outputClustersTemp->size());
-    mOutputTriggerRecordIndices->emplace_back(iTrgRcrd.getBCData(), currentStartIndices, outputCellDigitIndicesTemp->size());
-
-    currentStartClusters = mOutputClusters->size();
-    currentStartIndices = mOutputCellDigitIndices->size();
-  }
+  // Find clusters on cells/digits of all triggers, the triggers are distributed to the clusterizers of the pool
+  // * A cluster contains a range that correspond to the vector of cell/digit indices
+  // * The cell/digit index vector contains the indices of the clusterized cells/digits wrt to the original cell/digit array
+  mClusterizer.findClusters(Inputs, InputTriggerRecord, *mOutputClusters, *mOutputCellDigitIndices, *mOutputTriggerRecord, *mOutputTriggerRecordIndices);
+
   LOG(debug) << "[EMCALClusterizer - run] Writing " << mOutputClusters->size() << " clusters ...";
   ctx.outputs().snapshot(o2::framework::Output{o2::header::gDataOriginEMC, "CLUSTERS", 0}, *mOutputClusters);
   ctx.outputs().snapshot(o2::framework::Output{o2::header::gDataOriginEMC, "INDICES", 0}, *mOutputCellDigitIndices);
@@ -139,15 +116,20 @@ o2::framework::DataProcessorSpec o2::emcal::reco_workflow::getClusterizerSpec(bo
   outputs.emplace_back(o2::header::gDataOriginEMC, "CLUSTERSTRGR", 0, o2::framework::Lifetime::Timeframe);
   outputs.emplace_back(o2::header::gDataOriginEMC, "INDICESTRGR", 0, o2::framework::Lifetime::Timeframe);
 
+  o2::framework::Options options{
+    {"nthreads", o2::framework::VariantType::Int, 1, {"Number of threads clusterizing the triggers of a timeframe"}}};
+
   if (useDigits) {
     return o2::framework::DataProcessorSpec{"EMCALClusterizerSpec",
                                             inputs,
                                             outputs,
-                                            o2::framework::adaptFromTask<o2::emcal::reco_workflow::ClusterizerSpec<o2::emcal::Digit>>()};
+                                            o2::framework::adaptFromTask<o2::emcal::reco_workflow::ClusterizerSpec<o2::emcal::Digit>>(),
+                                            options};
   } else {
     return o2::framework::DataProcessorSpec{"EMCALClusterizerSpec",
                                             inputs,
                                             outputs,
-                                            o2::framework::adaptFromTask<o2::emcal::reco_workflow::ClusterizerSpec<o2::emcal::Cell>>()};
+                                            o2::framework::adaptFromTask<o2::emcal::reco_workflow::ClusterizerSpec<o2::emcal::Cell>>(),
+                                            options};
   }
 }
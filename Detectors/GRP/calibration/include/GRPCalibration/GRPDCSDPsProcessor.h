@@ -18,6 +18,7 @@
 #include "Framework/Logger.h"
 #include "DetectorsDCS/DataPointCompositeObject.h"
 #include "DetectorsDCS/DataPointIdentifier.h"
+#include "DetectorsDCS/DPIDFlatMap.h"
 #include "DetectorsDCS/DataPointValue.h"
 #include "DetectorsDCS/DeliveryType.h"
 #include "CCDB/CcdbObjectInfo.h"
@@ -355,7 +356,7 @@ class GRPDCSDPsProcessor
   void updateVector(const DPID& dpid, std::vector<std::pair<uint64_t, double>>& vect, std::string alias, uint64_t timestamp, double val);
 
  private:
-  std::unordered_map<DPID, bool> mPids; // contains all PIDs for the processor, the bool
+  o2::dcs::DPIDFlatMap<bool> mPids; // contains all PIDs for the processor, the bool
                                         // will be true if the DP was processed at least once
 
   long mStartValidityMagFi = o2::ccdb::CcdbObjectInfo::INFINITE_TIMESTAMP;
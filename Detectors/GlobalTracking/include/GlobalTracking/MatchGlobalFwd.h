@@ -17,7 +17,9 @@
 #define ALICEO2_GLOBTRACKING_MATCHGLOBALFWD_
 
 #include <Rtypes.h>
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <vector>
 #include <string>
 #include <gsl/span>
@@ -102,6 +104,14 @@ using SMatrix52 = ROOT::Math::SMatrix<double, 5, 2>;
 
 class MatchGlobalFwd
 {
+  ///< MCH-MFT pair passing the candidate cut, as collected per MFT ROF in the best-match mode
+  struct MatchCandidate {
+    int MCHId;
+    int MFTId;
+    double score;
+    bool closeMatch;
+  };
+
  public:
   enum MatchingType : uint8_t { ///< MFT-MCH matching modes
     MATCHINGFUNC,               ///< Matching function-based MFT-MCH track matching
@@ -130,6 +140,9 @@ class MatchGlobalFwd
   bool isMFTTriggered() const { return mMFTTriggered; }
 
   void setMCTruthOn(bool v) { mMCTruthON = v; }
+  ///< number of threads for the best-match mode; user-defined matching/cut functions must be reentrant
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
   ///< set MFT ROFrame duration in microseconds
   void setMFTROFrameLengthMUS(float fums);
   ///< set MFT ROFrame duration in BC (continuous mode only)
@@ -166,6 +179,16 @@ class MatchGlobalFwd
   ///< Matches MFT tracks in one MFT ROFrame with all MCH tracks in the overlapping MCH ROFrames
   template <int saveMode>
   void ROFMatch(int MFTROFId, int firstMCHROFId, int lastMCHROFId);
+  ///< Collects candidate pairs of one MFT ROFrame without touching the MCH tracks (best-match mode)
+  void ROFMatchCandidates(int MFTROFId, int firstMCHROFId, int lastMCHROFId, std::vector<MatchCandidate>& candidates);
+
+  void buildMCHSearchIndex(); ///< sort MCH tracks of each ROF by cell at the matching plane
+  int64_t searchCellKey(int ix, int iy) const { return (int64_t(ix) << 32) + (int64_t(iy) + 0x80000000LL); }
+  int searchCell(float v) const { return std::isfinite(v) ? int(std::clamp(std::floor(v / mSearchWindow), -1.e6f, 1.e6f)) : 0; }
+  bool inSearchWindow(const TrackLocMCH& mchTrack, const TrackLocMFT& mftTrack) const
+  {
+    return mSearchWindow <= 0.f || (std::abs(mchTrack.getX() - mftTrack.getX()) < mSearchWindow && std::abs(mchTrack.getY() - mftTrack.getY()) < mSearchWindow);
+  }
 
   void fitTracks();                                          ///< Fit all matched tracks
   void fitGlobalMuonTrack(o2::dataformats::GlobalFwdTrack&); ///< Kalman filter fit global Forward track by attaching MFT clusters
@@ -287,6 +310,8 @@ class MatchGlobalFwd
 
   float mBz = -5.f;                       ///< nominal Bz in kGauss
   float mMatchingPlaneZ = sLastMFTPlaneZ; ///< MCH-MFT matching plane Z position
+  float mSearchWindow = 0.f;              ///< max |dx|,|dy| of tested pairs at the matching plane, also the search cell size (0: no window)
+  int mNThreads = 1;                      ///< number of OMP threads
   Float_t mMFTDiskThicknessInX0 = 0.042 / 5; ///< MFT disk thickness in radiation length
   Float_t mAlignResidual = 1;                ///< Alignment residual for cluster position uncertainty
   o2::InteractionRecord mStartIR{0, 0}; ///< IR corresponding to the start of the TF
@@ -324,6 +349,7 @@ class MatchGlobalFwd
   std::vector<BracketF> mMCHROFTimes;                          ///< min/max times of MCH ROFs in \mus
   std::vector<TrackLocMCH> mMCHWork;                           ///< MCH track params prepared for matching
   std::vector<int> mMCHID2Work;                                ///< MCH track id to ensure correct indexing for matching
+  std::vector<std::pair<int64_t, int>> mMCHSearchIndex;        ///< (cell key, MCH track id), sorted within each MCH ROF
   std::vector<BracketF> mMFTROFTimes;                          ///< min/max times of MFT ROFs in \mus
   std::vector<TrackLocMFT> mMFTWork;                           ///< MFT track params prepared for matching
   std::vector<MFTCluster> mMFTClusters;                        ///< input MFT clusters
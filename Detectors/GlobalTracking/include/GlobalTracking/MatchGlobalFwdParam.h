@@ -41,6 +41,7 @@ struct GlobalFwdMatchingParam : public o2::conf::ConfigurableParamHelper<GlobalF
   Int_t saveMode = kBestMatch;                            ///< Global Forward Tracks save mode
   float MFTRadLength = 0.042;                             ///< MFT thickness in radiation length
   float alignResidual = 1.;                               ///< Alignment residual for cluster position uncertainty
+  float searchWindowXY = 0.;                              ///< if > 0: only pairs with |dx|,|dy| below this value (cm) at the matching plane are tested
 
   bool
     isMatchUpstream() const
@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include "GlobalTracking/MatchGlobalFwd.h"
+#include <limits>
 
 using namespace o2::globaltracking;
 
@@ -30,6 +31,9 @@ void MatchGlobalFwd::init()
   mMatchingPlaneZ = matchingParam.matchPlaneZ;
   LOG(info) << "MFTMCH matchingPlaneZ = " << mMatchingPlaneZ;
 
+  mSearchWindow = matchingParam.searchWindowXY;
+  LOG(info) << "MFTMCH search window at matching plane = " << (mSearchWindow > 0 ? std::to_string(mSearchWindow) : std::string("disabled"));
+
   auto& matchingFcnStr = matchingParam.matchFcn;
   LOG(info) << "Match function string = " << matchingFcnStr;
 
@@ -125,6 +129,7 @@ void MatchGlobalFwd::clear()
 {
   mMCHROFTimes.clear();
   mMCHWork.clear();
+  mMCHSearchIndex.clear();
   mMFTROFTimes.clear();
   mMFTWork.clear();
   mMFTClusters.clear();
@@ -339,6 +344,10 @@ void MatchGlobalFwd::doMatching()
   auto firstMFTTrackIdInROF = 0;
   auto MFTROFId = mMFTWork.front().roFrame;
   LOG(debug) << "(*) nMCHROFs: " << nMCHROFs << ", mMFTTracks.size(): " << mMFTTracks.size() << " MFTROFId: " << MFTROFId << ",  mMFTTrackROFRec.size(): " << mMFTTrackROFRec.size();
+  if (mSearchWindow > 0) {
+    buildMCHSearchIndex();
+  }
+  std::vector<std::array<int, 3>> rofRanges; // MFT ROF, first and last compatible MCH ROF
 
   while ((firstMFTTrackIdInROF < mMFTTracks.size()) && (MFTROFId < mMFTTrackROFRec.size())) {
     auto MFTROFId = mMFTWork[firstMFTTrackIdInROF].roFrame;
@@ -376,10 +385,35 @@ void MatchGlobalFwd::doMatching()
                << mMCHROFTimes[mchROFMatchLast].getMin() << ","
                << mMCHROFTimes[mchROFMatchLast].getMax() << "]  size: " << mMCHTrackROFRec[mchROFMatchLast].getNEntries();
 
-    ROFMatch<saveAllMode>(MFTROFId, mchROFMatchFirst, mchROFMatchLast);
+    rofRanges.push_back({MFTROFId, mchROFMatchFirst, mchROFMatchLast});
   }
 
   if constexpr (saveAllMode == SaveMode::kBestMatch) { // Otherwise output container is filled by ROFMatch()
+    // MFT ROFs are matched independently, the candidates are then applied in the ROF order as the serial loop would do
+    std::vector<std::vector<MatchCandidate>> candidates(rofRanges.size());
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+    for (size_t i = 0; i < rofRanges.size(); i++) {
+      ROFMatchCandidates(rofRanges[i][0], rofRanges[i][1], rofRanges[i][2], candidates[i]);
+    }
+    auto& matchAllChi2 = mMatchingFunctionMap["matchALL"];
+    for (const auto& rofCandidates : candidates) {
+      for (const auto& candidate : rofCandidates) {
+        auto& thisMCHTrack = mMCHWork[candidate.MCHId];
+        thisMCHTrack.countMFTCandidate();
+        if (candidate.closeMatch) {
+          thisMCHTrack.setCloseMatch();
+        }
+        if (candidate.score < thisMCHTrack.getMFTMCHMatchingScore()) {
+          thisMCHTrack.setMFTTrackID(candidate.MFTId);
+          auto chi2 = matchAllChi2(thisMCHTrack, mMFTWork[candidate.MFTId]); // Matching chi2 is stored independently
+          thisMCHTrack.setMFTMCHMatchingScore(candidate.score);
+          thisMCHTrack.setMFTMCHMatchingChi2(chi2);
+        }
+      }
+    }
+
     int nFakes = 0, nTrue = 0;
     for (auto& thisMCHTrack : mMCHWork) {
       auto bestMFTMatchID = thisMCHTrack.getMFTTrackID();
@@ -400,6 +434,71 @@ void MatchGlobalFwd::doMatching()
     if (mMCTruthON) {
       LOG(info) << "  MFT-MCH Matching: nFakes = " << nFakes << " nTrue = " << nTrue;
     }
+  } else {
+    for (const auto& range : rofRanges) {
+      ROFMatch<saveAllMode>(range[0], range[1], range[2]);
+    }
+  }
+}
+
+//_________________________________________________________
+void MatchGlobalFwd::buildMCHSearchIndex()
+{
+  mMCHSearchIndex.clear();
+  mMCHSearchIndex.resize(mMCHTracks.size(), {std::numeric_limits<int64_t>::max(), -1});
+  for (const auto& rofRec : mMCHTrackROFRec) {
+    int trlim = rofRec.getFirstIdx() + rofRec.getNEntries();
+    for (int it = rofRec.getFirstIdx(); it < trlim; it++) {
+      mMCHSearchIndex[it].second = it;
+      if (it < (int)mMCHWork.size()) {
+        mMCHSearchIndex[it].first = searchCellKey(searchCell(mMCHWork[it].getX()), searchCell(mMCHWork[it].getY()));
+      }
+    }
+    std::sort(mMCHSearchIndex.begin() + rofRec.getFirstIdx(), mMCHSearchIndex.begin() + trlim);
+  }
+}
+
+//_________________________________________________________
+void MatchGlobalFwd::ROFMatchCandidates(int MFTROFId, int firstMCHROFId, int lastMCHROFId, std::vector<MatchCandidate>& candidates)
+{
+  /// Collects MCH tracks in the range of ROFs passing the candidate cut with the MFT tracks of a given ROF.
+  /// For every MCH track the candidates come in increasing MFT track order, as in ROFMatch
+  const auto& thisMFTROF = mMFTTrackROFRec[MFTROFId];
+  auto firstMFTTrackID = thisMFTROF.getFirstEntry();
+  auto lastMFTTrackID = firstMFTTrackID + thisMFTROF.getNEntries() - 1;
+  auto firstMCHTrackID = mMCHTrackROFRec[firstMCHROFId].getFirstIdx();
+  auto lastMCHTrackID = mMCHTrackROFRec[lastMCHROFId].getLastIdx();
+
+  auto testPair = [&](int MCHId, int MFTId) {
+    const auto& thisMCHTrack = mMCHWork[MCHId];
+    const auto& thisMFTTrack = mMFTWork[MFTId];
+    if (!inSearchWindow(thisMCHTrack, thisMFTTrack) || !mCutFunc(thisMCHTrack, thisMFTTrack)) {
+      return;
+    }
+    bool closeMatch = mMCTruthON && computeLabel(MCHId, MFTId).isCorrect();
+    candidates.push_back({MCHId, MFTId, mMatchFunc(thisMCHTrack, thisMFTTrack), closeMatch});
+  };
+
+  for (auto MFTId = firstMFTTrackID; MFTId <= lastMFTTrackID; MFTId++) {
+    if (mSearchWindow <= 0) {
+      for (auto MCHId = firstMCHTrackID; MCHId <= lastMCHTrackID; MCHId++) {
+        testPair(MCHId, MFTId);
+      }
+      continue;
+    }
+    // only the 3x3 cells around the MFT track can contain MCH tracks within the search window
+    int ix = searchCell(mMFTWork[MFTId].getX()), iy = searchCell(mMFTWork[MFTId].getY());
+    for (int mchROF = firstMCHROFId; mchROF <= lastMCHROFId; mchROF++) {
+      auto rofBegin = mMCHSearchIndex.begin() + mMCHTrackROFRec[mchROF].getFirstIdx();
+      auto rofEnd = rofBegin + mMCHTrackROFRec[mchROF].getNEntries();
+      for (int jx = ix - 1; jx <= ix + 1; jx++) {
+        auto lastKey = searchCellKey(jx, iy + 1);
+        auto it = std::lower_bound(rofBegin, rofEnd, searchCellKey(jx, iy - 1), [](const auto& entry, int64_t key) { return entry.first < key; });
+        for (; it != rofEnd && it->first <= lastKey; ++it) {
+          testPair(it->second, MFTId);
+        }
+      }
+    }
   }
 }
 
@@ -437,6 +536,9 @@ void MatchGlobalFwd::ROFMatch(int MFTROFId, int firstMCHROFId, int lastMCHROFId)
     o2::MCCompLabel matchLabel;
     for (auto MFTId = firstMFTTrackID; MFTId <= lastMFTTrackID; MFTId++) {
       auto& thisMFTTrack = mMFTWork[MFTId];
+      if (!inSearchWindow(thisMCHTrack, thisMFTTrack)) {
+        continue;
+      }
       if (mMCTruthON) {
         matchLabel = computeLabel(MCHId, MFTId);
       }
@@ -635,6 +737,17 @@ bool MatchGlobalFwd::computeCluster(o2::dataformats::GlobalFwdTrack& track, cons
   return false;
 }
 
+//_________________________________________________________
+void MatchGlobalFwd::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  LOG(warning) << "Multithreading is not supported, imposing single thread";
+  mNThreads = 1;
+#endif
+}
+
 //_________________________________________________________
 void MatchGlobalFwd::setMFTROFrameLengthMUS(float fums)
 {
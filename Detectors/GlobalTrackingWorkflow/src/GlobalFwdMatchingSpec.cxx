@@ -73,6 +73,7 @@ void GlobalFwdMatchingDPL::init(InitContext& ic)
 {
   o2::base::GRPGeomHelper::instance().setRequest(mGGCCDBRequest);
   mMatching.setMCTruthOn(mUseMC);
+  mMatching.setNThreads(std::max(1, ic.options().get<int>("nthreads")));
 
   const auto& matchingParam = GlobalFwdMatchingParam::Instance();
   if (matchingParam.isMatchUpstream() && mMatchRootOutput) {
@@ -217,7 +218,7 @@ DataProcessorSpec getGlobalFwdMatchingSpec(bool useMC, bool matchRootOutput)
     dataRequest->inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<GlobalFwdMatchingDPL>(dataRequest, ggRequest, useMC, matchRootOutput)},
-    Options{}};
+    Options{{"nthreads", VariantType::Int, 1, {"Number of threads for the best-match MFT ROF matching"}}}};
 }
 
 } // namespace globaltracking
@@ -20,6 +20,7 @@
 #include "Framework/Logger.h"
 #include "DetectorsDCS/DataPointCompositeObject.h"
 #include "DetectorsDCS/DataPointIdentifier.h"
+#include "DetectorsDCS/DPIDFlatMap.h"
 #include "DetectorsDCS/DataPointValue.h"
 #include "DetectorsDCS/DeliveryType.h"
 #include "CCDB/CcdbObjectInfo.h"
@@ -144,7 +145,7 @@ class TOFDCSProcessor
 
  private:
   std::unordered_map<DPID, TOFDCSinfo> mTOFDCS;                // this is the object that will go to the CCDB
-  std::unordered_map<DPID, bool> mPids;                        // contains all PIDs for the processor, the bool
+  o2::dcs::DPIDFlatMap<bool> mPids;                            // contains all PIDs for the processor, the bool
                                                                // will be true if the DP was processed at least once
   std::unordered_map<DPID, std::vector<DPVAL>> mDpsdoublesmap; // this is the map that will hold the DPs for the
                                                                // double type (voltages and currents)
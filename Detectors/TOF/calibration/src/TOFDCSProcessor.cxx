@@ -96,7 +96,7 @@ int TOFDCSProcessor::process(const gsl::span<const DPCOM> dps)
       continue;
     }
     processDP(it);
-    mPids[it.id] = true;
+    el->second = true;
   }
 
   if (mUpdateFeacStatus) {
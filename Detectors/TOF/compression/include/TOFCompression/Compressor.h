@@ -34,7 +34,11 @@ class Compressor
 {
 
  public:
-  Compressor() { mDecoderSaveBuffer = new char[mDecoderSaveBufferSize]; };
+  Compressor()
+  {
+    mDecoderSaveBuffer = new char[mDecoderSaveBufferSize];
+    resetCounters();
+  };
   ~Compressor() { delete[] mDecoderSaveBuffer; };
 
   inline bool run()
@@ -69,6 +73,8 @@ class Compressor
 
   void checkSummary();
   void resetCounters();
+  /** add the counters of another compressor, e.g. for the summary of a pool of compressors **/
+  void addCounters(const Compressor& other);
 
   void setDecoderCONET(bool val)
   {
@@ -0,0 +1,89 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CompressorPool.h
+/// @brief  Pool of TOF raw data compressors running on independent payloads
+
+#ifndef O2_TOF_COMPRESSORPOOL
+#define O2_TOF_COMPRESSORPOOL
+
+#include "TOFCompression/Compressor.h"
+#include <memory>
+#include <vector>
+
+namespace o2
+{
+namespace tof
+{
+
+/** The link payloads of a timeframe are independent, therefore they are
+    distributed to one compressor per thread. Each payload is compressed
+    into the scratch buffer of its thread and copied into an output buffer
+    of its compressed size, so that the compressed payloads can be
+    concatenated in the input order independently of the number of threads. **/
+
+template <typename RDH, bool verbose, bool paranoid>
+class CompressorPool
+{
+
+ public:
+  struct Payload {
+    const char* buffer;
+    long size;
+  };
+
+  CompressorPool() = default;
+  ~CompressorPool() = default;
+
+  /** requests > 1 are ignored without OpenMP support **/
+  void setNThreads(int nThreads);
+  int getNThreads() const { return mNThreads; };
+
+  void setDecoderCONET(bool val);
+  void setDecoderVerbose(bool val);
+  void setEncoderVerbose(bool val);
+  void setCheckerVerbose(bool val);
+
+  /** scratch buffer size to compress a payload: payload size + val if val >= 0, -val otherwise **/
+  void setOutputBufferSize(int val) { mOutputBufferSize = val; };
+
+  /** compress the payloads, the output of payload i is available until the next run **/
+  void run(const std::vector<Payload>& payloads);
+
+  inline const char* getOutputBuffer(int i) const { return mOutputs[i].data(); };
+  inline long getOutputSize(int i) const { return mOutputs[i].size(); };
+
+  /** summary of the counters of all compressors **/
+  void checkSummary();
+
+ private:
+  struct Scratch {
+    std::unique_ptr<char[]> buffer;
+    long capacity = 0;
+  };
+
+  void createCompressors();
+
+  std::vector<std::unique_ptr<Compressor<RDH, verbose, paranoid>>> mCompressors;
+  std::vector<Scratch> mScratch;           // one per compressor
+  std::vector<std::vector<char>> mOutputs; // one per payload of the last run
+  int mNThreads = 1;
+  int mOutputBufferSize = 1048576;
+  bool mDecoderCONET = false;
+  bool mDecoderVerbose = false;
+  bool mEncoderVerbose = false;
+  bool mCheckerVerbose = false;
+};
+
+} // namespace tof
+} // namespace o2
+
+#endif /** O2_TOF_COMPRESSORPOOL **/
@@ -19,7 +19,7 @@
 
 #include "Framework/Task.h"
 #include "Framework/DataProcessorSpec.h"
-#include "TOFCompression/Compressor.h"
+#include "TOFCompression/CompressorPool.h"
 #include <fstream>
 
 using namespace o2::framework;
@@ -39,8 +39,8 @@ class CompressorTask : public Task
   void run(ProcessingContext& pc) final;
 
  private:
-  Compressor<RDH, verbose, paranoid> mCompressor;
-  int mOutputBufferSize;
+  CompressorPool<RDH, verbose, paranoid> mCompressorPool;
+  std::vector<typename CompressorPool<RDH, verbose, paranoid>::Payload> mPayloads;
   long mPayloadLimit = -1;
 };
 
@@ -0,0 +1,151 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CompressorPool.cxx
+/// @brief  Pool of TOF raw data compressors running on independent payloads
+
+#include "TOFCompression/CompressorPool.h"
+#include <fairlogger/Logger.h>
+#include <algorithm>
+#include <cstdlib>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace o2
+{
+namespace tof
+{
+
+template <typename RDH, bool verbose, bool paranoid>
+void CompressorPool<RDH, verbose, paranoid>::setNThreads(int nThreads)
+{
+#ifdef WITH_OPENMP
+  mNThreads = std::max(1, nThreads);
+#else
+  if (nThreads > 1) {
+    LOG(warning) << "Multithreading is not supported, imposing single thread";
+  }
+  mNThreads = 1;
+#endif
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+void CompressorPool<RDH, verbose, paranoid>::setDecoderCONET(bool val)
+{
+  mDecoderCONET = val;
+  for (auto& compressor : mCompressors) {
+    compressor->setDecoderCONET(val);
+  }
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+void CompressorPool<RDH, verbose, paranoid>::setDecoderVerbose(bool val)
+{
+  mDecoderVerbose = val;
+  for (auto& compressor : mCompressors) {
+    compressor->setDecoderVerbose(val);
+  }
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+void CompressorPool<RDH, verbose, paranoid>::setEncoderVerbose(bool val)
+{
+  mEncoderVerbose = val;
+  for (auto& compressor : mCompressors) {
+    compressor->setEncoderVerbose(val);
+  }
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+void CompressorPool<RDH, verbose, paranoid>::setCheckerVerbose(bool val)
+{
+  mCheckerVerbose = val;
+  for (auto& compressor : mCompressors) {
+    compressor->setCheckerVerbose(val);
+  }
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+void CompressorPool<RDH, verbose, paranoid>::createCompressors()
+{
+  while (mCompressors.size() < static_cast<size_t>(mNThreads)) {
+    /** the decoder summaries take several 100 kB, therefore the compressors are kept on the heap **/
+    auto& compressor = mCompressors.emplace_back(std::make_unique<Compressor<RDH, verbose, paranoid>>());
+    compressor->setDecoderCONET(mDecoderCONET);
+    compressor->setDecoderVerbose(mDecoderVerbose);
+    compressor->setEncoderVerbose(mEncoderVerbose);
+    compressor->setCheckerVerbose(mCheckerVerbose);
+  }
+  mScratch.resize(mCompressors.size());
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+void CompressorPool<RDH, verbose, paranoid>::run(const std::vector<Payload>& payloads)
+{
+  createCompressors();
+  int nPayloads = payloads.size();
+  mOutputs.resize(nPayloads);
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int ipayload = 0; ipayload < nPayloads; ++ipayload) {
+#ifdef WITH_OPENMP
+    int ithread = omp_get_thread_num();
+#else
+    int ithread = 0;
+#endif
+    auto& compressor = *mCompressors[ithread];
+    auto& scratch = mScratch[ithread];
+    const auto& payload = payloads[ipayload];
+
+    /** the scratch buffer of the thread is not initialised, it is reallocated when too small or more than twice too large **/
+    long capacity = mOutputBufferSize >= 0 ? mOutputBufferSize + payload.size : std::abs(mOutputBufferSize);
+    if (scratch.capacity < capacity || scratch.capacity > 2 * capacity) {
+      scratch.buffer.reset(new char[capacity]);
+      scratch.capacity = capacity;
+    }
+
+    compressor.setDecoderBuffer(payload.buffer);
+    compressor.setDecoderBufferSize(payload.size);
+    compressor.setEncoderBuffer(scratch.buffer.get());
+    compressor.setEncoderBufferSize(capacity);
+    compressor.run();
+
+    /** the output keeps only the compressed size **/
+    auto& output = mOutputs[ipayload];
+    output.assign(scratch.buffer.get(), scratch.buffer.get() + compressor.getEncoderByteCounter());
+    if (output.capacity() > 2 * output.size()) {
+      output.shrink_to_fit();
+    }
+  }
+}
+
+template <typename RDH, bool verbose, bool paranoid>
+void CompressorPool<RDH, verbose, paranoid>::checkSummary()
+{
+  createCompressors();
+  for (size_t icompressor = 1; icompressor < mCompressors.size(); ++icompressor) {
+    mCompressors[0]->addCounters(*mCompressors[icompressor]);
+    mCompressors[icompressor]->resetCounters();
+  }
+  mCompressors[0]->checkSummary();
+}
+
+template class CompressorPool<o2::header::RAWDataHeader, false, false>;
+template class CompressorPool<o2::header::RAWDataHeader, false, true>;
+template class CompressorPool<o2::header::RAWDataHeader, true, false>;
+template class CompressorPool<o2::header::RAWDataHeader, true, true>;
+
+} // namespace tof
+} // namespace o2
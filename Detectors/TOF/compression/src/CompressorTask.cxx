@@ -21,6 +21,7 @@
 #include "Framework/DataSpecUtils.h"
 #include "Framework/InputRecordWalker.h"
 #include "CommonUtils/VerbosityConfig.h"
+#include <cstring>
 
 using namespace o2::framework;
 
@@ -40,15 +41,19 @@ void CompressorTask<RDH, verbose, paranoid>::init(InitContext& ic)
   auto decoderVerbose = ic.options().get<bool>("tof-compressor-decoder-verbose");
   auto encoderVerbose = ic.options().get<bool>("tof-compressor-encoder-verbose");
   auto checkerVerbose = ic.options().get<bool>("tof-compressor-checker-verbose");
-  mOutputBufferSize = ic.options().get<int>("tof-compressor-output-buffer-size");
+  auto outputBufferSize = ic.options().get<int>("tof-compressor-output-buffer-size");
+  auto nThreads = ic.options().get<int>("tof-compressor-threads");
 
-  mCompressor.setDecoderCONET(decoderCONET);
-  mCompressor.setDecoderVerbose(decoderVerbose);
-  mCompressor.setEncoderVerbose(encoderVerbose);
-  mCompressor.setCheckerVerbose(checkerVerbose);
+  mCompressorPool.setNThreads(nThreads);
+  mCompressorPool.setOutputBufferSize(outputBufferSize);
+  mCompressorPool.setDecoderCONET(decoderCONET);
+  mCompressorPool.setDecoderVerbose(decoderVerbose);
+  mCompressorPool.setEncoderVerbose(encoderVerbose);
+  mCompressorPool.setCheckerVerbose(checkerVerbose);
+  LOG(info) << "Compressor running with " << mCompressorPool.getNThreads() << " thread(s)";
 
   auto finishFunction = [this]() {
-    mCompressor.checkSummary();
+    mCompressorPool.checkSummary();
   };
 
   ic.services().get<CallbackService>().set<CallbackService::Id::Stop>(finishFunction);
@@ -61,7 +66,6 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
 
   /** to store data sorted by subspec id **/
   std::map<int, std::vector<o2::framework::DataRef>> subspecPartMap;
-  std::map<int, int> subspecBufferSize;
 
   // if we see requested data type input with 0xDEADBEEF subspec and 0 payload this means that the "delayed message"
   // mechanism created it in absence of real data from upstream. Processor should send empty output to not block the workflow
@@ -99,18 +103,31 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
 
     /** store parts in map **/
     auto headerIn = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
-    auto payloadInSize = DataRefUtils::getPayloadSize(ref);
     auto subspec = headerIn->subSpecification;
     subspecPartMap[subspec].push_back(ref);
+    //  }
+  }
 
-    /** increase subspec buffer size **/
-    if (!subspecBufferSize.count(subspec)) {
-      subspecBufferSize[subspec] = 0;
+  /** collect the payloads of all subspecs, they are compressed concurrently **/
+  mPayloads.clear();
+  std::map<int, std::pair<int, int>> subspecPayloadRange;
+  for (auto& subspecPartEntry : subspecPartMap) {
+    auto& range = subspecPayloadRange[subspecPartEntry.first];
+    range.first = mPayloads.size();
+    for (const auto& ref : subspecPartEntry.second) {
+      auto payloadInSize = DataRefUtils::getPayloadSize(ref);
+      if (mPayloadLimit > -1 && payloadInSize > mPayloadLimit) {
+        LOG(error) << "Payload larger than limit (" << mPayloadLimit << "), payload = " << payloadInSize;
+        continue;
+      }
+      mPayloads.push_back({ref.payload, static_cast<long>(payloadInSize)});
     }
-    subspecBufferSize[subspec] += payloadInSize;
-    //  }
+    range.second = mPayloads.size();
   }
 
+  /** run **/
+  mCompressorPool.run(mPayloads);
+
   /** loop over subspecs **/
   for (auto& subspecPartEntry : subspecPartMap) {
 
@@ -124,47 +141,20 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
     headerOut.payloadSize = 0;
     headerOut.splitPayloadParts = 1;
 
-    /** initialise output message **/
-    auto bufferSize = mOutputBufferSize >= 0 ? mOutputBufferSize + subspecBufferSize[subspec] : std::abs(mOutputBufferSize);
-    auto bufferSizeDouble = bufferSize * 2;
+    /** concatenate the compressed payloads in input order **/
+    auto [firstPayload, lastPayload] = subspecPayloadRange[subspec];
+    for (int ipayload = firstPayload; ipayload < lastPayload; ++ipayload) {
+      headerOut.payloadSize += mCompressorPool.getOutputSize(ipayload);
+    }
     auto output = Output{headerOut.dataOrigin, "CRAWDATA", headerOut.subSpecification};
     auto&& v = pc.outputs().makeVector<char>(output);
-    v.resize(bufferSizeDouble);
-    // Better way of doing this would be to used an offset, so that we can resize the vector
-    // as well. However, this should be good enough because bufferSize overestimates the size
-    // of the payload.
+    v.resize(headerOut.payloadSize);
     auto bufferPointer = v.data();
-
-    /** loop over subspec parts **/
-    for (const auto& ref : parts) {
-      /** input **/
-      auto payloadIn = ref.payload;
-      auto payloadInSize = DataRefUtils::getPayloadSize(ref);
-
-      if (mPayloadLimit > -1 && payloadInSize > mPayloadLimit) {
-        LOG(error) << "Payload larger than limit (" << mPayloadLimit << "), payload = " << payloadInSize;
-        continue;
-      }
-
-      /** prepare compressor **/
-      mCompressor.setDecoderBuffer(payloadIn);
-      mCompressor.setDecoderBufferSize(payloadInSize);
-      mCompressor.setEncoderBuffer(bufferPointer);
-      mCompressor.setEncoderBufferSize(bufferSize);
-
-      /** run **/
-      mCompressor.run();
-      auto payloadOutSize = mCompressor.getEncoderByteCounter();
-      bufferPointer += payloadOutSize;
-      bufferSize -= payloadOutSize;
-      headerOut.payloadSize += payloadOutSize;
+    for (int ipayload = firstPayload; ipayload < lastPayload; ++ipayload) {
+      std::memcpy(bufferPointer, mCompressorPool.getOutputBuffer(ipayload), mCompressorPool.getOutputSize(ipayload));
+      bufferPointer += mCompressorPool.getOutputSize(ipayload);
     }
 
-    if (headerOut.payloadSize > bufferSizeDouble) {
-      headerOut.payloadSize = 0; // put payload to zero, otherwise it will trigger a crash
-    }
-
-    v.resize(headerOut.payloadSize);
     pc.outputs().adoptContainer(output, std::move(v));
   }
 }
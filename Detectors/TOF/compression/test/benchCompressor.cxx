@@ -0,0 +1,111 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   benchCompressor.cxx
+/// @brief  Replay of a recorded TOF raw data file through the compressor pool
+
+/** The raw file (e.g. written by o2-tof-reco-workflow --output-type raw or
+    recorded on an FLP) is split into one payload per link, like the parts
+    received by the compressor workflow, and the payloads are compressed
+    with different numbers of threads.
+
+    usage: o2-bench-tof-compressor-pool [benchmark options] <raw file> **/
+
+#include <benchmark/benchmark.h>
+#include "TOFCompression/CompressorPool.h"
+#include "DetectorsRaw/RDHUtils.h"
+#include "Headers/RAWDataHeader.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace o2::tof;
+using RDH = o2::header::RAWDataHeader;
+using Pool = CompressorPool<RDH, false, false>;
+
+namespace
+{
+std::vector<char> gRawData;
+std::vector<std::vector<char>> gLinkData;
+std::vector<Pool::Payload> gPayloads;
+
+/** concatenate the pages of each link in the order of the file **/
+bool loadRawFile(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.good()) {
+    std::cerr << "cannot open raw file " << filename << std::endl;
+    return false;
+  }
+  gRawData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  std::map<int, std::vector<char>> links;
+  long offset = 0;
+  while (offset + (long)sizeof(RDH) <= (long)gRawData.size()) {
+    const void* rdh = gRawData.data() + offset;
+    if (!o2::raw::RDHUtils::checkRDH(rdh, false)) {
+      std::cerr << "bad RDH at offset " << offset << std::endl;
+      return false;
+    }
+    auto offsetToNext = o2::raw::RDHUtils::getOffsetToNext(rdh);
+    if (offsetToNext == 0 || offset + offsetToNext > (long)gRawData.size()) {
+      break;
+    }
+    auto& link = links[o2::raw::RDHUtils::getFEEID(rdh)];
+    link.insert(link.end(), gRawData.data() + offset, gRawData.data() + offset + offsetToNext);
+    offset += offsetToNext;
+  }
+  for (auto& [feeId, link] : links) {
+    gLinkData.push_back(std::move(link));
+  }
+  for (const auto& link : gLinkData) {
+    gPayloads.push_back({link.data(), (long)link.size()});
+  }
+  return !gPayloads.empty();
+}
+} // namespace
+
+static void BM_CompressorPool(benchmark::State& state)
+{
+  Pool pool;
+  pool.setNThreads(state.range(0));
+  long bytesOut = 0;
+  for (auto _ : state) {
+    pool.run(gPayloads);
+    for (size_t ipayload = 0; ipayload < gPayloads.size(); ++ipayload) {
+      bytesOut += pool.getOutputSize(ipayload);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * gRawData.size());
+  state.counters["links"] = gPayloads.size();
+  state.counters["compression"] = double(bytesOut) / (state.iterations() * gRawData.size());
+}
+
+int main(int argc, char** argv)
+{
+  benchmark::Initialize(&argc, argv);
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0] << " [benchmark options] <raw file>" << std::endl;
+    return 1;
+  }
+  if (!loadRawFile(argv[1])) {
+    return 1;
+  }
+  auto bench = benchmark::RegisterBenchmark("BM_CompressorPool", BM_CompressorPool);
+  for (int nThreads : {1, 2, 4, 8, 16}) {
+    bench->Arg(nThreads);
+  }
+  bench->Unit(benchmark::kMillisecond)->UseRealTime();
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -100,7 +100,7 @@ class PoissonSolver
   const ParamSpaceCharge mParamGrid{mGrid3D.getParamSC()};           ///< parameters of the grid on which the calculations are performed
   inline static DataT sConvergenceError{1e-6};                       ///< Error tolerated
   static constexpr DataT INVTWOPI = 1. / o2::constants::math::TwoPI; ///< inverse of 2*pi
-  inline static int sNThreads{4};                                    ///< number of threads which are used during some of the calculations (increasing this number has no big impact)
+  inline static int sNThreads{4};                                    ///< number of threads which are used for the 3D relaxation, residue and grid transfer calculations
 
   /// \returns inverse grid size in phi (either 1/2Pi or NSECTORSPERSIDE/2Pi)
   static DataT getGridSizePhiInv();
@@ -241,6 +241,16 @@ class PoissonSolver
   void relax3D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int iPhi, const int symmetry, const DataT h2, const DataT tempRatioZ,
                const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3, const std::vector<DataT>& coefficient4) const;
 
+  /// red-black Gauss-Seidel relaxation of one colour of one phi slice (see relax3D)
+  /// \param iPhi number of phi slices
+  /// \param m phi slice which is relaxed
+  /// \param msw 1 for the first pass, 2 for the second pass
+  void relaxSlice3D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int iPhi, const int m, const int msw, const int symmetry, const DataT h2, const DataT tempRatioZ,
+                    const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3, const std::vector<DataT>& coefficient4) const;
+
+  /// neighbouring phi slices of slice m and the signs of their contributions for the given symmetry
+  static void getPhiNeighbours(const int m, const int nPhi, const int symmetry, int& mp1, int& signPlus, int& mm1, int& signMinus);
+
   /// Relax2D
   ///
   ///    Relaxation operation for multiGrid
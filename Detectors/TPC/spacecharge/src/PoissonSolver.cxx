@@ -956,46 +956,24 @@ template <typename DataT>
 void PoissonSolver<DataT>::residue3D(Vector& residue, const Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int tnPhi, const int symmetry,
                                      const DataT ih2, const DataT tempRatioZ, const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3, const std::vector<DataT>& inverseCoefficient4) const
 {
-#pragma omp parallel for num_threads(sNThreads) // parallising this loop is possible - but using more than 2 cores makes it slower -
+#pragma omp parallel for num_threads(sNThreads) schedule(static)
   for (int m = 0; m < tnPhi; ++m) {
-    int mp1 = m + 1;
+    int mp1 = 0;
     int signPlus = 1;
-    int mm1 = m - 1;
+    int mm1 = 0;
     int signMinus = 1;
-
-    // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
-    if (symmetry == 1) {
-      if (mp1 > tnPhi - 1) {
-        mp1 = tnPhi - 2;
-      }
-      if (mm1 < 0) {
-        mm1 = 1;
-      }
-    }
-    // Anti-symmetry in phi
-    else if (symmetry == -1) {
-      if (mp1 > tnPhi - 1) {
-        mp1 = tnPhi - 2;
-        signPlus = -1;
-      }
-      if (mm1 < 0) {
-        mm1 = 1;
-        signMinus = -1;
-      }
-    } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
-      if (mp1 > tnPhi - 1) {
-        mp1 = m + 1 - tnPhi;
-      }
-      if (mm1 < 0) {
-        mm1 = m - 1 + tnPhi;
-      }
-    }
+    getPhiNeighbours(m, tnPhi, symmetry, mp1, signPlus, mm1, signMinus);
 
     for (int j = 1; j < tnZColumn - 1; ++j) {
+      DataT* __restrict__ res = &residue(0, j, m);
+      const DataT* v = &matricesCurrentV(0, j, m);
+      const DataT* vZMinus = &matricesCurrentV(0, j - 1, m);
+      const DataT* vZPlus = &matricesCurrentV(0, j + 1, m);
+      const DataT* vPhiPlus = &matricesCurrentV(0, j, mp1);
+      const DataT* vPhiMinus = &matricesCurrentV(0, j, mm1);
+      const DataT* charge = &matricesCurrentCharge(0, j, m);
       for (int i = 1; i < tnRRow - 1; ++i) {
-        residue(i, j, m) = ih2 * (coefficient2[i] * matricesCurrentV(i - 1, j, m) + tempRatioZ * (matricesCurrentV(i, j - 1, m) + matricesCurrentV(i, j + 1, m)) + coefficient1[i] * matricesCurrentV(i + 1, j, m) +
-                                  coefficient3[i] * (signPlus * matricesCurrentV(i, j, mp1) + signMinus * matricesCurrentV(i, j, mm1)) - inverseCoefficient4[i] * matricesCurrentV(i, j, m)) +
-                           matricesCurrentCharge(i, j, m);
+        res[i] = ih2 * (coefficient2[i] * v[i - 1] + tempRatioZ * (vZMinus[i] + vZPlus[i]) + coefficient1[i] * v[i + 1] + coefficient3[i] * (signPlus * vPhiPlus[i] + signMinus * vPhiMinus[i]) - inverseCoefficient4[i] * v[i]) + charge[i];
       } // end cols
     }   // end mParamGrid.NRVertices
   }
@@ -1006,6 +984,8 @@ void PoissonSolver<DataT>::interp3D(Vector& matricesCurrentV, const Vector& matr
 {
   // Do restrict 2 D for each slice
   if (newPhiSlice == 2 * oldPhiSlice) {
+    // each iteration writes the slices m and m + 1 only
+#pragma omp parallel for num_threads(sNThreads) schedule(static)
     for (int m = 0; m < newPhiSlice; m += 2) {
       // assuming no symmetry
       int mm = m / 2;
@@ -1114,6 +1094,8 @@ void PoissonSolver<DataT>::addInterp3D(Vector& matricesCurrentV, const Vector& m
 {
   // Do restrict 2 D for each slice
   if (newPhiSlice == 2 * oldPhiSlice) {
+    // each iteration writes the slices m and m + 1 only
+#pragma omp parallel for num_threads(sNThreads) schedule(static)
     for (int m = 0; m < newPhiSlice; m += 2) {
       // assuming no symmetry
       int mm = m / 2;
@@ -1222,50 +1204,21 @@ void PoissonSolver<DataT>::relax3D(Vector& matricesCurrentV, const Vector& matri
 {
   // Gauss-Seidel (Read Black}
   if (MGParameters::relaxType == RelaxType::GaussSeidel) {
-    // for each slice
+    // in each pass only the points with one parity of i + j + m are updated and these depend only on points of the other parity,
+    // hence the phi slices are relaxed in parallel. For an odd number of slices without symmetry the first and the last slice
+    // have the same parity and are coupled: the last slice is relaxed after the others, as in the sequential order
+    const bool coupledLastSlice = (symmetry == 0) && (iPhi % 2);
+    const int nPhiParallel = coupledLastSlice ? iPhi - 1 : iPhi;
     for (int iPass = 1; iPass <= 2; ++iPass) {
       const int msw = (iPass % 2) ? 1 : 2;
-      for (int m = 0; m < iPhi; ++m) {
-        const int jsw = ((msw + m) % 2) ? 1 : 2;
-        int mp1 = m + 1;
-        int signPlus = 1;
-        int mm1 = m - 1;
-        int signMinus = 1;
-        // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
-        if (symmetry == 1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-          }
-        }
-        // Anti-symmetry in phi
-        else if (symmetry == -1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-            signPlus = -1;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-            signMinus = -1;
-          }
-        } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
-          if (mp1 > iPhi - 1) {
-            mp1 = m + 1 - iPhi;
-          }
-          if (mm1 < 0) {
-            mm1 = m - 1 + iPhi;
-          }
-        }
-        int isw = jsw;
-        for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
-          for (int i = isw; i < tnRRow - 1; i += 2) {
-            (matricesCurrentV)(i, j, m) = (coefficient2[i] * (matricesCurrentV)(i - 1, j, m) + tempRatioZ * ((matricesCurrentV)(i, j - 1, m) + (matricesCurrentV)(i, j + 1, m)) + coefficient1[i] * (matricesCurrentV)(i + 1, j, m) + coefficient3[i] * (signPlus * (matricesCurrentV)(i, j, mp1) + signMinus * (matricesCurrentV)(i, j, mm1)) + (h2 * (matricesCurrentCharge)(i, j, m))) * coefficient4[i];
-          } // end cols
-        }   // end mParamGrid.NRVertices
-      }     // end phi
-    }       // end sweep
+#pragma omp parallel for num_threads(sNThreads) schedule(static)
+      for (int m = 0; m < nPhiParallel; ++m) {
+        relaxSlice3D(matricesCurrentV, matricesCurrentCharge, tnRRow, tnZColumn, iPhi, m, msw, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+      }
+      if (coupledLastSlice) {
+        relaxSlice3D(matricesCurrentV, matricesCurrentCharge, tnRRow, tnZColumn, iPhi, iPhi - 1, msw, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+      }
+    } // end sweep
   } else if (MGParameters::relaxType == RelaxType::Jacobi) {
     // for each slice
     for (int m = 0; m < iPhi; ++m) {
@@ -1314,6 +1267,72 @@ void PoissonSolver<DataT>::relax3D(Vector& matricesCurrentV, const Vector& matri
   }
 }
 
+template <typename DataT>
+void PoissonSolver<DataT>::relaxSlice3D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const int iPhi, const int m, const int msw, const int symmetry, const DataT h2,
+                                        const DataT tempRatioZ, const std::vector<DataT>& coefficient1, const std::vector<DataT>& coefficient2, const std::vector<DataT>& coefficient3, const std::vector<DataT>& coefficient4) const
+{
+  const int jsw = ((msw + m) % 2) ? 1 : 2;
+  int mp1 = 0;
+  int signPlus = 1;
+  int mm1 = 0;
+  int signMinus = 1;
+  getPhiNeighbours(m, iPhi, symmetry, mp1, signPlus, mm1, signMinus);
+
+  const DataT* __restrict__ coeff1 = coefficient1.data();
+  const DataT* __restrict__ coeff2 = coefficient2.data();
+  const DataT* __restrict__ coeff3 = coefficient3.data();
+  const DataT* __restrict__ coeff4 = coefficient4.data();
+  int isw = jsw;
+  for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
+    // rows of the slice and of the neighbouring slices, the points updated in this pass are not read
+    DataT* v = &matricesCurrentV(0, j, m);
+    const DataT* vZMinus = &matricesCurrentV(0, j - 1, m);
+    const DataT* vZPlus = &matricesCurrentV(0, j + 1, m);
+    const DataT* vPhiPlus = &matricesCurrentV(0, j, mp1);
+    const DataT* vPhiMinus = &matricesCurrentV(0, j, mm1);
+    const DataT* __restrict__ charge = &matricesCurrentCharge(0, j, m);
+    for (int i = isw; i < tnRRow - 1; i += 2) {
+      v[i] = (coeff2[i] * v[i - 1] + tempRatioZ * (vZMinus[i] + vZPlus[i]) + coeff1[i] * v[i + 1] + coeff3[i] * (signPlus * vPhiPlus[i] + signMinus * vPhiMinus[i]) + (h2 * charge[i])) * coeff4[i];
+    } // end cols
+  }   // end mParamGrid.NRVertices
+}
+
+template <typename DataT>
+void PoissonSolver<DataT>::getPhiNeighbours(const int m, const int nPhi, const int symmetry, int& mp1, int& signPlus, int& mm1, int& signMinus)
+{
+  mp1 = m + 1;
+  signPlus = 1;
+  mm1 = m - 1;
+  signMinus = 1;
+  // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
+  if (symmetry == 1) {
+    if (mp1 > nPhi - 1) {
+      mp1 = nPhi - 2;
+    }
+    if (mm1 < 0) {
+      mm1 = 1;
+    }
+  }
+  // Anti-symmetry in phi
+  else if (symmetry == -1) {
+    if (mp1 > nPhi - 1) {
+      mp1 = nPhi - 2;
+      signPlus = -1;
+    }
+    if (mm1 < 0) {
+      mm1 = 1;
+      signMinus = -1;
+    }
+  } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
+    if (mp1 > nPhi - 1) {
+      mp1 = m + 1 - nPhi;
+    }
+    if (mm1 < 0) {
+      mm1 = m - 1 + nPhi;
+    }
+  }
+}
+
 template <typename DataT>
 void PoissonSolver<DataT>::relax2D(Vector& matricesCurrentV, const Vector& matricesCurrentCharge, const int tnRRow, const int tnZColumn, const DataT h2, const DataT tempFourth, const DataT tempRatio,
                                    std::vector<DataT>& coefficient1, std::vector<DataT>& coefficient2)
@@ -1389,8 +1408,9 @@ template <typename DataT>
 void PoissonSolver<DataT>::restrict3D(Vector& matricesCurrentCharge, const Vector& residue, const int tnRRow, const int tnZColumn, const int newPhiSlice, const int oldPhiSlice) const
 {
   if (2 * newPhiSlice == oldPhiSlice) {
-    int mm = 0;
-    for (int m = 0; m < newPhiSlice; m++, mm += 2) {
+#pragma omp parallel for num_threads(sNThreads) schedule(static)
+    for (int m = 0; m < newPhiSlice; m++) {
+      const int mm = 2 * m;
       // assuming no symmetry
       int mp1 = mm + 1;
       int mm1 = mm - 1;
@@ -1437,6 +1457,7 @@ void PoissonSolver<DataT>::restrict3D(Vector& matricesCurrentCharge, const Vecto
     } // end phis
 
   } else {
+#pragma omp parallel for num_threads(sNThreads) schedule(static)
     for (int m = 0; m < newPhiSlice; ++m) {
       restrict2D(matricesCurrentCharge, residue, tnRRow, tnZColumn, m);
     }
@@ -1482,7 +1503,7 @@ DataT PoissonSolver<DataT>::getConvergenceError(const Vector& matricesCurrentV,
   // subtract the two matrices
   std::transform(prevArrayV.begin(), prevArrayV.end(), matricesCurrentV.begin(), prevArrayV.begin(), std::minus<DataT>());
 
-#pragma omp parallel for num_threads(sNThreads) // parallising this loop is possible - but using more than 2 cores makes it slower -
+#pragma omp parallel for num_threads(sNThreads) schedule(static)
   for (unsigned int m = 0; m < prevArrayV.getNphi(); ++m) {
     // square each entry in the vector and sum them up
     const auto phiStep = prevArrayV.getNr() * prevArrayV.getNz(); // number of points in one phi slice
@@ -0,0 +1,64 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file  benchPoissonSolver.cxx
+/// \brief benchmark of the 3D multigrid poisson solver for the grid sizes used for the space-charge maps and different numbers of threads
+
+#include <benchmark/benchmark.h>
+#include "TPCSpaceCharge/PoissonSolver.h"
+#include "TPCSpaceCharge/PoissonSolverHelpers.h"
+#include "TPCSpaceCharge/SpaceChargeHelpers.h"
+#include "TPCSpaceCharge/DataContainer3D.h"
+
+using namespace o2::tpc;
+using DataT = double;
+
+static void BM_PoissonSolver3D(benchmark::State& state)
+{
+  using GridProp = GridProperties<DataT>;
+  const unsigned short nRZ = state.range(0);
+  const unsigned short nPhi = state.range(1);
+  const ParamSpaceCharge params{nRZ, nRZ, nPhi};
+  const RegularGrid3D<DataT> grid3D{GridProp::ZMIN, GridProp::RMIN, GridProp::PHIMIN, GridProp::getGridSpacingZ(nRZ), GridProp::getGridSpacingR(nRZ), GridProp::getGridSpacingPhi(nPhi), params};
+
+  // charge density and boundary potential from the analytical formulas
+  const AnalyticalFields<DataT> formulas;
+  DataContainer3D<DataT> charge(nRZ, nRZ, nPhi);
+  DataContainer3D<DataT> potentialBoundary(nRZ, nRZ, nPhi);
+  for (size_t iPhi = 0; iPhi < nPhi; ++iPhi) {
+    const DataT phi = grid3D.getPhiVertex(iPhi);
+    for (size_t iR = 0; iR < nRZ; ++iR) {
+      const DataT radius = grid3D.getRVertex(iR);
+      for (size_t iZ = 0; iZ < nRZ; ++iZ) {
+        const DataT z = grid3D.getZVertex(iZ);
+        charge(iZ, iR, iPhi) = formulas.evalDensity(z, radius, phi);
+        if (iR == 0 || iZ == 0 || iR == nRZ - 1u || iZ == nRZ - 1u) {
+          potentialBoundary(iZ, iR, iPhi) = formulas.evalPotential(z, radius, phi);
+        }
+      }
+    }
+  }
+
+  MGParameters::isFull3D = true;
+  PoissonSolver<DataT>::setNThreads(state.range(2));
+  PoissonSolver<DataT> poissonSolver(grid3D);
+  for (auto _ : state) {
+    auto potential = potentialBoundary;
+    poissonSolver.poissonSolver3D(potential, charge, 0);
+    benchmark::DoNotOptimize(potential(nRZ / 2, nRZ / 2, 0));
+  }
+  state.counters["vertices"] = double(nRZ) * nRZ * nPhi;
+}
+
+// grid sizes (r and z, phi) used for the space-charge distortion maps
+BENCHMARK(BM_PoissonSolver3D)->ArgsProduct({{65, 129}, {180, 360}, {1, 2, 4, 8, 16, 32}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -226,6 +226,43 @@ void poissonSolver2D()
   testAlmostEqualArray2D<DataT>(potentialAnalytical, potentialNumerical);
 }
 
+template <typename DataT>
+void poissonSolver3DThreads()
+{
+  using GridProp = GridProperties<DataT>;
+  const ParamSpaceCharge params{NR, NZ, NPHI};
+  const o2::tpc::RegularGrid3D<DataT> grid3D{GridProp::ZMIN, GridProp::RMIN, GridProp::PHIMIN, GridProp::getGridSpacingZ(NZ), GridProp::getGridSpacingR(NR), GridProp::getGridSpacingPhi(NPHI), params};
+
+  using DataContainer = o2::tpc::DataContainer3D<DataT>;
+  DataContainer charge(NZ, NR, NPHI);
+  DataContainer potentialBoundary(NZ, NR, NPHI);
+  const o2::tpc::AnalyticalFields<DataT> analyticalFields;
+  setChargeDensityFromFormula<DataT>(analyticalFields, grid3D, charge);
+  setPotentialBoundaryFromFormula<DataT>(analyticalFields, grid3D, potentialBoundary);
+
+  // the red-black relaxation is independent of the order of the phi slices, the result must not depend on the number of threads
+  const int nThreads = PoissonSolver<DataT>::getNThreads();
+  PoissonSolver<DataT>::setNThreads(1);
+  DataContainer potentialSingleThread = potentialBoundary;
+  PoissonSolver<DataT>(grid3D).poissonSolver3D(potentialSingleThread, charge, 0);
+
+  for (int threads : {2, 5, 16}) {
+    PoissonSolver<DataT>::setNThreads(threads);
+    DataContainer potential = potentialBoundary;
+    PoissonSolver<DataT>(grid3D).poissonSolver3D(potential, charge, 0);
+    int nDifferent = 0;
+    for (size_t iPhi = 0; iPhi < potential.getNPhi(); ++iPhi) {
+      for (size_t iR = 0; iR < potential.getNR(); ++iR) {
+        for (size_t iZ = 0; iZ < potential.getNZ(); ++iZ) {
+          nDifferent += (potential(iZ, iR, iPhi) != potentialSingleThread(iZ, iR, iPhi));
+        }
+      }
+    }
+    BOOST_CHECK_EQUAL(nDifferent, 0);
+  }
+  PoissonSolver<DataT>::setNThreads(nThreads);
+}
+
 BOOST_AUTO_TEST_CASE(PoissonSolver3D_test)
 {
   o2::tpc::MGParameters::isFull3D = true; // 3D
@@ -238,6 +275,12 @@ BOOST_AUTO_TEST_CASE(PoissonSolver3D2D_test)
   poissonSolver3D<DataT>();
 }
 
+BOOST_AUTO_TEST_CASE(PoissonSolver3D_threads_test)
+{
+  o2::tpc::MGParameters::isFull3D = true; // 3D
+  poissonSolver3DThreads<DataT>();
+}
+
 BOOST_AUTO_TEST_CASE(PoissonSolver2D_test)
 {
   poissonSolver2D<DataT>();
@@ -48,20 +48,21 @@ class TrapSimulator
          PLOTHITS = 2,
          PLOTTRACKLETS = 4 };
 
-  // Register for the ADC filters
+  // Registers for the ADC filters, one entry per ADC channel
+  // (kept as separate arrays, so that a filter stage runs over all channels of a timebin at once)
   struct FilterReg {
-    uint32_t mPedAcc;        // Accumulator for pedestal filter
-    uint32_t mGainCounterA;  // Counter for values above FGTA in the gain filter
-    uint32_t mGainCounterB;  // Counter for values above FGTB in the gain filter
-    uint16_t mTailAmplLong;  // Amplitude of the long component in the tail filter
-    uint16_t mTailAmplShort; // Amplitude of the short component in the tail filter
+    std::array<uint32_t, constants::NADCMCM> mPedAcc{};        // Accumulator for pedestal filter
+    std::array<uint32_t, constants::NADCMCM> mGainCounterA{};  // Counter for values above FGTA in the gain filter
+    std::array<uint32_t, constants::NADCMCM> mGainCounterB{};  // Counter for values above FGTB in the gain filter
+    std::array<uint16_t, constants::NADCMCM> mTailAmplLong{};  // Amplitude of the long component in the tail filter
+    std::array<uint16_t, constants::NADCMCM> mTailAmplShort{}; // Amplitude of the short component in the tail filter
     void ClearReg()
     {
-      mPedAcc = 0;
-      mGainCounterA = 0;
-      mGainCounterB = 0;
-      mTailAmplLong = 0;
-      mTailAmplShort = 0;
+      mPedAcc.fill(0);
+      mGainCounterA.fill(0);
+      mGainCounterB.fill(0);
+      mTailAmplLong.fill(0);
+      mTailAmplShort.fill(0);
     };
   };
 
@@ -117,9 +118,9 @@ class TrapSimulator
   void noiseTest(int nsamples, int mean, int sigma, int inputGain = 1, int inputTail = 2);
 
   // get unfiltered ADC data
-  int getDataRaw(int iadc, int timebin) const { return mADCR[iadc * mNTimeBin + timebin]; }
+  int getDataRaw(int iadc, int timebin) const { return mADCR[timebin * constants::NADCMCM + iadc]; }
   // get filtered ADC data
-  int getDataFiltered(int iadc, int timebin) const { return mADCF[iadc * mNTimeBin + timebin]; }
+  int getDataFiltered(int iadc, int timebin) const { return mADCF[timebin * constants::NADCMCM + iadc]; }
   int getZeroSupressionMap(int iadc) const { return (mZSMap[iadc]); }
   bool isDataSet() { return mDataIsSet; };
   // set ADC data with array
@@ -260,8 +261,8 @@ class TrapSimulator
   int mEmptyHPID24{mEmptyHPID8 | (mEmptyHPID8 << 8) | (mEmptyHPID8 << 16)}; ///< 0xffffff
 
   //TODO adcr adcf labels zerosupressionmap can all go into their own class. Refactor when stable.
-  std::vector<int> mADCR; // Array with MCM ADC values (Raw, 12 bit) 2d with dimension mNTimeBin
-  std::vector<int> mADCF; // Array with MCM ADC values (Filtered, 12 bit) 2d with dimension mNTimeBin
+  std::vector<int> mADCR; // Array with MCM ADC values (Raw, 12 bit) 2d with dimension mNTimeBin x NADCMCM, channels of one timebin are contiguous
+  std::vector<int> mADCF; // Array with MCM ADC values (Filtered, 12 bit) 2d with dimension mNTimeBin x NADCMCM, channels of one timebin are contiguous
   std::array<int, constants::NADCMCM> mADCDigitIndices{}; // indices of the incoming digits, used to relate the tracklets to labels in TRDTrapSimulatorSpec
   std::array<uint32_t, 4> mMCMT;                          // tracklet words for one mcm/trap-chip (one word for each cpu)
   std::vector<Tracklet64> mTrackletArray64; // Array of 64 bit tracklets
@@ -271,12 +272,38 @@ class TrapSimulator
 
   std::array<int, constants::NCPU> mFitPtr{};       // pointer to the tracklet to be calculated by CPU i
   std::array<FitReg, constants::NADCMCM> mFitReg{}; // Fit register for each ADC channel
-  std::array<FilterReg, constants::NADCMCM> mInternalFilterRegisters;
+  FilterReg mInternalFilterRegisters;               // Filter registers for all ADC channels
+
+  // TRAP registers needed for every sample, read from TrapConfig in init() for the current MCM
+  int mRegFPNP{0};                               //! pedestal at the output of the pedestal filter
+  int mRegFPTC{0};                               //! time constant of the pedestal filter
+  int mRegFPBY{0};                               //! bypass of the pedestal filter, active low
+  int mRegFGBY{0};                               //! bypass of the gain filter, active low
+  int mRegFGTA{0};                               //! threshold A of the gain filter
+  int mRegFGTB{0};                               //! threshold B of the gain filter
+  std::array<int, constants::NADCMCM> mRegFGF{}; //! gain correction factors FGF0..FGF20
+  std::array<int, constants::NADCMCM> mRegFGA{}; //! additive gain corrections FGA0..FGA20
+  int mRegFTAL{0};                               //! weight of the long component of the tail filter
+  int mRegFTLL{0};                               //! multiplier of the long component of the tail filter
+  int mRegFTLS{0};                               //! multiplier of the short component of the tail filter
+  int mRegFTBY{0};                               //! bypass of the tail filter, active low
+  int mRegEBIS{0};                               //! zero suppression threshold for the central channel
+  int mRegEBIT{0};                               //! zero suppression threshold for the cluster sum
+  int mRegEBIL{0};                               //! zero suppression look-up table
+  int mRegEBIN{0};                               //! zero suppression neighbour sensitivity, active low
+  int mRegTPFP{0};                               //! pedestal of the filtered data
+  int mRegTPHT{0};                               //! hit threshold for the cluster charge
+  int mRegTPVT{0};                               //! threshold of the cluster verification
+  int mRegTPVBY{0};                              //! bypass of the cluster verification, active low
+  std::array<int, 128> mRegTPL{};                //! position correction LUT TPL00..TPL7F
 
   // Parameter classes
   FeeParam* mFeeParam{FeeParam::instance()}; // FEE parameters, a singleton
   TrapConfig* mTrapConfig{nullptr};          // TRAP config
 
+  // Read the TRAP registers needed for every sample for the current MCM from TrapConfig
+  void loadTrapRegisters();
+
   // Sort functions as in TRAP
   void sort2(uint16_t idx1i, uint16_t idx2i, uint16_t val1i, uint16_t val2i,
              uint16_t* idx1o, uint16_t* idx2o, uint16_t* val1o, uint16_t* val2o) const;
@@ -35,6 +35,7 @@
 #include "TRandom.h"
 #include "TFile.h"
 
+#include <algorithm>
 #include <iomanip>
 
 using namespace o2::trd;
@@ -70,11 +71,46 @@ void TrapSimulator::init(TrapConfig* trapconfig, int det, int robPos, int mcmPos
     mADCR.resize(mNTimeBin * NADCMCM);
     mADCF.resize(mNTimeBin * NADCMCM);
   }
+  loadTrapRegisters();
 
   mInitialized = true;
   reset();
 }
 
+void TrapSimulator::loadTrapRegisters()
+{
+  // The filters, the zero suppression and the hit detection need a few TRAP registers
+  // for every sample. They are looked up once per MCM here instead.
+
+  auto reg = [this](TrapConfig::TrapReg_t r) { return mTrapConfig->getTrapReg(r, mDetector, mRobPos, mMcmPos); };
+
+  mRegFPNP = reg(TrapConfig::kFPNP);
+  mRegFPTC = reg(TrapConfig::kFPTC);
+  mRegFPBY = reg(TrapConfig::kFPBY);
+  mRegFGBY = reg(TrapConfig::kFGBY);
+  mRegFGTA = reg(TrapConfig::kFGTA);
+  mRegFGTB = reg(TrapConfig::kFGTB);
+  for (int adc = 0; adc < NADCMCM; adc++) {
+    mRegFGF[adc] = reg(TrapConfig::TrapReg_t(TrapConfig::kFGF0 + adc));
+    mRegFGA[adc] = reg(TrapConfig::TrapReg_t(TrapConfig::kFGA0 + adc));
+  }
+  mRegFTAL = reg(TrapConfig::kFTAL);
+  mRegFTLL = reg(TrapConfig::kFTLL);
+  mRegFTLS = reg(TrapConfig::kFTLS);
+  mRegFTBY = reg(TrapConfig::kFTBY);
+  mRegEBIS = reg(TrapConfig::kEBIS);
+  mRegEBIT = reg(TrapConfig::kEBIT);
+  mRegEBIL = reg(TrapConfig::kEBIL);
+  mRegEBIN = reg(TrapConfig::kEBIN);
+  mRegTPFP = reg(TrapConfig::kTPFP);
+  mRegTPHT = reg(TrapConfig::kTPHT);
+  mRegTPVT = reg(TrapConfig::kTPVT);
+  mRegTPVBY = reg(TrapConfig::kTPVBY);
+  for (int i = 0; i < (int)mRegTPL.size(); i++) {
+    mRegTPL[i] = reg(TrapConfig::TrapReg_t(TrapConfig::kTPL00 + i));
+  }
+}
+
 void TrapSimulator::reset()
 {
   // Resets the data values and internal filter registers
@@ -89,9 +125,7 @@ void TrapSimulator::reset()
   std::fill(mADCF.begin(), mADCF.end(), 0);
   std::fill(mADCDigitIndices.begin(), mADCDigitIndices.end(), -1);
 
-  for (auto filterreg : mInternalFilterRegisters) {
-    filterreg.ClearReg();
-  }
+  mInternalFilterRegisters.ClearReg();
 
   // Default unread, low active bit mask
   std::fill(mZSMap.begin(), mZSMap.end(), 0);
@@ -380,7 +414,7 @@ void TrapSimulator::printAdcDatXml(ostream& os) const
   for (int iChannel = 0; iChannel < NADCMCM; iChannel++) {
     os << "   <ch chnr=\"" << iChannel << "\">" << std::endl;
     for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
-      os << "<tb>" << mADCF[iChannel * mNTimeBin + iTimeBin] / 4 << "</tb>";
+      os << "<tb>" << mADCF[iTimeBin * NADCMCM + iChannel] / 4 << "</tb>";
     }
     os << "   </ch>" << std::endl;
   }
@@ -606,14 +640,14 @@ void TrapSimulator::draw(int choice, int index)
   if ((choice & PLOTRAW) != 0) {
     for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
       for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
-        hist->SetBinContent(iAdc + 1, iTimeBin + 1, mADCR[iAdc * mNTimeBin + iTimeBin] >> mgkAddDigits);
+        hist->SetBinContent(iAdc + 1, iTimeBin + 1, mADCR[iTimeBin * NADCMCM + iAdc] >> mgkAddDigits);
       }
     }
     hist->Draw("COLZ");
   } else {
     for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
       for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
-        histfiltered->SetBinContent(iAdc + 1, iTimeBin + 1, mADCF[iAdc * mNTimeBin + iTimeBin] >> mgkAddDigits);
+        histfiltered->SetBinContent(iAdc + 1, iTimeBin + 1, mADCF[iTimeBin * NADCMCM + iAdc] >> mgkAddDigits);
       }
     }
     histfiltered->Draw("COLZ");
@@ -670,8 +704,8 @@ void TrapSimulator::setData(int adc, const ArrayADC& data, unsigned int digitIdx
   }
 
   for (int it = 0; it < mNTimeBin; it++) {
-    mADCR[adc * mNTimeBin + it] = (data[it] << mgkAddDigits) + (mAdditionalBaseline << mgkAddDigits);
-    mADCF[adc * mNTimeBin + it] = (data[it] << mgkAddDigits) + (mAdditionalBaseline << mgkAddDigits);
+    mADCR[it * NADCMCM + adc] = (data[it] << mgkAddDigits) + (mAdditionalBaseline << mgkAddDigits);
+    mADCF[it * NADCMCM + adc] = (data[it] << mgkAddDigits) + (mAdditionalBaseline << mgkAddDigits);
   }
   mDataIsSet = true;
   mADCFilled |= (1 << adc);
@@ -696,8 +730,8 @@ void TrapSimulator::setBaselines()
     if ((mADCFilled & (1 << adc)) == 0) { // adc is empty by construction of mADCFilled.
       for (int timebin = 0; timebin < mNTimeBin; timebin++) {
         // kFPNP = 32 = 8 << 2 (pedestal correction additive) and kTPFP = 40 = 10 << 2 (filtered pedestal)
-        mADCR[adc * mNTimeBin + timebin] = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos); // OS: not using FPNP here, since in filter() the ADC values from the 'raw' array will be copied into the filtered array
-        mADCF[adc * mNTimeBin + timebin] = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos);
+        mADCR[timebin * NADCMCM + adc] = mRegTPFP; // OS: not using FPNP here, since in filter() the ADC values from the 'raw' array will be copied into the filtered array
+        mADCF[timebin * NADCMCM + adc] = mRegTPFP;
       }
     }
   }
@@ -718,8 +752,8 @@ void TrapSimulator::setDataPedestal(int adc)
   }
 
   for (int it = 0; it < mNTimeBin; it++) {
-    mADCR[adc * mNTimeBin + it] = mTrapConfig->getTrapReg(TrapConfig::kFPNP, mDetector, mRobPos, mMcmPos);
-    mADCF[adc * mNTimeBin + it] = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos);
+    mADCR[it * NADCMCM + adc] = mRegFPNP;
+    mADCF[it * NADCMCM + adc] = mRegTPFP;
   }
 }
 
@@ -845,10 +879,10 @@ void TrapSimulator::filterPedestalInit(int baseline)
   // been constant for a long time (compared to the time constant).
   //  LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
 
-  unsigned short fptc = mTrapConfig->getTrapReg(TrapConfig::kFPTC, mDetector, mRobPos, mMcmPos); // 0..3, 0 - fastest, 3 - slowest
+  unsigned short fptc = mRegFPTC; // 0..3, 0 - fastest, 3 - slowest
 
   for (int adc = 0; adc < NADCMCM; adc++) {
-    mInternalFilterRegisters[adc].mPedAcc = (baseline << 2) * (1 << mgkFPshifts[fptc]);
+    mInternalFilterRegisters.mPedAcc[adc] = (baseline << 2) * (1 << mgkFPshifts[fptc]);
   }
   //  LOG(debug) << "LEAVE: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
 }
@@ -860,20 +894,20 @@ unsigned short TrapSimulator::filterPedestalNextSample(int adc, int timebin, uns
   // history of the filter.
   LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__;
 
-  unsigned short fpnp = mTrapConfig->getTrapReg(TrapConfig::kFPNP, mDetector, mRobPos, mMcmPos); // 0..511 -> 0..127.75, pedestal at the output
-  unsigned short fptc = mTrapConfig->getTrapReg(TrapConfig::kFPTC, mDetector, mRobPos, mMcmPos); // 0..3, 0 - fastest, 3 - slowest
-  unsigned short fpby = mTrapConfig->getTrapReg(TrapConfig::kFPBY, mDetector, mRobPos, mMcmPos); // 0..1 bypass, active low
+  unsigned short fpnp = mRegFPNP; // 0..511 -> 0..127.75, pedestal at the output
+  unsigned short fptc = mRegFPTC; // 0..3, 0 - fastest, 3 - slowest
+  unsigned short fpby = mRegFPBY; // 0..1 bypass, active low
 
   unsigned short accumulatorShifted;
   unsigned short inpAdd;
 
   inpAdd = value + fpnp;
 
-  accumulatorShifted = (mInternalFilterRegisters[adc].mPedAcc >> mgkFPshifts[fptc]) & 0x3FF; // 10 bits
+  accumulatorShifted = (mInternalFilterRegisters.mPedAcc[adc] >> mgkFPshifts[fptc]) & 0x3FF; // 10 bits
   if (timebin == 0)                                                                          // the accumulator is disabled in the drift time
   {
     int correction = (value & 0x3FF) - accumulatorShifted;
-    mInternalFilterRegisters[adc].mPedAcc = (mInternalFilterRegisters[adc].mPedAcc + correction) & 0x7FFFFFFF; // 31 bits
+    mInternalFilterRegisters.mPedAcc[adc] = (mInternalFilterRegisters.mPedAcc[adc] + correction) & 0x7FFFFFFF; // 31 bits
   }
 
   if (fpby == 0) {
@@ -905,16 +939,30 @@ void TrapSimulator::filterPedestal()
   // It has only an effect if previous samples have been fed to
   // find the pedestal. Currently, the simulation assumes that
   // the input has been stable for a sufficiently long time.
-  // LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
+  // The output is the input as long as the bypass is hard-coded in filterPedestalNextSample(),
+  // only the accumulators are updated with the first timebin. This is done for all channels
+  // at once, the result is the same as feeding the samples one by one to filterPedestalNextSample().
 
-  for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
-    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
-      int oldadc = mADCF[iAdc * mNTimeBin + iTimeBin];
-      mADCF[iAdc * mNTimeBin + iTimeBin] = filterPedestalNextSample(iAdc, iTimeBin, mADCR[iAdc * mNTimeBin + iTimeBin]);
-      //    LOG(debug) << "mADCF : time : " << iTimeBin << " adc : " << iAdc << " change : " << oldadc << " -> " << mADCF[iAdc * mNTimeBin + iTimeBin];
-    }
+  if (mNTimeBin <= 0) {
+    return;
+  }
+  auto& pedAcc = mInternalFilterRegisters.mPedAcc;
+  const unsigned short fpShift = mgkFPshifts[(unsigned short)mRegFPTC];
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    unsigned short value = mADCR[iAdc];
+    unsigned short accumulatorShifted = (pedAcc[iAdc] >> fpShift) & 0x3FF; // 10 bits
+    int correction = (value & 0x3FF) - accumulatorShifted;
+    pedAcc[iAdc] = (pedAcc[iAdc] + correction) & 0x7FFFFFFF; // 31 bits
+  }
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+  for (int i = 0; i < mNTimeBin * NADCMCM; i++) {
+    mADCF[i] = (unsigned short)mADCR[i];
   }
-  // LOG(debug) << "BEGIN: " << __FILE__ << ":" << __func__ << ":" << __LINE__ ;
 }
 
 void TrapSimulator::filterGainInit()
@@ -925,8 +973,8 @@ void TrapSimulator::filterGainInit()
   for (int adc = 0; adc < NADCMCM; adc++) {
     // these are counters which in hardware continue
     // until maximum or reset
-    mInternalFilterRegisters[adc].mGainCounterA = 0;
-    mInternalFilterRegisters[adc].mGainCounterB = 0;
+    mInternalFilterRegisters.mGainCounterA[adc] = 0;
+    mInternalFilterRegisters.mGainCounterB[adc] = 0;
   }
 }
 
@@ -938,11 +986,11 @@ unsigned short TrapSimulator::filterGainNextSample(int adc, unsigned short value
   // history of the filter.
   //  if(mDetector==75&& mRobPos==5 && mMcmPos==15) LOG(debug) << "ENTER: " << __FILE__ << ":" << __func__ << ":" << __LINE__ << " with adc = " << adc << " value = " << value;
 
-  unsigned short mgby = mTrapConfig->getTrapReg(TrapConfig::kFGBY, mDetector, mRobPos, mMcmPos);                             // bypass, active low
-  unsigned short mgf = mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGF0 + adc), mDetector, mRobPos, mMcmPos); // 0x700 + (0 & 0x1ff);
-  unsigned short mga = mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGA0 + adc), mDetector, mRobPos, mMcmPos); // 40;
-  unsigned short mgta = mTrapConfig->getTrapReg(TrapConfig::kFGTA, mDetector, mRobPos, mMcmPos);                             // 20;
-  unsigned short mgtb = mTrapConfig->getTrapReg(TrapConfig::kFGTB, mDetector, mRobPos, mMcmPos);                             // 2060;
+  unsigned short mgby = mRegFGBY;    // bypass, active low
+  unsigned short mgf = mRegFGF[adc]; // 0x700 + (0 & 0x1ff);
+  unsigned short mga = mRegFGA[adc]; // 40;
+  unsigned short mgta = mRegFGTA;    // 20;
+  unsigned short mgtb = mRegFGTB;    // 2060;
   //  mgf=256;
   //  mga=8;
   //  mgta=20;
@@ -964,14 +1012,14 @@ unsigned short TrapSimulator::filterGainNextSample(int adc, unsigned short value
 
   // Update threshold counters
   // not really useful as they are cleared with every new event
-  if (!((mInternalFilterRegisters[adc].mGainCounterA == 0x3FFFFFF) || (mInternalFilterRegisters[adc].mGainCounterB == 0x3FFFFFF)))
+  if (!((mInternalFilterRegisters.mGainCounterA[adc] == 0x3FFFFFF) || (mInternalFilterRegisters.mGainCounterB[adc] == 0x3FFFFFF)))
   // stop when full
   {
     //  if(mDetector==75&& mRobPos==5 && mMcmPos==15) LOG(debug) <<__LINE__ <<  " adc = " << adc << " value = " << value << " corr  : " << corr  << " mgtb : " << mgtb;
     if (corr >= mgtb) {
-      mInternalFilterRegisters[adc].mGainCounterB++;
+      mInternalFilterRegisters.mGainCounterB[adc]++;
     } else if (corr >= mgta) {
-      mInternalFilterRegisters[adc].mGainCounterA++;
+      mInternalFilterRegisters.mGainCounterA[adc]++;
     }
   }
 
@@ -986,9 +1034,9 @@ void TrapSimulator::filterGain()
 {
   // Read data from mADCF and apply gain filter.
 
-  for (int adc = 0; adc < NADCMCM; adc++) {
-    for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
-      mADCF[adc * mNTimeBin + iTimeBin] = filterGainNextSample(adc, mADCF[adc * mNTimeBin + iTimeBin]);
+  for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
+    for (int adc = 0; adc < NADCMCM; adc++) {
+      mADCF[iTimeBin * NADCMCM + adc] = filterGainNextSample(adc, mADCF[iTimeBin * NADCMCM + adc]);
     }
   }
 }
@@ -1000,9 +1048,9 @@ void TrapSimulator::filterTailInit(int baseline)
   // sufficiently long time.
 
   // exponents and weight calculated from configuration
-  unsigned short alphaLong = 0x3ff & mTrapConfig->getTrapReg(TrapConfig::kFTAL, mDetector, mRobPos, mMcmPos);                            // the weight of the long component
-  unsigned short lambdaLong = (1 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLL, mDetector, mRobPos, mMcmPos) & 0x1FF);  // the multiplier
-  unsigned short lambdaShort = (0 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLS, mDetector, mRobPos, mMcmPos) & 0x1FF); // the multiplier
+  unsigned short alphaLong = 0x3ff & mRegFTAL;                            // the weight of the long component
+  unsigned short lambdaLong = (1 << 10) | (1 << 9) | (mRegFTLL & 0x1FF);  // the multiplier
+  unsigned short lambdaShort = (0 << 10) | (1 << 9) | (mRegFTLS & 0x1FF); // the multiplier
 
   float lambdaL = lambdaLong * 1.0 / (1 << 11);
   float lambdaS = lambdaShort * 1.0 / (1 << 11);
@@ -1015,7 +1063,7 @@ void TrapSimulator::filterTailInit(int baseline)
   float ql, qs;
 
   if (baseline < 0) {
-    baseline = mTrapConfig->getTrapReg(TrapConfig::kFPNP, mDetector, mRobPos, mMcmPos);
+    baseline = mRegFPNP;
   }
 
   ql = lambdaL * (1 - lambdaS) * alphaL;
@@ -1023,15 +1071,15 @@ void TrapSimulator::filterTailInit(int baseline)
 
   for (int adc = 0; adc < NADCMCM; adc++) {
     int value = baseline & 0xFFF;
-    int corr = (value * mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGF0 + adc), mDetector, mRobPos, mMcmPos)) >> 11;
+    int corr = (value * mRegFGF[adc]) >> 11;
     corr = corr > 0xfff ? 0xfff : corr;
-    corr = addUintClipping(corr, mTrapConfig->getTrapReg(TrapConfig::TrapReg_t(TrapConfig::kFGA0 + adc), mDetector, mRobPos, mMcmPos), 12);
+    corr = addUintClipping(corr, mRegFGA[adc], 12);
 
     float kt = kdc * baseline;
     unsigned short aout = baseline - (unsigned short)kt;
 
-    mInternalFilterRegisters[adc].mTailAmplLong = (unsigned short)(aout * ql / (ql + qs));
-    mInternalFilterRegisters[adc].mTailAmplShort = (unsigned short)(aout * qs / (ql + qs));
+    mInternalFilterRegisters.mTailAmplLong[adc] = (unsigned short)(aout * ql / (ql + qs));
+    mInternalFilterRegisters.mTailAmplShort[adc] = (unsigned short)(aout * qs / (ql + qs));
   }
 }
 
@@ -1042,9 +1090,9 @@ unsigned short TrapSimulator::filterTailNextSample(int adc, unsigned short value
   // history of the filter.
 
   // exponents and weight calculated from configuration
-  unsigned short alphaLong = 0x3ff & mTrapConfig->getTrapReg(TrapConfig::kFTAL, mDetector, mRobPos, mMcmPos);                            // the weight of the long component
-  unsigned short lambdaLong = (1 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLL, mDetector, mRobPos, mMcmPos) & 0x1FF);  // the multiplier of the long component
-  unsigned short lambdaShort = (0 << 10) | (1 << 9) | (mTrapConfig->getTrapReg(TrapConfig::kFTLS, mDetector, mRobPos, mMcmPos) & 0x1FF); // the multiplier of the short component
+  unsigned short alphaLong = 0x3ff & mRegFTAL;                            // the weight of the long component
+  unsigned short lambdaLong = (1 << 10) | (1 << 9) | (mRegFTLL & 0x1FF);  // the multiplier of the long component
+  unsigned short lambdaShort = (0 << 10) | (1 << 9) | (mRegFTLS & 0x1FF); // the multiplier of the short component
 
   // intermediate signals
   unsigned int aDiff;
@@ -1055,7 +1103,7 @@ unsigned short TrapSimulator::filterTailNextSample(int adc, unsigned short value
   unsigned short inpVolt = value & 0xFFF; // 12 bits
 
   // add the present generator outputs
-  aQ = addUintClipping(mInternalFilterRegisters[adc].mTailAmplLong, mInternalFilterRegisters[adc].mTailAmplShort, 12);
+  aQ = addUintClipping(mInternalFilterRegisters.mTailAmplLong[adc], mInternalFilterRegisters.mTailAmplShort[adc], 12);
 
   // calculate the difference between the input and the generated signal
   if (inpVolt > aQ) {
@@ -1069,16 +1117,16 @@ unsigned short TrapSimulator::filterTailNextSample(int adc, unsigned short value
 
   // the new values of the registers, used next time
   // long component
-  tmp = addUintClipping(mInternalFilterRegisters[adc].mTailAmplLong, alInpv, 12);
+  tmp = addUintClipping(mInternalFilterRegisters.mTailAmplLong[adc], alInpv, 12);
   tmp = (tmp * lambdaLong) >> 11;
-  mInternalFilterRegisters[adc].mTailAmplLong = tmp & 0xFFF;
+  mInternalFilterRegisters.mTailAmplLong[adc] = tmp & 0xFFF;
   // short component
-  tmp = addUintClipping(mInternalFilterRegisters[adc].mTailAmplShort, aDiff - alInpv, 12);
+  tmp = addUintClipping(mInternalFilterRegisters.mTailAmplShort[adc], aDiff - alInpv, 12);
   tmp = (tmp * lambdaShort) >> 11;
-  mInternalFilterRegisters[adc].mTailAmplShort = tmp & 0xFFF;
+  mInternalFilterRegisters.mTailAmplShort[adc] = tmp & 0xFFF;
 
   // the output of the filter
-  if (mTrapConfig->getTrapReg(TrapConfig::kFTBY, mDetector, mRobPos, mMcmPos) == 0) { // bypass mode, active low
+  if (mRegFTBY == 0) { // bypass mode, active low
     return value;
   } else {
     return aDiff;
@@ -1088,10 +1136,32 @@ unsigned short TrapSimulator::filterTailNextSample(int adc, unsigned short value
 void TrapSimulator::filterTail()
 {
   // Apply tail cancellation filter to all data.
+  // Same arithmetic as filterTailNextSample(), but applied to all channels of a timebin
+  // in one branch-free loop over the filter registers.
 
+  const unsigned int alphaLong = 0x3ff & mRegFTAL;                            // the weight of the long component
+  const unsigned int lambdaLong = (1 << 10) | (1 << 9) | (mRegFTLL & 0x1FF);  // the multiplier of the long component
+  const unsigned int lambdaShort = (0 << 10) | (1 << 9) | (mRegFTLS & 0x1FF); // the multiplier of the short component
+  const bool bypass = (mRegFTBY == 0);                                        // bypass mode, active low
+
+  auto& amplLong = mInternalFilterRegisters.mTailAmplLong;
+  auto& amplShort = mInternalFilterRegisters.mTailAmplShort;
   for (int iTimeBin = 0; iTimeBin < mNTimeBin; iTimeBin++) {
+    int* adcf = &mADCF[iTimeBin * NADCMCM];
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
     for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
-      mADCF[iAdc * mNTimeBin + iTimeBin] = filterTailNextSample(iAdc, mADCF[iAdc * mNTimeBin + iTimeBin]);
+      unsigned int value = (unsigned short)adcf[iAdc];
+      unsigned int inpVolt = value & 0xFFF; // 12 bits
+      unsigned int aL = amplLong[iAdc];
+      unsigned int aS = amplShort[iAdc];
+      unsigned int aQ = std::min(aL + aS, 0xFFFu);
+      unsigned int aDiff = inpVolt > aQ ? inpVolt - aQ : 0;
+      unsigned int alInpv = (aDiff * alphaLong) >> 11;
+      amplLong[iAdc] = ((std::min(aL + alInpv, 0xFFFu) * lambdaLong) >> 11) & 0xFFF;
+      amplShort[iAdc] = ((std::min(aS + aDiff - alInpv, 0xFFFu) * lambdaShort) >> 11) & 0xFFF;
+      adcf[iAdc] = bypass ? value : aDiff;
     }
   }
 }
@@ -1110,78 +1180,55 @@ void TrapSimulator::zeroSupressionMapping()
     return;
   }
 
-  int eBIS = mTrapConfig->getTrapReg(TrapConfig::kEBIS, mDetector, mRobPos, mMcmPos);
-  int eBIT = mTrapConfig->getTrapReg(TrapConfig::kEBIT, mDetector, mRobPos, mMcmPos);
-  int eBIL = mTrapConfig->getTrapReg(TrapConfig::kEBIL, mDetector, mRobPos, mMcmPos);
-  int eBIN = mTrapConfig->getTrapReg(TrapConfig::kEBIN, mDetector, mRobPos, mMcmPos);
-
-  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
-    mZSMap[iAdc] = -1;
-  }
+  const int eBIS = mRegEBIS;
+  const int eBIT = mRegEBIT;
+  const int eBIL = mRegEBIL;
+  const int neighbours = (mRegEBIN == 0); // neighbour sensitivity, active low
 
+  // The channels of one timebin are handled together: first the suppression flag of every
+  // channel is computed from its neighbours (channels outside of the MCM count as 0),
+  // then the flags are merged into the (low active) map.
+  std::array<int, NADCMCM> unsuppressed{}; // bit pattern of the timebins in which a channel is read out
   for (int it = 0; it < mNTimeBin; it++) {
-    int iAdc; // current ADC channel
-    int ap;
-    int ac;
-    int an;
-    int mask;
-    int supp; // suppression of the current channel (low active)
-
-    // ----- first channel -----
-    iAdc = 0;
-
-    ap = 0 >> mgkAddDigits;                                  // previous
-    ac = mADCF[iAdc * mNTimeBin + it] >> mgkAddDigits;       // current
-    an = mADCF[(iAdc + 1) * mNTimeBin + it] >> mgkAddDigits; // next
-
-    mask = (ac >= ap && ac >= an) ? 0 : 0x1; // peak center detection
-    mask += (ap + ac + an > eBIT) ? 0 : 0x2; // cluster
-    mask += (ac > eBIS) ? 0 : 0x4;           // absolute large peak
-
-    supp = (eBIL >> mask) & 1;
-
-    mZSMap[iAdc] &= ~((1 - supp) << it);
-    if (eBIN == 0) { // neighbour sensitivity
-      mZSMap[iAdc + 1] &= ~((1 - supp) << it);
+    std::array<int, NADCMCM + 2> adc{};
+    std::array<int, NADCMCM + 2> hit{};
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+      adc[iAdc + 1] = mADCF[it * NADCMCM + iAdc] >> mgkAddDigits;
     }
-
-    // ----- last channel -----
-    iAdc = NADCMCM - 1;
-
-    ap = mADCF[(iAdc - 1) * mNTimeBin + it] >> mgkAddDigits; // previous
-    ac = mADCF[iAdc * mNTimeBin + it] >> mgkAddDigits;       // current
-    an = 0 >> mgkAddDigits;                                  // next
-
-    mask = (ac >= ap && ac >= an) ? 0 : 0x1; // peak center detection
-    mask += (ap + ac + an > eBIT) ? 0 : 0x2; // cluster
-    mask += (ac > eBIS) ? 0 : 0x4;           // absolute large peak
-
-    supp = (eBIL >> mask) & 1;
-
-    mZSMap[iAdc] &= ~((1 - supp) << it);
-    if (eBIN == 0) { // neighbour sensitivity
-      mZSMap[iAdc - 1] &= ~((1 - supp) << it);
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+      int ap = adc[iAdc];     // previous
+      int ac = adc[iAdc + 1]; // current
+      int an = adc[iAdc + 2]; // next
+
+      int noPeak = (ac < ap) | (ac < an);     // peak center detection
+      int noCluster = (ap + ac + an <= eBIT); // cluster
+      int noLargePeak = (ac <= eBIS);         // absolute large peak
+
+      // supp = (eBIL >> mask) & 1 with mask = noPeak | noCluster << 1 | noLargePeak << 2,
+      // shifting in three steps avoids a shift by a different amount in each channel
+      int lut = eBIL;
+      lut = noPeak ? lut >> 1 : lut;
+      lut = noCluster ? lut >> 2 : lut;
+      lut = noLargePeak ? lut >> 4 : lut;
+      hit[iAdc + 1] = 1 - (lut & 1); // supp is low active
     }
-
-    // ----- middle channels -----
-    for (iAdc = 1; iAdc < NADCMCM - 1; iAdc++) {
-      ap = mADCF[(iAdc - 1) * mNTimeBin + it] >> mgkAddDigits; // previous
-      ac = mADCF[iAdc * mNTimeBin + it] >> mgkAddDigits;       // current
-      an = mADCF[(iAdc + 1) * mNTimeBin + it] >> mgkAddDigits; // next
-
-      mask = (ac >= ap && ac >= an) ? 0 : 0x1; // peak center detection
-      mask += (ap + ac + an > eBIT) ? 0 : 0x2; // cluster
-      mask += (ac > eBIS) ? 0 : 0x4;           // absolute large peak
-
-      supp = (eBIL >> mask) & 1;
-
-      mZSMap[iAdc] &= ~((1 - supp) << it);
-      if (eBIN == 0) { // neighbour sensitivity
-        mZSMap[iAdc - 1] &= ~((1 - supp) << it);
-        mZSMap[iAdc + 1] &= ~((1 - supp) << it);
-      }
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+      int readout = hit[iAdc + 1] | (neighbours & (hit[iAdc] | hit[iAdc + 2]));
+      unsuppressed[iAdc] |= readout << it;
     }
   }
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    mZSMap[iAdc] = ~unsuppressed[iAdc];
+  }
 }
 
 void TrapSimulator::addHitToFitreg(int adc, unsigned short timebin, unsigned short qtot, short ypos)
@@ -1260,37 +1307,24 @@ void TrapSimulator::calcFitreg()
   for (unsigned int timebin = timebin1; timebin < timebin2; timebin++) {
     // first find the hit candidates and store the total cluster charge in qTotal array
     // in case of not hit store 0 there.
+    // the candidates of all channels are checked at once on the contiguous ADC values of the timebin
     std::array<unsigned short, 20> qTotal{}; //[19 + 1]; // the last is dummy
-    int adcLeft, adcCentral, adcRight;
+    const int* adcRow = &mADCF[timebin * NADCMCM];
+    const bool verifyCluster = (mRegTPVBY != 0); // bypass the cluster verification, active low
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
     for (int adcch = 0; adcch < NADCMCM - 2; adcch++) {
-      adcLeft = mADCF[adcch * mNTimeBin + timebin];
-      adcCentral = mADCF[(adcch + 1) * mNTimeBin + timebin];
-      adcRight = mADCF[(adcch + 2) * mNTimeBin + timebin];
-      bool hitQual = false;
-      if (mTrapConfig->getTrapReg(TrapConfig::kTPVBY, mDetector, mRobPos, mMcmPos) == 0) {
-        // bypass the cluster verification
-        hitQual = true;
-      } else {
-        hitQual = ((adcLeft * adcRight) <
-                   ((mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos) * adcCentral * adcCentral) >> 10));
-        if (hitQual) {
-          LOG(debug) << "cluster quality cut passed with " << adcLeft << ", " << adcCentral << ", "
-                     << adcRight << " - threshold " << mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos)
-                     << " -> " << mTrapConfig->getTrapReg(TrapConfig::kTPVT, mDetector, mRobPos, mMcmPos) * adcCentral * adcCentral;
-        }
-      }
+      int adcLeft = adcRow[adcch];
+      int adcCentral = adcRow[adcch + 1];
+      int adcRight = adcRow[adcch + 2];
+      bool hitQual = !verifyCluster | ((adcLeft * adcRight) < ((mRegTPVT * adcCentral * adcCentral) >> 10));
 
       // The accumulated charge is with the pedestal!!!
       int qtotTemp = adcLeft + adcCentral + adcRight;
 
-      if ((hitQual) &&
-          (qtotTemp >= mTrapConfig->getTrapReg(TrapConfig::kTPHT, mDetector, mRobPos, mMcmPos)) &&
-          (adcLeft <= adcCentral) &&
-          (adcCentral > adcRight)) {
-        qTotal[adcch] = qtotTemp;
-      } else {
-        qTotal[adcch] = 0;
-      }
+      bool isHit = hitQual & (qtotTemp >= mRegTPHT) & (adcLeft <= adcCentral) & (adcCentral > adcRight);
+      qTotal[adcch] = isHit ? qtotTemp : 0;
     }
 
     short fromLeft = -1;
@@ -1366,17 +1400,17 @@ void TrapSimulator::calcFitreg()
     for (adcch = 0; adcch < 19; adcch++) {
       if (qTotal[adcch] > 0) // the channel is marked for processing
       {
-        adcLeft = mADCF[adcch * mNTimeBin + timebin];
-        adcCentral = mADCF[(adcch + 1) * mNTimeBin + timebin];
-        adcRight = mADCF[(adcch + 2) * mNTimeBin + timebin];
+        int adcLeft = adcRow[adcch];
+        int adcCentral = adcRow[adcch + 1];
+        int adcRight = adcRow[adcch + 2];
         LOGF(debug, "ch(%i): left(%i), central(%i), right(%i)", adcch, adcLeft, adcCentral, adcRight);
         //  hit detected, in TRAP we have 4 units and a hit-selection, here we proceed all channels!
         //  subtract the pedestal TPFP, clipping instead of wrapping
 
-        int regTPFP = mTrapConfig->getTrapReg(TrapConfig::kTPFP, mDetector, mRobPos, mMcmPos); //TODO put this together with the others as members of trapsim, which is initiliased by det,rob,mcm.
+        int regTPFP = mRegTPFP;
         LOG(debug) << "Hit found, time=" << timebin << ", adcch=" << adcch << "/" << adcch + 1 << "/"
                    << adcch + 2 << ", adc values=" << adcLeft << "/" << adcCentral << "/"
-                   << adcRight << ", regTPFP=" << regTPFP << ", TPHT=" << mTrapConfig->getTrapReg(TrapConfig::kTPHT, mDetector, mRobPos, mMcmPos);
+                   << adcRight << ", regTPFP=" << regTPFP << ", TPHT=" << mRegTPHT;
         // regTPFP >>= 2; // OS: this line should be commented out when checking real data. It's only needed for comparison with Venelin's simulation if in addition mgkAddDigits == 0
         if (adcLeft < regTPFP) {
           adcLeft = 0;
@@ -1408,8 +1442,7 @@ void TrapSimulator::calcFitreg()
         //  make the correction using the position LUT
         // LOG(info) << "ypos raw is " << ypos << "  adcrigh-adcleft/adccentral " << adcRight << "-" << adcLeft << "/" << adcCentral << "==" << (adcRight - adcLeft) / adcCentral << " 128 * numerator : " << 128 * (adcRight - adcLeft) / adcCentral;
         // LOG(info) << "ypos before lut correction : " << ypos;
-        ypos = ypos + mTrapConfig->getTrapReg((TrapConfig::TrapReg_t)(TrapConfig::kTPL00 + (ypos & 0x7F)),
-                                              mDetector, mRobPos, mMcmPos);
+        ypos = ypos + mRegTPL[ypos & 0x7F];
         // ypos += LUT_POS[ypos & 0x7f]; // FIXME use this LUT to obtain the same results as Venelin
         //   LOG(info) << "ypos after lut correction : " << ypos;
         if (adcLeft > adcRight) {
@@ -0,0 +1,161 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// Processing time of the TRAP simulation per MCM: the filter chain applied to all
+/// channels of the MCM (filter()) compared with feeding the samples one by one to the
+/// filters, the zero suppression and the full chain including the tracklet calculation.
+/// The argument selects bypassed (0) or active (1) tail filter and cluster verification.
+
+#include <benchmark/benchmark.h>
+#include "DataFormatsTRD/Constants.h"
+#include "TRDSimulation/TrapConfig.h"
+#include "TRDSimulation/TrapSimulator.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace o2::trd;
+using namespace o2::trd::constants;
+
+namespace
+{
+constexpr int NMCMS = 256;
+
+/// ADC data of a few MCMs with 1-3 tracks each on top of the pedestal
+const std::vector<std::array<ArrayADC, NADCMCM>>& mcmData()
+{
+  static std::vector<std::array<ArrayADC, NADCMCM>> data = [] {
+    std::vector<std::array<ArrayADC, NADCMCM>> res(NMCMS);
+    std::mt19937 gen(12345);
+    std::normal_distribution<float> noise(10.f, 1.5f);
+    std::uniform_real_distribution<float> uni(0.f, 1.f);
+    for (auto& mcm : res) {
+      int nTracks = 1 + gen() % 3;
+      std::array<float, 3> pos{}, slope{}, amp{};
+      for (int iTrk = 0; iTrk < nTracks; iTrk++) {
+        pos[iTrk] = 1.f + 18.f * uni(gen);
+        slope[iTrk] = 0.3f * (uni(gen) - 0.5f);
+        amp[iTrk] = 50.f + 600.f * uni(gen);
+      }
+      for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+        for (int iTb = 0; iTb < TIMEBINS; iTb++) {
+          float value = noise(gen);
+          for (int iTrk = 0; iTrk < nTracks; iTrk++) {
+            float dist = iAdc - pos[iTrk] - slope[iTrk] * iTb;
+            value += amp[iTrk] * (iTb < 2 ? 0.3f : std::exp(-(iTb - 2) / 25.f)) * std::exp(-dist * dist / 0.8f);
+          }
+          mcm[iAdc][iTb] = std::clamp((int)value, 0, 1023);
+        }
+      }
+    }
+    return res;
+  }();
+  return data;
+}
+
+void configureTrap(TrapConfig& cfg, bool activeFilters)
+{
+  cfg.setTrapReg(TrapConfig::kC13CPUA, TIMEBINS, 0);
+  if (activeFilters) {
+    cfg.setTrapReg(TrapConfig::kFTBY, 1, 0);
+    cfg.setTrapReg(TrapConfig::kTPVBY, 1, 0);
+    cfg.setTrapReg(TrapConfig::kTPVT, 20, 0);
+  }
+}
+
+void loadMcm(TrapSimulator& sim, TrapConfig& cfg, int iMcm)
+{
+  sim.init(&cfg, iMcm % MAXCHAMBER, iMcm % NROBC1, iMcm % NMCMROB);
+  const auto& data = mcmData()[iMcm];
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    sim.setData(iAdc, data[iAdc], iAdc);
+  }
+}
+} // namespace
+
+static void BM_FilterSingleSamples(benchmark::State& state)
+{
+  TrapConfig cfg;
+  configureTrap(cfg, state.range(0));
+  TrapSimulator sim;
+  for (auto _ : state) {
+    for (int iMcm = 0; iMcm < NMCMS; iMcm++) {
+      loadMcm(sim, cfg, iMcm);
+      int sum = 0;
+      for (int iTb = 0; iTb < TIMEBINS; iTb++) {
+        for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+          sum += sim.filterTailNextSample(iAdc, sim.filterPedestalNextSample(iAdc, iTb, sim.getDataRaw(iAdc, iTb)));
+        }
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NMCMS);
+}
+
+static void BM_Filter(benchmark::State& state)
+{
+  TrapConfig cfg;
+  configureTrap(cfg, state.range(0));
+  TrapSimulator sim;
+  for (auto _ : state) {
+    for (int iMcm = 0; iMcm < NMCMS; iMcm++) {
+      loadMcm(sim, cfg, iMcm);
+      sim.filter();
+      benchmark::DoNotOptimize(sim.getDataFiltered(0, 0));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NMCMS);
+}
+
+static void BM_FilterZeroSuppression(benchmark::State& state)
+{
+  TrapConfig cfg;
+  configureTrap(cfg, state.range(0));
+  TrapSimulator sim;
+  for (auto _ : state) {
+    for (int iMcm = 0; iMcm < NMCMS; iMcm++) {
+      loadMcm(sim, cfg, iMcm);
+      sim.filter();
+      sim.zeroSupressionMapping();
+      benchmark::DoNotOptimize(sim.getZeroSupressionMap(0));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NMCMS);
+}
+
+static void BM_FullChain(benchmark::State& state)
+{
+  TrapConfig cfg;
+  configureTrap(cfg, state.range(0));
+  TrapSimulator sim;
+  size_t nTracklets = 0;
+  for (auto _ : state) {
+    for (int iMcm = 0; iMcm < NMCMS; iMcm++) {
+      loadMcm(sim, cfg, iMcm);
+      sim.filter();
+      sim.zeroSupressionMapping();
+      sim.tracklet();
+      nTracklets += sim.getTrackletArray64().size();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NMCMS);
+  state.counters["tracklets/MCM"] = double(nTracklets) / (state.iterations() * NMCMS);
+}
+
+BENCHMARK(BM_FilterSingleSamples)->Arg(0)->Arg(1);
+BENCHMARK(BM_Filter)->Arg(0)->Arg(1);
+BENCHMARK(BM_FilterZeroSuppression)->Arg(0)->Arg(1);
+BENCHMARK(BM_FullChain)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
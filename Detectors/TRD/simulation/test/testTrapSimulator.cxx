@@ -0,0 +1,219 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test TRD TrapSimulator
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "DataFormatsTRD/Constants.h"
+#include "TRDSimulation/TrapConfig.h"
+#include "TRDSimulation/TrapSimulator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+
+namespace o2
+{
+namespace trd
+{
+
+using namespace o2::trd::constants;
+
+// ADC data of one MCM with a few tracks on top of the pedestal. Only integer arithmetic
+// on std::mt19937 is used, so that the data (and the reference values below) do not depend
+// on the platform.
+struct McmData {
+  int det, rob, mcm;
+  std::array<ArrayADC, NADCMCM> adc{};
+  std::array<bool, NADCMCM> filled{};
+};
+
+McmData generateMcm(std::mt19937& gen, int iMcm)
+{
+  static constexpr std::array<int, 9> padResponse{100, 92, 73, 50, 29, 14, 6, 2, 1}; // in %, vs distance in 1/4 pads
+
+  McmData data;
+  data.det = iMcm % MAXCHAMBER;
+  data.rob = iMcm % NROBC1;
+  data.mcm = iMcm % NMCMROB;
+  int nTracks = 1 + gen() % 3;
+  std::array<int, 3> pos{}, slope{}, amp{};
+  for (int iTrk = 0; iTrk < nTracks; iTrk++) {
+    pos[iTrk] = 4 + gen() % 72; // in 1/4 pads
+    slope[iTrk] = gen() % 9;    // in 1/4 pads per 8 timebins
+    slope[iTrk] -= 4;
+    amp[iTrk] = 50 + gen() % 600; // ADC counts
+  }
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    data.filled[iAdc] = (gen() % 100) < 85;
+    int shape = 100; // time response in %
+    for (int iTb = 0; iTb < TIMEBINS; iTb++) {
+      int value = 8 + gen() % 5;
+      for (int iTrk = 0; iTrk < nTracks; iTrk++) {
+        int dist = std::abs(4 * iAdc - pos[iTrk] - slope[iTrk] * iTb / 8);
+        if (dist < (int)padResponse.size()) {
+          value += amp[iTrk] * (iTb < 2 ? 30 : shape) / 100 * padResponse[dist] / 100;
+        }
+      }
+      if (iTb >= 2) {
+        shape = shape * 24 / 25;
+      }
+      data.adc[iAdc][iTb] = std::min(value, 1023);
+    }
+  }
+  return data;
+}
+
+void configureTrap(TrapConfig& cfg, bool activeFilters)
+{
+  cfg.setTrapReg(TrapConfig::kC13CPUA, TIMEBINS, 0);
+  if (activeFilters) {
+    cfg.setTrapReg(TrapConfig::kFTBY, 1, 0);  // tail filter active
+    cfg.setTrapReg(TrapConfig::kTPVBY, 1, 0); // cluster verification active
+    cfg.setTrapReg(TrapConfig::kTPVT, 20, 0);
+    cfg.setTrapReg(TrapConfig::kEBIN, 0, 0); // zero suppression sensitive to neighbours
+    for (int i = 0; i < 128; i++) {
+      cfg.setTrapReg(TrapConfig::TrapReg_t(TrapConfig::kTPL00 + i), i % 7, 0);
+    }
+  }
+}
+
+void runTrap(TrapSimulator& sim, TrapConfig& cfg, const McmData& data, int iMcm)
+{
+  sim.init(&cfg, data.det, data.rob, data.mcm);
+  for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+    if (data.filled[iAdc]) {
+      sim.setData(iAdc, data.adc[iAdc], iMcm * NADCMCM + iAdc);
+    }
+  }
+  sim.setBaselines();
+  sim.filter();
+  sim.zeroSupressionMapping();
+  sim.tracklet();
+}
+
+// the zero suppression map as computed channel by channel in the TRAP manual
+std::array<int, NADCMCM> referenceZeroSuppression(TrapConfig& cfg, const McmData& data, const std::array<std::array<int, TIMEBINS>, NADCMCM>& adcf)
+{
+  int eBIS = cfg.getTrapReg(TrapConfig::kEBIS, data.det, data.rob, data.mcm);
+  int eBIT = cfg.getTrapReg(TrapConfig::kEBIT, data.det, data.rob, data.mcm);
+  int eBIL = cfg.getTrapReg(TrapConfig::kEBIL, data.det, data.rob, data.mcm);
+  int eBIN = cfg.getTrapReg(TrapConfig::kEBIN, data.det, data.rob, data.mcm);
+  std::array<int, NADCMCM> zsMap;
+  zsMap.fill(-1);
+  for (int it = 0; it < TIMEBINS; it++) {
+    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+      int ap = iAdc > 0 ? adcf[iAdc - 1][it] >> TrapSimulator::mgkAddDigits : 0;
+      int ac = adcf[iAdc][it] >> TrapSimulator::mgkAddDigits;
+      int an = iAdc < NADCMCM - 1 ? adcf[iAdc + 1][it] >> TrapSimulator::mgkAddDigits : 0;
+      int mask = (ac >= ap && ac >= an) ? 0 : 0x1;
+      mask += (ap + ac + an > eBIT) ? 0 : 0x2;
+      mask += (ac > eBIS) ? 0 : 0x4;
+      int supp = (eBIL >> mask) & 1;
+      zsMap[iAdc] &= ~((1 - supp) << it);
+      if (eBIN == 0) {
+        if (iAdc > 0) {
+          zsMap[iAdc - 1] &= ~((1 - supp) << it);
+        }
+        if (iAdc < NADCMCM - 1) {
+          zsMap[iAdc + 1] &= ~((1 - supp) << it);
+        }
+      }
+    }
+  }
+  return zsMap;
+}
+
+void compareWithSingleSamples(bool activeFilters)
+{
+  TrapConfig cfg;
+  configureTrap(cfg, activeFilters);
+  std::mt19937 gen(1234);
+  TrapSimulator sim, ref;
+  for (int iMcm = 0; iMcm < 200; iMcm++) {
+    auto data = generateMcm(gen, iMcm);
+    runTrap(sim, cfg, data, iMcm);
+
+    // feed the same samples one by one through the filter chain
+    ref.init(&cfg, data.det, data.rob, data.mcm);
+    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+      if (data.filled[iAdc]) {
+        ref.setData(iAdc, data.adc[iAdc], 0);
+      }
+    }
+    ref.setBaselines();
+    std::array<std::array<int, TIMEBINS>, NADCMCM> adcf;
+    for (int iTb = 0; iTb < TIMEBINS; iTb++) {
+      for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+        auto value = ref.filterPedestalNextSample(iAdc, iTb, ref.getDataRaw(iAdc, iTb));
+        adcf[iAdc][iTb] = ref.filterTailNextSample(iAdc, value);
+        BOOST_REQUIRE_EQUAL(sim.getDataRaw(iAdc, iTb), ref.getDataRaw(iAdc, iTb));
+        BOOST_REQUIRE_EQUAL(sim.getDataFiltered(iAdc, iTb), adcf[iAdc][iTb]);
+      }
+    }
+    auto zsMap = referenceZeroSuppression(cfg, data, adcf);
+    for (int iAdc = 0; iAdc < NADCMCM; iAdc++) {
+      BOOST_REQUIRE_EQUAL(sim.getZeroSupressionMap(iAdc), zsMap[iAdc]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TrapSimulatorFilterChain_test)
+{
+  compareWithSingleSamples(false);
+  compareWithSingleSamples(true);
+}
+
+// The tracklets of the generated MCMs are summarized in a checksum. The reference values were
+// obtained with the sample by sample implementation of the filters and of the hit detection,
+// any change of the output of the TRAP simulation shows up here.
+void checkTracklets(bool activeFilters, int nTrackletsExpected, uint64_t checksumExpected)
+{
+  TrapConfig cfg;
+  configureTrap(cfg, activeFilters);
+  std::mt19937 gen(4321);
+  TrapSimulator sim;
+  uint64_t checksum = 14695981039346656037ULL; // FNV-1a
+  auto add = [&checksum](uint64_t value) {
+    checksum ^= value;
+    checksum *= 1099511628211ULL;
+  };
+  int nTracklets = 0;
+  for (int iMcm = 0; iMcm < 2000; iMcm++) {
+    auto data = generateMcm(gen, iMcm);
+    runTrap(sim, cfg, data, iMcm);
+    for (const auto& trklt : sim.getTrackletArray64()) {
+      add(trklt.getTrackletWord());
+      nTracklets++;
+    }
+    for (auto count : sim.getTrackletDigitCount()) {
+      add(count);
+    }
+    for (auto idx : sim.getTrackletDigitIndices()) {
+      add(idx);
+    }
+  }
+  BOOST_CHECK_EQUAL(nTracklets, nTrackletsExpected);
+  BOOST_CHECK_EQUAL(checksum, checksumExpected);
+}
+
+BOOST_AUTO_TEST_CASE(TrapSimulatorTracklets_test)
+{
+  checkTracklets(false, 3458, 948644416437051589ULL);
+  checkTracklets(true, 1153, 8678080104421986346ULL);
+}
+
+} // namespace trd
+} // namespace o2
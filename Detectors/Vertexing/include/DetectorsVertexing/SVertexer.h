@@ -28,12 +28,14 @@
 #include "CommonDataFormat/RangeReference.h"
 #include "DataFormatsTPC/ClusterNativeHelper.h"
 #include "DCAFitter/DCAFitterN.h"
+#include "DCAFitter/DCAFitterNBatch.h"
 #include "DetectorsVertexing/SVertexerParams.h"
 #include "DetectorsVertexing/SVertexHypothesis.h"
 #include "StrangenessTracking/StrangenessTracker.h"
 #include "DataFormatsTPC/TrackTPC.h"
 #include <numeric>
 #include <algorithm>
+#include <unordered_map>
 #include "GPUO2InterfaceRefit.h"
 #include "TPCFastTransform.h"
 #include "DataFormatsTPC/PIDResponse.h"
@@ -152,7 +154,12 @@ class SVertexer
   template <class TVI, class TCI, class T3I, class TR>
   void extractPVReferences(const TVI& v0s, TR& vtx2V0Refs, const TCI& cascades, TR& vtx2CascRefs, const T3I& vtxs3, TR& vtx2body3Refs);
   bool checkV0(const TrackCand& seed0, const TrackCand& seed1, int iP, int iN, int ithread);
+  bool preselectV0(const TrackCand& seedP, const TrackCand& seedN, bool isTPConly) const;
+  bool checkV0Candidate(DCAFitterN<2>& fitterV0, const TrackCand& seedP, const TrackCand& seedN, int iP, int iN, int ithread);
+  void checkV0sBatched(int iP, int firstN, int ithread);
   int checkCascades(const V0Index& v0Idx, const V0& v0, float rv0, std::array<float, 3> pV0, float p2V0, int avoidTrackID, int posneg, VBracket v0vlist, int ithread);
+  bool checkCascadeCandidate(DCAFitterN<2>& fitterCasc, const V0Index& v0Idx, const V0& v0, float rv0, const std::array<float, 3>& pV0, float p2V0,
+                             const TrackCand& bach, VBracket cascVlist, std::unordered_map<int, int>& pvMap, int ithread);
   int check3bodyDecays(const V0Index& v0Idx, const V0& v0, float rv0, std::array<float, 3> pV0, float p2V0, int avoidTrackID, int posneg, VBracket v0vlist, int ithread);
   void setupThreads();
   void buildT2V(const o2::globaltracking::RecoContainer& recoTracks);
@@ -193,6 +200,11 @@ class SVertexer
   std::vector<DCAFitterN<2>> mFitterV0;
   std::vector<DCAFitterN<2>> mFitterCasc;
   std::vector<DCAFitterN<3>> mFitter3body;
+  std::vector<DCAFitterNBatch<2>> mFitterV0Batch;   // used instead of mFitterV0 if fitBatchSize > 0
+  std::vector<DCAFitterNBatch<2>> mFitterCascBatch; // used instead of mFitterCasc if fitBatchSize > 0
+  // per thread: negative partners of the V0 batch, bachelors and their vertex ranges of the cascade batch
+  std::vector<std::vector<int>> mV0BatchPartners;
+  std::vector<std::vector<std::pair<int, VBracket>>> mCascBatchBachelors;
 
   PIDResponse mPIDresponse;
 
@@ -42,6 +42,7 @@ struct SVertexerParams : public o2::conf::ConfigurableParamHelper<SVertexerParam
   float maxDZIni = 5.;          ///< don't consider as a seed (circles intersection) if Z distance exceeds this
   float maxDXYIni = 4.;         ///< don't consider as a seed (circles intersection) if XY distance exceeds this
   float maxRIni = 150;          ///< don't consider as a seed (circles intersection) if its R exceeds this
+  int fitBatchSize = 0;         ///< if > 0, fit V0 and cascade candidates in batches of this size with vectorized iterations
   //
   // propagation options
   int matCorr = int(o2::base::Propagator::MatCorrType::USEMatCorrNONE); ///< material correction to use
@@ -62,6 +62,15 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData, o2::f
       LOG(debug) << "No partner is found for pos.track " << itp << " out of " << ntrP;
       continue;
     }
+#ifdef WITH_OPENMP
+    int iThread = omp_get_thread_num();
+#else
+    int iThread = 0;
+#endif
+    if (mSVParams->fitBatchSize > 0) {
+      checkV0sBatched(itp, firstN, iThread);
+      continue;
+    }
     for (int itn = firstN; itn < ntrN; itn++) { // start from the 1st negative track of lowest-ID vertex of positive
       auto& seedN = mTracksPool[NEG][itn];
       if (seedN.vBracket > seedP.vBracket) { // all vertices compatible with seedN are in future wrt that of seedP
@@ -71,11 +80,6 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData, o2::f
       if (mSVParams->maxPVContributors < 2 && seedP.gid.isPVContributor() + seedN.gid.isPVContributor() > mSVParams->maxPVContributors) {
         continue;
       }
-#ifdef WITH_OPENMP
-      int iThread = omp_get_thread_num();
-#else
-      int iThread = 0;
-#endif
       checkV0(seedP, seedN, itp, itn, iThread);
     }
   }
@@ -305,6 +309,12 @@ void SVertexer::updateTimeDependentParams()
   for (auto& ft : mFitterCasc) {
     ft.setBz(bz);
   }
+  for (auto& ft : mFitterV0Batch) {
+    ft.getConfig().setBz(bz);
+  }
+  for (auto& ft : mFitterCascBatch) {
+    ft.getConfig().setBz(bz);
+  }
   for (auto& ft : mFitter3body) {
     ft.setBz(bz);
   }
@@ -360,6 +370,11 @@ void SVertexer::setupThreads()
     fitter.setMaxSnp(mSVParams->maxSnp);
     fitter.setMinXSeed(mSVParams->minXSeed);
   }
+  mFitterV0Batch.resize(mNThreads);
+  mV0BatchPartners.resize(mNThreads);
+  for (int i = 0; i < mNThreads; i++) {
+    mFitterV0Batch[i].getConfig() = mFitterV0[i];
+  }
   mFitterCasc.resize(mNThreads);
   fitCounter = 1000;
   for (auto& fitter : mFitterCasc) {
@@ -380,6 +395,11 @@ void SVertexer::setupThreads()
     fitter.setMaxSnp(mSVParams->maxSnp);
     fitter.setMinXSeed(mSVParams->minXSeed);
   }
+  mFitterCascBatch.resize(mNThreads);
+  mCascBatchBachelors.resize(mNThreads);
+  for (int i = 0; i < mNThreads; i++) {
+    mFitterCascBatch[i].getConfig() = mFitterCasc[i];
+  }
 
   mFitter3body.resize(mNThreads);
   fitCounter = 2000;
@@ -572,8 +592,85 @@ void SVertexer::buildT2V(const o2::globaltracking::RecoContainer& recoData) // a
 bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP, int iN, int ithread)
 {
   auto& fitterV0 = mFitterV0[ithread];
-  // Fast rough cuts on pairs before feeding to DCAFitter, tracks are not in the same Frame or at same X
   bool isTPConly = (seedP.gid.getSource() == GIndex::TPC || seedN.gid.getSource() == GIndex::TPC);
+  if (!preselectV0(seedP, seedN, isTPConly)) {
+    return false;
+  }
+  if (mSVParams->mTPCTrackPhotonTune && isTPConly) {
+    // Setup looser cuts for the DCAFitter
+    fitterV0.setMaxDZIni(mSVParams->mTPCTrackMaxDZIni);
+    fitterV0.setMaxDXYIni(mSVParams->mTPCTrackMaxDXYIni);
+    fitterV0.setMaxChi2(mSVParams->mTPCTrackMaxChi2);
+  }
+
+  // feed DCAFitter
+  fitterV0.process(seedP, seedN);
+  if (mSVParams->mTPCTrackPhotonTune && isTPConly) {
+    // Reset immediately to the defaults
+    fitterV0.setMaxDZIni(mSVParams->maxDZIni);
+    fitterV0.setMaxDXYIni(mSVParams->maxDXYIni);
+    fitterV0.setMaxChi2(mSVParams->maxChi2);
+  }
+  return checkV0Candidate(fitterV0, seedP, seedN, iP, iN, ithread);
+}
+
+//__________________________________________________________________
+void SVertexer::checkV0sBatched(int iP, int firstN, int ithread)
+{
+  // same as the checkV0 calls for all partners of the positive track iP, but the preselected pairs are fitted in batches
+  auto& batch = mFitterV0Batch[ithread];
+  auto& config = batch.getConfig();
+  const auto& seedP = mTracksPool[POS][iP];
+  int ntrN = mTracksPool[NEG].size();
+  auto& partners = mV0BatchPartners[ithread];
+  partners.clear();
+  auto checkBatch = [&]() {
+    batch.process();
+    for (int i = 0; i < batch.size(); i++) {
+      checkV0Candidate(batch.getFitter(i), seedP, mTracksPool[NEG][partners[i]], iP, partners[i], ithread);
+    }
+    batch.clear();
+    partners.clear();
+  };
+  for (int itn = firstN; itn < ntrN; itn++) { // start from the 1st negative track of lowest-ID vertex of positive
+    const auto& seedN = mTracksPool[NEG][itn];
+    if (seedN.vBracket > seedP.vBracket) { // all vertices compatible with seedN are in future wrt that of seedP
+      LOG(debug) << "Brackets do not match";
+      break;
+    }
+    if (mSVParams->maxPVContributors < 2 && seedP.gid.isPVContributor() + seedN.gid.isPVContributor() > mSVParams->maxPVContributors) {
+      continue;
+    }
+    bool isTPConly = (seedP.gid.getSource() == GIndex::TPC || seedN.gid.getSource() == GIndex::TPC);
+    if (!preselectV0(seedP, seedN, isTPConly)) {
+      continue;
+    }
+    bool looseCuts = mSVParams->mTPCTrackPhotonTune && isTPConly;
+    if (looseCuts) { // the settings are copied to the candidate fitter by add
+      config.setMaxDZIni(mSVParams->mTPCTrackMaxDZIni);
+      config.setMaxDXYIni(mSVParams->mTPCTrackMaxDXYIni);
+      config.setMaxChi2(mSVParams->mTPCTrackMaxChi2);
+    }
+    batch.add(seedP, seedN);
+    partners.push_back(itn);
+    if (looseCuts) {
+      config.setMaxDZIni(mSVParams->maxDZIni);
+      config.setMaxDXYIni(mSVParams->maxDXYIni);
+      config.setMaxChi2(mSVParams->maxChi2);
+    }
+    if (batch.size() == mSVParams->fitBatchSize) {
+      checkBatch();
+    }
+  }
+  if (batch.size()) {
+    checkBatch();
+  }
+}
+
+//__________________________________________________________________
+bool SVertexer::preselectV0(const TrackCand& seedP, const TrackCand& seedN, bool isTPConly) const
+{
+  // Fast rough cuts on pairs before feeding to DCAFitter, tracks are not in the same Frame or at same X
   if (mSVParams->mTPCTrackPhotonTune && isTPConly) {
     // Check if Tgl is close enough
     if (std::abs(seedP.getTgl() - seedN.getTgl()) > mSVParams->maxV0TglAbsDiff) {
@@ -603,21 +700,16 @@ bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP,
       LOG(debug) << "RejDR" << dR;
       return false;
     }
-
-    // Setup looser cuts for the DCAFitter
-    fitterV0.setMaxDZIni(mSVParams->mTPCTrackMaxDZIni);
-    fitterV0.setMaxDXYIni(mSVParams->mTPCTrackMaxDXYIni);
-    fitterV0.setMaxChi2(mSVParams->mTPCTrackMaxChi2);
   }
+  return true;
+}
 
-  // feed DCAFitter
-  int nCand = fitterV0.process(seedP, seedN);
-  if (mSVParams->mTPCTrackPhotonTune && isTPConly) {
-    // Reset immediately to the defaults
-    fitterV0.setMaxDZIni(mSVParams->maxDZIni);
-    fitterV0.setMaxDXYIni(mSVParams->maxDXYIni);
-    fitterV0.setMaxChi2(mSVParams->maxChi2);
-  }
+//__________________________________________________________________
+bool SVertexer::checkV0Candidate(DCAFitterN<2>& fitterV0, const TrackCand& seedP, const TrackCand& seedN, int iP, int iN, int ithread)
+{
+  // validate the V0 candidate found by the fitter, look for cascades and 3-body decays using it
+  bool isTPConly = (seedP.gid.getSource() == GIndex::TPC || seedN.gid.getSource() == GIndex::TPC);
+  int nCand = fitterV0.getNCandidates();
   if (nCand == 0) { // discard this pair
     LOG(debug) << "RejDCAFitter";
     return false;
@@ -881,6 +973,7 @@ int SVertexer::checkCascades(const V0Index& v0Idx, const V0& v0, float rv0, std:
 {
   // check last added V0 for belonging to cascade
   auto& fitterCasc = mFitterCasc[ithread];
+  auto& batch = mFitterCascBatch[ithread];
   auto& tracks = mTracksPool[posneg];
   int nCascIni = mCascadesIdxTmp[ithread].size(), nv0use = 0;
 
@@ -892,6 +985,16 @@ int SVertexer::checkCascades(const V0Index& v0Idx, const V0& v0, float rv0, std:
   if (firstTr < 0) {
     firstTr = nTr;
   }
+  auto& bachelors = mCascBatchBachelors[ithread];
+  bachelors.clear();
+  auto checkBatch = [&]() {
+    batch.process();
+    for (int i = 0; i < batch.size(); i++) {
+      nv0use += checkCascadeCandidate(batch.getFitter(i), v0Idx, v0, rv0, pV0, p2V0, tracks[bachelors[i].first], bachelors[i].second, pvMap, ithread);
+    }
+    batch.clear();
+    bachelors.clear();
+  };
   for (int it = firstTr; it < nTr; it++) {
     if (it == avoidTrackID) {
       continue; // skip the track used by V0
@@ -918,131 +1021,153 @@ int SVertexer::checkCascades(const V0Index& v0Idx, const V0& v0, float rv0, std:
       cascVlist.setMax(v0Idx.getVertexID());
     }
 
-    int nCandC = fitterCasc.process(v0, bach);
-    if (nCandC == 0) { // discard this pair
+    if (mSVParams->fitBatchSize > 0) {
+      batch.add(v0, bach);
+      bachelors.emplace_back(it, cascVlist);
+      if (batch.size() == mSVParams->fitBatchSize) {
+        checkBatch();
+      }
       continue;
     }
-    const int candC = 0;
-    const auto& cascXYZ = fitterCasc.getPCACandidatePos(candC);
+    fitterCasc.process(v0, bach);
+    nv0use += checkCascadeCandidate(fitterCasc, v0Idx, v0, rv0, pV0, p2V0, bach, cascVlist, pvMap, ithread);
+  }
+  if (batch.size()) {
+    checkBatch();
+  }
 
-    // make sure the cascade radius is smaller than that of the mean vertex
-    float dxc = cascXYZ[0] - mMeanVertex.getX(), dyc = cascXYZ[1] - mMeanVertex.getY(), r2casc = dxc * dxc + dyc * dyc;
-    if (rv0 * rv0 - r2casc < mMinR2DiffV0Casc || r2casc < mMinR2ToMeanVertex) {
-      continue;
-    }
-    // do we want to apply mass cut ?
-    //
-    if (!fitterCasc.isPropagateTracksToVertexDone(candC) && !fitterCasc.propagateTracksToVertex(candC)) {
-      continue;
-    }
+  return nv0use;
+}
 
-    auto& trNeut = fitterCasc.getTrack(0, candC);
-    auto& trBach = fitterCasc.getTrack(1, candC);
-    trNeut.setPID(o2::track::PID::Lambda);
-    trBach.setPID(o2::track::PID::Pion);
-    std::array<float, 3> pNeut, pBach;
-    trNeut.getPxPyPzGlo(pNeut);
-    trBach.getPxPyPzGlo(pBach);
-    std::array<float, 3> pCasc = {pNeut[0] + pBach[0], pNeut[1] + pBach[1], pNeut[2] + pBach[2]};
+//__________________________________________________________________
+bool SVertexer::checkCascadeCandidate(DCAFitterN<2>& fitterCasc, const V0Index& v0Idx, const V0& v0, float rv0, const std::array<float, 3>& pV0, float p2V0,
+                                      const TrackCand& bach, VBracket cascVlist, std::unordered_map<int, int>& pvMap, int ithread)
+{
+  // validate the cascade candidate found by the fitter, return true if it uses the original V0 (not its clone with another PV)
+  bool usesV0 = false;
+  int nCandC = fitterCasc.getNCandidates();
+  if (nCandC == 0) { // discard this pair
+    return false;
+  }
+  const int candC = 0;
+  const auto& cascXYZ = fitterCasc.getPCACandidatePos(candC);
 
-    float pt2Casc = pCasc[0] * pCasc[0] + pCasc[1] * pCasc[1], p2Casc = pt2Casc + pCasc[2] * pCasc[2];
-    if (pt2Casc < mMinPt2Casc) { // pt cut
-      LOG(debug) << "Casc pt too low";
-      continue;
-    }
-    if (pCasc[2] * pCasc[2] / pt2Casc > mMaxTgl2Casc) { // tgLambda cut
-      LOG(debug) << "Casc tgLambda too high";
-      continue;
-    }
+  // make sure the cascade radius is smaller than that of the mean vertex
+  float dxc = cascXYZ[0] - mMeanVertex.getX(), dyc = cascXYZ[1] - mMeanVertex.getY(), r2casc = dxc * dxc + dyc * dyc;
+  if (rv0 * rv0 - r2casc < mMinR2DiffV0Casc || r2casc < mMinR2ToMeanVertex) {
+    return false;
+  }
+  // do we want to apply mass cut ?
+  //
+  if (!fitterCasc.isPropagateTracksToVertexDone(candC) && !fitterCasc.propagateTracksToVertex(candC)) {
+    return false;
+  }
 
-    // compute primary vertex and cosPA of the cascade
-    auto bestCosPA = mSVParams->minCosPACasc;
-    auto cascVtxID = -1;
+  auto& trNeut = fitterCasc.getTrack(0, candC);
+  auto& trBach = fitterCasc.getTrack(1, candC);
+  trNeut.setPID(o2::track::PID::Lambda);
+  trBach.setPID(o2::track::PID::Pion);
+  std::array<float, 3> pNeut, pBach;
+  trNeut.getPxPyPzGlo(pNeut);
+  trBach.getPxPyPzGlo(pBach);
+  std::array<float, 3> pCasc = {pNeut[0] + pBach[0], pNeut[1] + pBach[1], pNeut[2] + pBach[2]};
 
-    for (int iv = cascVlist.getMin(); iv <= cascVlist.getMax(); iv++) {
-      const auto& pv = mPVertices[iv];
-      // check cos of pointing angle
-      float dx = cascXYZ[0] - pv.getX(), dy = cascXYZ[1] - pv.getY(), dz = cascXYZ[2] - pv.getZ(), prodXYZcasc = dx * pCasc[0] + dy * pCasc[1] + dz * pCasc[2];
-      float cosPA = prodXYZcasc / std::sqrt((dx * dx + dy * dy + dz * dz) * p2Casc);
-      if (cosPA < bestCosPA) {
-        LOG(debug) << "Rej. cosPA: " << cosPA;
-        continue;
-      }
-      cascVtxID = iv;
-      bestCosPA = cosPA;
-    }
-    if (cascVtxID == -1) {
-      LOG(debug) << "Casc not compatible with any vertex";
-      continue;
-    }
+  float pt2Casc = pCasc[0] * pCasc[0] + pCasc[1] * pCasc[1], p2Casc = pt2Casc + pCasc[2] * pCasc[2];
+  if (pt2Casc < mMinPt2Casc) { // pt cut
+    LOG(debug) << "Casc pt too low";
+    return false;
+  }
+  if (pCasc[2] * pCasc[2] / pt2Casc > mMaxTgl2Casc) { // tgLambda cut
+    LOG(debug) << "Casc tgLambda too high";
+    return false;
+  }
 
-    const auto& cascPv = mPVertices[cascVtxID];
-    float dxCasc = cascXYZ[0] - cascPv.getX(), dyCasc = cascXYZ[1] - cascPv.getY(), dzCasc = cascXYZ[2] - cascPv.getZ();
-    auto prodPPos = pV0[0] * dxCasc + pV0[1] * dyCasc + pV0[2] * dzCasc;
-    if (prodPPos < 0.) { // causality cut
-      LOG(debug) << "Casc not causally compatible";
-      continue;
-    }
+  // compute primary vertex and cosPA of the cascade
+  auto bestCosPA = mSVParams->minCosPACasc;
+  auto cascVtxID = -1;
 
-    float p2Bach = pBach[0] * pBach[0] + pBach[1] * pBach[1] + pBach[2] * pBach[2];
-    float ptCasc = std::sqrt(pt2Casc);
-    bool goodHyp = false;
-    for (int ipid = 0; ipid < NHypCascade; ipid++) {
-      if (mCascHyps[ipid].check(p2V0, p2Bach, p2Casc, ptCasc)) {
-        goodHyp = true;
-        break;
-      }
-    }
-    if (!goodHyp) {
-      LOG(debug) << "Casc not compatible with any hypothesis";
+  for (int iv = cascVlist.getMin(); iv <= cascVlist.getMax(); iv++) {
+    const auto& pv = mPVertices[iv];
+    // check cos of pointing angle
+    float dx = cascXYZ[0] - pv.getX(), dy = cascXYZ[1] - pv.getY(), dz = cascXYZ[2] - pv.getZ(), prodXYZcasc = dx * pCasc[0] + dy * pCasc[1] + dz * pCasc[2];
+    float cosPA = prodXYZcasc / std::sqrt((dx * dx + dy * dy + dz * dz) * p2Casc);
+    if (cosPA < bestCosPA) {
+      LOG(debug) << "Rej. cosPA: " << cosPA;
       continue;
     }
-    // note: at the moment the v0 was not added yet. If some cascade will use v0 (with its PV), the v0 will be added after checkCascades
-    // but not necessarily at the and of current v0s vector, since meanwhile checkCascades may add v0 clones (with PV redefined).
-    Cascade casc(cascXYZ, pCasc, fitterCasc.calcPCACovMatrixFlat(candC), trNeut, trBach);
-    o2::track::TrackParCov trc = casc;
-    o2::dataformats::DCA dca;
-    if (!trc.propagateToDCA(cascPv, fitterCasc.getBz(), &dca, 5.) ||
-        std::abs(dca.getY()) > mSVParams->maxDCAXYCasc || std::abs(dca.getZ()) > mSVParams->maxDCAZCasc) {
-      LOG(debug) << "Casc not compatible with PV";
-      LOG(debug) << "DCA: " << dca.getY() << " " << dca.getZ();
-      continue;
+    cascVtxID = iv;
+    bestCosPA = cosPA;
+  }
+  if (cascVtxID == -1) {
+    LOG(debug) << "Casc not compatible with any vertex";
+    return false;
+  }
+
+  const auto& cascPv = mPVertices[cascVtxID];
+  float dxCasc = cascXYZ[0] - cascPv.getX(), dyCasc = cascXYZ[1] - cascPv.getY(), dzCasc = cascXYZ[2] - cascPv.getZ();
+  auto prodPPos = pV0[0] * dxCasc + pV0[1] * dyCasc + pV0[2] * dzCasc;
+  if (prodPPos < 0.) { // causality cut
+    LOG(debug) << "Casc not causally compatible";
+    return false;
+  }
+
+  float p2Bach = pBach[0] * pBach[0] + pBach[1] * pBach[1] + pBach[2] * pBach[2];
+  float ptCasc = std::sqrt(pt2Casc);
+  bool goodHyp = false;
+  for (int ipid = 0; ipid < NHypCascade; ipid++) {
+    if (mCascHyps[ipid].check(p2V0, p2Bach, p2Casc, ptCasc)) {
+      goodHyp = true;
+      break;
     }
-    CascadeIndex cascIdx(cascVtxID, -1, bach.gid); // the v0Idx was not yet added, this will be done after the checkCascades
-
-    LOGP(debug, "cascade successfully validated");
-
-    // clone the V0, set new cosPA and VerteXID, add it to the list of V0s
-    if (cascVtxID != v0Idx.getVertexID()) {
-      auto pvIdx = pvMap.find(cascVtxID);
-      if (pvIdx != pvMap.end()) {
-        cascIdx.setV0ID(pvIdx->second); // V0 already exists, add reference to the cascade
-      } else {                          // add V0 clone for this cascade (may be used also by other cascades)
-        const auto& pv = mPVertices[cascVtxID];
-        cascIdx.setV0ID(mV0sIdxTmp[ithread].size()); // set the new V0 index in the cascade
-        pvMap[cascVtxID] = mV0sTmp[ithread].size();  // add the new V0 index to the map
-        mV0sIdxTmp[ithread].emplace_back(cascVtxID, v0Idx.getProngs());
-        if (mSVParams->createFullV0s) {
-          mV0sTmp[ithread].push_back(v0);
-          float dx = v0.getX() - pv.getX(), dy = v0.getY() - pv.getY(), dz = v0.getZ() - pv.getZ(), prodXYZ = dx * pV0[0] + dy * pV0[1] + dz * pV0[2];
-          mV0sTmp[ithread].back().setCosPA(prodXYZ / std::sqrt((dx * dx + dy * dy + dz * dz) * p2V0));
-        }
+  }
+  if (!goodHyp) {
+    LOG(debug) << "Casc not compatible with any hypothesis";
+    return false;
+  }
+  // note: at the moment the v0 was not added yet. If some cascade will use v0 (with its PV), the v0 will be added after checkCascades
+  // but not necessarily at the and of current v0s vector, since meanwhile checkCascades may add v0 clones (with PV redefined).
+  Cascade casc(cascXYZ, pCasc, fitterCasc.calcPCACovMatrixFlat(candC), trNeut, trBach);
+  o2::track::TrackParCov trc = casc;
+  o2::dataformats::DCA dca;
+  if (!trc.propagateToDCA(cascPv, fitterCasc.getBz(), &dca, 5.) ||
+      std::abs(dca.getY()) > mSVParams->maxDCAXYCasc || std::abs(dca.getZ()) > mSVParams->maxDCAZCasc) {
+    LOG(debug) << "Casc not compatible with PV";
+    LOG(debug) << "DCA: " << dca.getY() << " " << dca.getZ();
+    return false;
+  }
+  CascadeIndex cascIdx(cascVtxID, -1, bach.gid); // the v0Idx was not yet added, this will be done after the checkCascades
+
+  LOGP(debug, "cascade successfully validated");
+
+  // clone the V0, set new cosPA and VerteXID, add it to the list of V0s
+  if (cascVtxID != v0Idx.getVertexID()) {
+    auto pvIdx = pvMap.find(cascVtxID);
+    if (pvIdx != pvMap.end()) {
+      cascIdx.setV0ID(pvIdx->second); // V0 already exists, add reference to the cascade
+    } else {                          // add V0 clone for this cascade (may be used also by other cascades)
+      const auto& pv = mPVertices[cascVtxID];
+      cascIdx.setV0ID(mV0sIdxTmp[ithread].size()); // set the new V0 index in the cascade
+      pvMap[cascVtxID] = mV0sTmp[ithread].size();  // add the new V0 index to the map
+      mV0sIdxTmp[ithread].emplace_back(cascVtxID, v0Idx.getProngs());
+      if (mSVParams->createFullV0s) {
+        mV0sTmp[ithread].push_back(v0);
+        float dx = v0.getX() - pv.getX(), dy = v0.getY() - pv.getY(), dz = v0.getZ() - pv.getZ(), prodXYZ = dx * pV0[0] + dy * pV0[1] + dz * pV0[2];
+        mV0sTmp[ithread].back().setCosPA(prodXYZ / std::sqrt((dx * dx + dy * dy + dz * dz) * p2V0));
       }
-    } else {
-      nv0use++; // original v0 was used
-    }
-    mCascadesIdxTmp[ithread].push_back(cascIdx);
-    if (mSVParams->createFullCascades) {
-      casc.setCosPA(bestCosPA);
-      casc.setDCA(fitterCasc.getChi2AtPCACandidate(candC));
-      mCascadesTmp[ithread].push_back(casc);
-    }
-    if (mStrTracker) {
-      mStrTracker->processCascade(mCascadesIdxTmp[ithread].size() - 1, casc, cascIdx, v0, ithread);
     }
+  } else {
+    usesV0 = true; // original v0 was used
   }
-
-  return nv0use;
+  mCascadesIdxTmp[ithread].push_back(cascIdx);
+  if (mSVParams->createFullCascades) {
+    casc.setCosPA(bestCosPA);
+    casc.setDCA(fitterCasc.getChi2AtPCACandidate(candC));
+    mCascadesTmp[ithread].push_back(casc);
+  }
+  if (mStrTracker) {
+    mStrTracker->processCascade(mCascadesIdxTmp[ithread].size() - 1, casc, cascIdx, v0, ithread);
+  }
+  return usesV0;
 }
 
 //__________________________________________________________________
@@ -1381,8 +1506,8 @@ std::array<size_t, 3> SVertexer::getNFitterCalls() const
 {
   std::array<size_t, 3> calls{};
   for (int i = 0; i < mNThreads; i++) {
-    calls[0] += mFitterV0[i].getCallID();
-    calls[1] += mFitterCasc[i].getCallID();
+    calls[0] += mFitterV0[i].getCallID() + mFitterV0Batch[i].getCallID();
+    calls[1] += mFitterCasc[i].getCallID() + mFitterCascBatch[i].getCallID();
     calls[2] += mFitter3body[i].getCallID();
   }
   return calls;
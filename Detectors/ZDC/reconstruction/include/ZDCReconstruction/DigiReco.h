@@ -11,6 +11,8 @@
 
 #include <map>
 #include <deque>
+#include <vector>
+#include <utility>
 #include <gsl/span>
 #include <TFile.h>
 #include <TTree.h>
@@ -60,6 +62,26 @@ struct DigiRecoTDC {
   o2::InteractionRecord ir;
 };
 
+// State of the reconstruction of a range of consecutive bunch crossings
+// Ranges are independent and are processed in parallel, one context per thread
+struct DigiRecoContext {
+  float offset[NChannels];              /// Offset in current orbit
+  uint32_t offsetOrbit = 0xffffffff;    /// Current orbit
+  uint8_t source[NChannels];            /// Source of pedestal
+  uint32_t missingPed[NChannels] = {0}; /// Orbits with missing pedestal
+  bool inError = false;                 /// Reconstruction of range ends in error
+  // Configuration of interpolation for current signal
+  int nbun = 0;                                  /// Number of adjacent bunches
+  int nsam = 0;                                  /// Number of acquired samples
+  int ntot = 0;                                  /// Total number of points in the interpolated arrays
+  int ilast = 0;                                 /// Index of last acquired sample
+  int nint = 0;                                  /// Total points in the interpolation region (-1)
+  O2_ZDC_DIGIRECO_FLT firstSample = 0;           /// First acquired sample
+  O2_ZDC_DIGIRECO_FLT lastSample = 0;            /// Last acquired sample
+  std::vector<O2_ZDC_DIGIRECO_FLT> samples;      /// Acquired samples padded with TSL copies of first and last sample
+  std::vector<O2_ZDC_DIGIRECO_FLT> interpolated; /// Buffer of interpolated points
+};
+
 class DigiReco
 {
  public:
@@ -137,43 +159,48 @@ class DigiReco
   {
     return mInError;
   }
+  // Number of threads used to process independent ranges of bunch crossings
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
 
   const uint32_t* getTDCMask() const { return mTDCMask; }
   const uint32_t* getChMask() const { return mChMask; }
   const std::vector<o2::zdc::RecEventAux>& getReco() { return mReco; }
 
  private:
-  const ModuleConfig* mModuleConfig = nullptr;              /// Trigger/readout configuration object
-  void updateOffsets(int ibun);                             /// Update offsets to process current bunch
-  void lowPassFilter();                                     /// low-pass filtering of digitized data
-  int reconstructTDC(int seq_beg, int seq_end);             /// Reconstruction of uncorrected TDCs
-  int reconstruct(int seq_beg, int seq_end);                /// Main method for data reconstruction
-  int processTrigger(int itdc, int ibeg, int iend);         /// Replay of trigger algorithm on acquired data
-  int processTriggerExtended(int itdc, int ibeg, int iend); /// Replay of trigger algorithm on acquired data
-  int interpolate(int itdc, int ibeg, int iend);            /// Interpolation of samples to evaluate signal amplitude and arrival time
-  int fullInterpolation(int itdc, int ibeg, int iend);      /// Interpolation of samples
-  void correctTDCPile();                                    /// Correction of pile-up in TDC
-  bool mLowPassFilter = true;                               /// Enable low pass filtering
-  bool mLowPassFilterSet = false;                           /// Low pass filtering set via function call
-  bool mFullInterpolation = false;                          /// Full waveform interpolation
-  bool mFullInterpolationSet = false;                       /// Full waveform interpolation set via function call
-  int mFullInterpolationMinLength = 2;                      /// Minimum length to perform full interpolation
-  int mInterpolationStep = 25;                              /// Coarse interpolation step
-  bool mCorrSignal = true;                                  /// Enable TDC signal correction
-  bool mCorrSignalSet = false;                              /// TDC signal correction set via function call
-  bool mCorrBackground = true;                              /// Enable TDC pile-up correction
-  bool mCorrBackgroundSet = false;                          /// TDC pile-up correction set via function call
-  bool mInError = false;                                    /// ZDC reconstruction ends in error
-  int mAssignedTDC[NTDCChannels] = {0};                     /// Number of assigned TDCs in sequence (debugging)
+  const ModuleConfig* mModuleConfig = nullptr;                                    /// Trigger/readout configuration object
+  void updateOffsets(DigiRecoContext& ctx, int ibun);                             /// Update offsets to process current bunch
+  void lowPassFilter();                                                           /// low-pass filtering of digitized data
+  int reconstructTDC(DigiRecoContext& ctx, int seq_beg, int seq_end);             /// Reconstruction of uncorrected TDCs
+  int reconstruct(DigiRecoContext& ctx, int seq_beg, int seq_end);                /// Main method for data reconstruction
+  int processTrigger(DigiRecoContext& ctx, int itdc, int ibeg, int iend);         /// Replay of trigger algorithm on acquired data
+  int processTriggerExtended(DigiRecoContext& ctx, int itdc, int ibeg, int iend); /// Replay of trigger algorithm on acquired data
+  int interpolate(DigiRecoContext& ctx, int itdc, int ibeg, int iend);            /// Interpolation of samples to evaluate signal amplitude and arrival time
+  int fullInterpolation(DigiRecoContext& ctx, int itdc, int ibeg, int iend);      /// Interpolation of samples
+  void correctTDCPile();                                                          /// Correction of pile-up in TDC
+  bool mLowPassFilter = true;                                                     /// Enable low pass filtering
+  bool mLowPassFilterSet = false;                                                 /// Low pass filtering set via function call
+  bool mFullInterpolation = false;                                                /// Full waveform interpolation
+  bool mFullInterpolationSet = false;                                             /// Full waveform interpolation set via function call
+  int mFullInterpolationMinLength = 2;                                            /// Minimum length to perform full interpolation
+  int mInterpolationStep = 25;                                                    /// Coarse interpolation step
+  bool mCorrSignal = true;                                                        /// Enable TDC signal correction
+  bool mCorrSignalSet = false;                                                    /// TDC signal correction set via function call
+  bool mCorrBackground = true;                                                    /// Enable TDC pile-up correction
+  bool mCorrBackgroundSet = false;                                                /// TDC pile-up correction set via function call
+  bool mInError = false;                                                          /// ZDC reconstruction ends in error
+  int mAssignedTDC[NTDCChannels] = {0};                                           /// Number of assigned TDCs in sequence (debugging)
 
   int correctTDCSignal(int itdc, int16_t TDCVal, float TDCAmp, float& fTDCVal, float& fTDCAmp, bool isbeg, bool isend); /// Correct TDC single signal
   int correctTDCBackground(int ibc, int itdc, std::deque<DigiRecoTDC>& tdc);                                            /// TDC amplitude and time corrections due to pile-up from previous bunches
 
-  O2_ZDC_DIGIRECO_FLT getPoint(int itdc, int ibeg, int iend, int i); /// Interpolation for current TDC
-  void setPoint(int itdc, int ibeg, int iend, int i);                /// Interpolation for current TDC
+  void setSamples(DigiRecoContext& ctx, int isig, int ibeg, int iend);                                /// Load samples of signal isig for interpolation
+  void interpolateRange(const DigiRecoContext& ctx, int ifirst, int ilast, O2_ZDC_DIGIRECO_FLT* y) const; /// Interpolation of points [ifirst, ilast)
+  O2_ZDC_DIGIRECO_FLT getPoint(DigiRecoContext& ctx, int i);                                          /// Interpolation for current signal
+  void setPoints(DigiRecoContext& ctx, int isig, int ibeg, int iend);                                 /// Interpolation of all points of current signal
 
-  void assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float amp); /// Set reconstructed TDC values
-  void findSignals(int ibeg, int iend);                                       /// Find signals around main-main that satisfy condition on TDC
+  void assignTDC(DigiRecoContext& ctx, int ibun, int ibeg, int iend, int itdc, int tdc, float amp); /// Set reconstructed TDC values
+  void findSignals(DigiRecoContext& ctx, int ibeg, int iend);                                       /// Find signals around main-main that satisfy condition on TDC
   const RecoParamZDC* mRopt = nullptr;
   bool mIsContinuous = true;                     /// continuous (self-triggered) or externally-triggered readout
   uint8_t mTriggerCondition = 0x3;               /// Trigger condition: 0x1 single, 0x3 double and 0x7 triple
@@ -189,6 +216,8 @@ class DigiReco
   const RecoConfigZDC* mRecoConfigZDC = nullptr; /// CCDB configuration parameters
   int32_t mVerbosity = DbgMinimal;
   O2_ZDC_DIGIRECO_FLT mTS[NTS];                     /// Tapered sinc function
+  O2_ZDC_DIGIRECO_FLT mTSPhase[2 * TSL][TSN];       /// Tapered sinc function coefficients for each interpolation phase
+  O2_ZDC_DIGIRECO_FLT mTSSum[TSN];                  /// Sum of coefficients for each interpolation phase
   bool mTreeDbg = false;                            /// Write reconstructed data in debug output file
   std::unique_ptr<TFile> mDbg = nullptr;            /// Debug output file
   std::unique_ptr<TTree> mTDbg = nullptr;           /// Debug tree
@@ -197,9 +226,10 @@ class DigiReco
   gsl::span<const o2::zdc::ChannelData> mChData;    /// Payload
   std::vector<o2::zdc::RecEventAux> mReco;          /// Reconstructed data
   std::map<uint32_t, int> mOrbit;                   /// Information about orbit
-  float mOffset[NChannels];                         /// Offset in current orbit
-  uint32_t mOffsetOrbit = 0xffffffff;               /// Current orbit
-  uint8_t mSource[NChannels];                       /// Source of pedestal
+  std::vector<DigiRecoContext> mContexts;           /// Reconstruction state for each thread
+  std::vector<std::pair<int, int>> mRanges;         /// Ranges of consecutive bunch crossings
+  std::vector<int> mRangeStatus;                    /// Return value of TDC reconstruction for each range
+  int mNThreads = 1;                                /// Number of threads
   static constexpr int mNSB = TSN * NTimeBinsPerBC; /// Total number of interpolated points per bunch crossing
   RecEventAux mRec;                                 /// Debug reconstruction event
   int mNBC = 0;
@@ -212,14 +242,6 @@ class DigiReco
   float tdc_offset[NTDCChannels] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0}; /// TDC offset
   constexpr static uint16_t mMask[NTimeBinsPerBC] = {0x0001, 0x002, 0x004, 0x008, 0x0010, 0x0020, 0x0040, 0x0080, 0x0100, 0x0200, 0x0400, 0x0800};
   O2_ZDC_DIGIRECO_FLT mAlpha = 3; // Parameter of interpolation function
-  // Configuration of interpolation for current TDC
-  int mNbun;  // Number of adjacent bunches
-  int mNsam;  // Number of acquired samples
-  int mNtot;  // Total number of points in the interpolated arrays
-  int mIlast; // Index of last acquired sample
-  int mNint;  // Total points in the interpolation region (-1)
-  O2_ZDC_DIGIRECO_FLT mFirstSample;
-  O2_ZDC_DIGIRECO_FLT mLastSample;
 };
 } // namespace zdc
 } // namespace o2
@@ -9,11 +9,16 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <algorithm>
 #include <TMath.h>
 #include "Framework/Logger.h"
 #include "ZDCReconstruction/DigiReco.h"
 #include "ZDCReconstruction/RecoParamZDC.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace zdc
@@ -447,6 +452,13 @@ void DigiReco::eor()
       }
     }
   }
+  // Each thread keeps track of missing pedestals in the orbits that it processed
+  for (auto& ctx : mContexts) {
+    for (int ich = 0; ich < NChannels; ich++) {
+      mMissingPed[ich] += ctx.missingPed[ich];
+      ctx.missingPed[ich] = 0;
+    }
+  }
   for (int ich = 0; ich < NChannels; ich++) {
     if (mMissingPed[ich] > 0) {
       LOGF(error, "Missing pedestal for ch %2d %s: %u", ich, ChannelNames[ich], mMissingPed[ich]);
@@ -480,10 +492,33 @@ void DigiReco::prepareInterpolation()
     mTS[n + tsi] = fs * fg;
     mTS[n - tsi] = mTS[n + tsi]; // Function is even
   }
+  // Coefficients arranged by interpolation phase: the point at phase im after sample ip
+  // is the sum over k of sample (ip - TSL + 1 + k) times mTSPhase[k][im].
+  // This layout allows to compute all phases between two samples in a vectorizable loop
+  for (int im = 0; im < TSN; im++) {
+    mTSSum[im] = 0;
+    for (int k = 0; k < 2 * TSL; k++) {
+      mTSPhase[k][im] = mTS[TSN - im + k * TSN];
+      // Same summation order as in the interpolation of a single point
+      mTSSum[im] += mTSPhase[k][im];
+    }
+  }
   LOG(info) << "Interpolation numeric precision is " << sizeof(O2_ZDC_DIGIRECO_FLT);
   LOG(info) << "Interpolation alpha = " << mAlpha;
 }
 
+void DigiReco::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  if (n > 1) {
+    LOG(warning) << "Multithreading is not supported, imposing single thread";
+  }
+  mNThreads = 1;
+#endif
+}
+
 int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, const gsl::span<const o2::zdc::BCData>& bcdata, const gsl::span<const o2::zdc::ChannelData>& chdata)
 {
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
@@ -495,6 +530,12 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
   mBCData = bcdata;
   mChData = chdata;
   mInError = false;
+  if (mContexts.size() < static_cast<size_t>(mNThreads)) {
+    mContexts.resize(mNThreads);
+  }
+  for (auto& ctx : mContexts) {
+    ctx.inError = false;
+  }
 
   // Initialization of lookup structure for pedestals
   mOrbit.clear();
@@ -629,6 +670,8 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
   }
 
   // TDC reconstruction
+  // Collect the ranges of consecutive bunch crossings
+  mRanges.clear();
   for (int ibc = 0; ibc < mNBC; ibc++) {
     auto& ir = mBCData[seq_end].ir;
     auto bcd = mBCData[ibc].ir.differenceInBC(ir);
@@ -641,21 +684,13 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
       return __LINE__;
     } else if (bcd > 1) {
       // Detected a gap
-      int rval = reconstructTDC(seq_beg, seq_end);
-      if (rval) {
-        return rval;
-      }
-
+      mRanges.emplace_back(seq_beg, seq_end);
       seq_beg = ibc;
       seq_end = ibc;
     } else if (ibc == (mNBC - 1)) {
       // Last bunch
       seq_end = ibc;
-      int rval = reconstructTDC(seq_beg, seq_end);
-      if (rval) {
-        return rval;
-      }
-
+      mRanges.emplace_back(seq_beg, seq_end);
       seq_beg = mNBC;
       seq_end = mNBC;
     } else {
@@ -668,6 +703,31 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
 #endif
   }
 
+  // Ranges are independent: each one reads and writes only its own bunch crossings
+  // in mReco, therefore the result does not depend on the number of threads
+  int nRanges = mRanges.size();
+  mRangeStatus.assign(nRanges, 0);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int irange = 0; irange < nRanges; irange++) {
+#ifdef WITH_OPENMP
+    auto& ctx = mContexts[omp_get_thread_num()];
+#else
+    auto& ctx = mContexts[0];
+#endif
+    mRangeStatus[irange] = reconstructTDC(ctx, mRanges[irange].first, mRanges[irange].second);
+  }
+  for (const auto& ctx : mContexts) {
+    mInError |= ctx.inError;
+  }
+  // Report the first error in bunch crossing order
+  for (int irange = 0; irange < nRanges; irange++) {
+    if (mRangeStatus[irange]) {
+      return mRangeStatus[irange];
+    }
+  }
+
   // Apply pile-up correction for TDCs to get corrected TDC amplitudes and values
   correctTDCPile();
 
@@ -686,7 +746,7 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
       return __LINE__;
     } else if (bcd > 1) {
       // Detected a gap
-      int rval = reconstruct(seq_beg, seq_end);
+      int rval = reconstruct(mContexts[0], seq_beg, seq_end);
       if (rval != 0) {
         return rval;
       }
@@ -695,7 +755,7 @@ int DigiReco::process(const gsl::span<const o2::zdc::OrbitData>& orbitdata, cons
     } else if (ibc == (mNBC - 1)) {
       // Last bunch
       seq_end = ibc;
-      int rval = reconstruct(seq_beg, seq_end);
+      int rval = reconstruct(mContexts[0], seq_beg, seq_end);
       if (rval != 0) {
         return rval;
       }
@@ -719,6 +779,10 @@ void DigiReco::lowPassFilter()
   LOG(info) << __func__;
 #endif
   constexpr int MaxTimeBin = NTimeBinsPerBC - 1;
+  // Channels are independent
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) num_threads(mNThreads)
+#endif
   for (int itdc = 0; itdc < NTDCChannels; itdc++) {
     auto isig = TDCSignal[itdc];
     for (int ibc = 0; ibc < mNBC; ibc++) {
@@ -737,53 +801,42 @@ void DigiReco::lowPassFilter()
         bcd_n = mReco[ibc + 1].ir.differenceInBC(mReco[ibc].ir); // b.c. number of (ibc+1) -  b.c. number (ibc)
       }
       if (ref_c != ZDCRefInitVal) { // Should always be true
+        // Samples of current bunch crossing with one sample on each side
+        int32_t padded[NTimeBinsPerBC + 2];
+        const auto& data = mChData[ref_c].data;
         for (int is = 0; is < NTimeBinsPerBC; is++) {
-          int32_t sum = mChData[ref_c].data[is];
-          if (is == 0) {
-            sum += mChData[ref_c].data[1];
-            if (ref_p != ZDCRefInitVal && bcd_p == 1) {
-              // Add last sample of previous bunch crossing
-              sum += mChData[ref_p].data[MaxTimeBin];
-            } else {
-              // As a backup we count twice the first sample
-              sum += mChData[ref_c].data[0];
-            }
-          } else if (is == MaxTimeBin) {
-            sum += mChData[ref_c].data[MaxTimeBin - 1];
-            if (ref_n != ZDCRefInitVal && bcd_n == 1) {
-              // Add first sample of next bunch crossing
-              sum += mChData[ref_n].data[0];
-            } else {
-              // As a backup we count twice the last sample
-              sum += mChData[ref_c].data[MaxTimeBin];
-            }
-          } else {
-            // Not on the bunch boundary
-            sum += mChData[ref_c].data[is - 1];
-            sum += mChData[ref_c].data[is + 1];
-          }
+          padded[is + 1] = data[is];
+        }
+        if (ref_p != ZDCRefInitVal && bcd_p == 1) {
+          // Add last sample of previous bunch crossing
+          padded[0] = mChData[ref_p].data[MaxTimeBin];
+        } else {
+          // As a backup we count twice the first sample
+          padded[0] = data[0];
+        }
+        if (ref_n != ZDCRefInitVal && bcd_n == 1) {
+          // Add first sample of next bunch crossing
+          padded[NTimeBinsPerBC + 1] = mChData[ref_n].data[0];
+        } else {
+          // As a backup we count twice the last sample
+          padded[NTimeBinsPerBC + 1] = data[MaxTimeBin];
+        }
+        auto& filtered = mReco[ibc].data[isig];
+        for (int is = 0; is < NTimeBinsPerBC; is++) {
+          int32_t sum = padded[is] + padded[is + 1] + padded[is + 2];
           // Make the average taking into account rounding and sign
-          bool isNegative = sum < 0;
-          if (isNegative) {
-            sum = -sum;
-          }
-          auto mod = sum % 3;
-          sum = sum / 3;
-          if (mod == 2) {
-            sum++;
-          }
-          if (isNegative) {
-            sum = -sum;
-          }
+          int32_t abssum = sum < 0 ? -sum : sum;
+          int32_t avg = abssum / 3;
+          avg += (abssum - 3 * avg) == 2;
           // Store filtered values
-          mReco[ibc].data[isig][is] = sum;
+          filtered[is] = sum < 0 ? -avg : avg;
         }
       }
     }
   }
 }
 
-int DigiReco::reconstructTDC(int ibeg, int iend)
+int DigiReco::reconstructTDC(DigiRecoContext& ctx, int ibeg, int iend)
 {
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
   LOG(info) << "________________________________________________________________________________";
@@ -811,9 +864,9 @@ int DigiReco::reconstructTDC(int ibeg, int iend)
           // Need data for at least two consecutive bunch crossings
           int rval = 0;
           if (mRopt->doExtendedSearch) {
-            rval = processTriggerExtended(itdc, istart, istop);
+            rval = processTriggerExtended(ctx, itdc, istart, istop);
           } else {
-            rval = processTrigger(itdc, istart, istop);
+            rval = processTrigger(ctx, itdc, istart, istop);
           }
           if (rval) {
             return rval;
@@ -827,9 +880,9 @@ int DigiReco::reconstructTDC(int ibeg, int iend)
     if (istart >= 0 && (istop - istart) > 0) {
       int rval = 0;
       if (mRopt->doExtendedSearch) {
-        rval = processTriggerExtended(itdc, istart, istop);
+        rval = processTriggerExtended(ctx, itdc, istart, istop);
       } else {
-        rval = processTrigger(itdc, istart, istop);
+        rval = processTrigger(ctx, itdc, istart, istop);
       }
       if (rval) {
         return rval;
@@ -864,7 +917,7 @@ int DigiReco::reconstructTDC(int ibeg, int iend)
           // A gap is detected
           if (istart >= 0 && (istop - istart + 1) >= mFullInterpolationMinLength) {
             // Need data for at least mFullInterpolationMinLength (two) consecutive bunch crossings
-            int rval = fullInterpolation(isig, istart, istop);
+            int rval = fullInterpolation(ctx, isig, istart, istop);
             if (rval) {
               return rval;
             }
@@ -875,7 +928,7 @@ int DigiReco::reconstructTDC(int ibeg, int iend)
       }
       // Check if there are mFullInterpolationMinLength consecutive bunch crossings at the end of group
       if (istart >= 0 && (istop - istart + 1) >= mFullInterpolationMinLength) {
-        int rval = fullInterpolation(isig, istart, istop);
+        int rval = fullInterpolation(ctx, isig, istart, istop);
         if (rval) {
           return rval;
         }
@@ -902,7 +955,7 @@ int DigiReco::reconstructTDC(int ibeg, int iend)
   return 0;
 } // reconstructTDC
 
-int DigiReco::reconstruct(int ibeg, int iend)
+int DigiReco::reconstruct(DigiRecoContext& ctx, int ibeg, int iend)
 {
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
   LOG(info) << "________________________________________________________________________________";
@@ -934,7 +987,7 @@ int DigiReco::reconstruct(int ibeg, int iend)
 #endif
 
   // After pile-up correction, find signals around main-main that satisfy condition on TDC
-  findSignals(ibeg, iend);
+  findSignals(ctx, ibeg, iend);
 
   // For each calorimeter that has detects a collision at the time of main-main
   // collisions we reconstruct integrated charges and fill output tree
@@ -991,7 +1044,7 @@ int DigiReco::reconstruct(int ibeg, int iend)
     }
     // Analyze all bunches
     for (int ibun = ibeg; ibun <= iend; ibun++) {
-      updateOffsets(ibun); // Get Orbit pedestals
+      updateOffsets(ctx, ibun); // Get Orbit pedestals
       auto& rec = mReco[ibun];
       // Check if the corresponding TDC is fired
       ref[0] = mReco[ibun].ref[ich];
@@ -1030,8 +1083,8 @@ int DigiReco::reconstruct(int ibeg, int iend)
           // (reference can be orbit or QC). If pile-up is detected we use orbit pedestal
           // instead of event pedestal
           // TODO: pedestal event could have a TM..
-          if (hasEvPed && (mSource[ich] == PedOr || mSource[ich] == PedQC)) {
-            auto pedref = mOffset[ich];
+          if (hasEvPed && (ctx.source[ich] == PedOr || ctx.source[ich] == PedQC)) {
+            auto pedref = ctx.offset[ich];
             if (evPed > pedref && (evPed - pedref) > mRopt->ped_thr_hi[ich]) {
               // Anomalous offset (put a warning but use event pedestal)
               rec.offPed[ich] = true;
@@ -1045,11 +1098,11 @@ int DigiReco::reconstruct(int ibeg, int iend)
           if (hasEvPed && rec.pilePed[ich] == false) {
             myPed = evPed;
             rec.adcPedEv[ich] = true;
-          } else if (mSource[ich] == PedOr) {
-            myPed = mOffset[ich];
+          } else if (ctx.source[ich] == PedOr) {
+            myPed = ctx.offset[ich];
             rec.adcPedOr[ich] = true;
-          } else if (mSource[ich] == PedQC) {
-            myPed = mOffset[ich];
+          } else if (ctx.source[ich] == PedQC) {
+            myPed = ctx.offset[ich];
             rec.adcPedQC[ich] = true;
           } else {
             rec.adcPedMissing[ich] = true;
@@ -1105,18 +1158,18 @@ int DigiReco::reconstruct(int ibeg, int iend)
   return 0;
 } // reconstruct
 
-void DigiReco::updateOffsets(int ibun)
+void DigiReco::updateOffsets(DigiRecoContext& ctx, int ibun)
 {
   auto orbit = mBCData[ibun].ir.orbit;
-  if (orbit == mOffsetOrbit) {
+  if (orbit == ctx.offsetOrbit) {
     return;
   }
-  mOffsetOrbit = orbit;
+  ctx.offsetOrbit = orbit;
 
   // Reset information about pedestal origin
   for (int ich = 0; ich < NChannels; ich++) {
-    mSource[ich] = PedND;
-    mOffset[ich] = std::numeric_limits<float>::infinity();
+    ctx.source[ich] = PedND;
+    ctx.offset[ich] = std::numeric_limits<float>::infinity();
   }
 
   // Default TDC pedestal is from orbit
@@ -1128,8 +1181,8 @@ void DigiReco::updateOffsets(int ibun)
       auto myped = float(orbitdata.data[ich]) * mModuleConfig->baselineFactor;
       if (myped >= ADCMin && myped <= ADCMax) {
         // Pedestal information is present for this channel
-        mOffset[ich] = myped;
-        mSource[ich] = PedOr;
+        ctx.offset[ich] = myped;
+        ctx.source[ich] = PedOr;
       }
     }
   }
@@ -1137,30 +1190,30 @@ void DigiReco::updateOffsets(int ibun)
   // Use average "QC" pedestal if orbit pedestals are missing
   if (mPedParam != nullptr) {
     for (int ich = 0; ich < NChannels; ich++) {
-      if (mSource[ich] == PedND) {
+      if (ctx.source[ich] == PedND) {
         auto myped = mPedParam->getCalib(ich);
         if (myped >= ADCMin && myped <= ADCMax) {
-          mOffset[ich] = myped;
-          mSource[ich] = PedQC;
+          ctx.offset[ich] = myped;
+          ctx.source[ich] = PedQC;
         }
       }
     }
   }
 
   for (int ich = 0; ich < NChannels; ich++) {
-    if (mSource[ich] == PedND) {
-      mMissingPed[ich]++;
+    if (ctx.source[ich] == PedND) {
+      ctx.missingPed[ich]++;
       if (mVerbosity > DbgMinimal) {
-        LOGF(error, "Missing pedestal for ch %2d %s orbit %u ", ich, ChannelNames[ich], mOffsetOrbit);
+        LOGF(error, "Missing pedestal for ch %2d %s orbit %u ", ich, ChannelNames[ich], ctx.offsetOrbit);
       }
     }
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
-    LOGF(info, "Pedestal for ch %2d %s orbit %u %s: %f", ich, ChannelNames[ich], mOffsetOrbit, mSource[ich] == PedOr ? "OR" : (mSource[ich] == PedQC ? "QC" : "??"), mOffset[ich]);
+    LOGF(info, "Pedestal for ch %2d %s orbit %u %s: %f", ich, ChannelNames[ich], ctx.offsetOrbit, ctx.source[ich] == PedOr ? "OR" : (ctx.source[ich] == PedQC ? "QC" : "??"), ctx.offset[ich]);
 #endif
   }
 } // updateOffsets
 
-int DigiReco::processTrigger(int itdc, int ibeg, int iend)
+int DigiReco::processTrigger(DigiRecoContext& ctx, int itdc, int ibeg, int iend)
 {
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
   LOG(info) << __func__ << "(itdc=" << itdc << "[" << ChannelNames[TDCSignal[itdc]] << "], " << ibeg << ", " << iend << "): " << mReco[ibeg].ir.orbit << "." << mReco[ibeg].ir.bc << " - " << mReco[iend].ir.orbit << "." << mReco[iend].ir.bc;
@@ -1252,10 +1305,10 @@ int DigiReco::processTrigger(int itdc, int ibeg, int iend)
       break;
     }
   }
-  return interpolate(itdc, ibeg, iend);
+  return interpolate(ctx, itdc, ibeg, iend);
 } // processTrigger
 
-int DigiReco::processTriggerExtended(int itdc, int ibeg, int iend)
+int DigiReco::processTriggerExtended(DigiRecoContext& ctx, int itdc, int ibeg, int iend)
 {
   auto isig = TDCSignal[itdc];
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
@@ -1263,13 +1316,13 @@ int DigiReco::processTriggerExtended(int itdc, int ibeg, int iend)
 #endif
   // Extends search zone at the beginning of sequence. Need pedestal information.
   // For simplicity we use information for current bunch/orbit
-  updateOffsets(ibeg);
-  if (mSource[isig] == PedND) {
+  updateOffsets(ctx, ibeg);
+  if (ctx.source[isig] == PedND) {
     // Fall back to normal trigger
     // Message will be produced when computing amplitude (if a hit is found in this bunch)
     // In this framework we have a potential undetected inefficiency, however pedestal
     // problem is a serious problem and will be noticed anyway
-    return processTrigger(itdc, ibeg, iend);
+    return processTrigger(ctx, itdc, ibeg, iend);
   }
 
   int nbun = iend - ibeg + 1;
@@ -1305,9 +1358,9 @@ int DigiReco::processTriggerExtended(int itdc, int ibeg, int iend)
         LOG(error) << __func__ << " @ " << __LINE__ << " Missing information for bunch crossing " << mReco[b2].ir.orbit << "." << mReco[b2].ir.bc << " sig = " << isig;
         return __LINE__;
       }
-      diff = mOffset[isig] - mChData[ref_s].data[s2];
+      diff = ctx.offset[isig] - mChData[ref_s].data[s2];
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
-      m[0] = mOffset[isig];
+      m[0] = ctx.offset[isig];
       s[0] = mChData[ref_s].data[s2];
 #endif
     } else {
@@ -1365,71 +1418,117 @@ int DigiReco::processTriggerExtended(int itdc, int ibeg, int iend)
       break;
     }
   }
-  return interpolate(itdc, ibeg, iend);
+  return interpolate(ctx, itdc, ibeg, iend);
 } // processTriggerExtended
 
-// Interpolation for single point
-O2_ZDC_DIGIRECO_FLT DigiReco::getPoint(int isig, int ibeg, int iend, int i)
+void DigiReco::setSamples(DigiRecoContext& ctx, int isig, int ibeg, int iend)
 {
-  constexpr int nsbun = TSN * NTimeBinsPerBC; // Total number of interpolated points per bunch crossing
-  if (i >= mNtot || i < 0) {
-    LOG(error) << "Error addressing isig=" << isig << " i=" << i << " mNtot=" << mNtot;
-    mInError = true;
-    return std::numeric_limits<float>::infinity();
+  // Set configuration for interpolation of signal isig, in consecutive bunches from ibeg to iend
+  constexpr int MaxTimeBin = NTimeBinsPerBC - 1; //< number of samples per BC
+  ctx.nbun = iend - ibeg + 1;                    // Number of adjacent bunches
+  ctx.nsam = ctx.nbun * NTimeBinsPerBC;          // Number of acquired samples
+  ctx.ntot = ctx.nsam * TSN;                     // Total number of points in the interpolated arrays
+  ctx.nint = (ctx.nsam - 1) * TSN;               // Total points in the interpolation region (-1)
+  ctx.ilast = ctx.ntot - TSNH;                   // Index of last acquired sample
+
+  // auto ref_beg = mReco[ibeg].ref[isig];
+  // auto ref_end = mReco[iend].ref[isig];
+  // ctx.firstSample = mChData[ref_beg].data[0]; // Original points
+  // ctx.lastSample = mChData[ref_end].data[MaxTimeBin]; // Original points
+
+  ctx.firstSample = mReco[ibeg].data[isig][0];
+  ctx.lastSample = mReco[iend].data[isig][MaxTimeBin];
+
+  // Filtered samples of the sequence in a contiguous array. Interpolation uses constant
+  // extrapolation outside of the sequence: the array is padded with TSL copies of the
+  // first and of the last sample so that the interpolation loops have no boundary checks
+  ctx.samples.resize(ctx.nsam + 2 * TSL);
+  auto* samples = ctx.samples.data();
+  for (int is = 0; is < TSL; is++) {
+    samples[is] = ctx.firstSample;
+    samples[ctx.nsam + TSL + is] = ctx.lastSample;
   }
-  // Constant extrapolation at the beginning and at the end of the array
-  if (i < TSNH) {
-    // Return value of first sample
-    return mFirstSample;
-  } else if (i >= mIlast) {
-    // Return value of last sample
-    return mLastSample;
-  } else {
-    // Identification of the point to be assigned
-    int ibun = ibeg + i / nsbun;
-    // Interpolation between acquired points (N.B. from 0 to mNint)
-    i = i - TSNH;
-    int im = i % TSN;
+  for (int ibun = ibeg; ibun <= iend; ibun++) {
+    auto* dst = samples + TSL + (ibun - ibeg) * NTimeBinsPerBC;
+    const auto& data = mReco[ibun].data[isig]; // Filtered points
+    // const auto& data = mChData[mReco[ibun].ref[isig]].data; // Original points
+    for (int is = 0; is < NTimeBinsPerBC; is++) {
+      dst[is] = data[is];
+    }
+  }
+}
+
+void DigiReco::interpolateRange(const DigiRecoContext& ctx, int ifirst, int ilast, O2_ZDC_DIGIRECO_FLT* y) const
+{
+  // Interpolation of points ifirst <= i < ilast of current signal
+  // Points between two acquired samples are computed together: the loop on the
+  // interpolation phase is the innermost one and can be vectorized
+  const auto* samples = ctx.samples.data();
+  int i = ifirst;
+  while (i < ilast) {
+    if (i < TSNH) {
+      // Constant extrapolation at the beginning of the array
+      *y++ = ctx.firstSample;
+      i++;
+      continue;
+    }
+    if (i >= ctx.ilast) {
+      // Constant extrapolation at the end of the array
+      *y++ = ctx.lastSample;
+      i++;
+      continue;
+    }
+    // Interpolation between acquired points (N.B. from 0 to nint)
+    int ip = (i - TSNH) / TSN;
+    int im_beg = (i - TSNH) % TSN;
+    int im_end = std::min(TSN, im_beg + std::min(ilast, ctx.ilast) - i);
+    int im = im_beg;
     if (im == 0) {
       // This is an acquired point
-      int ip = (i / TSN) % NTimeBinsPerBC;
-      int ib = ibeg + (i / TSN) / NTimeBinsPerBC;
-      if (ib != ibun) {
-        LOG(error) << "ib=" << ib << " ibun=" << ibun;
-        mInError = true;
-        return std::numeric_limits<float>::infinity();
-      }
-      return mReco[ibun].data[isig][ip]; // Filtered point
-      // return mChData[mReco[ibun].ref[isig]].data[ip]; // Original point
-    } else {
-      // Do the actual interpolation
-      O2_ZDC_DIGIRECO_FLT y = 0;
-      int ip = i / TSN;
-      O2_ZDC_DIGIRECO_FLT sum = 0;
-      for (int is = TSN - im, ii = ip - TSL + 1; is < NTS; is += TSN, ii++) {
-        // Default is first point in the array
-        O2_ZDC_DIGIRECO_FLT yy = mFirstSample;
-        if (ii > 0) {
-          if (ii < mNsam) {
-            int ip = ii % NTimeBinsPerBC;
-            int ib = ibeg + ii / NTimeBinsPerBC;
-            yy = mReco[ib].data[isig][ip];
-            // yy = mChData[mReco[ib].ref[isig]].data[ip];
-          } else {
-            // Last acquired point
-            yy = mLastSample;
-          }
+      *y++ = samples[ip + TSL];
+      im++;
+    }
+    int np = im_end - im;
+    if (np > 0) {
+      // Samples from ip - TSL + 1 to ip + TSL contribute to the interpolation
+      const auto* s = samples + ip + 1;
+      for (int j = 0; j < np; j++) {
+        y[j] = 0;
+      }
+      for (int k = 0; k < 2 * TSL; k++) {
+        const O2_ZDC_DIGIRECO_FLT yy = s[k];
+        const auto* ts = &mTSPhase[k][im];
+#ifdef WITH_OPENMP
+#pragma omp simd
+#endif
+        for (int j = 0; j < np; j++) {
+          y[j] += yy * ts[j];
         }
-        sum += mTS[is];
-        y += yy * mTS[is];
       }
-      y = y / sum;
-      return y;
+      const auto* sum = &mTSSum[im];
+      for (int j = 0; j < np; j++) {
+        y[j] = y[j] / sum[j];
+      }
+      y += np;
     }
+    i += im_end - im_beg;
+  }
+}
+
+// Interpolation for single point
+O2_ZDC_DIGIRECO_FLT DigiReco::getPoint(DigiRecoContext& ctx, int i)
+{
+  if (i >= ctx.ntot || i < 0) {
+    LOG(error) << "Error addressing i=" << i << " ntot=" << ctx.ntot;
+    ctx.inError = true;
+    return std::numeric_limits<float>::infinity();
   }
+  O2_ZDC_DIGIRECO_FLT y;
+  interpolateRange(ctx, i, i + 1, &y);
+  return y;
 }
 
-void DigiReco::setPoint(int isig, int ibeg, int iend, int i)
+void DigiReco::setPoints(DigiRecoContext& ctx, int isig, int ibeg, int iend)
 {
   // This function needs to be used only if mFullInterpolation is true otherwise the
   // vectors are not allocated
@@ -1438,28 +1537,17 @@ void DigiReco::setPoint(int isig, int ibeg, int iend, int i)
     return;
   }
   constexpr int nsbun = TSN * NTimeBinsPerBC; // Total number of interpolated points per bunch crossing
-  if (i >= mNtot || i < 0) {
-    LOG(error) << "Error addressing signal isig=" << isig << " i=" << i << " mNtot=" << mNtot;
-    mInError = true;
-    return;
-  }
-  // Constant extrapolation at the beginning and at the end of the array
-  if (i < TSNH) {
-    // Assign value of first sample
-    mReco[ibeg].inter[isig][i] = mFirstSample;
-  } else if (i >= mIlast) {
-    // Assign value of last sample
-    int isam = i % nsbun;
-    mReco[iend].inter[isig][isam] = mLastSample;
-  } else {
-    // Identification of the point to be assigned
-    int ibun = ibeg + i / nsbun;
-    int isam = i % nsbun;
-    mReco[ibun].inter[isig][isam] = getPoint(isig, ibeg, iend, i);
+  // Interpolate the whole sequence and then distribute the points to the bunch crossings
+  ctx.interpolated.resize(ctx.ntot);
+  interpolateRange(ctx, 0, ctx.ntot, ctx.interpolated.data());
+  for (int ibun = ibeg; ibun <= iend; ibun++) {
+    mReco[ibun].allocate(isig);
+    auto first = ctx.interpolated.begin() + (ibun - ibeg) * nsbun;
+    std::copy(first, first + nsbun, mReco[ibun].inter[isig].begin());
   }
-} // setPoint
+} // setPoints
 
-int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
+int DigiReco::fullInterpolation(DigiRecoContext& ctx, int isig, int ibeg, int iend)
 {
   // Interpolation of signal isig, in consecutive bunches from ibeg to iend
   // This function works for all signals and does not evaluate trigger
@@ -1471,15 +1559,6 @@ int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
   // TODO: get data from preceding time frame in case there are bunches
   // with signal at the beginning of the first orbit of a time frame
 
-  constexpr int MaxTimeBin = NTimeBinsPerBC - 1; //< number of samples per BC
-
-  // Set data members for interpolation of the current channel
-  mNbun = iend - ibeg + 1;                    // Number of adjacent bunches
-  mNsam = mNbun * NTimeBinsPerBC;             // Number of acquired samples
-  mNtot = mNsam * TSN;                        // Total number of points in the interpolated arrays
-  mNint = (mNbun * NTimeBinsPerBC - 1) * TSN; // Total points in the interpolation region (-1)
-  mIlast = mNtot - TSNH;                      // Index of last acquired sample
-
   // At this level there should be no need to check if the channel is connected
   // since a fatal should have been raised already
   for (int ibun = ibeg; ibun <= iend; ibun++) {
@@ -1490,23 +1569,18 @@ int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
     }
   }
 
-  mFirstSample = mReco[ibeg].data[isig][0];
-  mLastSample = mReco[iend].data[isig][MaxTimeBin];
+  // Set configuration for interpolation of the current channel
+  setSamples(ctx, isig, ibeg, iend);
 
   // Allocate and fill array of interpolated points
-  for (int ibun = ibeg; ibun <= iend; ibun++) {
-    mReco[ibun].allocate(isig);
-  }
-  for (int i = 0; i < mNtot; i++) {
-    setPoint(isig, ibeg, iend, i);
-  }
-  if (mInError) {
+  setPoints(ctx, isig, ibeg, iend);
+  if (ctx.inError) {
     return __LINE__;
   }
   return 0;
 }
 
-int DigiReco::interpolate(int itdc, int ibeg, int iend)
+int DigiReco::interpolate(DigiRecoContext& ctx, int itdc, int ibeg, int iend)
 {
   // Interpolation of TDC channel itdc, in consecutive bunches from ibeg to iend
   int isig = TDCSignal[itdc];
@@ -1521,13 +1595,6 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
   constexpr int MaxTimeBin = NTimeBinsPerBC - 1; //< number of samples per BC
   constexpr int nsbun = TSN * NTimeBinsPerBC;    // Total number of interpolated points per bunch crossing
 
-  // Set data members for interpolation of the current TDC
-  mNbun = iend - ibeg + 1;                    // Number of adjacent bunches
-  mNsam = mNbun * NTimeBinsPerBC;             // Number of acquired samples
-  mNtot = mNsam * TSN;                        // Total number of points in the interpolated arrays
-  mNint = (mNbun * NTimeBinsPerBC - 1) * TSN; // Total points in the interpolation region (-1)
-  mIlast = mNtot - TSNH;                      // Index of last acquired sample
-
   constexpr int nsp = 5; // Number of points to be searched
 
   // At this level there should be no need to check if the channel is connected
@@ -1540,27 +1607,18 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
     }
   }
 
-  // auto ref_beg = mReco[ibeg].ref[isig];
-  // auto ref_end = mReco[iend].ref[isig];
-  // mFirstSample = mChData[ref_beg].data[0]; // Original points
-  // mLastSample = mChData[ref_end].data[MaxTimeBin]; // Original points
-
-  mFirstSample = mReco[ibeg].data[isig][0];
-  mLastSample = mReco[iend].data[isig][MaxTimeBin];
+  // Set configuration for interpolation of the current TDC
+  setSamples(ctx, isig, ibeg, iend);
 
   // mFullInterpolation turns on full interpolation for debugging
   // otherwise the interpolation is performed only around actual signal
   if (mFullInterpolation) {
-    for (int ibun = ibeg; ibun <= iend; ibun++) {
-      mReco[ibun].allocate(isig);
-    }
-    for (int i = 0; i < mNtot; i++) {
-      setPoint(isig, ibeg, iend, i);
-    }
+    setPoints(ctx, isig, ibeg, iend);
   }
-  if (mInError) {
+  if (ctx.inError) {
     return __LINE__;
   }
+  O2_ZDC_DIGIRECO_FLT refined[TSN]; // Interpolated points in the refined search zone
   // Looking for a local maximum in a search zone
   O2_ZDC_DIGIRECO_FLT amp = std::numeric_limits<float>::infinity(); // Amplitude to be stored
   int isam_amp = 0;                                                 // Sample at maximum amplitude (relative to beginning of group)
@@ -1571,7 +1629,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
   int ip[nsp] = {-1, -1, -1, -1, -1};
   // N.B. Points at the extremes are constant therefore no local maximum
   // can occur in these two regions
-  for (int i = 0; i < mNint; i += mInterpolationStep) {
+  for (int i = 0; i < ctx.nint; i += mInterpolationStep) {
     int isam = i + TSNH;
     // Check if trigger is fired for this point
     // For the moment we don't take into account possible extensions of the search zone
@@ -1686,16 +1744,17 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
             sbeg = 0;
             send = sbeg + TSN;
           }
-          if (send > (mNint + TSNH)) {
-            send = mNint + TSNH;
+          if (send > (ctx.nint + TSNH)) {
+            send = ctx.nint + TSNH;
             sbeg = send - TSN;
           }
           if (sbeg < 0) {
             sbeg = 0;
           }
+          // Perform interpolation for all the searched points
+          interpolateRange(ctx, sbeg, send, refined);
           for (int spos = sbeg; spos < send; spos++) {
-            // Perform interpolation for the searched point
-            O2_ZDC_DIGIRECO_FLT myval = getPoint(isig, ibeg, iend, spos);
+            O2_ZDC_DIGIRECO_FLT myval = refined[spos - sbeg];
             // Get local minimum of waveform
             if (myval < amp) {
               amp = myval;
@@ -1705,19 +1764,19 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
         }
         // Store identified peak
         int ibun = ibeg + isam_amp / nsbun;
-        updateOffsets(ibun);
+        updateOffsets(ctx, ibun);
         // At this level offsets are from Orbit or QC therefore
         // the TDC amplitude and time are affected by pile-up from
         // previous collisions. Pile up correction needs to be
         // performed after all signals have been identified
-        if (mSource[isig] != PedND) {
-          amp = mOffset[isig] - amp;
+        if (ctx.source[isig] != PedND) {
+          amp = ctx.offset[isig] - amp;
         } else {
           LOGF(error, "%u.%-4d Missing pedestal for TDC %d %s ", mBCData[ibun].ir.orbit, mBCData[ibun].ir.bc, itdc, ChannelNames[TDCSignal[itdc]]);
           amp = std::numeric_limits<float>::infinity();
         }
         int tdc = isam_amp % nsbun;
-        assignTDC(ibun, ibeg, iend, itdc, tdc, amp);
+        assignTDC(ctx, ibun, ibeg, iend, itdc, tdc, amp);
       }
       amp = std::numeric_limits<float>::infinity();
       isam_amp = 0;
@@ -1731,7 +1790,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
         myval = mReco[ib_cur].inter[isig][mysam];
       } else {
         // Perform interpolation for the searched point
-        myval = getPoint(isig, ibeg, iend, isam);
+        myval = getPoint(ctx, isam);
       }
       // Get local minimum of waveform
       if (myval < amp) {
@@ -1740,7 +1799,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
       }
     }
   } // Loop on interpolated points
-  if (mInError) {
+  if (ctx.inError) {
     return __LINE__;
   }
 
@@ -1756,16 +1815,17 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
           sbeg = 0;
           send = sbeg + TSN;
         }
-        if (send > (mNint + TSNH)) {
-          send = mNint + TSNH;
+        if (send > (ctx.nint + TSNH)) {
+          send = ctx.nint + TSNH;
           sbeg = send - TSN;
         }
         if (sbeg < 0) {
           sbeg = 0;
         }
+        // Perform interpolation for all the searched points
+        interpolateRange(ctx, sbeg, send, refined);
         for (int spos = sbeg; spos < send; spos++) {
-          // Perform interpolation for the searched point
-          O2_ZDC_DIGIRECO_FLT myval = getPoint(isig, ibeg, iend, spos);
+          O2_ZDC_DIGIRECO_FLT myval = refined[spos - sbeg];
           // Get local minimum of waveform
           if (myval < amp) {
             amp = myval;
@@ -1775,25 +1835,25 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
       }
       // Store identified peak
       int ibun = ibeg + isam_amp / nsbun;
-      updateOffsets(ibun);
-      if (mSource[isig] != PedND) {
-        amp = mOffset[isig] - amp;
+      updateOffsets(ctx, ibun);
+      if (ctx.source[isig] != PedND) {
+        amp = ctx.offset[isig] - amp;
       } else {
         LOGF(error, "%u.%-4d Missing pedestal for TDC %d %s ", mBCData[ibun].ir.orbit, mBCData[ibun].ir.bc, itdc, ChannelNames[TDCSignal[itdc]]);
         amp = std::numeric_limits<float>::infinity();
       }
       int tdc = isam_amp % nsbun;
-      assignTDC(ibun, ibeg, iend, itdc, tdc, amp);
+      assignTDC(ctx, ibun, ibeg, iend, itdc, tdc, amp);
     }
   }
-  if (mInError) {
+  if (ctx.inError) {
     return __LINE__;
   }
   // TODO: add logic to assign TDC in presence of overflow
   return 0;
 } // interpolate
 
-void DigiReco::assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float amp)
+void DigiReco::assignTDC(DigiRecoContext& ctx, int ibun, int ibeg, int iend, int itdc, int tdc, float amp)
 {
   constexpr int nsbun = TSN * NTimeBinsPerBC; // Total number of interpolated points per bunch crossing
   constexpr int tdc_max = nsbun / 2;
@@ -1849,11 +1909,11 @@ void DigiReco::assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float
   }
 #endif
   // Assign info about pedestal subtration
-  if (mSource[isig] == PedOr) {
+  if (ctx.source[isig] == PedOr) {
     rec.tdcPedOr[isig] = true;
-  } else if (mSource[isig] == PedQC) {
+  } else if (ctx.source[isig] == PedQC) {
     rec.tdcPedQC[isig] = true;
-  } else if (mSource[isig] == PedEv) {
+  } else if (ctx.source[isig] == PedEv) {
     // In present implementation this never happens
     rec.tdcPedEv[isig] = true;
   } else {
@@ -1862,7 +1922,7 @@ void DigiReco::assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
   LOG(info) << __func__ << " itdc=" << itdc << " " << ChannelNames[isig] << " @ ibun=" << ibun << " " << mReco[ibun].ir.orbit << "." << mReco[ibun].ir.bc << " "
             << " tdc=" << tdc << " -> " << TDCValCorr << " shift=" << tdc_shift[itdc] << " -> TDCVal=" << TDCVal << "=" << TDCVal * o2::zdc::FTDCVal
-            << " mSource[" << isig << "] = " << unsigned(mSource[isig]) << " = " << mOffset[isig]
+            << " source[" << isig << "] = " << unsigned(ctx.source[isig]) << " = " << ctx.offset[isig]
             << " amp=" << amp << " -> " << TDCAmpCorr << " calib=" << tdc_calib[itdc] << " offset=" << tdc_offset[itdc] << " -> TDCAmp=" << TDCAmp << "=" << myamp
             << (ibun == ibeg ? " B" : "") << (ibun == iend ? " E" : "");
   mAssignedTDC[itdc]++;
@@ -1870,7 +1930,7 @@ void DigiReco::assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float
   ihit++;
 } // assignTDC
 
-void DigiReco::findSignals(int ibeg, int iend)
+void DigiReco::findSignals(DigiRecoContext& ctx, int ibeg, int iend)
 {
   // N.B. findSignals is called after pile-up correction on TDCs
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
@@ -1878,7 +1938,7 @@ void DigiReco::findSignals(int ibeg, int iend)
 #endif
   // Identify TDC signals
   for (int ibun = ibeg; ibun <= iend; ibun++) {
-    updateOffsets(ibun); // Get orbit pedestals or run pedestals as a fallback
+    updateOffsets(ctx, ibun); // Get orbit pedestals or run pedestals as a fallback
     auto& rec = mReco[ibun];
     for (int itdc = 0; itdc < NTDCChannels; itdc++) {
 #ifdef ALICEO2_ZDC_DIGI_RECO_DEBUG
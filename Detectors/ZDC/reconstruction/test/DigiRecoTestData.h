@@ -0,0 +1,202 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DigiRecoTestData.h
+/// \brief Configuration objects and synthetic digits to run DigiReco without CCDB access
+
+#ifndef O2_ZDC_DIGIRECOTESTDATA_H
+#define O2_ZDC_DIGIRECOTESTDATA_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "CommonConstants/LHCConstants.h"
+#include "CommonDataFormat/InteractionRecord.h"
+#include "DataFormatsZDC/BCData.h"
+#include "DataFormatsZDC/ChannelData.h"
+#include "DataFormatsZDC/OrbitData.h"
+#include "ZDCBase/Constants.h"
+#include "ZDCBase/ModuleConfig.h"
+#include "ZDCReconstruction/RecoConfigZDC.h"
+#include "ZDCReconstruction/ZDCTDCParam.h"
+
+namespace o2
+{
+namespace zdc
+{
+namespace test
+{
+
+/// Same module layout as in macro/CreateModuleConfig.C
+inline ModuleConfig createModuleConfig()
+{
+  ModuleConfig conf;
+  conf.nBunchAverage = 2;
+  int bshift = std::ceil(std::log2(double(NTimeBinsPerBC) * double(conf.nBunchAverage) * double(ADCRange))) - 16;
+  int divisor = 0x1 << bshift;
+  conf.baselineFactor = float(divisor) / float(conf.nBunchAverage) / float(NTimeBinsPerBC);
+
+  // Channel IDs of the four slots of each module: the common PMs are read out in the even modules and
+  // only trigger in the odd ones, where the analog sums are read out instead. ZEMs are in modules 4 and 6
+  const int8_t ids[NModules][NChPerModule] = {{IdZNAC, IdZNASum, IdZNA1, IdZNA2}, {IdZNAC, IdZNASum, IdZNA3, IdZNA4},
+                                              {IdZNCC, IdZNCSum, IdZNC1, IdZNC2}, {IdZNCC, IdZNCSum, IdZNC3, IdZNC4},
+                                              {IdZPAC, IdZEM1, IdZPA1, IdZPA2}, {IdZPAC, IdZPASum, IdZPA3, IdZPA4},
+                                              {IdZPCC, IdZEM2, IdZPC3, IdZPC4}, {IdZPCC, IdZPCSum, IdZPC1, IdZPC2}};
+  for (int im = 0; im < NModules; im++) {
+    auto& module = conf.modules[im];
+    module.id = im;
+    bool even = (im % 2) == 0;
+    bool zem = ids[im][1] == IdZEM1 || ids[im][1] == IdZEM2;
+    module.setChannel(0, ids[im][0], 2 * im, even, true, -5, 6, 4, 12);
+    module.setChannel(1, ids[im][1], 2 * im, !even || zem, zem, -5, 6, 4, 12);
+    module.setChannel(2, ids[im][2], 2 * im + 1, true, false, -5, 6, 4, 12);
+    module.setChannel(3, ids[im][3], 2 * im + 1, true, false, -5, 6, 4, 12);
+  }
+  conf.check();
+  return conf;
+}
+
+/// Same settings as in macro/CreateRecoConfigZDC.C
+inline RecoConfigZDC createRecoConfig()
+{
+  RecoConfigZDC conf;
+  conf.setDoubleTrigger();
+  for (int itdc = 0; itdc < NTDCChannels; itdc++) {
+    conf.setSearch(itdc, 250);
+  }
+  for (int ich = 0; ich < NChannels; ich++) {
+    conf.setIntegration(ich, 6, 8, -12, -8);
+    conf.setPedThreshold(ich, ADCRange, ADCRange);
+  }
+  return conf;
+}
+
+/// Same settings as in macro/CreateTDCCalib.C
+inline ZDCTDCParam createTDCParam()
+{
+  ZDCTDCParam param;
+  for (int itdc = 0; itdc < NTDCChannels; itdc++) {
+    param.setShift(itdc, 12.5);
+    param.setFactor(itdc, 1.);
+  }
+  return param;
+}
+
+/// Time frame of synthetic digits: runs of consecutive bunch crossings with negative pulses
+/// on top of a constant pedestal, separated by gaps, as in triggered readout
+struct DigiRecoTestData {
+  std::vector<OrbitData> orbitData;
+  std::vector<BCData> bcData;
+  std::vector<ChannelData> chData;
+
+  DigiRecoTestData(const ModuleConfig& conf, int nOrbits, int nRunsPerOrbit, unsigned seed = 1234)
+  {
+    constexpr float Pedestal = 100.;
+    constexpr float SampleWidth = 25. / NTimeBinsPerBC; // ns
+    constexpr float RiseTime = 4.;                      // ns
+    constexpr int MaxRunLength = 6;
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> flat(0., 1.);
+    std::normal_distribution<float> noise(0., 1.5);
+
+    // Slots that are read out and slots that provide the autotrigger bits
+    uint32_t chRead = 0, chTrig = 0;
+    for (int im = 0; im < NModules; im++) {
+      for (int ic = 0; ic < NChPerModule; ic++) {
+        const auto& module = conf.modules[im];
+        chRead |= module.readChannel[ic] ? (0x1 << (4 * im + ic)) : 0;
+        chTrig |= module.readChannel[ic] && module.trigChannel[ic] ? (0x1 << (4 * im + ic)) : 0;
+      }
+    }
+
+    std::array<int16_t, NChannels> ped;
+    ped.fill(std::nearbyint(Pedestal / conf.baselineFactor));
+    std::array<uint16_t, NChannels> scaler{};
+    int spacing = o2::constants::lhc::LHCMaxBunches / nRunsPerOrbit;
+    for (int iorb = 0; iorb < nOrbits; iorb++) {
+      uint32_t orbit = 1000 + iorb;
+      orbitData.emplace_back(o2::InteractionRecord(o2::constants::lhc::LHCMaxBunches - 1, orbit), ped, scaler);
+      for (int irun = 0; irun < nRunsPerOrbit; irun++) {
+        // Mostly short runs, a few lonely bunches
+        int nbc = 1 + int(flat(gen) * MaxRunLength);
+        int bc0 = irun * spacing + int(flat(gen) * (spacing - MaxRunLength - 1));
+        int nsam = nbc * NTimeBinsPerBC;
+        std::vector<uint32_t> trig(nbc, 0);
+        std::vector<uint16_t> modTrig(nbc * NModules, 0);
+        std::vector<std::vector<float>> waves(NChannels);
+        for (int im = 0; im < NModules; im++) {
+          for (int ic = 0; ic < NChPerModule; ic++) {
+            const auto& module = conf.modules[im];
+            if (!module.readChannel[ic]) {
+              continue;
+            }
+            auto& wave = waves[module.channelID[ic]];
+            wave.resize(nsam);
+            for (int is = 0; is < nsam; is++) {
+              wave[is] = Pedestal + noise(gen);
+            }
+            // Signals in 60% of the bunches, with pile-up from the preceding ones
+            for (int ib = 0; ib < nbc; ib++) {
+              if (flat(gen) > 0.6) {
+                continue;
+              }
+              float amp = 20. + flat(gen) * 1500.;
+              float t0 = (ib * NTimeBinsPerBC + 3 + flat(gen) * 4.) * SampleWidth;
+              for (int is = 0; is < nsam; is++) {
+                float x = (is * SampleWidth - t0) / RiseTime;
+                if (x > 0) {
+                  wave[is] -= amp * x * x * std::exp(2. * (1. - x));
+                }
+              }
+              if (amp > 40. && (chTrig & (0x1 << (4 * im + ic)))) {
+                trig[ib] |= 0x1 << (4 * im + ic);
+                ModuleTriggerMapData mt;
+                mt.w = modTrig[ib * NModules + im];
+                mt.f.Auto_0 = 1;
+                modTrig[ib * NModules + im] = mt.w;
+                if (ib + 1 < nbc) {
+                  mt.w = modTrig[(ib + 1) * NModules + im];
+                  mt.f.Auto_m = 1;
+                  modTrig[(ib + 1) * NModules + im] = mt.w;
+                }
+              }
+            }
+          }
+        }
+        for (int ib = 0; ib < nbc; ib++) {
+          int first = chData.size();
+          for (int ich = 0; ich < NChannels; ich++) {
+            if (waves[ich].empty()) {
+              continue;
+            }
+            std::array<float, NTimeBinsPerBC> samples;
+            for (int is = 0; is < NTimeBinsPerBC; is++) {
+              samples[is] = std::clamp(std::nearbyint(waves[ich][ib * NTimeBinsPerBC + is]), float(ADCMin), float(ADCMax));
+            }
+            chData.emplace_back(ich, samples);
+          }
+          auto& bcd = bcData.emplace_back(first, chData.size() - first, o2::InteractionRecord(bc0 + ib, orbit), chRead, trig[ib], 0);
+          for (int im = 0; im < NModules; im++) {
+            bcd.moduleTriggers[im] = modTrig[ib * NModules + im];
+          }
+        }
+      }
+    }
+  }
+};
+
+} // namespace test
+} // namespace zdc
+} // namespace o2
+
+#endif
@@ -0,0 +1,76 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// ZDC reconstruction of a time frame of synthetic digits with a variable number of threads,
+/// the argument is the number of threads passed to DigiReco::setNThreads.
+
+#include <benchmark/benchmark.h>
+#include "DigiRecoTestData.h"
+#include "ZDCReconstruction/DigiReco.h"
+
+using namespace o2::zdc;
+
+namespace
+{
+// 128 orbits, about 1/4 of a time frame
+constexpr int NOrbits = 128;
+constexpr int NRunsPerOrbit = 40;
+
+struct Setup {
+  ModuleConfig moduleConfig = test::createModuleConfig();
+  RecoConfigZDC recoConfig = test::createRecoConfig();
+  ZDCTDCParam tdcParam = test::createTDCParam();
+  test::DigiRecoTestData digits{moduleConfig, NOrbits, NRunsPerOrbit};
+  DigiReco reco;
+
+  Setup()
+  {
+    reco.setModuleConfig(&moduleConfig);
+    reco.setRecoConfigZDC(&recoConfig);
+    reco.setTDCParam(&tdcParam);
+    reco.init();
+  }
+};
+
+// DigiReco::init updates the RecoParamZDC singleton, therefore a single instance is shared by all benchmarks
+Setup& getSetup()
+{
+  static Setup setup;
+  return setup;
+}
+} // namespace
+
+static void BM_DigiReco(benchmark::State& state)
+{
+  auto& setup = getSetup();
+  setup.reco.setFullInterpolation(false);
+  setup.reco.setNThreads(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(setup.reco.process(setup.digits.orbitData, setup.digits.bcData, setup.digits.chData));
+  }
+  state.SetItemsProcessed(state.iterations() * setup.digits.bcData.size());
+}
+
+static void BM_DigiRecoFullInterpolation(benchmark::State& state)
+{
+  auto& setup = getSetup();
+  setup.reco.setFullInterpolation(true);
+  setup.reco.setNThreads(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(setup.reco.process(setup.digits.orbitData, setup.digits.bcData, setup.digits.chData));
+  }
+  state.SetItemsProcessed(state.iterations() * setup.digits.bcData.size());
+}
+
+BENCHMARK(BM_DigiReco)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DigiRecoFullInterpolation)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
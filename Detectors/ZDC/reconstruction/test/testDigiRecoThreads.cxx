@@ -0,0 +1,119 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test ZDC DigiReco thread count independence
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+#include "DigiRecoTestData.h"
+#include "ZDCReconstruction/DigiReco.h"
+
+namespace o2
+{
+namespace zdc
+{
+namespace
+{
+// Members of RecEventAux that are filled by DigiReco::process
+void compareReco(const RecEventAux& seq, const RecEventAux& par)
+{
+  BOOST_CHECK(seq.ir == par.ir);
+  BOOST_CHECK_EQUAL(seq.channels, par.channels);
+  BOOST_CHECK_EQUAL(seq.triggers, par.triggers);
+  BOOST_CHECK_EQUAL(seq.ezdcDecoded, par.ezdcDecoded);
+  BOOST_CHECK(seq.ezdc == par.ezdc);
+  for (int itdc = 0; itdc < NTDCChannels; itdc++) {
+    BOOST_CHECK_EQUAL(seq.ntdc[itdc], par.ntdc[itdc]);
+    BOOST_CHECK_EQUAL(seq.fired[itdc], par.fired[itdc]);
+    BOOST_CHECK(seq.TDCVal[itdc] == par.TDCVal[itdc]);
+    BOOST_CHECK(seq.TDCAmp[itdc] == par.TDCAmp[itdc]);
+    BOOST_CHECK(seq.TDCPile[itdc] == par.TDCPile[itdc]);
+  }
+  for (int ich = 0; ich < NChannels; ich++) {
+    BOOST_CHECK_EQUAL(seq.chfired[ich], par.chfired[ich]);
+    BOOST_CHECK_EQUAL(seq.ref[ich], par.ref[ich]);
+    BOOST_CHECK(seq.data[ich] == par.data[ich]);
+    BOOST_CHECK(seq.inter[ich] == par.inter[ich]);
+  }
+  // Reconstruction messages
+  BOOST_CHECK(seq.genericE == par.genericE);
+  BOOST_CHECK(seq.tdcPedEv == par.tdcPedEv);
+  BOOST_CHECK(seq.tdcPedOr == par.tdcPedOr);
+  BOOST_CHECK(seq.tdcPedQC == par.tdcPedQC);
+  BOOST_CHECK(seq.tdcPedMissing == par.tdcPedMissing);
+  BOOST_CHECK(seq.adcPedEv == par.adcPedEv);
+  BOOST_CHECK(seq.adcPedOr == par.adcPedOr);
+  BOOST_CHECK(seq.adcPedQC == par.adcPedQC);
+  BOOST_CHECK(seq.adcPedMissing == par.adcPedMissing);
+  BOOST_CHECK(seq.offPed == par.offPed);
+  BOOST_CHECK(seq.pilePed == par.pilePed);
+  BOOST_CHECK(seq.pileTM == par.pileTM);
+  BOOST_CHECK(seq.adcMissingwTDC == par.adcMissingwTDC);
+  BOOST_CHECK(seq.tdcPileEvC == par.tdcPileEvC);
+  BOOST_CHECK(seq.tdcPileEvE == par.tdcPileEvE);
+  BOOST_CHECK(seq.tdcPileM1C == par.tdcPileM1C);
+  BOOST_CHECK(seq.tdcPileM1E == par.tdcPileM1E);
+  BOOST_CHECK(seq.tdcPileM2C == par.tdcPileM2C);
+  BOOST_CHECK(seq.tdcPileM2E == par.tdcPileM2E);
+  BOOST_CHECK(seq.tdcPileM3C == par.tdcPileM3C);
+  BOOST_CHECK(seq.tdcPileM3E == par.tdcPileM3E);
+  BOOST_CHECK(seq.tdcSigE == par.tdcSigE);
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(DigiRecoThreads)
+{
+  auto moduleConfig = test::createModuleConfig();
+  auto recoConfig = test::createRecoConfig();
+  auto tdcParam = test::createTDCParam();
+  test::DigiRecoTestData digits(moduleConfig, 10, 40);
+
+  // A single instance is used since the initialization updates the RecoParamZDC singleton
+  DigiReco reco;
+  reco.setModuleConfig(&moduleConfig);
+  reco.setRecoConfigZDC(&recoConfig);
+  reco.setTDCParam(&tdcParam);
+  reco.init();
+
+  for (bool fullInterpolation : {false, true}) {
+    reco.setFullInterpolation(fullInterpolation);
+    reco.setNThreads(1);
+    BOOST_REQUIRE_EQUAL(reco.process(digits.orbitData, digits.bcData, digits.chData), 0);
+    std::vector<RecEventAux> seq = reco.getReco();
+    BOOST_REQUIRE_EQUAL(seq.size(), digits.bcData.size());
+
+    // Some signals must have been found, otherwise the comparison is meaningless
+    int nTDC = 0, nADC = 0;
+    for (const auto& rec : seq) {
+      for (int itdc = 0; itdc < NTDCChannels; itdc++) {
+        nTDC += rec.TDCVal[itdc].size();
+      }
+      nADC += rec.ezdc.size();
+    }
+    BOOST_CHECK(nTDC > 0);
+    BOOST_CHECK(nADC > 0);
+
+    for (int nThreads : {2, 4, 7}) {
+      reco.setNThreads(nThreads);
+      BOOST_REQUIRE_EQUAL(reco.process(digits.orbitData, digits.bcData, digits.chData), 0);
+      const auto& par = reco.getReco();
+      BOOST_REQUIRE_EQUAL(par.size(), seq.size());
+      for (size_t ibc = 0; ibc < seq.size(); ibc++) {
+        compareReco(seq[ibc], par[ibc]);
+      }
+    }
+  }
+}
+
+} // namespace zdc
+} // namespace o2
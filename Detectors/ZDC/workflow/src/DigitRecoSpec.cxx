@@ -66,6 +66,7 @@ void DigitRecoSpec::init(o2::framework::InitContext& ic)
   if (mMaxWave > 0) {
     LOG(warning) << "Limiting the number of waveforms in ourput to " << mMaxWave;
   }
+  mNThreads = ic.options().get<int>("nthreads");
   mRecoFraction = ic.options().get<double>("tf-fraction");
   if (mRecoFraction < 0 || mRecoFraction > 1) {
     LOG(error) << "Unphysical reconstructed fraction " << mRecoFraction << " set to 1.0";
@@ -165,6 +166,7 @@ void DigitRecoSpec::run(ProcessingContext& pc)
       mWorker.setDebugOutput();
     }
     mWorker.setVerbosity(mVerbosity);
+    mWorker.setNThreads(mNThreads);
     mWorker.init();
   }
   auto cput = mTimer.CpuTime();
@@ -323,7 +325,8 @@ framework::DataProcessorSpec getDigitRecoSpec(const int verbosity = 0, const boo
     outputs,
     AlgorithmSpec{adaptFromTask<DigitRecoSpec>(verbosity, enableDebugOut, enableZDCTDCCorr, enableZDCEnergyParam, enableZDCTowerParam, enableBaselineParam)},
     o2::framework::Options{{"max-wave", o2::framework::VariantType::Int, 0, {"Maximum number of waveforms per TF in output"}},
-                           {"tf-fraction", o2::framework::VariantType::Double, 1.0, {"Fraction of reconstructed TFs"}}}};
+                           {"tf-fraction", o2::framework::VariantType::Double, 1.0, {"Fraction of reconstructed TFs"}},
+                           {"nthreads", o2::framework::VariantType::Int, 1, {"Number of threads for the reconstruction of bunch crossing ranges"}}}};
 }
 
 } // namespace zdc
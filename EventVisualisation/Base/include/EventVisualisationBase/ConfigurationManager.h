@@ -75,6 +75,7 @@ class ConfigurationManager
   static std::string getDataPhysicsRunDir();
   static std::string getSimpleGeomR3Path();
   static UInt_t getOutreachFilesMax();
+  static UInt_t getDataFilesMax();
 
   static UInt_t getOutreachFrequencyInRefreshRates();
   static bool getScreenshotMonthly();
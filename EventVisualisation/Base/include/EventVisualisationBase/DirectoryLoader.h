@@ -17,6 +17,7 @@
 #define O2EVE_DIRECTORYLOADER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <deque>
 
@@ -32,6 +33,12 @@ class DirectoryLoader
   static std::string getLatestFile(std::string& path, std::vector<std::string>& ext);
 
  public:
+  /// part of the file name following the marker, files are ordered according to it
+  static std::string_view sortKey(const std::string& fileName, const std::string& marker)
+  {
+    // safety if marker not in the filename (npos+1 gives 0)
+    return std::string_view(fileName).substr(fileName.find_first_of(marker) + 1);
+  }
   static std::deque<std::string> load(const std::string& path, const std::string& marker, const std::vector<std::string>& ext);
   static std::deque<std::string> load(const std::vector<std::string>& paths, const std::string& marker, const std::vector<std::string>& ext);
   static void reduceNumberOfFiles(const std::string& path, const std::deque<std::string>& files, std::size_t filesInFolder);
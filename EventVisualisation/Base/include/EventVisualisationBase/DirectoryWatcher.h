@@ -0,0 +1,54 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DirectoryWatcher.h
+/// \brief Notifications about files created and removed in observed folders (inotify)
+
+#ifndef O2EVE_DIRECTORYWATCHER_H
+#define O2EVE_DIRECTORYWATCHER_H
+
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace event_visualisation
+{
+
+class DirectoryWatcher
+{
+ public:
+  struct Change {
+    std::string fileName; ///< name of the file (without path)
+    bool created;         ///< true: file appeared in the folder, false: file disappeared
+  };
+
+  DirectoryWatcher() = default;
+  DirectoryWatcher(const DirectoryWatcher&) = delete;
+  DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+  ~DirectoryWatcher();
+
+  /// start observing folders, false if notifications are not available (caller should poll)
+  bool watch(const std::vector<std::string>& folders);
+  void stop();
+  bool isActive() const { return mFd >= 0; }
+  /// appends pending changes, false if notifications were lost and folders must be rescanned
+  bool readChanges(std::vector<Change>& changes);
+
+ private:
+  int mFd = -1;
+  bool mFailureReported = false; ///< polling fallback is reported only once
+};
+
+} // namespace event_visualisation
+} // namespace o2
+
+#endif // O2EVE_DIRECTORYWATCHER_H
@@ -16,6 +16,7 @@
 #ifndef WATCHER_FILEWATCHER_H
 #define WATCHER_FILEWATCHER_H
 
+#include "EventVisualisationBase/DirectoryWatcher.h"
 #include <string>
 #include <deque>
 #include <vector>
@@ -29,16 +30,23 @@ class FileWatcher
 {
   static const char* mLowGuard;   ///< "artificial" file name meaning "on the first" (guard)
   static const char* mEndGuard;   ///< "artificial" file name meaning "on the last"  (guard)
+  static const char* mMarker;     ///< files are ordered by the part of the name following the marker
   std::deque<std::string> mFiles; ///< sorted file list with guards at the beginning and end
   std::string nextItem(const std::string& item) const;
   std::string prevItem(const std::string& item) const;
+  std::deque<std::string>::const_iterator find(const std::string& item) const; ///< binary search, mFiles.end() if absent
   std::vector<std::string> mDataFolders; ///< folders being observed
   std::string mCurrentFile; ///< "current" file name
   const std::vector<std::string>& mExt; ///< extensions of files to be observed
+  std::size_t mMaxFiles;                ///< maximum number of (newest) files kept in the list, 0 means no limit
+  DirectoryWatcher mWatcher;            ///< notifications about folder changes, folders are rescanned if not active
   bool currentFileExist();
+  void rescan();                                            ///< reads complete folder content
+  void applyChange(const DirectoryWatcher::Change& change); ///< updates the list with a single change
+  void resetFiles();                                        ///< empty list (guards only)
 
  public:
-  FileWatcher(const std::vector<std::string>& path, const std::vector<std::string>& ext);
+  FileWatcher(const std::vector<std::string>& path, const std::vector<std::string>& ext, std::size_t maxFiles = 0);
   void changeFolder(const std::string& path);                         ///< switch to observe other folder
   void changeFolder(const std::vector<std::string>& paths);           ///< switch to observe other folders
   void saveCurrentFileToFolder(const std::string& destinationFolder); ///< copies
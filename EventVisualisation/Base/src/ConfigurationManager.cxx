@@ -85,6 +85,11 @@ UInt_t ConfigurationManager::getOutreachFilesMax()
   return ConfigurationManager::getInstance().loadSettings()->mSettings.GetValue("outreach.files.max", 10);
 }
 
+UInt_t ConfigurationManager::getDataFilesMax() // 0 means all files in the folder are listed
+{
+  return ConfigurationManager::getInstance().loadSettings()->mSettings.GetValue("data.files.max", 0);
+}
+
 UInt_t ConfigurationManager::getScreenshotWidth(const char* prefix)
 {
   return ConfigurationManager::getInstance().loadSettings()->mSettings.GetValue((std::string(prefix) + ".width").c_str(), 3840);
@@ -14,6 +14,7 @@
 /// \author julian.myrcha@cern.ch
 
 #include <EventVisualisationBase/DataSourceOnline.h>
+#include <EventVisualisationBase/ConfigurationManager.h>
 
 #include <TSystem.h>
 #include <TEveTreeTools.h>
@@ -30,7 +31,7 @@ namespace o2
 {
 namespace event_visualisation
 {
-std::vector<std::string> DataSourceOnline::sourceFilextensions = {".json", ".root"};
+std::vector<std::string> DataSourceOnline::sourceFilextensions = {".json", ".root", ".eveb"};
 
 std::vector<std::pair<VisualisationEvent, EVisualisationGroup>>
   DataSourceOnline::getVisualisationList(int no, float minTime, float maxTime, float range)
@@ -87,7 +88,7 @@ std::vector<std::pair<VisualisationEvent, EVisualisationGroup>>
   return res;
 }
 
-DataSourceOnline::DataSourceOnline(const std::vector<std::string>& path) : mFileWatcher(path, sourceFilextensions)
+DataSourceOnline::DataSourceOnline(const std::vector<std::string>& path) : mFileWatcher(path, sourceFilextensions, ConfigurationManager::getDataFilesMax())
 {
 }
 
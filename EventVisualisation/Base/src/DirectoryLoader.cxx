@@ -30,10 +30,9 @@ deque<string> DirectoryLoader::load(const std::string& path, const std::string&
       result.push_back(entry.path().filename());
     }
   }
-  // comparison with safety if marker not in the filename (-1+1 gives 0)
   std::sort(result.begin(), result.end(),
-            [marker](std::string a, std::string b) {
-              return a.substr(a.find_first_of(marker) + 1) < b.substr(b.find_first_of(marker) + 1);
+            [&marker](const std::string& a, const std::string& b) {
+              return sortKey(a, marker) < sortKey(b, marker);
             });
 
   return result;
@@ -49,10 +48,9 @@ deque<string> DirectoryLoader::load(const std::vector<std::string>& paths, const
       }
     }
   }
-  // comparison with safety if marker not in the filename (-1+1 gives 0)
   std::sort(result.begin(), result.end(),
-            [marker](std::string a, std::string b) {
-              return a.substr(a.find_first_of(marker) + 1) < b.substr(b.find_first_of(marker) + 1);
+            [&marker](const std::string& a, const std::string& b) {
+              return sortKey(a, marker) < sortKey(b, marker);
             });
 
   return result;
@@ -0,0 +1,116 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DirectoryWatcher.cxx
+/// \brief Notifications about files created and removed in observed folders (inotify)
+
+#include "EventVisualisationBase/DirectoryWatcher.h"
+#include <fairlogger/Logger.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+using namespace o2::event_visualisation;
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+  stop();
+}
+
+#ifdef __linux__
+
+bool DirectoryWatcher::watch(const std::vector<std::string>& folders)
+{
+  stop();
+  mFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (mFd < 0) {
+    if (!mFailureReported) {
+      LOGF(warn, "inotify not available (%s), falling back to folder polling", strerror(errno));
+      mFailureReported = true;
+    }
+    return false;
+  }
+  for (const auto& folder : folders) {
+    // files are reported once they are completely written or moved in
+    if (inotify_add_watch(mFd, folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM | IN_DELETE_SELF | IN_MOVE_SELF) < 0) {
+      if (!mFailureReported) {
+        LOGF(warn, "cannot observe %s (%s), falling back to folder polling", folder, strerror(errno));
+        mFailureReported = true;
+      }
+      stop();
+      return false;
+    }
+  }
+  return true;
+}
+
+void DirectoryWatcher::stop()
+{
+  if (mFd >= 0) {
+    close(mFd);
+    mFd = -1;
+  }
+}
+
+bool DirectoryWatcher::readChanges(std::vector<Change>& changes)
+{
+  if (mFd < 0) {
+    return false;
+  }
+  alignas(struct inotify_event) char buffer[16 * 1024];
+  bool complete = true;
+  while (true) {
+    auto len = read(mFd, buffer, sizeof(buffer));
+    if (len <= 0) {
+      if (len < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        complete = false;
+      }
+      break;
+    }
+    for (char* ptr = buffer; ptr < buffer + len;) {
+      const auto* event = reinterpret_cast<const struct inotify_event*>(ptr);
+      ptr += sizeof(struct inotify_event) + event->len;
+      if (event->mask & IN_Q_OVERFLOW) {
+        complete = false; // kernel queue overflow, some events are lost
+      } else if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+        complete = false; // observed folder itself is gone
+      } else if (event->len > 0) {
+        changes.push_back({event->name, (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0});
+      }
+    }
+  }
+  if (!complete) {
+    stop();
+  }
+  return complete;
+}
+
+#else
+
+bool DirectoryWatcher::watch(const std::vector<std::string>& folders)
+{
+  return false;
+}
+
+void DirectoryWatcher::stop()
+{
+}
+
+bool DirectoryWatcher::readChanges(std::vector<Change>& changes)
+{
+  return false;
+}
+
+#endif
@@ -27,12 +27,18 @@ using namespace o2::event_visualisation;
 
 const char* FileWatcher::mLowGuard = " 0"; /// start guard
 const char* FileWatcher::mEndGuard = "~0"; /// stop guard
+const char* FileWatcher::mMarker = "_";
 
-FileWatcher::FileWatcher(const std::vector<string>& path, const std::vector<std::string>& ext) : mExt(ext)
+FileWatcher::FileWatcher(const std::vector<string>& path, const std::vector<std::string>& ext, std::size_t maxFiles) : mExt(ext), mMaxFiles(maxFiles)
 {
   //LOG(info) << "FileWatcher::FileWatcher(" << path << ")";
   this->mDataFolders = path;
   this->mCurrentFile = mEndGuard;
+  this->resetFiles();
+}
+
+void FileWatcher::resetFiles()
+{
   this->mFiles.clear();
   this->mFiles.push_front(mLowGuard);
   this->mFiles.push_back(mEndGuard);
@@ -46,9 +52,8 @@ void FileWatcher::changeFolder(const string& path)
   this->mDataFolders.clear();
   this->mDataFolders.push_back(path);
   this->mCurrentFile = mEndGuard;
-  this->mFiles.clear();
-  this->mFiles.push_front(mLowGuard);
-  this->mFiles.push_back(mEndGuard);
+  this->mWatcher.stop(); // observe the new folders
+  this->resetFiles();
   this->refresh();
   // LOG(info) << "FileWatcher" << this->getSize();
 }
@@ -61,19 +66,39 @@ void FileWatcher::changeFolder(const std::vector<string>& paths)
   this->mDataFolders.clear();
   this->mDataFolders = paths;
   this->mCurrentFile = mEndGuard;
-  this->mFiles.clear();
-  this->mFiles.push_front(mLowGuard);
-  this->mFiles.push_back(mEndGuard);
+  this->mWatcher.stop(); // observe the new folders
+  this->resetFiles();
   this->refresh();
   //LOG(info) << "FileWatcher" << this->getSize();
 }
 
+std::deque<std::string>::const_iterator FileWatcher::find(const string& item) const
+{
+  if (item == mLowGuard) {
+    return this->mFiles.begin();
+  }
+  if (item == mEndGuard) {
+    return this->mFiles.end() - 1;
+  }
+  // files between the guards are sorted by key, names sharing the key are checked one by one
+  auto key = DirectoryLoader::sortKey(item, mMarker);
+  auto first = std::lower_bound(this->mFiles.begin() + 1, this->mFiles.end() - 1, key,
+                                [](const std::string& name, std::string_view k) { return DirectoryLoader::sortKey(name, mMarker) < k; });
+  for (auto it = first; it != this->mFiles.end() - 1 && DirectoryLoader::sortKey(*it, mMarker) == key; ++it) {
+    if (*it == item) {
+      return it;
+    }
+  }
+  return this->mFiles.end();
+}
+
 string FileWatcher::nextItem(const string& item) const
 {
   if (item == mEndGuard) {
     return mEndGuard;
   }
-  return *(std::find(this->mFiles.begin(), this->mFiles.end(), item) + 1);
+  auto it = this->find(item);
+  return it == this->mFiles.end() ? mEndGuard : *(it + 1);
 }
 
 string FileWatcher::prevItem(const string& item) const
@@ -81,7 +106,8 @@ string FileWatcher::prevItem(const string& item) const
   if (item == mLowGuard) {
     return mLowGuard;
   }
-  return *(std::find(mFiles.begin(), mFiles.end(), item) - 1);
+  auto it = this->find(item);
+  return it == this->mFiles.end() ? mLowGuard : *(it - 1);
 }
 
 string FileWatcher::currentItem() const
@@ -137,7 +163,38 @@ int FileWatcher::getSize() const
 
 int FileWatcher::getPos() const
 {
-  return std::distance(mFiles.begin(), std::find(mFiles.begin(), mFiles.end(), this->mCurrentFile));
+  return std::distance(mFiles.begin(), this->find(this->mCurrentFile));
+}
+
+void FileWatcher::rescan()
+{
+  // start observing before listing, so no file created in between is missed (duplicates are ignored)
+  if (!this->mWatcher.isActive()) {
+    this->mWatcher.watch(this->mDataFolders);
+  }
+  this->mFiles = DirectoryLoader::load(this->mDataFolders, mMarker, this->mExt); // already sorted according part staring with marker
+  this->mFiles.push_front(mLowGuard);
+  this->mFiles.push_back(mEndGuard);
+}
+
+void FileWatcher::applyChange(const DirectoryWatcher::Change& change)
+{
+  if (std::find(this->mExt.begin(), this->mExt.end(), std::filesystem::path(change.fileName).extension()) == this->mExt.end()) {
+    return;
+  }
+  auto it = this->find(change.fileName);
+  if (change.created) {
+    if (it != this->mFiles.end()) {
+      return; // already known
+    }
+    auto key = DirectoryLoader::sortKey(change.fileName, mMarker);
+    // new files are usually the newest ones, so the insertion is at the end
+    auto pos = std::upper_bound(this->mFiles.begin() + 1, this->mFiles.end() - 1, key,
+                                [](std::string_view k, const std::string& name) { return k < DirectoryLoader::sortKey(name, mMarker); });
+    this->mFiles.insert(pos, change.fileName);
+  } else if (it != this->mFiles.end()) {
+    this->mFiles.erase(it);
+  }
 }
 
 bool FileWatcher::refresh()
@@ -146,24 +203,29 @@ bool FileWatcher::refresh()
   LOGF(info, "previous:", previous);
   LOGF(info, "currentFile:", this->mCurrentFile);
 
-  this->mFiles = DirectoryLoader::load(this->mDataFolders, "_", this->mExt); // already sorted according part staring with marker
-  if (this->mCurrentFile != mEndGuard) {
-    if (this->mFiles.empty()) {
+  std::vector<DirectoryWatcher::Change> changes;
+  if (this->mWatcher.readChanges(changes)) {
+    for (const auto& change : changes) {
+      this->applyChange(change);
+    }
+  } else {
+    this->rescan(); // no notifications available (or lost) - poll the folders
+  }
+  if (this->mMaxFiles > 0 && this->mFiles.size() > this->mMaxFiles + 2) { // keep only the newest files
+    this->mFiles.erase(this->mFiles.begin() + 1, this->mFiles.end() - 1 - this->mMaxFiles);
+  }
+
+  if (this->mCurrentFile != mEndGuard && this->mCurrentFile != mLowGuard) {
+    if (this->mFiles.size() == 2) {
       this->mCurrentFile = mEndGuard; // list empty - stick to last element
-    } else if (this->mCurrentFile < *(this->mFiles.begin())) {
-      this->mCurrentFile = mLowGuard; // lower then first => go to first
-    } else {
-      auto it = std::find(mFiles.begin(), mFiles.end(), this->mCurrentFile);
-      if (it == this->mFiles.end()) {
+    } else if (this->find(this->mCurrentFile) == this->mFiles.end()) {
+      if (DirectoryLoader::sortKey(this->mCurrentFile, mMarker) < DirectoryLoader::sortKey(this->mFiles[1], mMarker)) {
+        this->mCurrentFile = mLowGuard; // lower then first => go to first
+      } else {
         this->mCurrentFile = mEndGuard; // not on the list -> go to last element
       }
     }
   }
-  //for (auto it = this->mFiles.begin(); it != this->mFiles.end(); ++it) {
-  //  LOG(info) << *it;
-  //}
-  this->mFiles.push_front(mLowGuard);
-  this->mFiles.push_back(mEndGuard);
 
   LOGF(info, "this->mFiles.size() = ", this->mFiles.size());
   LOGF(info, "this->mCurrentFile = ", this->mCurrentFile);
@@ -28,6 +28,7 @@ class VisualisationCalo
 {
   friend class VisualisationEventJSONSerializer;
   friend class VisualisationEventROOTSerializer;
+  friend class VisualisationEventBinarySerializer;
 
  public:
   // Default constructor
@@ -44,6 +44,7 @@ class VisualisationEvent
 {
   friend class VisualisationEventJSONSerializer;
   friend class VisualisationEventROOTSerializer;
+  friend class VisualisationEventBinarySerializer;
 
  public:
   struct GIDVisualisation {
@@ -112,6 +113,11 @@ class VisualisationEvent
     return mTracks[i];
   };
 
+  VisualisationTrack& getTrack(int i)
+  {
+    return mTracks[i];
+  };
+
   // Returns number of tracks
   size_t getTrackCount() const
   {
@@ -0,0 +1,56 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    VisualisationEventBinarySerializer.h
+/// \brief   Compact binary serialization of VisualisationEvent
+///
+/// Scalars are stored as (zigzag) varints, floats verbatim. Space points of
+/// track polylines and clusters are quantized to BINARY_POSITION_STEP and
+/// stored as varint deltas to the previous point, which for densely sampled
+/// tracks is typically one or two bytes per coordinate.
+///
+
+#ifndef O2EVE_VISUALISATIONEVENTBINARYSERIALIZER_H
+#define O2EVE_VISUALISATIONEVENTBINARYSERIALIZER_H
+
+#include "EventVisualisationDataConverter/VisualisationEventSerializer.h"
+#include "EventVisualisationDataConverter/VisualisationTrack.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace event_visualisation
+{
+
+class VisualisationEventBinarySerializer : public VisualisationEventSerializer
+{
+ public:
+  static constexpr uint32_t BINARY_FILE_MAGIC = 0x42455645; // "EVEB"
+  static constexpr uint32_t BINARY_FILE_VERSION = 1;
+  static constexpr float BINARY_POSITION_STEP = 0.01f; // cm
+
+  /// Encode event into a byte buffer
+  static void toBuffer(const VisualisationEvent& event, std::vector<uint8_t>& buffer);
+  /// Decode event from a byte buffer, returns false if the buffer is malformed
+  static bool fromBuffer(VisualisationEvent& event, const uint8_t* data, size_t size);
+
+  bool fromFile(VisualisationEvent& event, std::string fileName) override;
+  void toFile(const VisualisationEvent& event, std::string fileName) override;
+  ~VisualisationEventBinarySerializer() override = default;
+};
+
+} // namespace event_visualisation
+} // namespace o2
+
+#endif // O2EVE_VISUALISATIONEVENTBINARYSERIALIZER_H
@@ -0,0 +1,341 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   VisualisationEventBinarySerializer.cxx
+/// \brief  Compact binary serialization
+///
+
+#include "EventVisualisationDataConverter/VisualisationEventBinarySerializer.h"
+#include <fairlogger/Logger.h>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace o2::event_visualisation
+{
+
+namespace
+{
+class BinaryWriter
+{
+ public:
+  explicit BinaryWriter(std::vector<uint8_t>& buffer) : mBuffer(buffer) {}
+
+  void putVarint(uint64_t value)
+  {
+    while (value >= 0x80) {
+      mBuffer.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    mBuffer.push_back(static_cast<uint8_t>(value));
+  }
+
+  void putSigned(int64_t value) { putVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)); }
+
+  void putFloat(float value)
+  {
+    uint8_t raw[sizeof(float)];
+    std::memcpy(raw, &value, sizeof(float));
+    mBuffer.insert(mBuffer.end(), raw, raw + sizeof(float));
+  }
+
+  void putString(const std::string& value)
+  {
+    putVarint(value.size());
+    mBuffer.insert(mBuffer.end(), value.begin(), value.end());
+  }
+
+  /// quantized coordinate stored as delta to the previous one
+  void putPosition(float value, int32_t& previous)
+  {
+    int32_t q = std::isfinite(value) ? static_cast<int32_t>(std::lround(value / VisualisationEventBinarySerializer::BINARY_POSITION_STEP)) : 0;
+    putSigned(static_cast<int64_t>(q) - previous);
+    previous = q;
+  }
+
+ private:
+  std::vector<uint8_t>& mBuffer;
+};
+
+class BinaryReader
+{
+ public:
+  BinaryReader(const uint8_t* data, size_t size) : mData(data), mEnd(data + size) {}
+
+  bool good() const { return mGood; }
+
+  uint64_t getVarint()
+  {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (mData == mEnd) {
+        mGood = false;
+        return 0;
+      }
+      uint8_t byte = *mData++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    mGood = false;
+    return 0;
+  }
+
+  int64_t getSigned()
+  {
+    uint64_t value = getVarint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  float getFloat()
+  {
+    float value = 0;
+    if (mEnd - mData < static_cast<ptrdiff_t>(sizeof(float))) {
+      mGood = false;
+      return value;
+    }
+    std::memcpy(&value, mData, sizeof(float));
+    mData += sizeof(float);
+    return value;
+  }
+
+  std::string getString()
+  {
+    auto size = getVarint();
+    if (!mGood || static_cast<uint64_t>(mEnd - mData) < size) {
+      mGood = false;
+      return {};
+    }
+    std::string value(reinterpret_cast<const char*>(mData), size);
+    mData += size;
+    return value;
+  }
+
+  float getPosition(int32_t& previous)
+  {
+    previous += static_cast<int32_t>(getSigned());
+    return previous * VisualisationEventBinarySerializer::BINARY_POSITION_STEP;
+  }
+
+  /// element count, rejected if the remaining bytes cannot possibly hold it
+  size_t getCount(size_t minElementSize)
+  {
+    auto count = getVarint();
+    if (!mGood || count * minElementSize > static_cast<uint64_t>(mEnd - mData)) {
+      mGood = false;
+      return 0;
+    }
+    return count;
+  }
+
+ private:
+  const uint8_t* mData;
+  const uint8_t* mEnd;
+  bool mGood = true;
+};
+} // namespace
+
+void VisualisationEventBinarySerializer::toBuffer(const VisualisationEvent& event, std::vector<uint8_t>& buffer)
+{
+  BinaryWriter out(buffer);
+  buffer.clear();
+  // rough guess to avoid most of the reallocations: ~3 bytes per coordinate
+  size_t points = 0;
+  for (const auto& track : event.mTracks) {
+    points += track.getPointCount() + track.getClusterCount();
+  }
+  buffer.reserve(64 + 9 * (points + event.mClusters.size()) + 64 * event.mTracks.size());
+
+  out.putVarint(BINARY_FILE_MAGIC);
+  out.putVarint(BINARY_FILE_VERSION);
+  out.putSigned(event.mRunNumber);
+  out.putSigned(event.mRunType);
+  out.putSigned(event.mClMask);
+  out.putSigned(event.mTrkMask);
+  out.putVarint(event.mTfCounter);
+  out.putVarint(event.mFirstTForbit);
+  out.putVarint(event.mPrimaryVertex);
+  out.putString(event.mCollisionTime);
+  out.putString(event.mEveVersion);
+  out.putString(event.mWorkflowParameters);
+
+  out.putVarint(event.mTracks.size());
+  for (const auto& track : event.mTracks) {
+    out.putVarint(track.mSource);
+    out.putString(track.mGID);
+    out.putFloat(std::isnan(track.mTime) ? 0 : track.mTime);
+    out.putSigned(track.mCharge);
+    out.putFloat(std::isnan(track.mTheta) ? 0 : track.mTheta);
+    out.putFloat(std::isnan(track.mPhi) ? 0 : track.mPhi);
+    out.putFloat(std::isnan(track.mEta) ? 0 : track.mEta);
+    out.putSigned(track.mPID);
+    for (int i = 0; i < 3; i++) {
+      out.putFloat(track.mStartCoordinates[i]);
+    }
+    int32_t prev[3] = {0, 0, 0};
+    out.putVarint(track.getPointCount());
+    for (size_t i = 0; i < track.getPointCount(); i++) {
+      out.putPosition(track.mPolyX[i], prev[0]);
+      out.putPosition(track.mPolyY[i], prev[1]);
+      out.putPosition(track.mPolyZ[i], prev[2]);
+    }
+    out.putVarint(track.getClusterCount());
+    for (const auto& cluster : track.mClusters) {
+      for (int i = 0; i < 3; i++) {
+        out.putPosition(cluster.mCoordinates[i], prev[i]);
+      }
+    }
+  }
+
+  int32_t prev[3] = {0, 0, 0};
+  out.putVarint(event.mClusters.size());
+  for (const auto& cluster : event.mClusters) {
+    out.putVarint(cluster.mSource);
+    for (int i = 0; i < 3; i++) {
+      out.putPosition(cluster.mCoordinates[i], prev[i]);
+    }
+  }
+
+  out.putVarint(event.mCalo.size());
+  for (const auto& calo : event.mCalo) {
+    out.putVarint(calo.mSource);
+    out.putFloat(std::isnan(calo.mTime) ? 0 : calo.mTime);
+    out.putFloat(calo.mEnergy);
+    out.putFloat(std::isnan(calo.mEta) ? 0 : calo.mEta);
+    out.putFloat(std::isnan(calo.mPhi) ? 0 : calo.mPhi);
+    out.putString(calo.mGID);
+    out.putSigned(calo.mPID);
+  }
+}
+
+bool VisualisationEventBinarySerializer::fromBuffer(VisualisationEvent& event, const uint8_t* data, size_t size)
+{
+  using GID = o2::dataformats::GlobalTrackID;
+  BinaryReader in(data, size);
+  event.mTracks.clear();
+  event.mClusters.clear();
+  event.mCalo.clear();
+
+  if (in.getVarint() != BINARY_FILE_MAGIC) {
+    LOGF(error, "VisualisationEventBinarySerializer: not a binary event file");
+    return false;
+  }
+  auto version = in.getVarint();
+  if (version != BINARY_FILE_VERSION) {
+    LOGF(error, "VisualisationEventBinarySerializer: unsupported version %d", version);
+    return false;
+  }
+  event.setRunNumber(in.getSigned());
+  event.setRunType(static_cast<parameters::GRPECS::RunType>(in.getSigned()));
+  event.setClMask(in.getSigned());
+  event.setTrkMask(in.getSigned());
+  event.setTfCounter(in.getVarint());
+  event.setFirstTForbit(in.getVarint());
+  event.setPrimaryVertex(in.getVarint());
+  event.setCollisionTime(in.getString());
+  event.mEveVersion = in.getString();
+  event.setWorkflowParameters(in.getString());
+
+  auto trackCount = in.getCount(1);
+  event.mTracks.reserve(trackCount);
+  for (size_t t = 0; t < trackCount && in.good(); t++) {
+    auto& track = event.mTracks.emplace_back();
+    track.mClusters.clear();
+    track.mSource = static_cast<GID::Source>(in.getVarint());
+    track.mGID = in.getString();
+    track.mTime = in.getFloat();
+    track.mCharge = in.getSigned();
+    track.mTheta = in.getFloat();
+    track.mPhi = in.getFloat();
+    track.mEta = in.getFloat();
+    track.mPID = in.getSigned();
+    for (int i = 0; i < 3; i++) {
+      track.mStartCoordinates[i] = in.getFloat();
+    }
+    int32_t prev[3] = {0, 0, 0};
+    auto pointCount = in.getCount(3);
+    track.mPolyX.reserve(pointCount);
+    track.mPolyY.reserve(pointCount);
+    track.mPolyZ.reserve(pointCount);
+    for (size_t i = 0; i < pointCount; i++) {
+      track.mPolyX.push_back(in.getPosition(prev[0]));
+      track.mPolyY.push_back(in.getPosition(prev[1]));
+      track.mPolyZ.push_back(in.getPosition(prev[2]));
+    }
+    auto clusterCount = in.getCount(3);
+    track.mClusters.reserve(clusterCount);
+    for (size_t i = 0; i < clusterCount; i++) {
+      float xyz[3];
+      for (int j = 0; j < 3; j++) {
+        xyz[j] = in.getPosition(prev[j]);
+      }
+      track.mClusters.emplace_back(xyz, 0).mSource = GID::HMP;
+    }
+  }
+
+  int32_t prev[3] = {0, 0, 0};
+  auto clusterCount = in.getCount(4);
+  event.mClusters.reserve(clusterCount);
+  for (size_t c = 0; c < clusterCount; c++) {
+    auto source = static_cast<GID::Source>(in.getVarint());
+    float xyz[3];
+    for (int j = 0; j < 3; j++) {
+      xyz[j] = in.getPosition(prev[j]);
+    }
+    event.mClusters.emplace_back(xyz, 0).mSource = source;
+  }
+
+  auto caloCount = in.getCount(19);
+  event.mCalo.reserve(caloCount);
+  for (size_t c = 0; c < caloCount; c++) {
+    auto& calo = event.mCalo.emplace_back();
+    calo.mSource = static_cast<GID::Source>(in.getVarint());
+    calo.mTime = in.getFloat();
+    calo.mEnergy = in.getFloat();
+    calo.mEta = in.getFloat();
+    calo.mPhi = in.getFloat();
+    calo.mGID = in.getString();
+    calo.mPID = in.getSigned();
+  }
+
+  if (!in.good()) {
+    LOGF(error, "VisualisationEventBinarySerializer: truncated or corrupted event");
+    event.clear();
+    return false;
+  }
+  event.afterLoading();
+  return true;
+}
+
+void VisualisationEventBinarySerializer::toFile(const VisualisationEvent& event, std::string fileName)
+{
+  std::vector<uint8_t> buffer;
+  toBuffer(event, buffer);
+  std::ofstream out(fileName, std::ios::binary);
+  out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+  out.close();
+}
+
+bool VisualisationEventBinarySerializer::fromFile(VisualisationEvent& event, std::string fileName)
+{
+  LOGF(info, "VisualisationEventBinarySerializer <- %s", fileName);
+  std::ifstream in(fileName, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  return fromBuffer(event, buffer.data(), buffer.size());
+}
+
+} // namespace o2::event_visualisation
@@ -0,0 +1,168 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test VisualisationEventBinarySerializer
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <unistd.h>
+
+#include "EventVisualisationDataConverter/VisualisationEvent.h"
+#include "EventVisualisationDataConverter/VisualisationEventBinarySerializer.h"
+#include "TVector3.h"
+
+namespace o2::event_visualisation
+{
+namespace
+{
+using GID = o2::dataformats::GlobalTrackID;
+// the space points are quantized, everything else is stored exactly
+const float positionTolerance = 0.5f * VisualisationEventBinarySerializer::BINARY_POSITION_STEP + 1e-4f;
+
+VisualisationEvent makeEvent()
+{
+  VisualisationEvent event;
+  event.setRunNumber(529450);
+  event.setRunType(o2::parameters::GRPECS::PHYSICS);
+  event.setClMask(31);
+  event.setTrkMask(15);
+  event.setTfCounter(1234);
+  event.setFirstTForbit(987654);
+  event.setPrimaryVertex(3);
+  event.setCollisionTime("2023-05-01 12:00:00");
+  event.setWorkflowParameters("--use-binary-format");
+
+  for (int t = 0; t < 3; t++) {
+    VisualisationTrack::VisualisationTrackVO vo{.time = 1.5f * t, .charge = t % 2 ? 1 : -1, .PID = 2, .startXYZ = {0.1f, -0.2f, 3.f}, .phi = 0.3f * t, .theta = 1.1f, .eta = -0.4f * t, .gid = "ITS-TPC/" + std::to_string(t), .source = GID::ITSTPC};
+    auto* track = event.addTrack(vo);
+    for (int i = 0; i < 50; i++) {
+      track->addPolyPoint(1.f + 2.345f * i, -0.5f * i + t, 0.1234f * i * i);
+    }
+    for (int i = 0; i < 5; i++) {
+      event.addCluster(10.f * i + 0.003f, -4.f * i, 7.77f, 0.f);
+    }
+  }
+  for (int i = 0; i < 10; i++) {
+    event.addGlobalCluster(TVector3(-100.f + i, 50.f - 3.21f * i, 0.01f * i));
+  }
+  for (int i = 0; i < 4; i++) {
+    event.addCalo({.time = 0.5f * i, .energy = 2.5f + i, .phi = 0.2f * i, .eta = 0.1f * i, .PID = 0, .gid = "EMC/" + std::to_string(i), .source = GID::EMC});
+  }
+  return event;
+}
+
+void compareEvents(const VisualisationEvent& a, const VisualisationEvent& b)
+{
+  BOOST_CHECK_EQUAL(a.getRunNumber(), b.getRunNumber());
+  BOOST_CHECK_EQUAL(a.getRunType(), b.getRunType());
+  BOOST_CHECK_EQUAL(a.getClMask(), b.getClMask());
+  BOOST_CHECK_EQUAL(a.getTrkMask(), b.getTrkMask());
+  BOOST_CHECK_EQUAL(a.getTfCounter(), b.getTfCounter());
+  BOOST_CHECK_EQUAL(a.getFirstTForbit(), b.getFirstTForbit());
+  BOOST_CHECK_EQUAL(a.getCollisionTime(), b.getCollisionTime());
+
+  BOOST_REQUIRE_EQUAL(a.getTrackCount(), b.getTrackCount());
+  for (size_t t = 0; t < a.getTrackCount(); t++) {
+    const auto& ta = a.getTrack(t);
+    const auto& tb = b.getTrack(t);
+    BOOST_CHECK_EQUAL(ta.getSource(), tb.getSource());
+    BOOST_CHECK_EQUAL(ta.getGIDAsString(), tb.getGIDAsString());
+    BOOST_CHECK_EQUAL(ta.getTime(), tb.getTime());
+    BOOST_CHECK_EQUAL(ta.getCharge(), tb.getCharge());
+    BOOST_CHECK_EQUAL(ta.getPID(), tb.getPID());
+    BOOST_CHECK_EQUAL(ta.getPhi(), tb.getPhi());
+    BOOST_CHECK_EQUAL(ta.getTheta(), tb.getTheta());
+    for (int i = 0; i < 3; i++) {
+      BOOST_CHECK_EQUAL(ta.getStartCoordinates()[i], tb.getStartCoordinates()[i]);
+    }
+    BOOST_REQUIRE_EQUAL(ta.getPointCount(), tb.getPointCount());
+    for (size_t i = 0; i < ta.getPointCount(); i++) {
+      for (int j = 0; j < 3; j++) {
+        BOOST_CHECK_SMALL(ta.getPoint(i)[j] - tb.getPoint(i)[j], positionTolerance);
+      }
+    }
+    BOOST_REQUIRE_EQUAL(ta.getClusterCount(), tb.getClusterCount());
+    for (size_t i = 0; i < ta.getClusterCount(); i++) {
+      BOOST_CHECK_SMALL(ta.getCluster(i).X() - tb.getCluster(i).X(), positionTolerance);
+      BOOST_CHECK_SMALL(ta.getCluster(i).Y() - tb.getCluster(i).Y(), positionTolerance);
+      BOOST_CHECK_SMALL(ta.getCluster(i).Z() - tb.getCluster(i).Z(), positionTolerance);
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(a.getClusterCount(), b.getClusterCount());
+  for (size_t i = 0; i < a.getClusterCount(); i++) {
+    BOOST_CHECK_EQUAL(a.getCluster(i).getSource(), b.getCluster(i).getSource());
+    BOOST_CHECK_SMALL(a.getCluster(i).X() - b.getCluster(i).X(), positionTolerance);
+    BOOST_CHECK_SMALL(a.getCluster(i).Y() - b.getCluster(i).Y(), positionTolerance);
+    BOOST_CHECK_SMALL(a.getCluster(i).Z() - b.getCluster(i).Z(), positionTolerance);
+  }
+
+  BOOST_REQUIRE_EQUAL(a.getCaloCount(), b.getCaloCount());
+  auto caloA = a.getCalorimetersSpan();
+  auto caloB = b.getCalorimetersSpan();
+  for (size_t i = 0; i < a.getCaloCount(); i++) {
+    BOOST_CHECK_EQUAL(caloA[i].getSource(), caloB[i].getSource());
+    BOOST_CHECK_EQUAL(caloA[i].getGIDAsString(), caloB[i].getGIDAsString());
+    BOOST_CHECK_EQUAL(caloA[i].getTime(), caloB[i].getTime());
+    BOOST_CHECK_EQUAL(caloA[i].getEnergy(), caloB[i].getEnergy());
+    BOOST_CHECK_EQUAL(caloA[i].getPhi(), caloB[i].getPhi());
+    BOOST_CHECK_EQUAL(caloA[i].getEta(), caloB[i].getEta());
+    BOOST_CHECK_EQUAL(caloA[i].getPID(), caloB[i].getPID());
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(BinarySerializerRoundTrip)
+{
+  auto event = makeEvent();
+  std::vector<uint8_t> buffer;
+  VisualisationEventBinarySerializer::toBuffer(event, buffer);
+  BOOST_CHECK(!buffer.empty());
+
+  VisualisationEvent loaded;
+  BOOST_REQUIRE(VisualisationEventBinarySerializer::fromBuffer(loaded, buffer.data(), buffer.size()));
+  compareEvents(event, loaded);
+
+  // serialising the decoded event again gives the same bytes
+  std::vector<uint8_t> again;
+  VisualisationEventBinarySerializer::toBuffer(loaded, again);
+  BOOST_CHECK(buffer == again);
+}
+
+BOOST_AUTO_TEST_CASE(BinarySerializerFile)
+{
+  auto event = makeEvent();
+  std::string fileName = "testEvent" + std::to_string(getpid()) + ".eveb";
+  VisualisationEventBinarySerializer serializer;
+  serializer.toFile(event, fileName);
+  VisualisationEvent loaded;
+  BOOST_REQUIRE(serializer.fromFile(loaded, fileName));
+  std::remove(fileName.c_str());
+  compareEvents(event, loaded);
+}
+
+BOOST_AUTO_TEST_CASE(BinarySerializerMalformed)
+{
+  auto event = makeEvent();
+  std::vector<uint8_t> buffer;
+  VisualisationEventBinarySerializer::toBuffer(event, buffer);
+
+  VisualisationEvent loaded;
+  for (size_t size : {size_t(0), size_t(3), buffer.size() / 2, buffer.size() - 1}) {
+    BOOST_CHECK(!VisualisationEventBinarySerializer::fromBuffer(loaded, buffer.data(), size));
+    BOOST_CHECK(loaded.isEmpty());
+  }
+  buffer[0] ^= 0xff;
+  BOOST_CHECK(!VisualisationEventBinarySerializer::fromBuffer(loaded, buffer.data(), buffer.size()));
+}
+
+} // namespace o2::event_visualisation
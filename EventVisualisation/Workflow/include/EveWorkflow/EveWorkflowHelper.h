@@ -138,6 +138,8 @@ class EveWorkflowHelper
 
   EveWorkflowHelper(const FilterSet& enabledFilters = {}, std::size_t maxNTracks = -1, const Bracket& timeBracket = {}, const Bracket& etaBracket = {}, bool primaryVertexMode = false);
   static std::vector<PNT> getTrackPoints(const o2::track::TrackPar& trc, float minR, float maxR, float maxStep, float minZ = -25000, float maxZ = 25000);
+  void sampleTrackPoints(); // propagates all tracks queued by addTrackToEvent and fills their polylines
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
   void selectTracks(const CalibObjectsConst* calib, GID::mask_t maskCl, GID::mask_t maskTrk, GID::mask_t maskMatch);
   void selectTowers();
   void setITSROFs();
@@ -179,7 +181,11 @@ class EveWorkflowHelper
   void drawGlobalPoint(const TVector3& xyx) { mEvent.addGlobalCluster(xyx); }
   void prepareITSClusters(const o2::itsmft::TopologyDictionary* dict); // fills mITSClustersArray
   void prepareMFTClusters(const o2::itsmft::TopologyDictionary* dict); // fills mMFTClustersArray
-  void clear() { mEvent.clear(); }
+  void clear()
+  {
+    mEvent.clear();
+    mPendingTracks.clear();
+  }
 
   GID::Source detectorMapToGIDSource(uint8_t dm);
   o2::mch::TrackParam forwardTrackToMCHTrack(const o2::track::TrackParFwd& track);
@@ -191,13 +197,14 @@ class EveWorkflowHelper
   bool isInsideITSROF(float t);
   bool isInsideTimeBracket(float t);
 
-  void save(const std::string& jsonPath,
-            const std::string& ext,
-            int numberOfFiles,
-            o2::dataformats::GlobalTrackID::mask_t trkMask,
-            o2::dataformats::GlobalTrackID::mask_t clMask,
-            o2::header::DataHeader::RunNumberType runNumber,
-            o2::framework::DataProcessingHeader::CreationTime creationTime);
+  /// serializes mEvent into a new file, returns the number of bytes written
+  std::size_t save(const std::string& jsonPath,
+                   const std::string& ext,
+                   int numberOfFiles,
+                   o2::dataformats::GlobalTrackID::mask_t trkMask,
+                   o2::dataformats::GlobalTrackID::mask_t clMask,
+                   o2::header::DataHeader::RunNumberType runNumber,
+                   o2::framework::DataProcessingHeader::CreationTime creationTime);
 
   FilterSet mEnabledFilters;
   std::size_t mMaxNTracks;
@@ -228,6 +235,18 @@ class EveWorkflowHelper
   float mTPCBin2MUS = 0;
   static int BCDiffErrCount;
   const o2::vertexing::PVertexerParams* mPVParams = nullptr;
+
+ private:
+  /// track whose polyline is still to be sampled by sampleTrackPoints
+  struct PendingTrack {
+    std::size_t index; ///< track index in mEvent
+    o2::track::TrackPar track;
+    PropagationRange range;
+    float maxStep;
+    float dz;
+  };
+  std::vector<PendingTrack> mPendingTracks;
+  int mNThreads = 1;
 };
 } // namespace o2::event_visualisation
 
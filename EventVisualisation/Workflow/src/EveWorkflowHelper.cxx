@@ -37,6 +37,7 @@
 #include "EMCALBase/Geometry.h"
 #include <TGeoBBox.h>
 #include <tuple>
+#include <filesystem>
 #include <gsl/span>
 
 using namespace o2::event_visualisation;
@@ -459,12 +460,14 @@ void EveWorkflowHelper::draw(std::size_t primaryVertexIdx, bool sortTracks)
       }
     }
   }
+  sampleTrackPoints();
 }
 
-void EveWorkflowHelper::save(const std::string& jsonPath, const std::string& ext, int numberOfFiles,
-                             o2::dataformats::GlobalTrackID::mask_t trkMask, o2::dataformats::GlobalTrackID::mask_t clMask,
-                             o2::header::DataHeader::RunNumberType runNumber, o2::framework::DataProcessingHeader::CreationTime creation)
+std::size_t EveWorkflowHelper::save(const std::string& jsonPath, const std::string& ext, int numberOfFiles,
+                                    o2::dataformats::GlobalTrackID::mask_t trkMask, o2::dataformats::GlobalTrackID::mask_t clMask,
+                                    o2::header::DataHeader::RunNumberType runNumber, o2::framework::DataProcessingHeader::CreationTime creation)
 {
+  sampleTrackPoints();
   mEvent.setEveVersion(o2_eve_version);
   mEvent.setRunNumber(runNumber);
   std::time_t timeStamp = std::time(nullptr);
@@ -478,7 +481,11 @@ void EveWorkflowHelper::save(const std::string& jsonPath, const std::string& ext
   mEvent.setCollisionTime(asciiCreationTime);
 
   FileProducer producer(jsonPath, ext, numberOfFiles);
-  VisualisationEventSerializer::getInstance(ext)->toFile(mEvent, producer.newFileName());
+  auto fileName = producer.newFileName();
+  VisualisationEventSerializer::getInstance(ext)->toFile(mEvent, fileName);
+  std::error_code ec;
+  auto size = std::filesystem::file_size(fileName, ec);
+  return ec ? 0 : size;
 }
 
 std::vector<PNT> EveWorkflowHelper::getTrackPoints(const o2::track::TrackPar& trc, float minR, float maxR, float maxStep, float minZ, float maxZ)
@@ -553,13 +560,31 @@ void EveWorkflowHelper::addTrackToEvent(const o2::track::TrackPar& tr, GID gid,
     return;
   }
 
-  const auto& prange = it->second;
-
-  auto pnts = getTrackPoints(tr, prange.minR, prange.maxR, maxStep, prange.minZ, prange.maxZ);
+  // the polyline is filled later by sampleTrackPoints, which propagates all tracks of the event at once
+  mPendingTracks.push_back({mEvent.getTrackCount() - 1, tr, it->second, maxStep, dz});
+}
 
-  for (size_t ip = 0; ip < pnts.size(); ip++) {
-    vTrack->addPolyPoint(pnts[ip][0], pnts[ip][1], pnts[ip][2] + dz);
+void EveWorkflowHelper::sampleTrackPoints()
+{
+  if (mPendingTracks.empty()) {
+    return;
+  }
+  std::vector<std::vector<PNT>> points(mPendingTracks.size());
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (size_t i = 0; i < mPendingTracks.size(); i++) {
+    const auto& pending = mPendingTracks[i];
+    points[i] = getTrackPoints(pending.track, pending.range.minR, pending.range.maxR, pending.maxStep, pending.range.minZ, pending.range.maxZ);
+  }
+  // fill sequentially, so the event content does not depend on the number of threads
+  for (size_t i = 0; i < mPendingTracks.size(); i++) {
+    auto& vTrack = mEvent.getTrack(mPendingTracks[i].index);
+    for (const auto& pnt : points[i]) {
+      vTrack.addPolyPoint(pnt[0], pnt[1], pnt[2] + mPendingTracks[i].dz);
+    }
   }
+  mPendingTracks.clear();
 }
 
 void EveWorkflowHelper::prepareITSClusters(const o2::itsmft::TopologyDictionary* dict)
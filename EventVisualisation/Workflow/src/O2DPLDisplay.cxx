@@ -53,6 +53,8 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
   std::vector<o2::framework::ConfigParamSpec> options{
     {"jsons-folder", VariantType::String, "jsons", {"name of the folder to store json files"}},
     {"use-json-format", VariantType::Bool, false, {"instead of root format (default) use json format"}},
+    {"use-binary-format", VariantType::Bool, false, {"instead of root format (default) use compact binary format"}},
+    {"track-sampling-threads", VariantType::Int, 1, {"number of threads used to propagate tracks to the display points"}},
     {"eve-hostname", VariantType::String, "", {"name of the host allowed to produce files (empty means no limit)"}},
     {"eve-dds-collection-index", VariantType::Int, -1, {"number of dpl collection allowed to produce files (-1 means no limit)"}},
     {"number-of_files", VariantType::Int, 150, {"maximum number of json files in folder"}},
@@ -121,6 +123,7 @@ void O2DPLDisplaySpec::run(ProcessingContext& pc)
   enabledFilters.set(EveWorkflowHelper::Filter::EtaBracket, this->mRemoveTPCEta);
   enabledFilters.set(EveWorkflowHelper::Filter::TotalNTracks, this->mNumberOfTracks != -1);
   EveWorkflowHelper helper(enabledFilters, this->mNumberOfTracks, this->mTimeBracket, this->mEtaBracket, this->mPrimaryVertexMode);
+  helper.setNThreads(this->mTrackSamplingThreads);
   helper.setRecoContainer(&recoCont);
   helper.setITSROFs();
   helper.selectTracks(&(mData.mConfig.configCalib), mClMask, mTrkMask, mTrkMask);
@@ -131,6 +134,7 @@ void O2DPLDisplaySpec::run(ProcessingContext& pc)
   const auto& tinfo = pc.services().get<o2::framework::TimingInfo>();
 
   std::size_t filesSaved = 0;
+  std::size_t bytesSaved = 0;
   auto processData = [&](const auto& dataMap) {
     for (const auto& keyVal : dataMap) {
       if (filesSaved >= mMaxPrimaryVertices) {
@@ -173,7 +177,7 @@ void O2DPLDisplaySpec::run(ProcessingContext& pc)
         helper.mEvent.setFirstTForbit(tinfo.firstTForbit);
         helper.mEvent.setRunType(this->mRunType);
         helper.mEvent.setPrimaryVertex(pv);
-        helper.save(this->mJsonPath, this->mExt, this->mNumberOfFiles, this->mTrkMask, this->mClMask, tinfo.runNumber, tinfo.creation);
+        bytesSaved += helper.save(this->mJsonPath, this->mExt, this->mNumberOfFiles, this->mTrkMask, this->mClMask, tinfo.runNumber, tinfo.creation);
         filesSaved++;
       }
 
@@ -187,7 +191,16 @@ void O2DPLDisplaySpec::run(ProcessingContext& pc)
   }
 
   auto endTime = std::chrono::high_resolution_clock::now();
-  LOGP(info, "Visualization of TF:{} at orbit {} took {} s.", tinfo.tfCounter, tinfo.firstTForbit, std::chrono::duration_cast<std::chrono::microseconds>(endTime - currentTime).count() * 1e-6);
+  auto elapsedSeconds = std::chrono::duration_cast<std::chrono::microseconds>(endTime - currentTime).count() * 1e-6;
+  LOGP(info, "Visualization of TF:{} at orbit {} took {} s.", tinfo.tfCounter, tinfo.firstTForbit, elapsedSeconds);
+
+  mTotalFilesSaved += filesSaved;
+  mTotalBytesSaved += bytesSaved;
+  mTotalProcessingTime += elapsedSeconds;
+  if (filesSaved) {
+    LOGP(info, "Throughput: {:.1f} events/s, {} bytes/event ({} format, {} track sampling threads)",
+         filesSaved / elapsedSeconds, bytesSaved / filesSaved, mExt, mTrackSamplingThreads);
+  }
 
   LOGP(info, "PVs with tracks: {}", helper.mPrimaryVertexTrackGIDs.size());
   LOGP(info, "PVs with triggers: {}", helper.mPrimaryVertexTriggerGIDs.size());
@@ -219,6 +232,10 @@ void O2DPLDisplaySpec::run(ProcessingContext& pc)
 
 void O2DPLDisplaySpec::endOfStream(EndOfStreamContext& ec)
 {
+  if (mTotalFilesSaved) {
+    LOGP(info, "Saved {} events, {:.1f} events/s, {} bytes/event ({} format)",
+         mTotalFilesSaved, mTotalFilesSaved / mTotalProcessingTime, mTotalBytesSaved / mTotalFilesSaved, mExt);
+  }
 }
 
 void O2DPLDisplaySpec::updateTimeDependentParams(ProcessingContext& pc)
@@ -261,9 +278,16 @@ WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
   auto jsonFolder = cfgc.options().get<std::string>("jsons-folder");
   std::string ext = ".root"; // root files are default format
   auto useJsonFormat = cfgc.options().get<bool>("use-json-format");
+  auto useBinaryFormat = cfgc.options().get<bool>("use-binary-format");
+  if (useJsonFormat && useBinaryFormat) {
+    throw std::runtime_error("--use-json-format and --use-binary-format are mutually exclusive");
+  }
   if (useJsonFormat) {
     ext = ".json";
+  } else if (useBinaryFormat) {
+    ext = ".eveb";
   }
+  auto trackSamplingThreads = cfgc.options().get<int>("track-sampling-threads");
   auto eveHostName = cfgc.options().get<std::string>("eve-hostname");
   o2::conf::ConfigurableParam::updateFromString(cfgc.options().get<std::string>("configKeyValues"));
   bool useMC = !cfgc.options().get<bool>("disable-mc");
@@ -389,7 +413,7 @@ WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
     "o2-eve-export",
     dataRequest->inputs,
     {},
-    AlgorithmSpec{adaptFromTask<O2DPLDisplaySpec>(disableWrite, useMC, srcTrk, srcCl, dataRequest, ggRequest, jsonFolder, ext, timeInterval, numberOfFiles, numberOfTracks, eveHostNameMatch, minITSTracks, minTracks, filterITSROF, filterTime, timeBracket, removeTPCEta, etaBracket, tracksSorting, onlyNthEvent, primaryVertexMode, maxPrimaryVertices, primaryVertexTriggers, primaryVertexMinZ, primaryVertexMaxZ, primaryVertexMinX, primaryVertexMaxX, primaryVertexMinY, primaryVertexMaxY)}});
+    AlgorithmSpec{adaptFromTask<O2DPLDisplaySpec>(disableWrite, useMC, srcTrk, srcCl, dataRequest, ggRequest, jsonFolder, ext, timeInterval, numberOfFiles, numberOfTracks, eveHostNameMatch, minITSTracks, minTracks, filterITSROF, filterTime, timeBracket, removeTPCEta, etaBracket, tracksSorting, onlyNthEvent, primaryVertexMode, maxPrimaryVertices, primaryVertexTriggers, primaryVertexMinZ, primaryVertexMaxZ, primaryVertexMinX, primaryVertexMaxX, primaryVertexMinY, primaryVertexMaxY, trackSamplingThreads)}});
 
   // configure dpl timer to inject correct firstTForbit: start from the 1st orbit of TF containing 1st sampled orbit
   o2::raw::HBFUtilsInitializer hbfIni(cfgc, specs);
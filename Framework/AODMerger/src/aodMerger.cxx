@@ -11,10 +11,13 @@
 
 #include <map>
 #include <list>
+#include <vector>
 #include <fstream>
+#include <future>
 #include <getopt.h>
 
 #include "TSystem.h"
+#include "TROOT.h"
 #include "TFile.h"
 #include "TTree.h"
 #include "TList.h"
@@ -38,6 +41,7 @@ int main(int argc, char* argv[])
   bool skipNonExistingFiles = false;
   bool skipParentFilesList = false;
   int verbosity = 2;
+  int nThreads = 1;
   int exitCode = 0; // 0: success, >0: failure
 
   int option_index = 0;
@@ -49,6 +53,7 @@ int main(int argc, char* argv[])
     {"skip-parent-files-list", no_argument, nullptr, 4},
     {"verbosity", required_argument, nullptr, 5},
     {"help", no_argument, nullptr, 6},
+    {"threads", required_argument, nullptr, 7},
     {nullptr, 0, nullptr, 0}};
 
   while (true) {
@@ -75,7 +80,10 @@ int main(int argc, char* argv[])
       printf("  --skip-non-existing-files    Flag to allow skipping of non-existing files in the input list.\n");
       printf("  --skip-parent-files-list     Flag to allow skipping the merging of the parent files list.\n");
       printf("  --verbosity <flag>           Verbosity of output (default: %d).\n", verbosity);
+      printf("  --threads <n>                Open the next input file in the background if > 1, the merging itself is sequential (default: %d).\n", nThreads);
       return -1;
+    } else if (c == 7) {
+      nThreads = atoi(optarg);
     } else {
       return -2;
     }
@@ -88,6 +96,9 @@ int main(int argc, char* argv[])
   if (skipNonExistingFiles) {
     printf("  WARNING: Skipping non-existing files.\n");
   }
+  if (nThreads > 1) {
+    printf("  Prefetching the next input file in the background\n");
+  }
 
   std::map<std::string, TTree*> trees;
   std::map<std::string, uint64_t> sizeCompressed;
@@ -101,28 +112,48 @@ int main(int argc, char* argv[])
 
   std::ifstream in;
   in.open(inputCollection);
+  std::vector<TString> inputFiles;
   TString line;
   bool connectedToAliEn = false;
-  TMap* metaData = nullptr;
-  TMap* parentFiles = nullptr;
-  int totalMergedDFs = 0;
-  int mergedDFs = 0;
-  while (in.good() && exitCode == 0) {
+  while (in.good()) {
     in >> line;
-
     if (line.Length() == 0) {
       continue;
     }
-
     if (line.BeginsWith("alien:") && !connectedToAliEn) {
       printf("Connecting to AliEn...");
       TGrid::Connect("alien:");
       connectedToAliEn = true; // Only try once
     }
+    inputFiles.push_back(line);
+    line = "";
+  }
+
+  // While a file is merged, the next one is already opened in the background. This hides the latency
+  // of remote files, the merging itself stays sequential to preserve the order of the output.
+  std::future<TFile*> nextInputFile;
+  auto openInputFile = [&inputFiles, nThreads](size_t i) {
+    return std::async(nThreads > 1 ? std::launch::async : std::launch::deferred, [name = inputFiles[i]]() { return TFile::Open(name); });
+  };
+  if (nThreads > 1) {
+    ROOT::EnableThreadSafety();
+  }
+  if (!inputFiles.empty()) {
+    nextInputFile = openInputFile(0);
+  }
 
+  TMap* metaData = nullptr;
+  TMap* parentFiles = nullptr;
+  int totalMergedDFs = 0;
+  int mergedDFs = 0;
+  for (size_t iFile = 0; iFile < inputFiles.size() && exitCode == 0; ++iFile) {
+    line = inputFiles[iFile];
     printf("Processing input file: %s\n", line.Data());
 
-    auto inputFile = TFile::Open(line);
+    auto inputFile = nextInputFile.get();
+    if (iFile + 1 < inputFiles.size()) {
+      nextInputFile = openInputFile(iFile + 1);
+    }
     if (!inputFile) {
       printf("Error: Could not open input file %s.\n", line.Data());
       if (skipNonExistingFiles) {
@@ -255,10 +286,28 @@ int main(int argc, char* argv[])
 
         auto outputTree = trees[treeName];
         // register index and connect VLA columns
+        // Scalar and slice indices are kept in one contiguous buffer (with their offsets in a parallel array),
+        // so that they can be shifted in a single pass. fIndexArray elements live in the VLA buffers.
         std::vector<std::pair<int*, int>> indexList;
         std::vector<char*> vlaPointers;
-        std::vector<int*> indexPointers;
+        std::vector<int> indexValues;
+        std::vector<int> indexOffsets;
         TObjArray* branches = inputTree->GetListOfBranches();
+        size_t nIndexValues = 0;
+        for (int i = 0; i < branches->GetEntriesFast(); ++i) {
+          TBranch* br = (TBranch*)branches->UncheckedAt(i);
+          TString branchName(br->GetName());
+          if (((TLeaf*)br->GetListOfLeaves()->First())->GetLeafCount() != nullptr) {
+            continue;
+          } else if (branchName.BeginsWith("fIndexSlice")) {
+            nIndexValues += 2;
+          } else if (branchName.BeginsWith("fIndex") && !branchName.EndsWith("_size")) {
+            nIndexValues += 1;
+          }
+        }
+        // the buffer must not be reallocated after the branch addresses are set
+        indexValues.resize(nIndexValues, 0);
+        indexOffsets.reserve(nIndexValues);
         for (int i = 0; i < branches->GetEntriesFast(); ++i) {
           TBranch* br = (TBranch*)branches->UncheckedAt(i);
           TString branchName(br->GetName());
@@ -288,37 +337,36 @@ int main(int argc, char* argv[])
               }
             }
           } else if (branchName.BeginsWith("fIndexSlice")) {
-            int* buffer = new int[2];
-            memset(buffer, 0, 2 * sizeof(buffer[0]));
-            vlaPointers.push_back(reinterpret_cast<char*>(buffer));
+            int* buffer = indexValues.data() + indexOffsets.size();
 
             inputTree->SetBranchAddress(br->GetName(), buffer);
             outputTree->SetBranchAddress(br->GetName(), buffer);
 
-            indexList.push_back({buffer, offsets[getTableName(branchName, treeName)]});
-            indexList.push_back({buffer + 1, offsets[getTableName(branchName, treeName)]});
+            indexOffsets.push_back(offsets[getTableName(branchName, treeName)]);
+            indexOffsets.push_back(offsets[getTableName(branchName, treeName)]);
           } else if (branchName.BeginsWith("fIndex") && !branchName.EndsWith("_size")) {
-            int* buffer = new int;
-            *buffer = 0;
-            indexPointers.push_back(buffer);
+            int* buffer = indexValues.data() + indexOffsets.size();
 
             inputTree->SetBranchAddress(br->GetName(), buffer);
             outputTree->SetBranchAddress(br->GetName(), buffer);
 
-            indexList.push_back({buffer, offsets[getTableName(branchName, treeName)]});
+            indexOffsets.push_back(offsets[getTableName(branchName, treeName)]);
           }
         }
 
-        if (indexList.size() > 0) {
+        if (indexList.size() > 0 || indexValues.size() > 0) {
           auto entries = inputTree->GetEntries();
           int minIndexOffset = unassignedIndexOffset[treeName];
           auto newMinIndexOffset = minIndexOffset;
           for (int i = 0; i < entries; i++) {
+            // Any positive number will do, in any case it will not be filled in the output. Otherwise the previous entry is used and manipulated in the following.
+            std::fill(indexValues.begin(), indexValues.end(), 0);
             for (auto& index : indexList) {
-              *(index.first) = 0; // Any positive number will do, in any case it will not be filled in the output. Otherwise the previous entry is used and manipulated in the following.
+              *(index.first) = 0;
             }
             inputTree->GetEntry(i);
             // shift index columns by offset
+            newMinIndexOffset = shiftIndices(indexValues.data(), indexOffsets.data(), indexValues.size(), minIndexOffset, newMinIndexOffset);
             for (const auto& idx : indexList) {
               // if negative, the index is unassigned. In this case, the different unassigned blocks have to get unique negative IDs
               if (*(idx.first) < 0) {
@@ -345,9 +393,6 @@ int main(int argc, char* argv[])
 
         delete inputTree;
 
-        for (auto& buffer : indexPointers) {
-          delete buffer;
-        }
         for (auto& buffer : vlaPointers) {
           delete[] buffer;
         }
@@ -411,6 +456,13 @@ int main(int argc, char* argv[])
     }
     inputFile->Close();
   }
+  // the merging was aborted while the next file was being opened
+  if (nextInputFile.valid()) {
+    auto pendingFile = nextInputFile.get();
+    if (pendingFile) {
+      pendingFile->Close();
+    }
+  }
 
   if (parentFiles) {
     outputFile->cd();
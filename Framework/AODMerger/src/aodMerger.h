@@ -10,6 +10,8 @@
 // or submit itself to any jurisdiction.
 
 #include <TString.h>
+#include <algorithm>
+#include <cstdint>
 
 const char* removeVersionSuffix(const char* treeName)
 {
@@ -48,3 +50,36 @@ const char* getTableName(const char* branchName, const char* treeName)
   // printf("%s --> %s\n", branchName, tableName.Data());
   return tableName;
 }
+
+// Shift a contiguous block of index values by the offsets of the tables they point to.
+// Negative (unassigned) indices are shifted by minIndexOffset instead, so that unassigned blocks
+// of different dataframes keep unique negative IDs. Returns the smallest of such shifted indices
+// and newMinIndexOffset. The loop is branch-free so that the compiler can vectorize it.
+int shiftIndices(int* values, const int* offsets, size_t n, int minIndexOffset, int newMinIndexOffset)
+{
+  for (size_t i = 0; i < n; ++i) {
+    int value = values[i];
+    bool unassigned = value < 0;
+    int shifted = value + (unassigned ? minIndexOffset : offsets[i]);
+    newMinIndexOffset = unassigned ? std::min(newMinIndexOffset, shifted) : newMinIndexOffset;
+    values[i] = shifted;
+  }
+  return newMinIndexOffset;
+}
+
+// Map a contiguous block of row-major index values (width values per row) through newIndices, which holds
+// the new position of each referenced entry or -1 if it was removed. Rows referring to a removed (or
+// non-existent) entry are cleared in keep, unassigned (negative) indices are left untouched.
+void remapIndices(int* values, size_t nRows, size_t width, const int* newIndices, size_t nIndices, uint8_t* keep)
+{
+  for (size_t i = 0; i < nRows; ++i) {
+    uint8_t keepRow = keep[i];
+    for (size_t k = 0; k < width; ++k) {
+      int value = values[i * width + k];
+      int mapped = (value < 0) ? value : (static_cast<size_t>(value) < nIndices ? newIndices[value] : -1);
+      keepRow &= (value < 0) | (mapped >= 0);
+      values[i * width + k] = mapped;
+    }
+    keep[i] = keepRow;
+  }
+}
@@ -9,10 +9,12 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
-#include <unordered_map>
+#include <vector>
+#include <future>
 #include <getopt.h>
 
 #include "TSystem.h"
+#include "TROOT.h"
 #include "TStopwatch.h"
 #include "TString.h"
 #include "TRegexp.h"
@@ -29,6 +31,124 @@
 
 #include "aodMerger.h"
 
+namespace
+{
+// Read a single column of a tree, without touching the other branches.
+// width > 1 reads fixed size arrays (e.g. index slices) row by row into the flat vector.
+template <typename T>
+bool readColumn(TTree* tree, const char* branchName, std::vector<T>& column, int width = 1)
+{
+  auto branch = tree->GetBranch(branchName);
+  if (branch == nullptr) {
+    return false;
+  }
+  auto entries = tree->GetEntries();
+  column.resize(entries * width);
+  std::vector<T> buffer(width);
+  tree->SetBranchAddress(branchName, buffer.data());
+  for (Long64_t i = 0; i < entries; ++i) {
+    branch->GetEntry(i);
+    std::copy(buffer.begin(), buffer.end(), column.begin() + i * width);
+  }
+  tree->ResetBranchAddress(branch);
+  return true;
+}
+
+// Tracks to be kept in one dataframe, computed before any of its trees is rewritten
+struct DataframeSelection {
+  TString v0Name{"O2v0_???"};
+  TString trkExtraName{"O2trackextra*"};
+  std::vector<int> acceptedTracks; // new index of each track, -1 if removed
+  std::vector<bool> hasCollision;
+  int exitCode = 0;
+};
+
+DataframeSelection selectTracks(TFile* inputFile, const char* dfName)
+{
+  DataframeSelection selection;
+  auto folder = (TDirectoryFile*)inputFile->Get(dfName);
+
+  auto treeList = folder->GetListOfKeys();
+  treeList->Sort();
+
+  // Scan versions e.g. 001 or 002 ...
+  TRegexp v0Re(selection.v0Name, kTRUE), trkExtraRe(selection.trkExtraName, kTRUE);
+  for (TObject* obj : *treeList) {
+    TString st = obj->GetName();
+    if (st.Index(v0Re) != kNPOS) {
+      selection.v0Name = st;
+    } else if (st.Index(trkExtraRe) != kNPOS) {
+      selection.trkExtraName = st;
+    }
+  }
+
+  auto trackExtraTree = (TTree*)inputFile->Get(Form("%s/%s", dfName, selection.trkExtraName.Data()));
+  if (trackExtraTree == nullptr) {
+    printf("%s table not found\n", selection.trkExtraName.Data());
+    selection.exitCode = 6;
+    return selection;
+  }
+  auto track_iu = (TTree*)inputFile->Get(Form("%s/%s", dfName, "O2track_iu"));
+  if (track_iu == nullptr) {
+    printf("O2track_iu table not found\n");
+    selection.exitCode = 7;
+    return selection;
+  }
+  auto v0s = (TTree*)inputFile->Get(Form("%s/%s", dfName, selection.v0Name.Data()));
+  if (v0s == nullptr) {
+    printf("%s table not found\n", selection.v0Name.Data());
+    selection.exitCode = 8;
+    return selection;
+  }
+
+  // Flag the prongs of all V0s in a bitmask over the tracks
+  auto entries = trackExtraTree->GetEntries();
+  std::vector<uint64_t> v0Prongs((entries + 63) / 64, 0);
+  std::vector<int> trackIdxPos, trackIdxNeg;
+  readColumn(v0s, "fIndexTracks_Pos", trackIdxPos);
+  readColumn(v0s, "fIndexTracks_Neg", trackIdxNeg);
+  for (auto prongs : {&trackIdxPos, &trackIdxNeg}) {
+    for (int idx : *prongs) {
+      if (idx >= 0 && idx < entries) {
+        v0Prongs[idx / 64] |= uint64_t(1) << (idx % 64);
+      }
+    }
+  }
+
+  // Only the columns entering the selection are read. Missing ones do not take part in it.
+  std::vector<uint8_t> tpcNClsFindable, ITSClusterMap, TRDPattern;
+  std::vector<float_t> TOFChi2;
+  std::vector<int> fIndexCollisions;
+  bool bTPClsFindable = readColumn(trackExtraTree, "fTPCNClsFindable", tpcNClsFindable);
+  bool bITSClusterMap = readColumn(trackExtraTree, "fITSClusterMap", ITSClusterMap);
+  bool bTRDPattern = readColumn(trackExtraTree, "fTRDPattern", TRDPattern);
+  bool bTOFChi2 = readColumn(trackExtraTree, "fTOFChi2", TOFChi2);
+  readColumn(track_iu, "fIndexCollisions", fIndexCollisions);
+
+  selection.acceptedTracks.resize(entries);
+  selection.hasCollision.resize(entries);
+  int counter = 0;
+  for (Long64_t i = 0; i < entries; i++) {
+    // Flag collisions
+    selection.hasCollision[i] = i < (Long64_t)fIndexCollisions.size() && fIndexCollisions[i] >= 0;
+
+    // Remove TPC only tracks, if (opt.) they are not assoc. to a V0
+    bool remove = (!bTPClsFindable || tpcNClsFindable[i] > 0.) &&
+                  (!bITSClusterMap || ITSClusterMap[i] == 0) &&
+                  (!bTRDPattern || TRDPattern[i] == 0) &&
+                  (!bTOFChi2 || TOFChi2[i] < -1.) &&
+                  !((v0Prongs[i / 64] >> (i % 64)) & 1);
+    counter += remove;
+    selection.acceptedTracks[i] = remove ? -1 : i - counter;
+  }
+
+  delete trackExtraTree;
+  delete track_iu;
+  delete v0s;
+  return selection;
+}
+} // namespace
+
 // AOD reduction tool
 //   Designed for the 2022 pp data with specific selections:
 //   - Remove all TPC only tracks, optionally keep TPC-only V0 tracks
@@ -42,14 +162,16 @@ int main(int argc, char* argv[])
   std::string outputFileName("AO2D_thinned.root");
   int exitCode = 0; // 0: success, !=0: failure
   bool bOverwrite = false;
+  int nThreads = 1;
 
   int option_index = 1;
 
-  const char* const short_opts = "i:o:KOh";
+  const char* const short_opts = "i:o:t:KOh";
   static struct option long_options[] = {
     {"input", required_argument, nullptr, 'i'},
     {"output", required_argument, nullptr, 'o'},
     {"overwrite", no_argument, nullptr, 'O'},
+    {"threads", required_argument, nullptr, 't'},
     {"help", no_argument, nullptr, 'h'},
     {nullptr, 0, nullptr, 0}};
 
@@ -69,6 +191,9 @@ int main(int argc, char* argv[])
         bOverwrite = true;
         printf("Overwriting existing output file if existing\n");
         break;
+      case 't':
+        nThreads = atoi(optarg);
+        break;
       case 'h':
       case '?':
       default:
@@ -78,6 +203,7 @@ int main(int argc, char* argv[])
         printf("\n");
         printf("  Optional Arguments:\n");
         printf("  --overwrite/-O                  Overwrite existing output file\n");
+        printf("  --threads/-t <n>                Select the tracks of the next dataframe in the background if > 1, the output is written sequentially. Default: %d\n", nThreads);
         return -1;
     }
   }
@@ -85,6 +211,12 @@ int main(int argc, char* argv[])
   printf("AOD reduction started with:\n");
   printf("  Input file: %s\n", inputFileName.c_str());
   printf("  Ouput file name: %s\n", outputFileName.c_str());
+  if (nThreads > 1) {
+    // Only the track selection of the next dataframe runs in the background, on its own handle of the input
+    // file. The trees are written by the main thread in the same order as in the single threaded case.
+    printf("  Selecting the tracks of the next dataframe in the background\n");
+    ROOT::EnableThreadSafety();
+  }
 
   TStopwatch clock;
   clock.Start(kTRUE);
@@ -110,6 +242,28 @@ int main(int argc, char* argv[])
   TList* keyList = inputFile->GetListOfKeys();
   keyList->Sort();
 
+  // While the trees of a dataframe are rewritten, the tracks of the next one are already selected
+  // in the background, reading from a separate handle of the input file.
+  std::vector<TString> dfNames;
+  for (auto key : *keyList) {
+    if (((TObjString*)key)->GetString().BeginsWith("DF_")) {
+      dfNames.push_back(((TObjString*)key)->GetString());
+    }
+  }
+  TFile* selectionFile = (nThreads > 1) ? TFile::Open(inputFileName.c_str()) : inputFile;
+  if (selectionFile == nullptr) {
+    selectionFile = inputFile;
+  }
+  auto startSelection = [&](size_t i) {
+    return std::async(selectionFile != inputFile ? std::launch::async : std::launch::deferred,
+                      [selectionFile, dfName = dfNames[i]]() { return selectTracks(selectionFile, dfName.Data()); });
+  };
+  size_t dfCounter = 0;
+  std::future<DataframeSelection> nextSelection;
+  if (!dfNames.empty()) {
+    nextSelection = startSelection(0);
+  }
+
   for (auto key1 : *keyList) {
     // Keep metaData
     if (((TObjString*)key1)->GetString().EqualTo("metaData")) {
@@ -158,112 +312,23 @@ int main(int argc, char* argv[])
       }
     }
 
-    // Scan versions e.g. 001 or 002 ...
-    TString v0Name{"O2v0_???"}, trkExtraName{"O2trackextra*"};
-    TRegexp v0Re(v0Name, kTRUE), trkExtraRe(trkExtraName, kTRUE);
-    for (TObject* obj : *treeList) {
-      TString st = obj->GetName();
-      if (st.Index(v0Re) != kNPOS) {
-        v0Name = st;
-      } else if (st.Index(trkExtraRe) != kNPOS) {
-        trkExtraName = st;
-      }
+    auto selection = nextSelection.get();
+    if (++dfCounter < dfNames.size()) {
+      nextSelection = startSelection(dfCounter);
+    }
+    if (selection.exitCode != 0) {
+      exitCode = selection.exitCode;
+      break;
     }
+    const auto& acceptedTracks = selection.acceptedTracks;
+    const auto& hasCollision = selection.hasCollision;
 
     // Certain order needed in order to populate vectors of skipped entries
-    auto v0Entry = (TObject*)treeList->FindObject(v0Name);
+    auto v0Entry = (TObject*)treeList->FindObject(selection.v0Name);
     treeList->Remove(v0Entry);
     treeList->AddFirst(v0Entry);
 
-    // Prepare maps for track skimming
-    auto trackExtraTree = (TTree*)inputFile->Get(Form("%s/%s", dfName, trkExtraName.Data()));
-    if (trackExtraTree == nullptr) {
-      printf("%s table not found\n", trkExtraName.Data());
-      exitCode = 6;
-      break;
-    }
-    auto track_iu = (TTree*)inputFile->Get(Form("%s/%s", dfName, "O2track_iu"));
-    if (track_iu == nullptr) {
-      printf("O2track_iu table not found\n");
-      exitCode = 7;
-      break;
-    }
-    auto v0s = (TTree*)inputFile->Get(Form("%s/%s", dfName, v0Name.Data()));
-    if (v0s == nullptr) {
-      printf("%s table not found\n", v0Name.Data());
-      exitCode = 8;
-      break;
-    }
-
-    // We need to loop over the V0s once and flag the prong indices
-    int trackIdxPos = 0, trackIdxNeg = 0;
-    std::unordered_map<int, bool> keepV0TPCs;
-    v0s->SetBranchAddress("fIndexTracks_Pos", &trackIdxPos);
-    v0s->SetBranchAddress("fIndexTracks_Neg", &trackIdxNeg);
-    auto nV0s = v0s->GetEntriesFast();
-    for (int i{0}; i < nV0s; ++i) {
-      v0s->GetEntry(i);
-      keepV0TPCs[trackIdxPos] = true;
-      keepV0TPCs[trackIdxNeg] = true;
-    }
-
-    std::vector<int> acceptedTracks(trackExtraTree->GetEntries(), -1);
-    std::vector<bool> hasCollision(trackExtraTree->GetEntries(), false);
-    std::vector<int> keepV0s(v0s->GetEntries(), -1);
-
-    uint8_t tpcNClsFindable = 0;
-    bool bTPClsFindable = false;
-    uint8_t ITSClusterMap = 0;
-    bool bITSClusterMap = false;
-    uint8_t TRDPattern = 0;
-    bool bTRDPattern = false;
-    float_t TOFChi2 = 0;
-    bool bTOFChi2 = false;
-
-    // Test if track properties exist
-    TBranch* br = nullptr;
-    TIter next(trackExtraTree->GetListOfBranches());
-    while ((br = (TBranch*)next())) {
-      TString brName = br->GetName();
-      if (brName == "fTPCNClsFindable") {
-        trackExtraTree->SetBranchAddress("fTPCNClsFindable", &tpcNClsFindable);
-        bTPClsFindable = true;
-      } else if (brName == "fITSClusterMap") {
-        trackExtraTree->SetBranchAddress("fITSClusterMap", &ITSClusterMap);
-        bITSClusterMap = true;
-      } else if (brName == "fTRDPattern") {
-        trackExtraTree->SetBranchAddress("fTRDPattern", &TRDPattern);
-        bTRDPattern = true;
-      } else if (brName == "fTOFChi2") {
-        trackExtraTree->SetBranchAddress("fTOFChi2", &TOFChi2);
-        bTOFChi2 = true;
-      }
-    }
-
-    int fIndexCollisions = 0;
-    track_iu->SetBranchAddress("fIndexCollisions", &fIndexCollisions);
-
-    // loop over all tracks
-    auto entries = trackExtraTree->GetEntries();
-    int counter = 0;
-    for (int i = 0; i < entries; i++) {
-      trackExtraTree->GetEntry(i);
-      track_iu->GetEntry(i);
-
-      // Flag collisions
-      hasCollision[i] = (fIndexCollisions >= 0);
-
-      // Remove TPC only tracks, if (opt.) they are not assoc. to a V0
-      if ((!bTPClsFindable || tpcNClsFindable > 0.) &&
-          (!bITSClusterMap || ITSClusterMap == 0) &&
-          (!bTRDPattern || TRDPattern == 0) &&
-          (!bTOFChi2 || TOFChi2 < -1.) &&
-          (keepV0TPCs.find(i) == keepV0TPCs.end())) {
-        counter++;
-      } else {
-        acceptedTracks[i] = i - counter;
-      }
-    }
+    std::vector<int> keepV0s;
 
     for (auto key2 : *treeList) {
       TString treeName = ((TObjString*)key2)->GetString().Data();
@@ -281,9 +346,14 @@ int main(int argc, char* argv[])
       auto outputTree = inputTree->CloneTree(0);
       outputTree->SetAutoFlush(0);
 
-      std::vector<int*> indexList;
-      std::vector<char*> vlaPointers;
-      std::vector<int*> indexPointers;
+      // Index columns pointing to tracks are read and remapped in one pass before the entries are copied.
+      // Their buffers are then overwritten with the remapped values for each copied entry.
+      struct IndexColumn {
+        int* buffer;
+        int width;
+        std::vector<int> values;
+      };
+      std::vector<IndexColumn> indexList;
       TObjArray* branches = inputTree->GetListOfBranches();
       for (int i = 0; i < branches->GetEntriesFast(); ++i) {
         TBranch* br = (TBranch*)branches->UncheckedAt(i);
@@ -297,24 +367,12 @@ int main(int argc, char* argv[])
         if (((TLeaf*)br->GetListOfLeaves()->First())->GetLeafCount() != nullptr) {
           printf("  *** FATAL ***: VLA detection is not supported\n");
           exitCode = 9;
-        } else if (branchName.BeginsWith("fIndexSlice")) {
-          int* buffer = new int[2];
-          memset(buffer, 0, 2 * sizeof(buffer[0]));
-          vlaPointers.push_back(reinterpret_cast<char*>(buffer));
-          inputTree->SetBranchAddress(br->GetName(), buffer);
-          outputTree->SetBranchAddress(br->GetName(), buffer);
-
-          indexList.push_back(buffer);
-          indexList.push_back(buffer + 1);
-        } else if (branchName.BeginsWith("fIndex") && !branchName.EndsWith("_size")) {
-          int* buffer = new int;
-          *buffer = 0;
-          indexPointers.push_back(buffer);
-
-          inputTree->SetBranchAddress(br->GetName(), buffer);
-          outputTree->SetBranchAddress(br->GetName(), buffer);
-
-          indexList.push_back(buffer);
+        } else if (branchName.BeginsWith("fIndexSlice") || (branchName.BeginsWith("fIndex") && !branchName.EndsWith("_size"))) {
+          int width = branchName.BeginsWith("fIndexSlice") ? 2 : 1;
+          auto& column = indexList.emplace_back(IndexColumn{new int[width](), width, {}});
+          readColumn(inputTree, br->GetName(), column.values, width);
+          inputTree->SetBranchAddress(br->GetName(), column.buffer);
+          outputTree->SetBranchAddress(br->GetName(), column.buffer);
         }
       }
 
@@ -324,58 +382,61 @@ int main(int argc, char* argv[])
       bool processingAmbiguousTracks = treeName.BeginsWith("O2ambiguoustrack");
 
       auto indexV0s = -1;
+      std::vector<int> indexV0sColumn;
       if (processingCascades) {
+        readColumn(inputTree, "fIndexV0s", indexV0sColumn);
         inputTree->SetBranchAddress("fIndexV0s", &indexV0s);
         outputTree->SetBranchAddress("fIndexV0s", &indexV0s);
       }
 
+      // Decide on all entries before reading any of them
       auto entries = inputTree->GetEntries();
-      for (int i = 0; i < entries; i++) {
-        inputTree->GetEntry(i);
-        bool fillThisEntry = true;
+      std::vector<uint8_t> keep(entries, 1);
+      if (processingTracks) {
         // Special case for Tracks, TracksExtra, TracksCov
-        if (processingTracks) {
-          if (acceptedTracks[i] < 0) {
-            fillThisEntry = false;
-          }
-        } else {
-          // Other table than Tracks* --> reassign indices to Tracks
-          for (const auto& idx : indexList) {
-            int oldTrackIndex = *idx;
-
-            // if negative, the index is unassigned.
-            if (oldTrackIndex >= 0) {
-              if (acceptedTracks[oldTrackIndex] < 0) {
-                fillThisEntry = false;
-              } else {
-                *idx = acceptedTracks[oldTrackIndex];
-              }
-            }
-          }
+        for (Long64_t i = 0; i < entries; i++) {
+          keep[i] = i < (Long64_t)acceptedTracks.size() && acceptedTracks[i] >= 0;
         }
-
-        // Reassign v0 index of cascades
-        if (processingCascades) {
-          if (keepV0s[indexV0s] < 0) {
-            fillThisEntry = false;
-          } else {
-            indexV0s = keepV0s[indexV0s];
-          }
+      } else {
+        // Other table than Tracks* --> reassign indices to Tracks
+        for (auto& column : indexList) {
+          remapIndices(column.values.data(), entries, column.width, acceptedTracks.data(), acceptedTracks.size(), keep.data());
         }
-
-        // Keep only tracks which have no collision, see O2-3601
-        if (processingAmbiguousTracks) {
-          if (hasCollision[i]) {
-            fillThisEntry = false;
-          }
+      }
+      // Reassign v0 index of cascades
+      if (processingCascades) {
+        remapIndices(indexV0sColumn.data(), entries, 1, keepV0s.data(), keepV0s.size(), keep.data());
+        for (Long64_t i = 0; i < entries; i++) {
+          keep[i] &= indexV0sColumn[i] >= 0; // cascades always refer to a V0
         }
+      }
+      // Keep only tracks which have no collision, see O2-3601
+      if (processingAmbiguousTracks) {
+        for (Long64_t i = 0; i < entries; i++) {
+          keep[i] &= !(i < (Long64_t)hasCollision.size() && hasCollision[i]);
+        }
+      }
+      if (processingV0s) {
+        keepV0s.assign(entries, -1);
+      }
 
-        if (fillThisEntry) {
-          outputTree->Fill();
-          if (processingV0s) {
-            keepV0s[i] = outputTree->GetEntries() - 1;
+      for (Long64_t i = 0; i < entries; i++) {
+        if (!keep[i]) {
+          continue;
+        }
+        inputTree->GetEntry(i);
+        if (!processingTracks) {
+          for (auto& column : indexList) {
+            std::copy_n(column.values.data() + i * column.width, column.width, column.buffer);
           }
         }
+        if (processingCascades) {
+          indexV0s = indexV0sColumn[i];
+        }
+        outputTree->Fill();
+        if (processingV0s) {
+          keepV0s[i] = outputTree->GetEntries() - 1;
+        }
       }
 
       if (entries != outputTree->GetEntries()) {
@@ -384,11 +445,8 @@ int main(int argc, char* argv[])
 
       delete inputTree;
 
-      for (auto& buffer : indexPointers) {
-        delete buffer;
-      }
-      for (auto& buffer : vlaPointers) {
-        delete[] buffer;
+      for (auto& column : indexList) {
+        delete[] column.buffer;
       }
 
       outputDir->cd();
@@ -401,6 +459,12 @@ int main(int argc, char* argv[])
 
     outputDir = nullptr;
   }
+  if (selectionFile != inputFile) {
+    if (nextSelection.valid()) {
+      nextSelection.wait(); // may still read from selectionFile
+    }
+    selectionFile->Close();
+  }
   inputFile->Close();
 
   outputFile->Write();
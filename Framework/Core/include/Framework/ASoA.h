@@ -21,6 +21,7 @@
 #include "Framework/ArrowTypes.h"
 #include "Framework/ArrowTableSlicingCache.h"
 #include "Framework/SliceCache.h"
+#include "Framework/SelectionBitmap.h"
 #include <arrow/table.h>
 #include <arrow/array.h>
 #include <arrow/util/config.h>
@@ -75,8 +76,6 @@ auto createFieldsFromColumns(framework::pack<C...>)
   return std::vector<std::shared_ptr<arrow::Field>>{C::asArrowField()...};
 }
 
-using SelectionVector = std::vector<int64_t>;
-
 template <typename, typename = void>
 inline constexpr bool is_index_column_v = false;
 
@@ -3000,41 +2999,26 @@ class FilteredBase : public T
 
   void sumWithSelection(SelectionVector const& selection)
   {
-    mCached = true;
-    SelectionVector rowsUnion;
-    std::set_union(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(rowsUnion));
-    mSelectedRowsCache.clear();
-    mSelectedRowsCache = rowsUnion;
-    resetRanges();
+    sumWithSelection(gsl::span<int64_t const>{selection});
   }
 
   void intersectWithSelection(SelectionVector const& selection)
   {
-    mCached = true;
-    SelectionVector intersection;
-    std::set_intersection(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(intersection));
-    mSelectedRowsCache.clear();
-    mSelectedRowsCache = intersection;
-    resetRanges();
+    intersectWithSelection(gsl::span<int64_t const>{selection});
   }
 
+  // dense selections are combined as bitmaps, sparse ones by merging the sorted row lists
   void sumWithSelection(gsl::span<int64_t const> const& selection)
   {
     mCached = true;
-    SelectionVector rowsUnion;
-    std::set_union(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(rowsUnion));
-    mSelectedRowsCache.clear();
-    mSelectedRowsCache = rowsUnion;
+    mSelectedRowsCache = uniteSelections(mSelectedRows, selection, tableSize());
     resetRanges();
   }
 
   void intersectWithSelection(gsl::span<int64_t const> const& selection)
   {
     mCached = true;
-    SelectionVector intersection;
-    std::set_intersection(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(intersection));
-    mSelectedRowsCache.clear();
-    mSelectedRowsCache = intersection;
+    mSelectedRowsCache = intersectSelections(mSelectedRows, selection, tableSize());
     resetRanges();
   }
 
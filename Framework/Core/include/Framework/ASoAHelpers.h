@@ -17,6 +17,7 @@
 #include "Framework/RuntimeError.h"
 #include <arrow/table.h>
 
+#include <algorithm>
 #include <iterator>
 #include <tuple>
 #include <utility>
@@ -72,6 +73,34 @@ inline bool diffCategory(BinningIndex const& a, BinningIndex const& b)
   return a.bin >= b.bin;
 }
 
+// Sort entries added with increasing index by bin, equivalent to a stable sort.
+// A counting sort is used when the range of bins is not much larger than the number of entries.
+inline void sortByBin(std::vector<BinningIndex>& groupedIndices)
+{
+  if (groupedIndices.size() < 2) {
+    return;
+  }
+  auto [minIt, maxIt] = std::minmax_element(groupedIndices.begin(), groupedIndices.end(), [](BinningIndex const& a, BinningIndex const& b) { return a.bin < b.bin; });
+  const int64_t minBin = minIt->bin;
+  const int64_t nBins = static_cast<int64_t>(maxIt->bin) - minBin + 1;
+  if (nBins > 4 * static_cast<int64_t>(groupedIndices.size()) + 1024) {
+    std::stable_sort(groupedIndices.begin(), groupedIndices.end());
+    return;
+  }
+  std::vector<uint64_t> binOffsets(nBins + 1, 0);
+  for (auto const& entry : groupedIndices) {
+    ++binOffsets[entry.bin - minBin + 1];
+  }
+  for (int64_t bin = 0; bin < nBins; ++bin) {
+    binOffsets[bin + 1] += binOffsets[bin];
+  }
+  std::vector<BinningIndex> sorted(groupedIndices.size(), BinningIndex{0, 0});
+  for (auto const& entry : groupedIndices) {
+    sorted[binOffsets[entry.bin - minBin]++] = entry;
+  }
+  groupedIndices.swap(sorted);
+}
+
 template <template <typename... Cs> typename BP, typename T, typename... Cs>
 std::vector<BinningIndex> groupTable(const T& table, const BP<Cs...>& binningPolicy, int minCatSize, int outsider)
 {
@@ -148,20 +177,22 @@ std::vector<BinningIndex> groupTable(const T& table, const BP<Cs...>& binningPol
     }
   }
 
-  // Do a stable sort so that same categories entries are
-  // grouped together.
-  std::stable_sort(groupedIndices.begin(), groupedIndices.end());
+  // Sort so that same categories entries are grouped together
+  // in contiguous ranges, keeping the index order within a category.
+  sortByBin(groupedIndices);
 
   // Remove categories of too small size
   if (minCatSize > 1) {
+    auto out = groupedIndices.begin();
     auto catBegin = groupedIndices.begin();
     while (catBegin != groupedIndices.end()) {
-      auto catEnd = std::upper_bound(catBegin, groupedIndices.end(), *catBegin, sameCategory);
-      if (std::distance(catBegin, catEnd) < minCatSize) {
-        catEnd = groupedIndices.erase(catBegin, catEnd);
+      auto catEnd = std::find_if(catBegin, groupedIndices.end(), [bin = catBegin->bin](BinningIndex const& entry) { return entry.bin != bin; });
+      if (std::distance(catBegin, catEnd) >= minCatSize) {
+        out = std::move(catBegin, catEnd, out);
       }
       catBegin = catEnd;
     }
+    groupedIndices.erase(out, groupedIndices.end());
   }
 
   return groupedIndices;
@@ -451,8 +482,21 @@ struct CombinationsBlockIndexPolicyBase : public CombinationsIndexPolicyBase<Ts.
       return;
     }
 
+    // The same table is often passed several times (e.g. for mixing pairs of the same collisions),
+    // in that case its binning is computed only once
+    std::array<void const*, k> tablePointers{};
     int tableIndex = 0;
-    ((this->mGroupedIndices[tableIndex++] = groupTable(tables, this->mBP, 1, this->mOutsider)), ...);
+    auto groupTableOnce = [&, this](auto const& table) {
+      tablePointers[tableIndex] = &table;
+      for (int previous = 0; previous < tableIndex; previous++) {
+        if (tablePointers[previous] == &table) {
+          this->mGroupedIndices[tableIndex++] = this->mGroupedIndices[previous];
+          return;
+        }
+      }
+      this->mGroupedIndices[tableIndex++] = groupTable(table, this->mBP, 1, this->mOutsider);
+    };
+    (groupTableOnce(tables), ...);
 
     // Synchronize categories across tables
     syncCategories(this->mGroupedIndices);
@@ -411,6 +411,13 @@ class DataAllocator
   void snapshot(const Output& spec, const char* payload, size_t payloadSize,
                 o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
 
+  /// Send the payload of a received message to the output without copying it:
+  /// the new message is a shallow, reference counted, copy of @a payload, so
+  /// that only a new header is created. If the message cannot be shared with the
+  /// transport of the output, the payload is copied as with snapshot().
+  void forward(const Output& spec, fair::mq::Message const& payload,
+               o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
+
   /// make an object of type T and route to output specified by OutputRef
   /// The object is owned by the framework, returned reference can be used to fill the object.
   ///
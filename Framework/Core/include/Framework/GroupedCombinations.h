@@ -17,6 +17,8 @@
 #include "Framework/Pack.h"
 #include "Framework/SliceCache.h"
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace o2::framework
 {
@@ -76,6 +78,7 @@ struct GroupedCombinationsGenerator {
       } else {
         mGrouping = std::make_shared<G>(std::vector{grouping.asArrowTable()});
       }
+      resetAssociatedSlices();
       setMultipleGroupingTables<sizeof...(As)>(grouping);
       if (!this->mIsEnd) {
         setCurrentGroupedCombination();
@@ -95,12 +98,19 @@ struct GroupedCombinationsGenerator {
         mGrouping = std::make_shared<G>(std::vector{grouping.asArrowTable()});
       }
       mAssociated = std::make_shared<std::tuple<As...>>(std::make_tuple(std::get<has_type_at<As>(pack<T2s...>{})>(associated)...));
+      resetAssociatedSlices();
       setMultipleGroupingTables<sizeof...(As)>(grouping);
       if (!this->mIsEnd) {
         setCurrentGroupedCombination();
       }
     }
 
+    // The end iterator is only compared to, it needs neither the binning of the grouping table nor the associated slices
+    void setEndTables(const G& grouping)
+    {
+      setEndCombination(grouping, std::make_index_sequence<sizeof...(As)>());
+    }
+
     template <std::size_t N, typename T, typename... Args>
     void setMultipleGroupingTables(const T& param, const Args&... args)
     {
@@ -158,6 +168,22 @@ struct GroupedCombinationsGenerator {
       return std::make_tuple(getAssociatedTable<Is>()...);
     }
 
+    template <std::size_t... Is>
+    void setEndCombination(const G& grouping, std::index_sequence<Is...>)
+    {
+      this->mCurrent = typename GroupingPolicy::CombinationType{(static_cast<void>(Is), grouping.begin())...};
+      GroupingPolicy::moveToEnd();
+    }
+
+    void resetAssociatedSlices()
+    {
+      std::size_t capacity = 16;
+      while (capacity < 4 * this->mSlidingWindowSize && capacity < MAX_ASSOCIATED_SLICES) {
+        capacity <<= 1;
+      }
+      mAssociatedSlices = std::make_shared<AssociatedSlicesType>(std::vector<std::optional<std::pair<uint64_t, As>>>(capacity)...);
+    }
+
     template <std::size_t I>
     auto getAssociatedTable()
     {
@@ -165,7 +191,14 @@ struct GroupedCombinationsGenerator {
       if (std::get<I>(*mAssociated).size() == 0) {
         return std::get<I>(*mAssociated);
       }
-      return std::get<I>(*mAssociated).sliceByCached(mIndexColumns[I], ind, *cache);
+      // the same grouping rows come back in all the combinations of a window,
+      // keep their slices instead of slicing the associated table again
+      auto& slices = std::get<I>(*mAssociatedSlices);
+      auto& slice = slices[ind & (slices.size() - 1)];
+      if (!slice || slice->first != ind) {
+        slice.emplace(ind, std::get<I>(*mAssociated).sliceByCached(mIndexColumns[I], ind, *cache));
+      }
+      return slice->second;
     }
 
     void setCurrentGroupedCombination()
@@ -177,9 +210,14 @@ struct GroupedCombinationsGenerator {
       }
     }
 
+    /// Direct-mapped cache of associated table slices, indexed by the grouping row
+    using AssociatedSlicesType = std::tuple<std::vector<std::optional<std::pair<uint64_t, As>>>...>;
+    static constexpr std::size_t MAX_ASSOCIATED_SLICES = 1024;
+
     std::array<expressions::BindingNode, sizeof...(As)> mIndexColumns;
     std::shared_ptr<G> mGrouping;
     std::shared_ptr<std::tuple<As...>> mAssociated;
+    std::shared_ptr<AssociatedSlicesType> mAssociatedSlices;
     std::optional<std::tuple<As...>> mSlices;
     std::optional<GroupedIteratorType> mCurrentGrouped;
     SliceCache* cache = nullptr;
@@ -222,8 +260,7 @@ struct GroupedCombinationsGenerator {
   void setTables(const G& grouping, const std::tuple<T2s...>& associated)
   {
     mBegin.setTables(grouping, associated);
-    mEnd.setTables(grouping, associated);
-    mEnd.moveToEnd();
+    mEnd.setEndTables(grouping);
   }
 
  private:
@@ -27,6 +27,7 @@
 #include <TDataType.h>
 
 #include <deque>
+#include <utility>
 
 class TList;
 
@@ -48,11 +49,53 @@ struct HistFiller {
   template <typename... Cs, typename R, typename T>
   static void fillHistAny(std::shared_ptr<R> hist, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // fill any type of histogram with all (selected) rows of the columns (Cs) of a table (if weight is requested it must reside the last specified column)
+  template <typename... Cs, typename R, typename T>
+  static void fillHistColumns(std::shared_ptr<R> hist, const T& table);
+
+  // fill any type of histogram with arrays of equal length holding the positions (and weight) of the entries
+  template <typename R, typename... Ts>
+  static void fillHistSpans(std::shared_ptr<R> hist, gsl::span<Ts>... columns);
+
+  // fill TH1, TH2, TH3, THn or THnSparse with nEntries tuples of nValues positions (and weight) stored consecutively in values
+  template <typename T>
+  static void fillHistBulk(std::shared_ptr<T> hist, const double* values, size_t nEntries, int nValues);
+
+  // histogram types that can be filled with fillHistBulk
+  template <typename T>
+  static constexpr bool isBulkFillable()
+  {
+    return std::is_same_v<TH1, T> || std::is_same_v<TH2, T> || std::is_same_v<TH3, T> || std::is_base_of_v<THnBase, T>;
+  }
+
   // function that returns rough estimate for the size of a histogram in MB
   template <typename T>
   static double getSize(std::shared_ptr<T> hist, double fillFraction = 1.);
 
  private:
+  // number of entries converted to double at once by the bulk fills
+  static constexpr size_t BULK_FILL_BLOCK_SIZE{1024};
+
+  // check that the bins of a histogram can be computed by fillBinned (fixed binning, no buffer, no extendable axes and no axis range set)
+  static bool canFillBinned(TH1* hist);
+
+  // fill a TH1, TH2 or TH3 that passes canFillBinned with tuples of (x[, y[, z]][, weight]), computing the bins of a block of entries at once
+  static void fillBinned(TH1* hist, int nDim, bool weighted, const double* values, size_t nEntries);
+
+  // fill the histogram with a block of tuples, using fillHistBulk if supported by the histogram type and fillHistAny row by row otherwise
+  template <int N, typename R>
+  static void fillHistBlock(std::shared_ptr<R> hist, const double* values, size_t nEntries);
+
+  template <typename R, size_t... Is>
+  static void fillHistRows(std::shared_ptr<R> hist, const double* values, size_t nEntries, std::index_sequence<Is...>);
+
+  // copy the values of a table column at the given rows (or at all rows starting at first if rows is null) to every stride-th element of out
+  template <typename V>
+  static void gatherColumn(arrow::ChunkedArray* column, const int64_t* rows, size_t first, size_t n, double* out, int stride);
+
+  template <typename... Cs, size_t... Is>
+  static void gatherColumns(const std::array<arrow::ChunkedArray*, sizeof...(Cs)>& columns, const int64_t* rows, size_t first, size_t n, double* out, std::index_sequence<Is...>);
+
   // helper function to determine base element size of histograms (in bytes)
   template <typename T>
   static int getBaseElementSize(T* ptr);
@@ -133,6 +176,23 @@ class HistogramRegistry
   template <typename... Cs, typename T>
   void fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // fill hist with all (selected) rows of the columns (Cs) of a (filtered) table
+  template <typename... Cs, typename T, typename = std::enable_if_t<o2::soa::is_soa_table_like_v<T>>>
+  void fill(const HistName& histName, const T& table);
+
+  // fill hist with arrays of equal length, one per position (and weight) argument
+  template <typename... Ts>
+  void fill(const HistName& histName, gsl::span<Ts>... columns);
+
+  // in buffered fill mode the single-entry fills of TH1, TH2, TH3, THn and THnSparse are collected per histogram
+  // and filled in bulk when the buffer is full, when flush() is called (at the end of every dataframe in analysis tasks)
+  // or when the histogram is accessed via get() or getListOfHistograms()
+  void setBufferedFill(bool bufferedFill = true);
+  bool isBufferedFill() const { return mBufferedFill; }
+
+  // fill the buffered entries into the histograms
+  void flush();
+
   // get rough estimate for size of histogram stored in registry
   double getSize(const HistName& histName, double fillFraction = 1.);
 
@@ -174,6 +234,13 @@ class HistogramRegistry
   // helper function that checks if name of histogram is reasonable and keeps track of names already in use
   void registerName(const std::string& name);
 
+  // append an entry to the fill buffer of the histogram at position idx
+  template <typename... Ts>
+  void bufferFill(uint32_t idx, Ts... positionAndWeight);
+
+  // fill the buffered entries into the histogram at position idx
+  void flush(uint32_t idx);
+
   std::string mName{};
   OutputObjHandlingPolicy mPolicy{};
   bool mCreateRegistryDir{};
@@ -187,6 +254,12 @@ class HistogramRegistry
   static constexpr uint32_t MAX_REGISTRY_SIZE{REGISTRY_BITMASK + 1};
   std::array<uint32_t, MAX_REGISTRY_SIZE> mRegistryKey{};
   std::array<HistPtr, MAX_REGISTRY_SIZE> mRegistryValue{};
+
+  // buffered entries of each histogram stored as consecutive tuples of mFillBufferStride values
+  static constexpr size_t MAX_FILL_BUFFER_ENTRIES{8192};
+  bool mBufferedFill{};
+  std::array<std::vector<double>, MAX_REGISTRY_SIZE> mFillBuffers{};
+  std::array<uint8_t, MAX_REGISTRY_SIZE> mFillBufferStride{};
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -234,17 +307,139 @@ void HistFiller::fillHistAny(std::shared_ptr<T> hist, const Ts&... positionAndWe
 template <typename... Cs, typename R, typename T>
 void HistFiller::fillHistAny(std::shared_ptr<R> hist, const T& table, const o2::framework::expressions::Filter& filter)
 {
-  if constexpr (std::is_base_of_v<StepTHn, T>) {
-    LOGF(fatal, "Table filling is not (yet?) supported for StepTHn.");
-    return;
-  }
   auto s = o2::framework::expressions::createSelection(table.asArrowTable(), filter);
   auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, s};
-  for (auto& t : filtered) {
-    fillHistAny(hist, (*(static_cast<Cs>(t).getIterator()))...);
+  fillHistColumns<Cs...>(hist, filtered);
+}
+
+template <typename... Cs, typename R, typename T>
+void HistFiller::fillHistColumns(std::shared_ptr<R> hist, const T& table)
+{
+  static_assert(sizeof...(Cs) > 0, "At least one column must be specified.");
+  static_assert(std::conjunction_v<typename Cs::persistent...>, "Only persistent columns can be used to fill histograms.");
+  constexpr int nValues = sizeof...(Cs);
+  std::array<arrow::ChunkedArray*, nValues> columns{o2::soa::getIndexFromLabel(table.asArrowTable().get(), Cs::columnLabel())...};
+  const int64_t* rows = nullptr;
+  size_t nEntries = table.asArrowTable()->num_rows();
+  if constexpr (o2::soa::is_soa_filtered_v<T>) {
+    rows = table.getSelectedRows().data();
+    nEntries = table.getSelectedRows().size();
+  }
+  std::vector<double> values(std::min(nEntries, BULK_FILL_BLOCK_SIZE) * nValues);
+  for (size_t first = 0; first < nEntries; first += BULK_FILL_BLOCK_SIZE) {
+    const size_t n = std::min(BULK_FILL_BLOCK_SIZE, nEntries - first);
+    gatherColumns<Cs...>(columns, rows, first, n, values.data(), std::make_index_sequence<nValues>{});
+    fillHistBlock<nValues>(hist, values.data(), n);
+  }
+}
+
+template <typename R, typename... Ts>
+void HistFiller::fillHistSpans(std::shared_ptr<R> hist, gsl::span<Ts>... columns)
+{
+  static_assert(sizeof...(Ts) > 0, "At least one array must be specified.");
+  static_assert((std::is_arithmetic_v<Ts> && ...), "Only arrays of arithmetic types can be used to fill histograms.");
+  constexpr int nValues = sizeof...(Ts);
+  const size_t nEntries = std::get<0>(std::forward_as_tuple(columns...)).size();
+  if (((columns.size() != nEntries) || ...)) {
+    LOGF(fatal, "The arrays used to fill histogram %s have different lengths.", hist->GetName());
+  }
+  std::vector<double> values(std::min(nEntries, BULK_FILL_BLOCK_SIZE) * nValues);
+  for (size_t first = 0; first < nEntries; first += BULK_FILL_BLOCK_SIZE) {
+    const size_t n = std::min(BULK_FILL_BLOCK_SIZE, nEntries - first);
+    for (size_t i = 0; i < n; ++i) {
+      double* entry = values.data() + i * nValues;
+      int j = 0;
+      ((entry[j++] = static_cast<double>(columns[first + i])), ...);
+    }
+    fillHistBlock<nValues>(hist, values.data(), n);
   }
 }
 
+template <typename T>
+void HistFiller::fillHistBulk(std::shared_ptr<T> hist, const double* values, size_t nEntries, int nValues)
+{
+  static_assert(isBulkFillable<T>(), "Bulk filling is only supported for TH1, TH2, TH3, THn and THnSparse.");
+  int nDim{};
+  if constexpr (std::is_base_of_v<THnBase, T>) {
+    nDim = hist->GetNdimensions();
+  } else {
+    nDim = hist->GetDimension();
+  }
+  if (nValues != nDim && nValues != nDim + 1) {
+    LOGF(fatal, "The number of arguments in fill function called for histogram %s is incompatible with histogram dimensions.", hist->GetName());
+  }
+  const bool weighted = (nValues == nDim + 1);
+
+  if constexpr (std::is_base_of_v<THnBase, T>) {
+    for (size_t i = 0; i < nEntries; ++i) {
+      const double* entry = values + i * nValues;
+      hist->Fill(entry, weighted ? entry[nDim] : 1.);
+    }
+  } else {
+    if (canFillBinned(hist.get())) {
+      fillBinned(hist.get(), nDim, weighted, values, nEntries);
+      return;
+    }
+    for (size_t i = 0; i < nEntries; ++i) {
+      const double* entry = values + i * nValues;
+      const double weight = weighted ? entry[nDim] : 1.;
+      if constexpr (std::is_same_v<TH1, T>) {
+        hist->Fill(entry[0], weight);
+      } else if constexpr (std::is_same_v<TH2, T>) {
+        hist->Fill(entry[0], entry[1], weight);
+      } else {
+        hist->Fill(entry[0], entry[1], entry[2], weight);
+      }
+    }
+  }
+}
+
+template <int N, typename R>
+void HistFiller::fillHistBlock(std::shared_ptr<R> hist, const double* values, size_t nEntries)
+{
+  if constexpr (isBulkFillable<R>()) {
+    fillHistBulk(hist, values, nEntries, N);
+  } else {
+    fillHistRows(hist, values, nEntries, std::make_index_sequence<N>{});
+  }
+}
+
+template <typename R, size_t... Is>
+void HistFiller::fillHistRows(std::shared_ptr<R> hist, const double* values, size_t nEntries, std::index_sequence<Is...>)
+{
+  for (size_t i = 0; i < nEntries; ++i) {
+    const double* entry = values + i * sizeof...(Is);
+    fillHistAny(hist, entry[Is]...);
+  }
+}
+
+template <typename V>
+void HistFiller::gatherColumn(arrow::ChunkedArray* column, const int64_t* rows, size_t first, size_t n, double* out, int stride)
+{
+  static_assert(std::is_arithmetic_v<V> && !std::is_same_v<bool, V>, "Only columns of arithmetic (non-bool) type can be used to fill histograms.");
+  // rows are increasing, so the chunks are traversed only once
+  int chunk = -1;
+  int64_t chunkBegin = 0;
+  int64_t chunkEnd = 0;
+  const V* chunkValues = nullptr;
+  for (size_t i = 0; i < n; ++i) {
+    const int64_t row = rows ? rows[first + i] : static_cast<int64_t>(first + i);
+    while (row >= chunkEnd) {
+      auto array = column->chunk(++chunk);
+      chunkBegin = chunkEnd;
+      chunkEnd += array->length();
+      chunkValues = std::static_pointer_cast<o2::soa::arrow_array_for_t<V>>(array)->raw_values();
+    }
+    out[i * stride] = static_cast<double>(chunkValues[row - chunkBegin]);
+  }
+}
+
+template <typename... Cs, size_t... Is>
+void HistFiller::gatherColumns(const std::array<arrow::ChunkedArray*, sizeof...(Cs)>& columns, const int64_t* rows, size_t first, size_t n, double* out, std::index_sequence<Is...>)
+{
+  (gatherColumn<typename Cs::type>(columns[Is], rows, first, n, out + Is, sizeof...(Cs)), ...);
+}
+
 template <typename T>
 double HistFiller::getSize(std::shared_ptr<T> hist, double fillFraction)
 {
@@ -364,7 +559,11 @@ std::shared_ptr<T> HistogramRegistry::add(char const* const name, char const* co
 template <typename T>
 std::shared_ptr<T> HistogramRegistry::get(const HistName& histName)
 {
-  if (auto histPtr = std::get_if<std::shared_ptr<T>>(&mRegistryValue[getHistIndex(histName)])) {
+  const uint32_t idx = getHistIndex(histName);
+  if (!mFillBuffers[idx].empty()) {
+    flush(idx);
+  }
+  if (auto histPtr = std::get_if<std::shared_ptr<T>>(&mRegistryValue[idx])) {
     return *histPtr;
   } else {
     throw runtime_error_f(R"(Histogram type specified in get<>(HIST("%s")) does not match the actual type of the histogram!)", histName.str);
@@ -413,13 +612,66 @@ uint32_t HistogramRegistry::getHistIndex(const T& histName)
 template <typename... Ts>
 void HistogramRegistry::fill(const HistName& histName, Ts&&... positionAndWeight)
 {
-  std::visit([&positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, std::forward<Ts>(positionAndWeight)...); }, mRegistryValue[getHistIndex(histName)]);
+  const uint32_t idx = getHistIndex(histName);
+  std::visit([this, idx, &positionAndWeight...](auto&& hist) {
+    using H = typename std::decay_t<decltype(hist)>::element_type;
+    if constexpr (HistFiller::isBulkFillable<H>() && sizeof...(Ts) > 0 && (std::is_arithmetic_v<std::decay_t<Ts>> && ...)) {
+      if (mBufferedFill) {
+        bufferFill(idx, static_cast<double>(positionAndWeight)...);
+        return;
+      }
+    }
+    HistFiller::fillHistAny(hist, std::forward<Ts>(positionAndWeight)...);
+  },
+             mRegistryValue[idx]);
 }
 
 template <typename... Cs, typename T>
 void HistogramRegistry::fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter)
 {
-  std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[getHistIndex(histName)]);
+  const uint32_t idx = getHistIndex(histName);
+  if (!mFillBuffers[idx].empty()) {
+    flush(idx);
+  }
+  std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[idx]);
+}
+
+template <typename... Cs, typename T, typename>
+void HistogramRegistry::fill(const HistName& histName, const T& table)
+{
+  const uint32_t idx = getHistIndex(histName);
+  if (!mFillBuffers[idx].empty()) {
+    flush(idx);
+  }
+  std::visit([&table](auto&& hist) { HistFiller::fillHistColumns<Cs...>(hist, table); }, mRegistryValue[idx]);
+}
+
+template <typename... Ts>
+void HistogramRegistry::fill(const HistName& histName, gsl::span<Ts>... columns)
+{
+  const uint32_t idx = getHistIndex(histName);
+  if (!mFillBuffers[idx].empty()) {
+    flush(idx);
+  }
+  std::visit([&columns...](auto&& hist) { HistFiller::fillHistSpans(hist, columns...); }, mRegistryValue[idx]);
+}
+
+template <typename... Ts>
+void HistogramRegistry::bufferFill(uint32_t idx, Ts... positionAndWeight)
+{
+  constexpr uint8_t stride = sizeof...(Ts);
+  auto& buffer = mFillBuffers[idx];
+  if (mFillBufferStride[idx] != stride) {
+    // entries with a different number of arguments cannot share the buffer
+    if (!buffer.empty()) {
+      flush(idx);
+    }
+    mFillBufferStride[idx] = stride;
+  }
+  (buffer.push_back(positionAndWeight), ...);
+  if (buffer.size() >= MAX_FILL_BUFFER_ENTRIES * stride) {
+    flush(idx);
+  }
 }
 
 } // namespace o2::framework
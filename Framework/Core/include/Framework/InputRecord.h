@@ -21,6 +21,7 @@
 #include "Framework/Logger.h"
 #include "Framework/ObjectCache.h"
 #include "Framework/CallbackService.h"
+#include "Framework/TimingInfo.h"
 
 #include "Headers/DataHeader.h"
 
@@ -379,6 +380,9 @@ class InputRecord
         // explicitely specify serialization method to ROOT-serialized because type T
         // is messageable and a different method would be deduced in DataRefUtils
         // return type with owning Deleter instance, forwarding to default_deleter
+        if (ref.spec && ObjectCache::policyFor(*ref.spec) == ObjectCachePolicy::ContentHash) {
+          return getContentCached<ValueT>(ref);
+        }
         std::unique_ptr<ValueT const, Deleter<ValueT const>> result(DataRefUtils::as<ROOTSerialized<ValueT>>(ref).release());
         return result;
       } else if (method == o2::header::gSerializationMethodCCDB) {
@@ -446,6 +450,9 @@ class InputRecord
         // explicitely specify serialization method to ROOT-serialized because type T
         // is messageable and a different method would be deduced in DataRefUtils
         // return type with owning Deleter instance, forwarding to default_deleter
+        if (ref.spec && ObjectCache::policyFor(*ref.spec) == ObjectCachePolicy::ContentHash) {
+          return getContentCached<T>(ref);
+        }
         std::unique_ptr<T const, Deleter<T const>> result(DataRefUtils::as<ROOTSerialized<T>>(ref).release());
         return result;
       } else {
@@ -661,6 +668,30 @@ class InputRecord
   // Produce a string describing the available inputs.
   [[nodiscard]] std::string describeAvailableInputs() const;
 
+  /// Deserialise a ROOT serialised object, reusing the instance from
+  /// a previous timeslice if the hash of the payload did not change.
+  /// The returned object is owned by the ObjectCache and stays valid
+  /// until the end of the processing of the current timeslice.
+  template <typename ValueT>
+  std::unique_ptr<ValueT const, Deleter<ValueT const>> getContentCached(DataRef const& ref) const
+  {
+    auto header = DataRefUtils::getHeader<header::DataHeader*>(ref);
+    auto payloadSize = DataRefUtils::getPayloadSize(ref);
+    ConcreteDataMatcher matcher{header->dataOrigin, header->dataDescription, header->subSpecification};
+    auto path = fmt::format("{}", DataSpecUtils::describe(matcher));
+    auto hash = ObjectCache::hashPayload(ref.payload, payloadSize);
+    auto& cache = mRegistry.get<ObjectCache>();
+    auto timeslice = mRegistry.get<TimingInfo>().timeslice;
+
+    if (auto* cached = cache.getContent(path, hash, payloadSize, timeslice)) {
+      LOGP(debug, "Returning cached object for {} ({})", path, cached);
+      return std::unique_ptr<ValueT const, Deleter<ValueT const>>((ValueT const*)cached, false);
+    }
+    auto* obj = DataRefUtils::as<ROOTSerialized<ValueT>>(ref).release();
+    auto* cached = cache.putContent(path, hash, payloadSize, (void*)obj, [](void* p) { delete reinterpret_cast<ValueT*>(p); }, timeslice);
+    return std::unique_ptr<ValueT const, Deleter<ValueT const>>((ValueT const*)cached, false);
+  }
+
   ServiceRegistryRef mRegistry;
   std::vector<InputRoute> const& mInputsSchema;
   InputSpan& mSpan;
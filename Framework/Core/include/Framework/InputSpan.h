@@ -12,6 +12,7 @@
 #define O2_FRAMEWORK_INPUTSPAN_H_
 
 #include "Framework/DataRef.h"
+#include <fairmq/FwdDecls.h>
 #include <functional>
 
 extern template class std::function<o2::framework::DataRef(size_t)>;
@@ -54,6 +55,21 @@ class InputSpan
     return mGetter(i, partidx);
   }
 
+  /// @a getter returns the message holding the payload of a part, which allows
+  /// to forward the payload without copying it. Without it, payloadMessage()
+  /// returns nullptr.
+  void setPayloadMessageGetter(std::function<fair::mq::Message const*(size_t, size_t)> getter)
+  {
+    mPayloadMessageGetter = std::move(getter);
+  }
+
+  /// message holding the payload of the @a i-th element of the InputSpan, or
+  /// nullptr if not available. It is valid until the end of the processing.
+  [[nodiscard]] fair::mq::Message const* payloadMessage(size_t i, size_t partidx = 0) const
+  {
+    return mPayloadMessageGetter ? mPayloadMessageGetter(i, partidx) : nullptr;
+  }
+
   /// @a number of parts in the i-th element of the InputSpan
   [[nodiscard]] size_t getNofParts(size_t i) const
   {
@@ -236,6 +252,7 @@ class InputSpan
  private:
   std::function<DataRef(size_t, size_t)> mGetter;
   std::function<size_t(size_t)> mNofPartsGetter;
+  std::function<fair::mq::Message const*(size_t, size_t)> mPayloadMessageGetter;
   size_t mSize;
 };
 
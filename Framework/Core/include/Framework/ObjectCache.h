@@ -12,11 +12,33 @@
 #define O2_FRAMEWORK_OBJECTCACHE_H_
 
 #include "Framework/DataRef.h"
+#include "Framework/ConfigParamSpec.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace o2::framework
 {
 
+struct InputSpec;
+
+/// How ROOT serialised inputs which are not conditions should be
+/// cached across timeslices.
+enum struct ObjectCachePolicy : int {
+  /// Deserialise the payload on every InputRecord::get (default)
+  None = 0,
+  /// Keep the deserialised object around as long as the hash of
+  /// the serialised payload does not change.
+  ContentHash = 1
+};
+
+/// Metadata for an InputSpec which enables the content-hash cache
+/// for the associated ROOT serialised input.
+ConfigParamSpec objectCachePolicySpec(ObjectCachePolicy policy = ObjectCachePolicy::ContentHash);
+
 /// A cache for CCDB objects or objects in general
 /// which have more than one timeframe of lifetime.
 struct ObjectCache {
@@ -46,6 +68,58 @@ struct ObjectCache {
   /// A map from a CacheId (which is the void* ptr of the previous map).
   /// to an actual (type erased) pointer to the deserialised object.
   std::unordered_map<Id, void*, Id::hash_fn> idToObject;
+
+  /// An entry of the content-hash keyed cache. Since the cache is
+  /// type erased we need to remember how to delete the object.
+  struct ContentEntry {
+    uint64_t hash = 0;
+    size_t size = 0;
+    void* object = nullptr;
+    void (*deleter)(void*) = nullptr;
+    /// The last timeslice in which the entry was used, for the LRU eviction.
+    size_t lastTimeslice = 0;
+    /// Number of timeslices in flight which received the object. Since the
+    /// cache is shared by all the streams, the object is only deleted once
+    /// none of them can hold a reference to it anymore.
+    int refCount = 0;
+  };
+  /// Cache for ROOT serialised objects which are not conditions, keyed
+  /// by the data matcher and validated by the hash of the payload.
+  std::unordered_map<std::string, std::unique_ptr<ContentEntry>> matcherToContent;
+  /// Entries which were invalidated or evicted while still in use.
+  std::vector<std::unique_ptr<ContentEntry>> retiredContent;
+  /// The content entries received by each timeslice in flight.
+  std::unordered_map<size_t, std::vector<ContentEntry*>> contentInFlight;
+  /// Sum of the serialised sizes of the objects owned by the content cache.
+  size_t contentCacheSize = 0;
+  /// Upper bound for contentCacheSize before least recently used
+  /// entries get evicted, set by --object-cache-size-limit.
+  size_t contentCacheLimit = 256 * 1024 * 1024;
+  /// Protects the content cache, which is accessed by all the streams.
+  std::mutex contentMutex;
+
+  /// @return the caching policy requested via the metadata of @a spec
+  static ObjectCachePolicy policyFor(InputSpec const& spec);
+  /// @return a 64 bit hash of the serialised payload
+  static uint64_t hashPayload(char const* payload, size_t size);
+  /// @return the cached object for @a path if the hash and size of its payload
+  /// match, nullptr otherwise. The object is kept alive until @a timeslice is
+  /// released. An entry with a different payload is invalidated.
+  void* getContent(std::string const& path, uint64_t hash, size_t size, size_t timeslice);
+  /// Add @a object as the cached object for @a path, used by @a timeslice.
+  /// @return the cached object, which is not @a object (then deleted) if
+  /// another stream cached the same payload in the meanwhile.
+  void* putContent(std::string const& path, uint64_t hash, size_t size, void* object, void (*deleter)(void*), size_t timeslice);
+  /// Drop the references of @a timeslice, deleting the objects which are
+  /// not cached anymore and evicting entries exceeding contentCacheLimit.
+  void releaseContent(size_t timeslice);
+  /// Drop the content cache entry for @a path. The object is deleted
+  /// once it is not used by any timeslice in flight. Requires contentMutex.
+  void eraseContent(std::string const& path);
+  /// Evict least recently used entries which are not in use until the
+  /// content cache fits into contentCacheLimit. Requires contentMutex.
+  void evictContent();
+  ~ObjectCache();
 };
 
 } // namespace o2::framework
@@ -0,0 +1,106 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_FRAMEWORK_SELECTIONBITMAP_H_
+#define O2_FRAMEWORK_SELECTIONBITMAP_H_
+
+#include <gsl/span>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace o2::soa
+{
+/// Sorted list of the selected rows of a table
+using SelectionVector = std::vector<int64_t>;
+
+/// Selection of table rows stored as one bit per row, with the same layout as
+/// the Arrow validity bitmaps (row i is bit i % 64 of word i / 64).
+/// It takes nRows / 8 bytes independently of the number of selected rows,
+/// compared to 8 bytes per selected row for a SelectionVector, and selections
+/// are combined word by word instead of merging sorted lists.
+class SelectionBitmap
+{
+ public:
+  SelectionBitmap() = default;
+  /// empty selection for a table with nRows rows
+  explicit SelectionBitmap(int64_t nRows);
+  /// selection of the given (sorted or unsorted) rows of a table with nRows rows,
+  /// throws if a row is outside of the table
+  SelectionBitmap(gsl::span<int64_t const> rows, int64_t nRows);
+
+  int64_t size() const { return mNRows; }
+  bool test(int64_t row) const { return (mWords[row >> 6] >> (row & 63)) & 1; }
+  void set(int64_t row)
+  {
+    assert(row >= 0 && row < mNRows);
+    mWords[row >> 6] |= uint64_t{1} << (row & 63);
+  }
+  uint64_t const* data() const { return mWords.data(); }
+
+  /// number of selected rows
+  int64_t count() const;
+
+  /// intersection with a bitmap for a table of the same size
+  SelectionBitmap& operator&=(SelectionBitmap const& other);
+  /// union with a bitmap for a table of the same size
+  SelectionBitmap& operator|=(SelectionBitmap const& other);
+
+  /// sorted list of the selected rows
+  SelectionVector toRows() const;
+
+  /// call f(row) for every selected row in increasing order
+  template <typename F>
+  void forEach(F&& f) const;
+
+ private:
+  int64_t mNRows = 0;
+  std::vector<uint64_t> mWords;
+};
+
+template <typename F>
+void SelectionBitmap::forEach(F&& f) const
+{
+  for (size_t w = 0; w < mWords.size(); ++w) {
+    for (uint64_t word = mWords[w]; word; word &= word - 1) {
+      f(static_cast<int64_t>(w * 64 + __builtin_ctzll(word)));
+    }
+  }
+}
+
+/// Selections for which the bitmap is cheaper to build and combine than the
+/// sorted merge of the index lists: more than one selected row every
+/// SELECTION_BITMAP_DENSITY rows of the table
+constexpr int64_t SELECTION_BITMAP_DENSITY = 32;
+
+inline bool preferSelectionBitmap(int64_t nSelected, int64_t nRows)
+{
+  return nSelected * SELECTION_BITMAP_DENSITY > nRows;
+}
+
+/// whether all the rows of a sorted selection fit in a bitmap for nRows rows
+inline bool fitsSelectionBitmap(gsl::span<int64_t const> rows, int64_t nRows)
+{
+  return rows.empty() || (rows.front() >= 0 && rows.back() < nRows);
+}
+
+/// union of two sorted selections of a table with nRows rows,
+/// using a bitmap or merging the lists depending on the selectivity.
+/// Selections with rows outside of the table are always merged.
+SelectionVector uniteSelections(gsl::span<int64_t const> a, gsl::span<int64_t const> b, int64_t nRows);
+
+/// intersection of two sorted selections of a table with nRows rows,
+/// using a bitmap or merging the lists depending on the selectivity.
+/// Selections with rows outside of the table are always merged.
+SelectionVector intersectSelections(gsl::span<int64_t const> a, gsl::span<int64_t const> b, int64_t nRows);
+} // namespace o2::soa
+
+#endif // O2_FRAMEWORK_SELECTIONBITMAP_H_
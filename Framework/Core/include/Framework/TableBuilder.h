@@ -893,8 +893,17 @@ auto makeEmptyTable(const char* name)
   return b.finalize();
 }
 
+/// Compiled gandiva projector for a given set of expressions. It is
+/// reused across dataframes as long as the schema of the source table
+/// does not change, so that the LLVM compilation happens only once.
+struct SpawnerProjectorCache {
+  std::shared_ptr<gandiva::Projector> projector = nullptr;
+  std::shared_ptr<arrow::Schema> schema = nullptr;
+};
+
 std::shared_ptr<arrow::Table> spawnerHelper(std::shared_ptr<arrow::Table>& fullTable, std::shared_ptr<arrow::Schema> newSchema, size_t nColumns,
-                                            expressions::Projector* projectors, std::vector<std::shared_ptr<arrow::Field>> const& fields, const char* name);
+                                            expressions::Projector* projectors, std::vector<std::shared_ptr<arrow::Field>> const& fields, const char* name,
+                                            SpawnerProjectorCache& cache);
 
 /// Expression-based column generator to materialize columns
 template <typename... C>
@@ -906,8 +915,9 @@ auto spawner(framework::pack<C...> columns, std::vector<std::shared_ptr<arrow::T
   }
   static auto fields = o2::soa::createFieldsFromColumns(columns);
   static auto new_schema = std::make_shared<arrow::Schema>(fields);
+  static SpawnerProjectorCache cache;
   std::array<expressions::Projector, sizeof...(C)> projectors{{std::move(C::Projector())...}};
-  return spawnerHelper(fullTable, new_schema, sizeof...(C), projectors.data(), fields, name);
+  return spawnerHelper(fullTable, new_schema, sizeof...(C), projectors.data(), fields, name, cache);
 }
 
 template <typename... T>
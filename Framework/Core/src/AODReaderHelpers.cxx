@@ -42,6 +42,7 @@
 #include <arrow/util/key_value_metadata.h>
 
 #include <thread>
+#include <chrono>
 
 namespace o2::framework::readers
 {
@@ -150,6 +151,7 @@ AlgorithmSpec AODReaderHelpers::aodSpawnerCallback(std::vector<InputSpec>& reque
   return AlgorithmSpec::InitCallback{[requested](InitContext& /*ic*/) {
     return [requested](ProcessingContext& pc) {
       auto outputs = pc.outputs();
+      auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
       // spawn tables
       for (auto& input : requested) {
         auto&& [origin, description, version] = DataSpecUtils::asConcreteDataMatcher(input);
@@ -164,7 +166,11 @@ AlgorithmSpec AODReaderHelpers::aodSpawnerCallback(std::vector<InputSpec>& reque
               originalTables.push_back(pc.inputs().get<TableConsumer>(spec.binding)->asArrowTable());
             }
           }
-          return o2::framework::spawner(expressions{}, std::move(originalTables), input.binding.c_str());
+          auto start = std::chrono::steady_clock::now();
+          auto spawned = o2::framework::spawner(expressions{}, std::move(originalTables), input.binding.c_str());
+          auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+          monitoring.send(o2::monitoring::Metric{(uint64_t)elapsed, fmt::format("aod-spawner-time-{}", input.binding)}.addTag(o2::monitoring::tags::Key::Subsystem, o2::monitoring::tags::Value::DPL));
+          return spawned;
         };
 
         if (description == header::DataDescription{"TRACK"}) {
@@ -0,0 +1,103 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "AODWriterQueue.h"
+#include "Framework/Logger.h"
+#include <chrono>
+
+namespace o2::framework
+{
+
+AODWriterQueue::AODWriterQueue(size_t maxQueuedBytes, WriteCallback write)
+  : mMaxQueuedBytes{maxQueuedBytes},
+    mWrite{std::move(write)},
+    mThread{&AODWriterQueue::run, this}
+{
+}
+
+AODWriterQueue::~AODWriterQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mJobAvailable.notify_all();
+  mThread.join();
+}
+
+void AODWriterQueue::push(AODWriteJob&& job)
+{
+  auto size = job.size();
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    // Always accept a job if the queue is empty, even if it
+    // is larger than the limit, not to deadlock.
+    mSpaceAvailable.wait(lock, [this, size]() { return mError || mJobs.empty() || mQueuedBytes + size <= mMaxQueuedBytes; });
+    rethrow();
+    mJobs.emplace_back(std::move(job));
+    mQueuedJobs = mJobs.size();
+    mQueuedBytes += size;
+  }
+  mJobAvailable.notify_one();
+}
+
+void AODWriterQueue::flush()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mSpaceAvailable.wait(lock, [this]() { return mError || (mJobs.empty() && !mBusy); });
+  rethrow();
+}
+
+void AODWriterQueue::rethrow()
+{
+  if (mError) {
+    auto error = mError;
+    mError = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void AODWriterQueue::run()
+{
+  while (true) {
+    AODWriteJob job;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mJobAvailable.wait(lock, [this]() { return mStop || !mJobs.empty(); });
+      if (mJobs.empty()) {
+        return;
+      }
+      job = std::move(mJobs.front());
+      mJobs.pop_front();
+      mBusy = true;
+    }
+    auto size = job.size();
+    auto start = std::chrono::steady_clock::now();
+    try {
+      mWrite(job);
+    } catch (...) {
+      LOGP(error, "Exception while writing table {}", job.tableName);
+      std::lock_guard<std::mutex> lock(mMutex);
+      mError = std::current_exception();
+    }
+    mWriteTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    mWrittenBytes += size;
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mQueuedBytes -= size;
+      mQueuedJobs = mJobs.size();
+      mBusy = false;
+    }
+    mSpaceAvailable.notify_all();
+  }
+}
+
+} // namespace o2::framework
@@ -0,0 +1,103 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_AODWRITERQUEUE_H_
+#define O2_FRAMEWORK_AODWRITERQUEUE_H_
+
+#include <TString.h>
+#include <fairmq/Message.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace o2::framework
+{
+
+struct DataOutputDescriptor;
+
+/// A serialised arrow table which has to be written by the AOD writer,
+/// together with all the information needed to route it to the right
+/// file and folder. The job holds a reference to the input message, so
+/// that the payload outlives the processing callback without being
+/// copied. The payload vector is only used when no message is available.
+struct AODWriteJob {
+  fair::mq::MessagePtr message;
+  std::vector<uint8_t> payload;
+  std::string tableName;
+  std::vector<DataOutputDescriptor*> descriptors;
+  uint64_t tfNumber = 0;
+  std::string aodInputFile;
+  std::vector<TString> metaDataKeys;
+  std::vector<TString> metaDataVals;
+  /// Check (and close) the output files which reached the size limit before
+  /// writing this job. Set for the first job of each timeslice.
+  bool checkFileSizes = false;
+
+  uint8_t const* data() const { return message ? reinterpret_cast<uint8_t const*>(message->GetData()) : payload.data(); }
+  size_t size() const { return message ? message->GetSize() : payload.size(); }
+};
+
+/// A bounded queue of AODWriteJobs, consumed by a dedicated writer thread,
+/// so that compression and disk I/O do not block the processing of the
+/// next timeslice. The producer blocks in push() once the payloads in the
+/// queue exceed the configured memory limit.
+class AODWriterQueue
+{
+ public:
+  using WriteCallback = std::function<void(AODWriteJob&)>;
+
+  AODWriterQueue(size_t maxQueuedBytes, WriteCallback write);
+  ~AODWriterQueue();
+
+  /// Enqueue a job, waiting for the writer if the queue is full.
+  /// Rethrows any exception which happened in the writer thread.
+  void push(AODWriteJob&& job);
+  /// Wait until all the queued jobs have been written.
+  /// Rethrows any exception which happened in the writer thread.
+  void flush();
+
+  size_t queuedJobs() const { return mQueuedJobs.load(); }
+  size_t queuedBytes() const { return mQueuedBytes.load(); }
+  /// Serialised bytes written since the start.
+  uint64_t writtenBytes() const { return mWrittenBytes.load(); }
+  /// Time spent writing since the start, in microseconds.
+  uint64_t writeTime() const { return mWriteTime.load(); }
+
+ private:
+  void run();
+  void rethrow();
+
+  size_t mMaxQueuedBytes;
+  WriteCallback mWrite;
+  std::deque<AODWriteJob> mJobs;
+  std::mutex mMutex;
+  std::condition_variable mJobAvailable;
+  std::condition_variable mSpaceAvailable;
+  bool mStop = false;
+  bool mBusy = false;
+  std::exception_ptr mError = nullptr;
+  std::atomic<size_t> mQueuedJobs = 0;
+  std::atomic<size_t> mQueuedBytes = 0;
+  std::atomic<uint64_t> mWrittenBytes = 0;
+  std::atomic<uint64_t> mWriteTime = 0;
+  std::thread mThread;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_AODWRITERQUEUE_H_
@@ -41,12 +41,14 @@
 #include "Framework/RateLimiter.h"
 #include "Framework/Plugins.h"
 #include "Framework/DeviceSpec.h"
+#include "AODWriterQueue.h"
 #include <Monitoring/Monitoring.h>
 
 #include "TFile.h"
 #include "TTree.h"
 #include "TMap.h"
 #include "TObjString.h"
+#include "TROOT.h"
 
 #include <fairmq/Device.h>
 #include <chrono>
@@ -306,8 +308,79 @@ DataProcessorSpec
       };
     }
 
+    // write a table to all the files / folders it is requested in
+    auto writeTable = [dod](std::shared_ptr<arrow::Table> const& table, std::string const& tableName,
+                            std::vector<DataOutputDescriptor*> const& ds, uint64_t tfNumber, std::string const& aodInputFile,
+                            std::vector<TString> const& aodMetaDataKeys, std::vector<TString> const& aodMetaDataVals) {
+      if (!table->Validate().ok()) {
+        LOGP(warning, "The table \"{}\" is not valid and will not be saved!", tableName);
+        return;
+      }
+      if (table->schema()->fields().empty()) {
+        LOGP(debug, "The table \"{}\" is empty but will be saved anyway!", tableName);
+      }
+
+      // loop over all DataOutputDescriptors
+      // a table can be saved in multiple ways
+      // e.g. different selections of columns to different files
+      for (auto d : ds) {
+        auto fileAndFolder = dod->getFileFolder(d, tfNumber, aodInputFile);
+        auto treename = fileAndFolder.folderName + "/" + d->treename;
+        TableToTree ta2tr(table,
+                          fileAndFolder.file,
+                          treename.c_str());
+
+        // update metadata
+        if (fileAndFolder.file->FindObjectAny("metaData")) {
+          LOGF(debug, "Metadata: target file %s already has metadata, preserving it", fileAndFolder.file->GetName());
+        } else if (!aodMetaDataKeys.empty() && !aodMetaDataVals.empty()) {
+          TMap aodMetaDataMap;
+          for (uint32_t imd = 0; imd < aodMetaDataKeys.size(); imd++) {
+            aodMetaDataMap.Add(new TObjString(aodMetaDataKeys[imd]), new TObjString(aodMetaDataVals[imd]));
+          }
+          fileAndFolder.file->WriteObject(&aodMetaDataMap, "metaData", "Overwrite");
+        }
+
+        if (!d->colnames.empty()) {
+          for (auto& cn : d->colnames) {
+            auto idx = table->schema()->GetFieldIndex(cn);
+            auto col = table->column(idx);
+            auto field = table->schema()->field(idx);
+            if (idx != -1) {
+              ta2tr.addBranch(col, field);
+            }
+          }
+        } else {
+          ta2tr.addAllBranches();
+        }
+        ta2tr.process();
+      }
+    };
+
+    // If requested, the conversion to TTrees and the actual writing happens in a
+    // dedicated thread, so that compression and I/O do not backpressure the
+    // producers. The writer thread owns the output files, so everything touching
+    // them (including the size checks) goes through the queue.
+    std::shared_ptr<AODWriterQueue> writerQueue;
+    auto queueSize = ic.options().get<int64_t>("aod-writer-queue-size");
+    if (queueSize > 0) {
+      LOGP(info, "Writing AODs asynchronously, buffering up to {} MB", queueSize);
+      // the processing callback keeps deserialising ROOT objects while the writer thread writes
+      ROOT::EnableThreadSafety();
+      writerQueue = std::make_shared<AODWriterQueue>(queueSize * 1024 * 1024, [dod, writeTable](AODWriteJob& job) {
+        if (job.checkFileSizes) {
+          dod->checkFileSizes();
+        }
+        TableConsumer consumer(job.data(), job.size());
+        writeTable(consumer.asArrowTable(), job.tableName, job.descriptors, job.tfNumber, job.aodInputFile, job.metaDataKeys, job.metaDataVals);
+      });
+    }
+
     // end of data functor is called at the end of the data stream
-    auto endofdatacb = [dod](EndOfStreamContext& context) {
+    auto endofdatacb = [dod, writerQueue](EndOfStreamContext& context) {
+      if (writerQueue) {
+        writerQueue->flush();
+      }
       dod->closeDataFiles();
       context.services().get<ControlService>().readyToQuit(QuitRequest::Me);
     };
@@ -323,7 +396,7 @@ DataProcessorSpec
     std::vector<TString> aodMetaDataVals;
 
     // this functor is called once per time frame
-    return [dod, tfNumbers, tfFilenames, aodMetaDataKeys, aodMetaDataVals](ProcessingContext& pc) mutable -> void {
+    return [dod, tfNumbers, tfFilenames, aodMetaDataKeys, aodMetaDataVals, writeTable, writerQueue](ProcessingContext& pc) mutable -> void {
       LOGP(debug, "======== getGlobalAODSink::processing ==========");
       LOGP(debug, " processing data set with {} entries", pc.inputs().size());
 
@@ -352,7 +425,11 @@ DataProcessorSpec
       }
 
       // close all output files if one has reached size limit
-      dod->checkFileSizes();
+      bool checkFileSizes = true;
+      if (!writerQueue) {
+        dod->checkFileSizes();
+        checkFileSizes = false;
+      }
 
       // loop over the DataRefs which are contained in pc.inputs()
       for (const auto& ref : pc.inputs()) {
@@ -404,50 +481,43 @@ DataProcessorSpec
           LOGP(error, "No header for message {}:{}", ref.spec->binding, DataSpecUtils::describe(*ref.spec));
           continue;
         }
-        auto s = pc.inputs().get<TableConsumer>(ref.spec->binding);
-        auto table = s->asArrowTable();
-        if (!table->Validate().ok()) {
-          LOGP(warning, "The table \"{}\" is not valid and will not be saved!", tableName);
+        if (writerQueue) {
+          // The input message is released once we return, so the writer gets its own
+          // reference to it. Copy() shares the underlying buffer rather than copying it.
+          AODWriteJob job{
+            .tableName = tableName,
+            .descriptors = ds,
+            .tfNumber = tfNumber,
+            .aodInputFile = aodInputFile,
+            .metaDataKeys = aodMetaDataKeys,
+            .metaDataVals = aodMetaDataVals,
+            .checkFileSizes = checkFileSizes};
+          if (auto const* payloadMessage = pc.inputs().span().payloadMessage(pc.inputs().getPos(ref.spec->binding))) {
+            job.message = payloadMessage->GetTransport()->CreateMessage();
+            job.message->Copy(*payloadMessage);
+          } else {
+            auto payload = reinterpret_cast<uint8_t const*>(msg.payload);
+            job.payload.assign(payload, payload + DataRefUtils::getPayloadSize(msg));
+          }
+          checkFileSizes = false;
+          writerQueue->push(std::move(job));
           continue;
         }
-        if (table->schema()->fields().empty()) {
-          LOGP(debug, "The table \"{}\" is empty but will be saved anyway!", tableName);
-        }
-
-        // loop over all DataOutputDescriptors
-        // a table can be saved in multiple ways
-        // e.g. different selections of columns to different files
-        for (auto d : ds) {
-          auto fileAndFolder = dod->getFileFolder(d, tfNumber, aodInputFile);
-          auto treename = fileAndFolder.folderName + "/" + d->treename;
-          TableToTree ta2tr(table,
-                            fileAndFolder.file,
-                            treename.c_str());
-
-          // update metadata
-          if (fileAndFolder.file->FindObjectAny("metaData")) {
-            LOGF(debug, "Metadata: target file %s already has metadata, preserving it", fileAndFolder.file->GetName());
-          } else if (!aodMetaDataKeys.empty() && !aodMetaDataVals.empty()) {
-            TMap aodMetaDataMap;
-            for (uint32_t imd = 0; imd < aodMetaDataKeys.size(); imd++) {
-              aodMetaDataMap.Add(new TObjString(aodMetaDataKeys[imd]), new TObjString(aodMetaDataVals[imd]));
-            }
-            fileAndFolder.file->WriteObject(&aodMetaDataMap, "metaData", "Overwrite");
-          }
+        auto s = pc.inputs().get<TableConsumer>(ref.spec->binding);
+        writeTable(s->asArrowTable(), tableName, ds, tfNumber, aodInputFile, aodMetaDataKeys, aodMetaDataVals);
+      }
 
-          if (!d->colnames.empty()) {
-            for (auto& cn : d->colnames) {
-              auto idx = table->schema()->GetFieldIndex(cn);
-              auto col = table->column(idx);
-              auto field = table->schema()->field(idx);
-              if (idx != -1) {
-                ta2tr.addBranch(col, field);
-              }
-            }
-          } else {
-            ta2tr.addAllBranches();
-          }
-          ta2tr.process();
+      if (writerQueue) {
+        using o2::monitoring::Metric;
+        using o2::monitoring::tags::Key;
+        using o2::monitoring::tags::Value;
+        auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+        monitoring.send(Metric{(uint64_t)writerQueue->queuedJobs(), "aod-writer-queue-depth"}.addTag(Key::Subsystem, Value::DPL));
+        monitoring.send(Metric{(uint64_t)writerQueue->queuedBytes() / 1000, "aod-writer-queue-kb"}.addTag(Key::Subsystem, Value::DPL));
+        auto writeTime = writerQueue->writeTime();
+        if (writeTime > 0) {
+          // serialised MB written per second of writer activity
+          monitoring.send(Metric{(double)writerQueue->writtenBytes() / (double)writeTime, "aod-writer-throughput-mb-s"}.addTag(Key::Subsystem, Value::DPL));
         }
       }
     };
@@ -460,7 +530,7 @@ DataProcessorSpec
     outputInputs,
     Outputs{},
     AlgorithmSpec(writerFunction),
-    {}};
+    {{"aod-writer-queue-size", VariantType::Int64, 0LL, {"Maximum size (MB) of the tables queued for the asynchronous writer thread, 0 writes synchronously"}}}};
 
   return spec;
 }
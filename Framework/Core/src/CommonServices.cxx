@@ -1147,11 +1147,19 @@ o2::framework::ServiceSpec CommonServices::objectCache()
 {
   return ServiceSpec{
     .name = "object-cache",
-    .init = [](ServiceRegistryRef, DeviceState&, fair::mq::ProgOptions&) -> ServiceHandle {
+    .init = [](ServiceRegistryRef, DeviceState&, fair::mq::ProgOptions& options) -> ServiceHandle {
       auto* cache = new ObjectCache();
+      if (options.Count("object-cache-size-limit")) {
+        cache->contentCacheLimit = std::stoll(options.GetPropertyAsString("object-cache-size-limit")) * 1024 * 1024;
+      }
       return ServiceHandle{TypeIdHelpers::uniqueId<ObjectCache>(), cache};
     },
     .configure = noConfiguration(),
+    .postProcessing = [](ProcessingContext& ctx, void* service) {
+      // Objects handed out for this timeslice cannot be referenced anymore.
+      auto* cache = (ObjectCache*)service;
+      cache->releaseContent(ctx.services().get<TimingInfo>().timeslice);
+    },
     .kind = ServiceKind::Serial};
 }
 
@@ -291,6 +291,26 @@ void DataAllocator::snapshot(const Output& spec, const char* payload, size_t pay
   addPartToContext(routeIndex, std::move(payloadMessage), spec, serializationMethod);
 }
 
+void DataAllocator::forward(const Output& spec, fair::mq::Message const& payload,
+                            o2::header::SerializationMethod serializationMethod)
+{
+  auto& proxy = mRegistry.get<FairMQDeviceProxy>();
+  auto& timingInfo = mRegistry.get<TimingInfo>();
+
+  RouteIndex routeIndex = matchDataHeader(spec, timingInfo.timeslice);
+  auto* transport = proxy.getOutputTransport(routeIndex);
+  fair::mq::MessagePtr payloadMessage;
+  if (payload.GetType() == transport->GetType()) {
+    payloadMessage = transport->CreateMessage();
+    payloadMessage->Copy(payload);
+  } else {
+    payloadMessage = proxy.createOutputMessage(routeIndex, payload.GetSize());
+    memcpy(payloadMessage->GetData(), payload.GetData(), payload.GetSize());
+  }
+
+  addPartToContext(routeIndex, std::move(payloadMessage), spec, serializationMethod);
+}
+
 Output DataAllocator::getOutputByBind(OutputRef&& ref)
 {
   if (ref.label.empty()) {
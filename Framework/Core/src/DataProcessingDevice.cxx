@@ -2121,7 +2121,15 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
     auto nofPartsGetter = [&currentSetOfInputs](size_t i) -> size_t {
       return currentSetOfInputs[i].getNumberOfPairs();
     };
-    return InputSpan{getter, nofPartsGetter, currentSetOfInputs.size()};
+    auto payloadMessageGetter = [&currentSetOfInputs](size_t i, size_t partindex) -> fair::mq::Message const* {
+      if (currentSetOfInputs[i].getNumberOfPairs() > partindex) {
+        return currentSetOfInputs[i].associatedPayload(partindex).get();
+      }
+      return nullptr;
+    };
+    InputSpan span{getter, nofPartsGetter, currentSetOfInputs.size()};
+    span.setPayloadMessageGetter(payloadMessageGetter);
+    return span;
   };
 
   auto markInputsAsDone = [ref](TimesliceSlot slot) -> void {
@@ -17,6 +17,123 @@
 namespace o2::framework
 {
 
+bool HistFiller::canFillBinned(TH1* hist)
+{
+  if (hist->GetBuffer()) {
+    return false;
+  }
+  TAxis* axes[] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+  for (int d = 0; d < hist->GetDimension(); ++d) {
+    if (axes[d]->GetXbins()->fN || axes[d]->CanExtend() || axes[d]->TestBit(TAxis::kAxisRange)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// same result as the entry by entry TH1::Fill, but the bins of a block of entries are computed
+// in a loop without function calls that the compiler can vectorize, the bin content arrays
+// are updated directly and the statistics are updated once per call
+void HistFiller::fillBinned(TH1* hist, int nDim, bool weighted, const double* values, size_t nEntries)
+{
+  constexpr size_t blockSize{256};
+  const int nValues = nDim + weighted;
+  TAxis* axes[] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+  int nBins[3]{1, 1, 1};
+  double min[3]{}, max[3]{};
+  for (int d = 0; d < nDim; ++d) {
+    nBins[d] = axes[d]->GetNbins();
+    min[d] = axes[d]->GetXmin();
+    max[d] = axes[d]->GetXmax();
+  }
+
+  // weights other than 1 require the sum of squares of weights, as in TH1::Fill
+  TArrayD* sumw2 = hist->GetSumw2();
+  if (weighted && !sumw2->fN && !hist->TestBit(TH1::kIsNotW)) {
+    for (size_t i = 0; i < nEntries; ++i) {
+      if (values[i * nValues + nDim] != 1.) {
+        hist->Sumw2();
+        break;
+      }
+    }
+  }
+  double* contentD = nullptr;
+  float* contentF = nullptr;
+  if (auto array = dynamic_cast<TArrayD*>(hist)) {
+    contentD = array->GetArray();
+  } else if (auto array = dynamic_cast<TArrayF*>(hist)) {
+    contentF = array->GetArray();
+  }
+  double* sumw2Array = sumw2->fN ? sumw2->GetArray() : nullptr;
+
+  // stats as defined in TH1::GetStats, TH2::GetStats and TH3::GetStats
+  double stats[TH1::kNstat]{};
+  if (hist->GetEntries() > 0) {
+    hist->GetStats(stats);
+  }
+  const bool statOverflows = hist->GetStatOverflowsBehaviour();
+
+  int bins[blockSize];
+  int inRange[blockSize];
+  for (size_t first = 0; first < nEntries; first += blockSize) {
+    const int n = std::min(blockSize, nEntries - first);
+    const double* block = values + first * nValues;
+    for (int i = 0; i < n; ++i) {
+      bins[i] = 0;
+      inRange[i] = 1;
+    }
+    // same bin as TAxis::FindBin for fixed bins, global bin as in TH1::GetBin
+    for (int d = nDim - 1; d >= 0; --d) {
+      const int nb = nBins[d];
+      const double xmin = min[d], xmax = max[d];
+      for (int i = 0; i < n; ++i) {
+        const double x = block[i * nValues + d];
+        int bin = x < xmin ? 0 : (!(x < xmax) ? nb + 1 : 1 + static_cast<int>(nb * (x - xmin) / (xmax - xmin)));
+        bins[i] = bins[i] * (nb + 2) + bin;
+        inRange[i] &= (bin > 0) & (bin <= nb);
+      }
+    }
+    for (int i = 0; i < n; ++i) {
+      const double* entry = block + i * nValues;
+      const double w = weighted ? entry[nDim] : 1.;
+      if (contentD) {
+        contentD[bins[i]] += w;
+      } else if (contentF) {
+        contentF[bins[i]] += static_cast<float>(w);
+      } else {
+        hist->AddBinContent(bins[i], w);
+      }
+      if (sumw2Array) {
+        sumw2Array[bins[i]] += w * w;
+      }
+      if (!inRange[i] && !statOverflows) {
+        continue;
+      }
+      const double x = entry[0];
+      stats[0] += w;
+      stats[1] += w * w;
+      stats[2] += w * x;
+      stats[3] += w * x * x;
+      if (nDim > 1) {
+        const double y = entry[1];
+        stats[4] += w * y;
+        stats[5] += w * y * y;
+        stats[6] += w * x * y;
+        if (nDim > 2) {
+          const double z = entry[2];
+          stats[7] += w * z;
+          stats[8] += w * z * z;
+          stats[9] += w * x * z;
+          stats[10] += w * y * z;
+        }
+      }
+    }
+  }
+  const double entries = hist->GetEntries() + nEntries;
+  hist->PutStats(stats);
+  hist->SetEntries(entries);
+}
+
 constexpr HistogramRegistry::HistName::HistName(char const* const name)
   : str(name),
     hash(compile_time_hash(name)),
@@ -188,6 +305,40 @@ void HistogramRegistry::clean()
   for (auto& value : mRegistryValue) {
     std::visit([](auto&& hist) { hist.reset(); }, value);
   }
+  for (auto& buffer : mFillBuffers) {
+    buffer.clear();
+  }
+}
+
+void HistogramRegistry::setBufferedFill(bool bufferedFill)
+{
+  if (!bufferedFill) {
+    flush();
+  }
+  mBufferedFill = bufferedFill;
+}
+
+void HistogramRegistry::flush()
+{
+  for (auto j = 0u; j < MAX_REGISTRY_SIZE; ++j) {
+    if (!mFillBuffers[j].empty()) {
+      flush(j);
+    }
+  }
+}
+
+void HistogramRegistry::flush(uint32_t idx)
+{
+  auto& buffer = mFillBuffers[idx];
+  const int stride = mFillBufferStride[idx];
+  std::visit([&](auto&& hist) {
+    using H = typename std::decay_t<decltype(hist)>::element_type;
+    if constexpr (HistFiller::isBulkFillable<H>()) {
+      HistFiller::fillHistBulk(hist, buffer.data(), buffer.size() / stride, stride);
+    }
+  },
+             mRegistryValue[idx]);
+  buffer.clear();
 }
 
 // print some useful meta-info about the stored histograms
@@ -281,6 +432,8 @@ void HistogramRegistry::print(bool showAxisDetails)
 // create output structure will be propagated to file-sink
 TList* HistogramRegistry::getListOfHistograms()
 {
+  flush();
+
   TList* list = new TList();
   list->SetName(mName.data());
 
@@ -0,0 +1,209 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/ObjectCache.h"
+#include "Framework/InputSpec.h"
+#include "Framework/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace o2::framework
+{
+
+ConfigParamSpec objectCachePolicySpec(ObjectCachePolicy policy)
+{
+  return ConfigParamSpec{"object-cache-policy", VariantType::Int, static_cast<int>(policy), {"Cache policy for deserialised objects (0: none, 1: content hash)"}, ConfigParamKind::kGeneric};
+}
+
+ObjectCachePolicy ObjectCache::policyFor(InputSpec const& spec)
+{
+  for (auto& meta : spec.metadata) {
+    if (meta.name == "object-cache-policy") {
+      return static_cast<ObjectCachePolicy>(meta.defaultValue.get<int>());
+    }
+  }
+  return ObjectCachePolicy::None;
+}
+
+// MurmurHash64A, processing the payload 8 bytes at the time.
+uint64_t ObjectCache::hashPayload(char const* payload, size_t size)
+{
+  constexpr uint64_t m = 0xc6a4a7935bd1e995ULL;
+  constexpr int r = 47;
+  uint64_t h = 0x8445d61a4e774912ULL ^ (size * m);
+
+  size_t nWords = size / sizeof(uint64_t);
+  for (size_t i = 0; i < nWords; ++i) {
+    uint64_t k;
+    std::memcpy(&k, payload + i * sizeof(uint64_t), sizeof(uint64_t));
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+    h ^= k;
+    h *= m;
+  }
+
+  auto const* tail = reinterpret_cast<unsigned char const*>(payload + nWords * sizeof(uint64_t));
+  switch (size & 7) {
+    case 7:
+      h ^= uint64_t(tail[6]) << 48;
+      [[fallthrough]];
+    case 6:
+      h ^= uint64_t(tail[5]) << 40;
+      [[fallthrough]];
+    case 5:
+      h ^= uint64_t(tail[4]) << 32;
+      [[fallthrough]];
+    case 4:
+      h ^= uint64_t(tail[3]) << 24;
+      [[fallthrough]];
+    case 3:
+      h ^= uint64_t(tail[2]) << 16;
+      [[fallthrough]];
+    case 2:
+      h ^= uint64_t(tail[1]) << 8;
+      [[fallthrough]];
+    case 1:
+      h ^= uint64_t(tail[0]);
+      h *= m;
+  }
+
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+  return h;
+}
+
+namespace
+{
+void useContent(ObjectCache& cache, ObjectCache::ContentEntry& entry, size_t timeslice)
+{
+  entry.lastTimeslice = std::max(entry.lastTimeslice, timeslice);
+  auto& used = cache.contentInFlight[timeslice];
+  if (std::find(used.begin(), used.end(), &entry) == used.end()) {
+    used.push_back(&entry);
+    entry.refCount++;
+  }
+}
+} // namespace
+
+void* ObjectCache::getContent(std::string const& path, uint64_t hash, size_t size, size_t timeslice)
+{
+  std::lock_guard<std::mutex> lock(contentMutex);
+  auto it = matcherToContent.find(path);
+  if (it == matcherToContent.end()) {
+    return nullptr;
+  }
+  auto& entry = *it->second;
+  if (entry.hash != hash || entry.size != size) {
+    // Content changed, the old object is not valid anymore.
+    LOGP(debug, "Content of {} changed, invalidating cached object", path);
+    eraseContent(path);
+    return nullptr;
+  }
+  useContent(*this, entry, timeslice);
+  return entry.object;
+}
+
+void* ObjectCache::putContent(std::string const& path, uint64_t hash, size_t size, void* object, void (*deleter)(void*), size_t timeslice)
+{
+  std::lock_guard<std::mutex> lock(contentMutex);
+  auto it = matcherToContent.find(path);
+  if (it != matcherToContent.end()) {
+    auto& entry = *it->second;
+    if (entry.hash == hash && entry.size == size) {
+      deleter(object);
+      useContent(*this, entry, timeslice);
+      return entry.object;
+    }
+    eraseContent(path);
+  }
+  auto& entry = matcherToContent[path];
+  entry = std::make_unique<ContentEntry>(ContentEntry{.hash = hash, .size = size, .object = object, .deleter = deleter, .lastTimeslice = timeslice});
+  useContent(*this, *entry, timeslice);
+  contentCacheSize += size;
+  evictContent();
+  return object;
+}
+
+void ObjectCache::releaseContent(size_t timeslice)
+{
+  std::lock_guard<std::mutex> lock(contentMutex);
+  auto it = contentInFlight.find(timeslice);
+  if (it == contentInFlight.end()) {
+    return;
+  }
+  for (auto* entry : it->second) {
+    entry->refCount--;
+  }
+  contentInFlight.erase(it);
+  for (auto retired = retiredContent.begin(); retired != retiredContent.end();) {
+    if ((*retired)->refCount > 0) {
+      ++retired;
+      continue;
+    }
+    (*retired)->deleter((*retired)->object);
+    contentCacheSize -= (*retired)->size;
+    retired = retiredContent.erase(retired);
+  }
+  evictContent();
+}
+
+void ObjectCache::eraseContent(std::string const& path)
+{
+  auto it = matcherToContent.find(path);
+  if (it == matcherToContent.end()) {
+    return;
+  }
+  auto entry = std::move(it->second);
+  matcherToContent.erase(it);
+  if (entry->refCount > 0) {
+    retiredContent.push_back(std::move(entry));
+    return;
+  }
+  entry->deleter(entry->object);
+  contentCacheSize -= entry->size;
+}
+
+void ObjectCache::evictContent()
+{
+  while (contentCacheSize > contentCacheLimit) {
+    auto oldest = matcherToContent.end();
+    for (auto it = matcherToContent.begin(); it != matcherToContent.end(); ++it) {
+      if (it->second->refCount > 0) {
+        continue;
+      }
+      if (oldest == matcherToContent.end() || it->second->lastTimeslice < oldest->second->lastTimeslice) {
+        oldest = it;
+      }
+    }
+    // Everything which is left is in use by some timeslice in flight.
+    if (oldest == matcherToContent.end()) {
+      return;
+    }
+    LOGP(debug, "Evicting cached object for {} ({} bytes)", oldest->first, oldest->second->size);
+    oldest->second->deleter(oldest->second->object);
+    contentCacheSize -= oldest->second->size;
+    matcherToContent.erase(oldest);
+  }
+}
+
+ObjectCache::~ObjectCache()
+{
+  for (auto& [path, entry] : matcherToContent) {
+    entry->deleter(entry->object);
+  }
+  for (auto& entry : retiredContent) {
+    entry->deleter(entry->object);
+  }
+}
+
+} // namespace o2::framework
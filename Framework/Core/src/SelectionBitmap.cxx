@@ -0,0 +1,106 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/SelectionBitmap.h"
+#include "Framework/RuntimeError.h"
+#include <algorithm>
+#include <iterator>
+
+namespace o2::soa
+{
+
+SelectionBitmap::SelectionBitmap(int64_t nRows)
+  : mNRows(nRows),
+    mWords((nRows + 63) / 64, 0)
+{
+}
+
+SelectionBitmap::SelectionBitmap(gsl::span<int64_t const> rows, int64_t nRows)
+  : SelectionBitmap(nRows)
+{
+  for (auto row : rows) {
+    if (row < 0 || row >= nRows) {
+      throw o2::framework::runtime_error_f("Row %lld is outside of a table with %lld rows", static_cast<long long>(row), static_cast<long long>(nRows));
+    }
+    set(row);
+  }
+}
+
+int64_t SelectionBitmap::count() const
+{
+  int64_t n = 0;
+  for (auto word : mWords) {
+    n += __builtin_popcountll(word);
+  }
+  return n;
+}
+
+SelectionBitmap& SelectionBitmap::operator&=(SelectionBitmap const& other)
+{
+  if (other.mNRows != mNRows) {
+    throw o2::framework::runtime_error_f("Cannot intersect selections of tables with %lld and %lld rows", static_cast<long long>(mNRows), static_cast<long long>(other.mNRows));
+  }
+  auto* __restrict__ words = mWords.data();
+  auto const* __restrict__ otherWords = other.mWords.data();
+  for (size_t w = 0; w < mWords.size(); ++w) {
+    words[w] &= otherWords[w];
+  }
+  return *this;
+}
+
+SelectionBitmap& SelectionBitmap::operator|=(SelectionBitmap const& other)
+{
+  if (other.mNRows != mNRows) {
+    throw o2::framework::runtime_error_f("Cannot unite selections of tables with %lld and %lld rows", static_cast<long long>(mNRows), static_cast<long long>(other.mNRows));
+  }
+  auto* __restrict__ words = mWords.data();
+  auto const* __restrict__ otherWords = other.mWords.data();
+  for (size_t w = 0; w < mWords.size(); ++w) {
+    words[w] |= otherWords[w];
+  }
+  return *this;
+}
+
+SelectionVector SelectionBitmap::toRows() const
+{
+  SelectionVector rows(count());
+  auto* row = rows.data();
+  forEach([&row](int64_t selected) { *row++ = selected; });
+  return rows;
+}
+
+SelectionVector uniteSelections(gsl::span<int64_t const> a, gsl::span<int64_t const> b, int64_t nRows)
+{
+  if (preferSelectionBitmap(a.size() + b.size(), nRows) && fitsSelectionBitmap(a, nRows) && fitsSelectionBitmap(b, nRows)) {
+    SelectionBitmap bitmap{a, nRows};
+    bitmap |= SelectionBitmap{b, nRows};
+    return bitmap.toRows();
+  }
+  SelectionVector rowsUnion;
+  rowsUnion.reserve(a.size() + b.size());
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(rowsUnion));
+  return rowsUnion;
+}
+
+SelectionVector intersectSelections(gsl::span<int64_t const> a, gsl::span<int64_t const> b, int64_t nRows)
+{
+  if (preferSelectionBitmap(std::min(a.size(), b.size()), nRows) && fitsSelectionBitmap(a, nRows) && fitsSelectionBitmap(b, nRows)) {
+    SelectionBitmap bitmap{a, nRows};
+    bitmap &= SelectionBitmap{b, nRows};
+    return bitmap.toRows();
+  }
+  SelectionVector intersection;
+  intersection.reserve(std::min(a.size(), b.size()));
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(intersection));
+  return intersection;
+}
+
+} // namespace o2::soa
@@ -10,7 +10,11 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/TableBuilder.h"
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
+#include <mutex>
+#include <thread>
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
@@ -22,6 +26,8 @@
 #include <arrow/table.h>
 #include <arrow/type_traits.h>
 #include <arrow/util/key_value_metadata.h>
+#include <arrow/util/parallel.h>
+#include <arrow/util/thread_pool.h>
 #if defined(__GNUC__)
 #pragma GCC diagnostic pop
 #endif
@@ -44,6 +50,27 @@ void ArrayFromVector(const std::vector<C_TYPE>& values, std::shared_ptr<arrow::A
   assert(status.ok());
 }
 
+// Small pool dedicated to the evaluation of the spawned columns. Its
+// size can be changed with DPL_SPAWNER_THREADS, 1 disables threading.
+arrow::internal::ThreadPool* spawnerThreadPool()
+{
+  static std::shared_ptr<arrow::internal::ThreadPool> pool = []() -> std::shared_ptr<arrow::internal::ThreadPool> {
+    int nThreads = std::min(4, std::max(1, (int)std::thread::hardware_concurrency()));
+    if (char const* env = getenv("DPL_SPAWNER_THREADS")) {
+      nThreads = std::max(1, atoi(env));
+    }
+    if (nThreads == 1) {
+      return nullptr;
+    }
+    auto result = arrow::internal::ThreadPool::Make(nThreads);
+    if (!result.ok()) {
+      return nullptr;
+    }
+    return *result;
+  }();
+  return pool.get();
+}
+
 } // namespace
 
 namespace o2::framework
@@ -85,17 +112,23 @@ void TableBuilder::setLabel(const char* label)
 }
 
 std::shared_ptr<arrow::Table> spawnerHelper(std::shared_ptr<arrow::Table>& fullTable, std::shared_ptr<arrow::Schema> newSchema, size_t nColumns,
-                                            expressions::Projector* projectors, std::vector<std::shared_ptr<arrow::Field>> const& fields, const char* name)
+                                            expressions::Projector* projectors, std::vector<std::shared_ptr<arrow::Field>> const& fields, const char* name,
+                                            SpawnerProjectorCache& cache)
 {
-  auto mergedProjectors = framework::expressions::createProjectorHelper(nColumns, projectors, fullTable->schema(), fields);
+  std::shared_ptr<gandiva::Projector> mergedProjectors;
+  {
+    static std::mutex compileMutex;
+    std::lock_guard<std::mutex> lock(compileMutex);
+    if (cache.projector == nullptr || cache.schema == nullptr || !cache.schema->Equals(*fullTable->schema(), false)) {
+      cache.projector = framework::expressions::createProjectorHelper(nColumns, projectors, fullTable->schema(), fields);
+      cache.schema = fullTable->schema();
+    }
+    mergedProjectors = cache.projector;
+  }
 
   arrow::TableBatchReader reader(*fullTable);
   std::shared_ptr<arrow::RecordBatch> batch;
-  arrow::ArrayVector v;
-  std::vector<arrow::ArrayVector> chunks;
-  chunks.resize(nColumns);
-  std::vector<std::shared_ptr<arrow::ChunkedArray>> arrays;
-
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
   while (true) {
     auto s = reader.ReadNext(&batch);
     if (!s.ok()) {
@@ -104,15 +137,30 @@ std::shared_ptr<arrow::Table> spawnerHelper(std::shared_ptr<arrow::Table>& fullT
     if (batch == nullptr) {
       break;
     }
+    batches.push_back(batch);
+  }
+
+  // gandiva::Projector::Evaluate is thread safe, so the batches
+  // can be evaluated concurrently, each into its own output slot.
+  std::vector<arrow::ArrayVector> results(batches.size());
+  auto evaluate = [&](int ib) -> arrow::Status {
     try {
-      s = mergedProjectors->Evaluate(*batch, arrow::default_memory_pool(), &v);
-      if (!s.ok()) {
-        throw runtime_error_f("Cannot apply projector to source table of %s: %s", name, s.ToString().c_str());
-      }
+      return mergedProjectors->Evaluate(*batches[ib], arrow::default_memory_pool(), &results[ib]);
     } catch (std::exception& e) {
-      throw runtime_error_f("Cannot apply projector to source table of %s: exception caught: %s", name, e.what());
+      return arrow::Status::ExecutionError("exception caught: ", e.what());
     }
+  };
+  auto* pool = spawnerThreadPool();
+  auto s = arrow::internal::OptionalParallelFor(pool != nullptr && batches.size() > 1, (int)batches.size(), evaluate,
+                                                pool != nullptr ? pool : arrow::internal::GetCpuThreadPool());
+  if (!s.ok()) {
+    throw runtime_error_f("Cannot apply projector to source table of %s: %s", name, s.ToString().c_str());
+  }
 
+  std::vector<arrow::ArrayVector> chunks;
+  chunks.resize(nColumns);
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> arrays;
+  for (auto& v : results) {
     for (auto i = 0U; i < nColumns; ++i) {
       chunks[i].emplace_back(v.at(i));
     }
@@ -62,7 +62,32 @@ static void BM_StandardNameLookup(benchmark::State& state)
     }
   }
 }
+/// Fill a TH2F entry by entry (0), in buffered mode (1) and with arrays (2)
+static void BM_Fill(benchmark::State& state)
+{
+  const int nEntries = 100000;
+  std::vector<float> x(nEntries), y(nEntries);
+  for (auto i = 0; i < nEntries; ++i) {
+    x[i] = (i * 7919 % 1000) / 100.f;
+    y[i] = (i * 104729 % 1000) / 100.f;
+  }
+  HistogramRegistry registry{"registry", {{"xy", "xy", {HistType::kTH2F, {{100, 0, 10}, {100, 0, 10}}}}}};
+  registry.setBufferedFill(state.range(0) == 1);
+  for (auto _ : state) {
+    if (state.range(0) == 2) {
+      registry.fill(HIST("xy"), gsl::span<const float>(x), gsl::span<const float>(y));
+    } else {
+      for (auto i = 0; i < nEntries; ++i) {
+        registry.fill(HIST("xy"), x[i], y[i]);
+      }
+      registry.flush();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * nEntries);
+}
+
 BENCHMARK(BM_HashedNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 BENCHMARK(BM_StandardNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
+BENCHMARK(BM_Fill)->Arg(0)->Arg(1)->Arg(2);
 
 BENCHMARK_MAIN();
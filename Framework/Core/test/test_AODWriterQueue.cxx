@@ -0,0 +1,49 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+#include "../src/AODWriterQueue.h"
+#include <stdexcept>
+
+using namespace o2::framework;
+
+TEST_CASE("TestAODWriterQueue")
+{
+  std::vector<std::string> written;
+  {
+    AODWriterQueue queue(100, [&written](AODWriteJob& job) {
+      written.push_back(job.tableName);
+    });
+    for (int i = 0; i < 10; ++i) {
+      // each job is larger than the limit, so push has to wait for the writer
+      queue.push(AODWriteJob{.payload = std::vector<uint8_t>(150), .tableName = std::to_string(i)});
+    }
+    queue.flush();
+    REQUIRE(queue.queuedJobs() == 0);
+    REQUIRE(queue.queuedBytes() == 0);
+    REQUIRE(queue.writtenBytes() == 1500);
+  }
+  REQUIRE(written.size() == 10);
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(written[i] == std::to_string(i));
+  }
+}
+
+TEST_CASE("TestAODWriterQueueError")
+{
+  AODWriterQueue queue(100, [](AODWriteJob& job) {
+    throw std::runtime_error("failed to write " + job.tableName);
+  });
+  queue.push(AODWriteJob{.payload = std::vector<uint8_t>(10), .tableName = "O2track"});
+  REQUIRE_THROWS_AS(queue.flush(), std::runtime_error);
+  // the error is reported only once
+  queue.flush();
+}
@@ -14,6 +14,7 @@
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/ExpressionHelpers.h"
 #include <catch_amalgamated.hpp>
+#include <random>
 
 using namespace o2::framework;
 using namespace o2::soa;
@@ -1400,3 +1401,26 @@ TEST_CASE("BlockCombinationsCounters")
     previousEvent = c0.index();
   }
 }
+
+TEST_CASE("SortByBin")
+{
+  std::mt19937 gen(1234);
+  // dense bins use the counting sort, sparse ones fall back to the stable sort
+  for (int maxBin : {0, 10, 1000, 1000000000}) {
+    std::uniform_int_distribution<int> binDist(-1, maxBin);
+    for (uint64_t nEntries : {0, 1, 100, 5000}) {
+      std::vector<BinningIndex> groupedIndices;
+      for (uint64_t index = 0; index < nEntries; index++) {
+        groupedIndices.emplace_back(binDist(gen), index);
+      }
+      auto expected = groupedIndices;
+      std::stable_sort(expected.begin(), expected.end());
+      sortByBin(groupedIndices);
+      REQUIRE(groupedIndices.size() == expected.size());
+      for (uint64_t i = 0; i < nEntries; i++) {
+        REQUIRE(groupedIndices[i].bin == expected[i].bin);
+        REQUIRE(groupedIndices[i].index == expected[i].index);
+      }
+    }
+  }
+}
@@ -125,3 +125,108 @@ TEST_CASE("HistogramRegistryStepTHn")
 
   registry.print();
 }
+
+TEST_CASE("HistogramRegistryBulkFill")
+{
+  std::vector<float> x{0.5f, 1.5f, -1.0f, 3.5f, 9.9f, 12.0f, 4.25f, 7.0f};
+  std::vector<float> y{-2.0f, -4.0f, -1.0f, -5.0f, 0.0f, -9.0f, -7.0f, -4.0f};
+  std::vector<double> w{1.0, 0.5, 2.0, 1.0, 1.0, 3.0, 0.25, 1.0};
+
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float>({"x", "y"});
+  for (auto i = 0u; i < x.size(); ++i) {
+    rowWriter(0, x[i], y[i]);
+  }
+  using TestA = o2::soa::Table<o2::soa::Index<>, test::X, test::Y>;
+  TestA tests{builder.finalize()};
+
+  std::vector<HistogramSpec> histSpecs{
+    {"x", "test x", {HistType::kTH1F, {{10, 0.0f, 10.0f}}}},
+    {"xw", "test x weighted", {HistType::kTH1D, {{10, 0.0f, 10.0f}}}},
+    {"xy", "test xy", {HistType::kTH2F, {{10, 0.0f, 10.0f}, {10, -10.0f, 0.0f}}}},
+    {"xyw", "test xy weighted", {HistType::kTHnF, {{10, 0.0f, 10.0f}, {10, -10.0f, 0.0f}}}},
+    {"xyProf", "test xy profile", {HistType::kTProfile, {{10, 0.0f, 10.0f}}}}};
+  HistogramRegistry reference{"reference", histSpecs};
+  HistogramRegistry buffered{"buffered", histSpecs};
+  HistogramRegistry spans{"spans", histSpecs};
+  HistogramRegistry table{"table", histSpecs};
+
+  buffered.setBufferedFill();
+  for (auto i = 0u; i < x.size(); ++i) {
+    reference.fill(HIST("x"), x[i]);
+    reference.fill(HIST("xw"), x[i], w[i]);
+    reference.fill(HIST("xy"), x[i], y[i]);
+    reference.fill(HIST("xyw"), x[i], y[i], w[i]);
+    reference.fill(HIST("xyProf"), x[i], y[i]);
+    buffered.fill(HIST("x"), x[i]);
+    buffered.fill(HIST("xw"), x[i], w[i]);
+    buffered.fill(HIST("xy"), x[i], y[i]);
+    buffered.fill(HIST("xyw"), x[i], y[i], w[i]);
+    buffered.fill(HIST("xyProf"), x[i], y[i]);
+  }
+  // buffered entries are filled when the histogram is accessed or the registry is flushed
+  REQUIRE(buffered.get<THn>(HIST("xyw"))->GetEntries() == x.size());
+  buffered.flush();
+
+  spans.fill(HIST("x"), gsl::span<const float>(x));
+  spans.fill(HIST("xw"), gsl::span<const float>(x), gsl::span<const double>(w));
+  spans.fill(HIST("xy"), gsl::span<const float>(x), gsl::span<const float>(y));
+  spans.fill(HIST("xyw"), gsl::span<const float>(x), gsl::span<const float>(y), gsl::span<const double>(w));
+  spans.fill(HIST("xyProf"), gsl::span<const float>(x), gsl::span<const float>(y));
+
+  table.fill<test::X>(HIST("x"), tests);
+  table.fill<test::X, test::Y>(HIST("xy"), tests);
+  table.fill<test::X, test::Y>(HIST("xyProf"), tests);
+
+  auto compareTH1 = [&](HistogramRegistry& registry, auto histName) {
+    auto ref = reference.get<TH1>(histName);
+    auto hist = registry.get<TH1>(histName);
+    REQUIRE(hist->GetEntries() == ref->GetEntries());
+    REQUIRE(hist->GetMean() == Catch::Approx(ref->GetMean()));
+    REQUIRE(hist->GetStdDev() == Catch::Approx(ref->GetStdDev()));
+    for (int bin = 0; bin < ref->GetNcells(); ++bin) {
+      REQUIRE(hist->GetBinContent(bin) == ref->GetBinContent(bin));
+      REQUIRE(hist->GetBinError(bin) == Catch::Approx(ref->GetBinError(bin)));
+    }
+  };
+  auto compareTH2 = [&](HistogramRegistry& registry) {
+    auto ref = reference.get<TH2>(HIST("xy"));
+    auto hist = registry.get<TH2>(HIST("xy"));
+    REQUIRE(hist->GetEntries() == ref->GetEntries());
+    REQUIRE(hist->GetCorrelationFactor() == Catch::Approx(ref->GetCorrelationFactor()));
+    for (int bin = 0; bin < ref->GetNcells(); ++bin) {
+      REQUIRE(hist->GetBinContent(bin) == ref->GetBinContent(bin));
+    }
+  };
+  auto compareTHn = [&](HistogramRegistry& registry) {
+    auto ref = reference.get<THn>(HIST("xyw"));
+    auto hist = registry.get<THn>(HIST("xyw"));
+    REQUIRE(hist->GetEntries() == ref->GetEntries());
+    for (Long64_t bin = 0; bin < ref->GetNbins(); ++bin) {
+      REQUIRE(hist->GetBinContent(bin) == ref->GetBinContent(bin));
+    }
+  };
+  auto compareTProfile = [&](HistogramRegistry& registry) {
+    auto ref = reference.get<TProfile>(HIST("xyProf"));
+    auto hist = registry.get<TProfile>(HIST("xyProf"));
+    REQUIRE(hist->GetEntries() == ref->GetEntries());
+    for (int bin = 0; bin < ref->GetNcells(); ++bin) {
+      REQUIRE(hist->GetBinContent(bin) == Catch::Approx(ref->GetBinContent(bin)));
+    }
+  };
+
+  for (auto registry : {&buffered, &spans}) {
+    compareTH1(*registry, HIST("x"));
+    compareTH1(*registry, HIST("xw"));
+    compareTH2(*registry);
+    compareTHn(*registry);
+    compareTProfile(*registry);
+  }
+  compareTH1(table, HIST("x"));
+  compareTH2(table);
+  compareTProfile(table);
+
+  /// Selected rows of a filtered table
+  table.fill<test::X>(HIST("xw"), tests, test::y > -4.5f);
+  REQUIRE(table.get<TH1>(HIST("xw"))->GetEntries() == 5);
+}
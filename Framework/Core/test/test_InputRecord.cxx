@@ -159,6 +159,65 @@ TEST_CASE("TestInputRecord")
   REQUIRE(record.end().begin() == record.end().end());
 }
 
+TEST_CASE("TestObjectCacheContentHash")
+{
+  InputSpec plain{"x", "TST", "A", 0, Lifetime::Timeframe};
+  InputSpec cached{"y", "TST", "B", 0, Lifetime::Timeframe, {objectCachePolicySpec()}};
+  REQUIRE(ObjectCache::policyFor(plain) == ObjectCachePolicy::None);
+  REQUIRE(ObjectCache::policyFor(cached) == ObjectCachePolicy::ContentHash);
+
+  char buffer1[] = "some serialised payload";
+  char buffer2[] = "some serialised payloaD";
+  REQUIRE(ObjectCache::hashPayload(buffer1, sizeof(buffer1)) == ObjectCache::hashPayload(buffer1, sizeof(buffer1)));
+  REQUIRE(ObjectCache::hashPayload(buffer1, sizeof(buffer1)) != ObjectCache::hashPayload(buffer2, sizeof(buffer2)));
+  REQUIRE(ObjectCache::hashPayload(buffer1, sizeof(buffer1)) != ObjectCache::hashPayload(buffer1, sizeof(buffer1) - 1));
+
+  ObjectCache cache;
+  cache.contentCacheLimit = 150;
+  int nDeleted = 0;
+  static int* deleted = &nDeleted;
+  auto deleter = [](void* p) { delete reinterpret_cast<int*>(p); (*deleted)++; };
+  auto add = [&cache, deleter](std::string const& path, uint64_t hash, size_t size, size_t timeslice) {
+    return cache.putContent(path, hash, size, new int{0}, deleter, timeslice);
+  };
+  add("a", 0, 100, 1);
+  cache.releaseContent(1);
+  add("b", 0, 100, 2);
+  cache.releaseContent(2);
+  // "a" was least recently used
+  REQUIRE(cache.matcherToContent.count("a") == 0);
+  REQUIRE(cache.matcherToContent.count("b") == 1);
+  REQUIRE(cache.contentCacheSize == 100);
+  REQUIRE(nDeleted == 1);
+  // Entries used by timeslices in flight are never evicted, even
+  // if they were used by another stream.
+  REQUIRE(cache.getContent("b", 0, 100, 3) != nullptr);
+  add("c", 0, 100, 4);
+  add("d", 0, 100, 5);
+  REQUIRE(cache.matcherToContent.size() == 3);
+  REQUIRE(cache.contentCacheSize == 300);
+  cache.releaseContent(3);
+  REQUIRE(cache.matcherToContent.count("b") == 0);
+  REQUIRE(cache.contentCacheSize == 200);
+  // A changed payload invalidates the entry, but the object stays
+  // alive until the timeslice which received it is done.
+  auto* c = cache.getContent("c", 0, 100, 6);
+  REQUIRE(c != nullptr);
+  REQUIRE(cache.getContent("c", 1, 100, 7) == nullptr);
+  REQUIRE(cache.matcherToContent.count("c") == 0);
+  REQUIRE(cache.retiredContent.size() == 1);
+  cache.releaseContent(4);
+  REQUIRE(cache.retiredContent.size() == 1);
+  int deletedBefore = nDeleted;
+  cache.releaseContent(6);
+  REQUIRE(cache.retiredContent.empty());
+  REQUIRE(nDeleted == deletedBefore + 1);
+  REQUIRE(cache.contentCacheSize == 100);
+  // Caching the same payload twice keeps the first object.
+  auto* e = add("e", 2, 10, 8);
+  REQUIRE(add("e", 2, 10, 9) == e);
+}
+
 // TODO:
 // - test all `get` implementations
 // - create a list of supported types and check that the API compiles
@@ -0,0 +1,89 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/SelectionBitmap.h"
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <iterator>
+#include <random>
+
+using namespace o2::soa;
+
+namespace
+{
+SelectionVector randomSelection(std::mt19937& gen, int64_t nRows, double fraction)
+{
+  std::bernoulli_distribution select(fraction);
+  SelectionVector rows;
+  for (int64_t row = 0; row < nRows; ++row) {
+    if (select(gen)) {
+      rows.push_back(row);
+    }
+  }
+  return rows;
+}
+} // namespace
+
+TEST_CASE("SelectionBitmapBasics")
+{
+  SelectionVector rows{0, 3, 63, 64, 65, 127, 128, 199};
+  SelectionBitmap bitmap{rows, 200};
+  REQUIRE(bitmap.size() == 200);
+  REQUIRE(bitmap.count() == static_cast<int64_t>(rows.size()));
+  for (int64_t row = 0; row < 200; ++row) {
+    REQUIRE(bitmap.test(row) == std::binary_search(rows.begin(), rows.end(), row));
+  }
+  REQUIRE(bitmap.toRows() == rows);
+
+  SelectionBitmap other{SelectionVector{3, 4, 64, 199}, 200};
+  auto intersection = bitmap;
+  intersection &= other;
+  REQUIRE(intersection.toRows() == SelectionVector{3, 64, 199});
+  auto rowsUnion = bitmap;
+  rowsUnion |= other;
+  REQUIRE(rowsUnion.toRows() == SelectionVector{0, 3, 4, 63, 64, 65, 127, 128, 199});
+
+  REQUIRE(SelectionBitmap{0}.toRows().empty());
+  REQUIRE_THROWS(bitmap &= SelectionBitmap{100});
+  REQUIRE_THROWS(SelectionBitmap{SelectionVector{3, 200}, 200});
+  REQUIRE_THROWS(SelectionBitmap{SelectionVector{-1, 3}, 200});
+}
+
+TEST_CASE("SelectionBitmapCombineSelections")
+{
+  std::mt19937 gen(1234);
+  // sparse selections are merged as lists, dense ones are combined as bitmaps
+  for (double fraction : {0.001, 0.05, 0.5, 0.99}) {
+    for (int64_t nRows : {0, 1, 1000, 4097}) {
+      auto a = randomSelection(gen, nRows, fraction);
+      auto b = randomSelection(gen, nRows, fraction);
+      SelectionVector expectedUnion, expectedIntersection;
+      std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expectedUnion));
+      std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expectedIntersection));
+      REQUIRE(uniteSelections(a, b, nRows) == expectedUnion);
+      REQUIRE(intersectSelections(a, b, nRows) == expectedIntersection);
+      REQUIRE(intersectSelections(a, SelectionVector{}, nRows).empty());
+      REQUIRE(uniteSelections(a, SelectionVector{}, nRows) == a);
+    }
+  }
+}
+
+TEST_CASE("SelectionBitmapRowsOutsideOfTable")
+{
+  // dense selections with rows beyond the table size fall back to the merge
+  SelectionVector a{0, 1, 2, 5, 9, 12};
+  SelectionVector b{1, 2, 3, 9, 10};
+  REQUIRE(uniteSelections(a, b, 10) == SelectionVector{0, 1, 2, 3, 5, 9, 10, 12});
+  REQUIRE(intersectSelections(a, b, 10) == SelectionVector{1, 2, 9});
+  REQUIRE_FALSE(fitsSelectionBitmap(a, 10));
+  REQUIRE(fitsSelectionBitmap(a, 13));
+  REQUIRE(fitsSelectionBitmap(SelectionVector{}, 0));
+}
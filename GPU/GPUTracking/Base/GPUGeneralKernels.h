@@ -84,6 +84,11 @@ class GPUKernelTemplate
 
   typedef GPUconstantref() MEM_CONSTANT(GPUConstantMem) processorType;
   GPUhdi() CONSTEXPR static GPUDataTypes::RecoStep GetRecoStep() { return GPUCA_RECO_STEP::NoRecoStep; }
+  // In the CPU backend every GPU thread runs as a block of one thread with its own shared memory and no-op barriers.
+  // Kernels whose CPU code only depends on the global thread index and ignores the padding of the grid can therefore
+  // be split into work items of one thread each (see processing.ompBlockThreads). Kernels relying on the block
+  // structure, e.g. stream compaction or ZS decoding, must not be flagged.
+  GPUhdi() CONSTEXPR static bool IndependentThreads() { return false; }
   MEM_TEMPLATE()
   GPUhdi() static processorType* Processor(MEM_TYPE(GPUConstantMem) & processors)
   {
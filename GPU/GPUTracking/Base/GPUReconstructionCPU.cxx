@@ -68,8 +68,8 @@ int GPUReconstructionCPUBackend::runKernelBackend(krnlSetup& _xyz, const Args&..
   if (x.device == krnlDeviceType::Device) {
     throw std::runtime_error("Cannot run device kernel on host");
   }
-  if (x.nThreads != 1) {
-    throw std::runtime_error("Cannot run device kernel on host with nThreads != 1");
+  if (x.nThreads != 1 && !T::IndependentThreads()) {
+    throw std::runtime_error("Cannot run device kernel with block-level synchronization on host with nThreads != 1");
   }
   unsigned int num = y.num == 0 || y.num == -1 ? 1 : y.num;
   for (unsigned int k = 0; k < num; k++) {
@@ -83,7 +83,19 @@ int GPUReconstructionCPUBackend::runKernelBackend(krnlSetup& _xyz, const Args&..
     } else {
       ompThreads = mProcessingSettings.ompKernels ? mProcessingSettings.ompThreads : 1;
     }
-    if (ompThreads > 1) {
+    if (x.nThreads > 1) {
+      // Only a scheduling change: the threads are not run as SIMD lanes or with a shared block context, but as nBlocks * nThreads
+      // single-thread blocks, distributed dynamically over the OMP threads in chunks of one GPU block for better load balancing
+      const unsigned int nVirtualBlocks = x.nBlocks * x.nThreads;
+      if (mProcessingSettings.debugLevel >= 5) {
+        printf("Running %d ompThreads for %d blocks of %d threads\n", ompThreads, x.nBlocks, x.nThreads);
+      }
+      GPUCA_OPENMP(parallel for num_threads(ompThreads) schedule(dynamic, x.nThreads))
+      for (unsigned int iB = 0; iB < nVirtualBlocks; iB++) {
+        typename T::GPUSharedMemory smem;
+        T::template Thread<I>(nVirtualBlocks, 1, iB, 0, smem, T::Processor(*mHostConstantMem)[y.start + k], args...);
+      }
+    } else if (ompThreads > 1) {
       if (mProcessingSettings.debugLevel >= 5) {
         printf("Running %d ompThreads\n", ompThreads);
       }
@@ -112,6 +124,9 @@ int GPUReconstructionCPUBackend::runKernelBackend<GPUMemClean16, 0>(krnlSetup& _
 template <class T, int I>
 GPUReconstruction::krnlProperties GPUReconstructionCPUBackend::getKernelPropertiesBackend()
 {
+  if (T::IndependentThreads() && mProcessingSettings.ompKernels) {
+    return krnlProperties{std::min(std::max(1, mProcessingSettings.ompBlockThreads), GPUCA_MAX_THREADS), 1};
+  }
   return krnlProperties{1, 1};
 }
 
@@ -222,6 +222,7 @@ AddOption(registerStandaloneInputMemory, bool, false, "registerInputMemory", 0,
 AddOption(ompThreads, int, -1, "omp", 't', "Number of OMP threads to run (-1: all)", min(-1), message("Using %s OMP threads"))
 AddOption(ompKernels, unsigned char, 2, "", 0, "Parallelize with OMP inside kernels instead of over slices, 2 for nested parallelization over TPC sectors and inside kernels")
 AddOption(ompAutoNThreads, bool, true, "", 0, "Auto-adjust number of OMP threads, decreasing the number for small input data")
+AddOption(ompBlockThreads, int, 1, "", 0, "OMP scheduling granularity on the CPU for kernels without block-level synchronization: split each block into this many single-thread work items, scheduled dynamically (1: one work item per block, static schedule)", min(1))
 AddOption(nDeviceHelperThreads, int, 1, "", 0, "Number of CPU helper threads for CPU processing")
 AddOption(nStreams, char, 8, "", 0, "Number of GPU streams / command queues")
 AddOption(nTPCClustererLanes, char, -1, "", 0, "Number of TPC clusterers that can run in parallel (-1 = autoset)")
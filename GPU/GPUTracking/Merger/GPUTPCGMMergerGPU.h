@@ -39,6 +39,7 @@ class GPUTPCGMMergerGeneral : public GPUKernelTemplate
 class GPUTPCGMMergerTrackFit : public GPUTPCGMMergerGeneral
 {
  public:
+  GPUhdi() CONSTEXPR static bool IndependentThreads() { return true; }
 #if !defined(GPUCA_ALIROOT_LIB) || !defined(GPUCA_GPUCODE)
   template <int iKernel = defaultKernel>
   GPUd() static void Thread(int nBlocks, int nThreads, int iBlock, int iThread, GPUsharedref() GPUSharedMemory& smem, processorType& merger, int mode);
@@ -48,6 +49,7 @@ class GPUTPCGMMergerTrackFit : public GPUTPCGMMergerGeneral
 class GPUTPCGMMergerFollowLoopers : public GPUTPCGMMergerGeneral
 {
  public:
+  GPUhdi() CONSTEXPR static bool IndependentThreads() { return true; }
 #if !defined(GPUCA_ALIROOT_LIB) || !defined(GPUCA_GPUCODE)
   template <int iKernel = defaultKernel>
   GPUd() static void Thread(int nBlocks, int nThreads, int iBlock, int iThread, GPUsharedref() GPUSharedMemory& smem, processorType& merger);
@@ -25,6 +25,7 @@ class GPUTrackingRefitKernel : public GPUKernelTemplate
 {
  public:
   GPUhdi() CONSTEXPR static GPUDataTypes::RecoStep GetRecoStep() { return GPUDataTypes::RecoStep::TPCCompression; }
+  GPUhdi() CONSTEXPR static bool IndependentThreads() { return true; }
 
   enum K : int {
     mode0asGPU = 0,
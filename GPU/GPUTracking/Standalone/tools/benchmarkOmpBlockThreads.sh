@@ -0,0 +1,23 @@
+#!/bin/bash
+
+# Compare the CPU kernel timings for different values of --PROCompBlockThreads.
+# Run from the standalone folder: tools/benchmarkOmpBlockThreads.sh [events] [runs] [values...]
+# ompBlockThreads only changes the OMP scheduling granularity of kernels flagged IndependentThreads(),
+# so only the timings of those kernels and the totals are printed.
+
+EVENTS=${1:-pp}
+RUNS=${2:-10}
+shift $(($# < 2 ? $# : 2))
+VALUES=${@:-1 2 4 8 16 32}
+KERNELS="GPUTPCGMMergerTrackFit|GPUTPCGMMergerFollowLoopers|GPUTrackingRefitKernel|GPUTPCCFChargeMapFiller|GPUTPCCFPeakFinder|GPUTPCCFNoiseSuppression|GPUTPCCFDeconvolution|GPUTPCCFClusterizer|Total Kernel|Total Wall"
+
+if [ ! -x ./ca ]; then
+  echo "Standalone benchmark ./ca not found, run from the standalone folder"
+  exit 1
+fi
+
+for i in $VALUES; do
+  echo "ompBlockThreads = $i"
+  ./ca -c -e $EVENTS --runs $RUNS --runsInit 1 --debug 1 --PROCompBlockThreads $i $BENCHMARK_EXTRA_ARGS | grep "Execution Time" | grep -E "$KERNELS"
+  if [ ${PIPESTATUS[0]} != 0 ]; then exit 1; fi
+done
@@ -54,6 +54,11 @@ class GPUTPCCFChargeMapFiller : public GPUKernelTemplate
     return GPUDataTypes::RecoStep::TPCClusterFinding;
   }
 
+  GPUhdi() CONSTEXPR static bool IndependentThreads()
+  {
+    return true;
+  }
+
   template <int iKernel = defaultKernel, typename... Args>
   GPUd() static void Thread(int nBlocks, int nThreads, int iBlock, int iThread, GPUSharedMemory& smem, processorType& clusterer, Args... args);
 
@@ -49,6 +49,11 @@ class GPUTPCCFDeconvolution : public GPUKernelTemplate
     return GPUDataTypes::RecoStep::TPCClusterFinding;
   }
 
+  GPUhdi() CONSTEXPR static bool IndependentThreads()
+  {
+    return true;
+  }
+
   template <int iKernel = defaultKernel, typename... Args>
   GPUd() static void Thread(int nBlocks, int nThreads, int iBlock, int iThread, GPUSharedMemory& smem, processorType& clusterer, Args... args);
 
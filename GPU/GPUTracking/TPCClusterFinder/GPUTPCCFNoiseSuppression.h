@@ -53,6 +53,11 @@ class GPUTPCCFNoiseSuppression : public GPUKernelTemplate
     return GPUDataTypes::RecoStep::TPCClusterFinding;
   }
 
+  GPUhdi() CONSTEXPR static bool IndependentThreads()
+  {
+    return true;
+  }
+
   template <int iKernel = defaultKernel, typename... Args>
   GPUd() static void Thread(int nBlocks, int nThreads, int iBlock, int iThread, GPUSharedMemory& smem, processorType& clusterer, Args... args);
 
@@ -18,6 +18,9 @@
 #include "SimulationDataFormat/MCEventHeader.h"
 #include "SimulationDataFormat/TrackReference.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
+#include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 class TChain;
@@ -82,6 +85,23 @@ class MCKinematicsReader
   /// API to ask releasing tracks (freeing memory) for source + event
   void releaseTracksForSourceAndEvent(int source, int event);
 
+  /// bound the number of events for which tracks are kept in memory (0 = unbounded, the default);
+  /// beyond this size the tracks of the least recently used events are released, hence the tracks
+  /// returned by getTrack(s) are only valid until cacheSize other events have been accessed
+  void setCacheSize(size_t cacheSize);
+  size_t getCacheSize() const { return mCacheSize; }
+
+  /// load the tracks for a list of (source, event) pairs in one pass sorted by source and event
+  void loadTracks(std::vector<std::pair<int, int>> sourceEvents) const;
+
+  /// start a background thread reading ahead the tracks of up to depth events following the
+  /// collision order of the digitization context (the event order when initialized from kinematics),
+  /// starting after the last event loaded on demand
+  void startPrefetching(int depth = 16);
+
+  /// stop the prefetching thread and release the tracks it read ahead
+  void stopPrefetching();
+
   /// variant returning all tracks for an event id (source = 0) at once
   std::vector<MCTrack> const& getTracks(int event) const;
 
@@ -113,8 +133,15 @@ class MCKinematicsReader
   }
 
  private:
+  struct Prefetcher;
+
   void initTracksForSource(int source) const;
   void loadTracksForSourceAndEvent(int source, int eventID) const;
+  std::vector<o2::MCTrack>* readTracks(int source, int eventID) const;
+  std::vector<o2::MCTrack>* takePrefetchedTracks(int source, int eventID) const;
+  void prefetchTracks() const;
+  void releaseLeastRecentlyUsedTracks() const;
+  std::unique_lock<std::mutex> lockInput() const;
   void loadHeadersForSource(int source) const;
   void loadTrackRefsForSource(int source) const;
   void initIndexedTrackRefs(std::vector<o2::TrackReference>& refs, o2::dataformats::MCTruthContainer<o2::TrackReference>& indexedrefs) const;
@@ -129,6 +156,14 @@ class MCKinematicsReader
   mutable std::vector<std::vector<o2::dataformats::MCEventHeader>> mHeaders;                                 // the in-memory header container
   mutable std::vector<std::vector<o2::dataformats::MCTruthContainer<o2::TrackReference>>> mIndexedTrackRefs; // the in-memory track ref container
 
+  // bookkeeping of the events with tracks in memory for the bounded cache
+  size_t mCacheSize = 0;                                       // maximal number of events with tracks in memory (0 = unbounded)
+  mutable std::vector<std::pair<int, int>> mCachedEvents;      // (source, event) with tracks in memory
+  mutable std::vector<std::vector<unsigned long>> mLastAccess; // access stamp for each source and event
+  mutable unsigned long mAccessCounter = 0;
+
+  std::unique_ptr<Prefetcher> mPrefetcher; // state of the read-ahead thread (if started)
+
   bool mInitialized = false; // whether initialized
 };
 
@@ -157,6 +192,8 @@ inline std::vector<MCTrack> const& MCKinematicsReader::getTracks(int source, int
   }
   if (mTracks[source][event] == nullptr) {
     loadTracksForSourceAndEvent(source, event);
+  } else if (mCacheSize > 0) {
+    mLastAccess[source][event] = ++mAccessCounter;
   }
   return *mTracks[source][event];
 }
@@ -14,13 +14,36 @@
 #include "SimulationDataFormat/MCEventHeader.h"
 #include "SimulationDataFormat/TrackReference.h"
 #include <TChain.h>
+#include <TROOT.h>
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <thread>
 #include <vector>
 #include <fairlogger/Logger.h>
 
 using namespace o2::steer;
 
+// state shared between the reader and the read-ahead thread
+struct MCKinematicsReader::Prefetcher {
+  std::mutex inputMutex; // serialises the access to the input chains
+  std::mutex mutex;      // protects the members below
+  std::condition_variable condition;
+  std::vector<std::pair<int, int>> order; // (source, event) in the order of reading
+  std::vector<std::vector<int>> position; // position of (source, event) in the order
+  std::map<std::pair<int, int>, std::unique_ptr<std::vector<o2::MCTrack>>> prefetched;
+  std::pair<int, int> inflight{-1, -1}; // (source, event) being read by the thread
+  size_t depth = 16;
+  size_t consumer = 0; // position after the last event loaded on demand
+  size_t cursor = 0;   // next position to be read by the thread
+  bool stop = false;
+  std::thread thread;
+};
+
 MCKinematicsReader::~MCKinematicsReader()
 {
+  stopPrefetching();
+
   for (auto chain : mInputChains) {
     delete chain;
   }
@@ -50,31 +73,54 @@ void MCKinematicsReader::initIndexedTrackRefs(std::vector<o2::TrackReference>& r
   }
 }
 
+std::unique_lock<std::mutex> MCKinematicsReader::lockInput() const
+{
+  return mPrefetcher ? std::unique_lock<std::mutex>(mPrefetcher->inputMutex) : std::unique_lock<std::mutex>();
+}
+
 void MCKinematicsReader::initTracksForSource(int source) const
 {
   auto chain = mInputChains[source];
   if (chain) {
+    auto lock = lockInput();
     // todo: get name from NameConfig
     auto br = chain->GetBranch("MCTrack");
     mTracks[source].resize(br->GetEntries(), nullptr);
+    mLastAccess[source].resize(br->GetEntries(), 0);
   }
 }
 
-void MCKinematicsReader::loadTracksForSourceAndEvent(int source, int event) const
+std::vector<o2::MCTrack>* MCKinematicsReader::readTracks(int source, int event) const
 {
   auto chain = mInputChains[source];
   if (chain) {
     // todo: get name from NameConfig
     auto br = chain->GetBranch("MCTrack");
     if (br) {
+      // the vector allocated by ROOT is taken over
       std::vector<MCTrack>* loadtracks = nullptr;
       br->SetAddress(&loadtracks);
       br->GetEntry(event);
-      mTracks[source][event] = new std::vector<o2::MCTrack>;
-      *mTracks[source][event] = *loadtracks;
-      delete loadtracks;
+      return loadtracks ? loadtracks : new std::vector<o2::MCTrack>;
     }
   }
+  return nullptr;
+}
+
+void MCKinematicsReader::loadTracksForSourceAndEvent(int source, int event) const
+{
+  auto tracks = mPrefetcher ? takePrefetchedTracks(source, event) : nullptr;
+  if (!tracks) {
+    auto lock = lockInput();
+    tracks = readTracks(source, event);
+  }
+  if (!tracks) {
+    return;
+  }
+  mTracks[source][event] = tracks;
+  mCachedEvents.emplace_back(source, event);
+  mLastAccess[source][event] = ++mAccessCounter;
+  releaseLeastRecentlyUsedTracks();
 }
 
 void MCKinematicsReader::releaseTracksForSourceAndEvent(int source, int eventID)
@@ -82,13 +128,179 @@ void MCKinematicsReader::releaseTracksForSourceAndEvent(int source, int eventID)
   if (mTracks.at(source).at(eventID) != nullptr) {
     delete mTracks[source][eventID];
     mTracks[source][eventID] = nullptr;
+    auto iter = std::find(mCachedEvents.begin(), mCachedEvents.end(), std::make_pair(source, eventID));
+    if (iter != mCachedEvents.end()) {
+      *iter = mCachedEvents.back();
+      mCachedEvents.pop_back();
+    }
+  }
+}
+
+void MCKinematicsReader::releaseLeastRecentlyUsedTracks() const
+{
+  // the cache is small compared to the cost of reading an event, a linear search is sufficient
+  while (mCacheSize > 0 && mCachedEvents.size() > mCacheSize) {
+    auto lru = std::min_element(mCachedEvents.begin(), mCachedEvents.end(), [this](const auto& a, const auto& b) {
+      return mLastAccess[a.first][a.second] < mLastAccess[b.first][b.second];
+    });
+    delete mTracks[lru->first][lru->second];
+    mTracks[lru->first][lru->second] = nullptr;
+    *lru = mCachedEvents.back();
+    mCachedEvents.pop_back();
+  }
+}
+
+void MCKinematicsReader::setCacheSize(size_t cacheSize)
+{
+  mCacheSize = cacheSize;
+  releaseLeastRecentlyUsedTracks();
+}
+
+void MCKinematicsReader::loadTracks(std::vector<std::pair<int, int>> sourceEvents) const
+{
+  // reading in the order of the entries makes best use of the baskets already read
+  std::sort(sourceEvents.begin(), sourceEvents.end());
+  sourceEvents.erase(std::unique(sourceEvents.begin(), sourceEvents.end()), sourceEvents.end());
+  for (const auto& [source, event] : sourceEvents) {
+    if (mTracks[source].size() == 0) {
+      initTracksForSource(source);
+    }
+    if (mTracks[source][event] == nullptr) {
+      loadTracksForSourceAndEvent(source, event);
+    }
+  }
+}
+
+std::vector<o2::MCTrack>* MCKinematicsReader::takePrefetchedTracks(int source, int event) const
+{
+  auto& prefetcher = *mPrefetcher;
+  std::vector<o2::MCTrack>* tracks = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(prefetcher.mutex);
+    const auto key = std::make_pair(source, event);
+    // do not read an event twice if the thread is already at it
+    prefetcher.condition.wait(lock, [&prefetcher, &key]() { return prefetcher.inflight != key; });
+    auto iter = prefetcher.prefetched.find(key);
+    if (iter != prefetcher.prefetched.end()) {
+      tracks = iter->second.release();
+      prefetcher.prefetched.erase(iter);
+    }
+    // continue reading ahead after this event
+    if (source < (int)prefetcher.position.size() && event < (int)prefetcher.position[source].size() && prefetcher.position[source][event] >= 0) {
+      prefetcher.consumer = prefetcher.position[source][event] + 1;
+      if (prefetcher.cursor < prefetcher.consumer || prefetcher.cursor > prefetcher.consumer + prefetcher.depth) {
+        prefetcher.cursor = prefetcher.consumer;
+      }
+      // drop what was read ahead and has been left behind
+      for (auto it = prefetcher.prefetched.begin(); it != prefetcher.prefetched.end();) {
+        const size_t pos = prefetcher.position[it->first.first][it->first.second];
+        if (pos + prefetcher.depth < prefetcher.consumer || pos >= prefetcher.consumer + 2 * prefetcher.depth) {
+          it = prefetcher.prefetched.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+  }
+  prefetcher.condition.notify_all();
+  return tracks;
+}
+
+void MCKinematicsReader::prefetchTracks() const
+{
+  auto& prefetcher = *mPrefetcher;
+  while (true) {
+    std::pair<int, int> next;
+    {
+      std::unique_lock<std::mutex> lock(prefetcher.mutex);
+      prefetcher.condition.wait(lock, [&prefetcher]() {
+        return prefetcher.stop || (prefetcher.cursor < prefetcher.order.size() && prefetcher.cursor < prefetcher.consumer + prefetcher.depth);
+      });
+      if (prefetcher.stop) {
+        return;
+      }
+      next = prefetcher.order[prefetcher.cursor++];
+      if (prefetcher.prefetched.count(next)) {
+        continue;
+      }
+      prefetcher.inflight = next;
+    }
+    std::unique_ptr<std::vector<o2::MCTrack>> tracks;
+    {
+      std::lock_guard<std::mutex> lock(prefetcher.inputMutex);
+      tracks.reset(readTracks(next.first, next.second));
+    }
+    {
+      std::lock_guard<std::mutex> lock(prefetcher.mutex);
+      if (tracks) {
+        prefetcher.prefetched[next] = std::move(tracks);
+      }
+      prefetcher.inflight = {-1, -1};
+    }
+    prefetcher.condition.notify_all();
+  }
+}
+
+void MCKinematicsReader::startPrefetching(int depth)
+{
+  if (!mInitialized) {
+    LOG(warn) << "MCKinematicsReader not initialized; cannot start prefetching";
+    return;
+  }
+  stopPrefetching();
+  ROOT::EnableThreadSafety();
+
+  auto prefetcher = std::make_unique<Prefetcher>();
+  prefetcher->depth = std::max(1, depth);
+  prefetcher->position.resize(mInputChains.size());
+  for (int source = 0; source < (int)mInputChains.size(); ++source) {
+    if (mTracks[source].size() == 0) {
+      initTracksForSource(source);
+    }
+    prefetcher->position[source].resize(mTracks[source].size(), -1);
+  }
+  auto addToOrder = [&prefetcher](int source, int event) {
+    auto& positions = prefetcher->position;
+    if (source >= 0 && source < (int)positions.size() && event >= 0 && event < (int)positions[source].size() && positions[source][event] < 0) {
+      positions[source][event] = prefetcher->order.size();
+      prefetcher->order.emplace_back(source, event);
+    }
+  };
+  if (mDigitizationContext) {
+    for (const auto& parts : mDigitizationContext->getEventParts()) {
+      for (const auto& part : parts) {
+        addToOrder(part.sourceID, part.entryID);
+      }
+    }
+  } else {
+    for (int event = 0; event < (int)mTracks[0].size(); ++event) {
+      addToOrder(0, event);
+    }
+  }
+
+  mPrefetcher = std::move(prefetcher);
+  mPrefetcher->thread = std::thread([this]() { prefetchTracks(); });
+}
+
+void MCKinematicsReader::stopPrefetching()
+{
+  if (!mPrefetcher) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mPrefetcher->mutex);
+    mPrefetcher->stop = true;
   }
+  mPrefetcher->condition.notify_all();
+  mPrefetcher->thread.join();
+  mPrefetcher.reset();
 }
 
 void MCKinematicsReader::loadHeadersForSource(int source) const
 {
   auto chain = mInputChains[source];
   if (chain) {
+    auto lock = lockInput();
     // todo: get name from NameConfig
     auto br = chain->GetBranch("MCEventHeader.");
     if (br) {
@@ -111,6 +323,7 @@ void MCKinematicsReader::loadTrackRefsForSource(int source) const
 {
   auto chain = mInputChains[source];
   if (chain) {
+    auto lock = lockInput();
     // todo: get name from NameConfig
     auto br = chain->GetBranch("TrackRefs");
     if (br) {
@@ -153,6 +366,7 @@ bool MCKinematicsReader::initFromDigitContext(std::string_view name)
   mTracks.resize(mInputChains.size());
   mHeaders.resize(mInputChains.size());
   mIndexedTrackRefs.resize(mInputChains.size());
+  mLastAccess.resize(mInputChains.size());
 
   // actual loading will be done only if someone asks
   // the first time for a particular source ...
@@ -171,6 +385,7 @@ bool MCKinematicsReader::initFromKinematics(std::string_view name)
   mTracks.resize(1);
   mHeaders.resize(1);
   mIndexedTrackRefs.resize(1);
+  mLastAccess.resize(1);
   mInitialized = true;
 
   return true;
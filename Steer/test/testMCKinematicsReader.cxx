@@ -0,0 +1,101 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test MCKinematicsReader class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "Steer/MCKinematicsReader.h"
+#include "SimulationDataFormat/MCTrack.h"
+#include "CommonUtils/NameConf.h"
+#include <TFile.h>
+#include <TTree.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace steer
+{
+
+constexpr int NEVENTS = 50;
+
+// mockup kinematics file: event e has e + 1 tracks, the first daughter ID of track t is 1000 * e + t
+void makeKinematicsFile(std::string const& prefix)
+{
+  TFile file(o2::base::NameConf::getMCKinematicsFileName(prefix).c_str(), "RECREATE");
+  TTree tree("o2sim", "");
+  std::vector<o2::MCTrack> tracks;
+  auto tracksPtr = &tracks;
+  tree.Branch("MCTrack", &tracksPtr);
+  for (int event = 0; event < NEVENTS; ++event) {
+    tracks.clear();
+    for (int track = 0; track <= event; ++track) {
+      tracks.emplace_back().SetFirstDaughterTrackId(1000 * event + track);
+    }
+    tree.Fill();
+  }
+  tree.Write();
+  file.Close();
+}
+
+void checkEvent(MCKinematicsReader const& reader, int event)
+{
+  auto const& tracks = reader.getTracks(event);
+  BOOST_REQUIRE_EQUAL(tracks.size(), size_t(event + 1));
+  for (int track = 0; track <= event; ++track) {
+    BOOST_CHECK_EQUAL(tracks[track].getFirstDaughterTrackId(), 1000 * event + track);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MCKinematicsReaderCache)
+{
+  makeKinematicsFile("mckinereadertest");
+  MCKinematicsReader reader("mckinereadertest", MCKinematicsReader::Mode::kMCKine);
+  BOOST_REQUIRE_EQUAL(reader.getNEvents(0), size_t(NEVENTS));
+
+  reader.setCacheSize(4);
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> pick(0, NEVENTS - 1);
+  for (int i = 0; i < 200; ++i) {
+    checkEvent(reader, pick(gen));
+  }
+
+  // bulk loading of more events than the cache keeps
+  std::vector<std::pair<int, int>> sourceEvents{{0, 7}, {0, 3}, {0, 7}, {0, 42}, {0, 11}, {0, 5}};
+  reader.loadTracks(sourceEvents);
+  checkEvent(reader, 5);
+  reader.setCacheSize(0);
+  reader.loadTracks(sourceEvents);
+  checkEvent(reader, 3);
+  checkEvent(reader, 42);
+}
+
+BOOST_AUTO_TEST_CASE(MCKinematicsReaderPrefetch)
+{
+  makeKinematicsFile("mckinereadertest");
+  MCKinematicsReader reader("mckinereadertest", MCKinematicsReader::Mode::kMCKine);
+  reader.setCacheSize(8);
+  reader.startPrefetching(4);
+  // in order, with jumps forward and backward
+  for (int event = 0; event < NEVENTS; ++event) {
+    checkEvent(reader, event);
+  }
+  for (int event : {30, 31, 2, 3, 4, 45, 10, 11}) {
+    checkEvent(reader, event);
+  }
+  reader.stopPrefetching();
+  checkEvent(reader, 20);
+}
+
+} // namespace steer
+} // namespace o2
@@ -67,13 +67,14 @@ class Dispatcher : public framework::Task
   DataSamplingHeader prepareDataSamplingHeader(const DataSamplingPolicy& policy);
   header::Stack extractAdditionalHeaders(const char* inputHeaderStack) const;
   void reportStats(monitoring::Monitoring& monitoring) const;
-  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, const framework::Output& output) const;
+  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, fair::mq::Message const* payloadMessage, const framework::Output& output) const;
 
   std::string mName;
   DataSamplingHeader::DeviceIDType mDeviceID = "invalid";
   std::string mReconfigurationSource;
   // policies should be shared between all pipeline threads
   std::vector<std::shared_ptr<DataSamplingPolicy>> mPolicies;
+  bool mCopyPayloads = false;
 };
 
 } // namespace o2::utilities
@@ -73,6 +73,8 @@ void Dispatcher::init(InitContext& ctx)
     }
   }
 
+  mCopyPayloads = ctx.options().isSet("copy-payloads") && ctx.options().get<bool>("copy-payloads");
+
   auto& spec = ctx.services().get<const DeviceSpec>();
   mDeviceID.runtimeInit(spec.id.substr(0, DataSamplingHeader::deviceIDTypeSize).c_str());
 }
@@ -100,7 +102,8 @@ void Dispatcher::run(ProcessingContext& ctx)
       if (auto route = policy->match(inputMatcher); route != nullptr && policy->decide(firstPart)) {
         auto routeAsConcreteDataType = DataSpecUtils::asConcreteDataTypeMatcher(*route);
         auto dsheader = prepareDataSamplingHeader(*policy);
-        for (const auto& part : inputIt) {
+        for (size_t partIndex = 0; partIndex < inputIt.size(); ++partIndex) {
+          const DataRef& part = inputIt.getByPos(partIndex);
           if (part.header != nullptr) {
             // We copy every header which is not DataHeader or DataProcessingHeader,
             // so that custom data-dependent headers are passed forward,
@@ -115,7 +118,7 @@ void Dispatcher::run(ProcessingContext& ctx)
               routeAsConcreteDataType.description,
               partInputHeader->subSpecification,
               std::move(headerStack)};
-            send(ctx.outputs(), part, output);
+            send(ctx.outputs(), part, ctx.inputs().span().payloadMessage(inputIt.position(), partIndex), output);
           }
         }
       }
@@ -171,10 +174,15 @@ header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack)
   return headerStack;
 }
 
-void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const Output& output) const
+void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, fair::mq::Message const* payloadMessage, const Output& output) const
 {
   const auto* inputHeader = DataRefUtils::getHeader<header::DataHeader*>(inputData);
-  dataAllocator.snapshot(output, inputData.payload, DataRefUtils::getPayloadSize(inputData), inputHeader->payloadSerializationMethod);
+  // the same payload may be sampled by several policies, we forward it without copying whenever possible
+  if (payloadMessage != nullptr && !mCopyPayloads) {
+    dataAllocator.forward(output, *payloadMessage, inputHeader->payloadSerializationMethod);
+  } else {
+    dataAllocator.snapshot(output, inputData.payload, DataRefUtils::getPayloadSize(inputData), inputHeader->payloadSerializationMethod);
+  }
 }
 
 void Dispatcher::registerPolicy(std::unique_ptr<DataSamplingPolicy>&& policy)
@@ -235,7 +243,8 @@ Outputs Dispatcher::getOutputSpecs()
 }
 framework::Options Dispatcher::getOptions()
 {
-  return {{"period-timer-stats", framework::VariantType::Int, 10 * 1000000, {"Dispatcher's stats timer period"}}};
+  return {{"period-timer-stats", framework::VariantType::Int, 10 * 1000000, {"Dispatcher's stats timer period"}},
+          {"copy-payloads", framework::VariantType::Bool, false, {"Copy the sampled payloads instead of sending shallow copies of the input messages"}}};
 }
 
 size_t Dispatcher::numberOfPolicies()
@@ -39,6 +39,8 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
   workflowOptions.push_back(ConfigParamSpec{"usleep", VariantType::Int, 0, {"usleep time of producers"}});
   workflowOptions.push_back(ConfigParamSpec{
     "fill", VariantType::Bool, false, {"should fill the messages (prevents memory overcommitting)"}});
+  workflowOptions.push_back(ConfigParamSpec{
+    "copy-payloads", VariantType::Bool, false, {"dispatchers copy the sampled payloads instead of forwarding the input messages"}});
 }
 
 #include <memory>
@@ -69,6 +71,7 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
   size_t dispatchers = config.options().get<int>("dispatchers");
   size_t usleepTime = config.options().get<int>("usleep");
   bool fill = config.options().get<bool>("fill");
+  bool copyPayloads = config.options().get<bool>("copy-payloads");
 
   ptree policy;
   policy.put("id", "benchmark");
@@ -109,6 +112,14 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
   }
 
   DataSampling::GenerateInfrastructure(specs, policies, dispatchers);
+  // compare the zero-copy forwarding with the copy of the payloads
+  for (auto& spec : specs) {
+    for (auto& option : spec.options) {
+      if (option.name == "copy-payloads") {
+        option.defaultValue = Variant(copyPayloads);
+      }
+    }
+  }
 
   DataProcessorSpec podDataSink{
     "dataSink",
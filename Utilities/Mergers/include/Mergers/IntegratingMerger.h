@@ -24,6 +24,7 @@
 #include "Framework/Task.h"
 
 #include <memory>
+#include <vector>
 
 class TObject;
 
@@ -58,10 +59,13 @@ class IntegratingMerger : public framework::Task
   void publishIntegral(framework::DataAllocator& allocator);
   void publishMovingWindow(framework::DataAllocator& allocator);
   static void merge(ObjectStore& mMergedDelta, ObjectStore&& other);
+  void mergeBatch(ObjectStore& mMergedDelta, std::vector<ObjectStore>&& others);
   void clear();
 
  private:
   header::DataHeader::SubSpecificationType mSubSpec;
+  // deltas received since the last merge, they are merged in one batch when publishing
+  std::vector<ObjectStore> mPendingDeltas;
   // data points since the last cycle end. it allows us to create moving windows
   ObjectStore mMergedObjectLastCycle = std::monostate{};
   // data points since the last state reset
@@ -19,6 +19,8 @@
 
 #include "ObjectStore.h"
 
+#include <vector>
+
 class TObject;
 
 namespace o2::mergers::algorithm
@@ -33,6 +35,19 @@ void merge(TObject* const target, TObject* const other);
 /// of targets vector.
 void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others);
 
+/// \brief A function which merges a batch of TObjects into the target
+///
+/// Histograms (TH1D/F, TH2D/F, TH3D/F) with the same type and fixed binning as the target, without labels
+/// and buffers, are summed directly bin by bin, using nThreads for large histograms if OpenMP is available.
+/// The bins are added in the order of others, thus the result does not depend on the number of threads.
+/// All the other objects are merged one by one with merge(target, other).
+void mergeBatch(TObject* const target, const std::vector<TObject*>& others, int nThreads = 1);
+/// \brief A function which merges a batch of vectors of TObjects
+///
+/// Objects with the same name are merged with mergeBatch(target, others, nThreads). Objects without
+/// a target of the same name are cloned and pushed to the end of targets vector, as in merge(targets, others).
+void mergeBatch(VectorOfTObjectPtrs& targets, const std::vector<const VectorOfTObjectPtrs*>& others, int nThreads = 1);
+
 void deleteTCollections(TObject* obj);
 
 } // namespace o2::mergers::algorithm
@@ -96,6 +96,8 @@ struct MergerConfig {
   std::string monitoringUrl = "infologger:///debug?qc";
   std::string detectorName = "TST";
   ConfigEntry<ParallelismType> parallelismType = {ParallelismType::SplitInputs};
+  int mergingThreads = 1;   // number of threads summing large histograms with the same binning
+  int maxBufferedDeltas = 1; // IntegratingMerger merges the buffered deltas before the publication once there are so many (1 - merge each call, 0 - no limit)
   std::vector<o2::framework::DataProcessorLabel> labels;
 };
 
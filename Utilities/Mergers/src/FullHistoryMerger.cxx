@@ -151,12 +151,14 @@ void FullHistoryMerger::mergeCache()
   // We expect that all the objects use the same kind of interface
   if (std::holds_alternative<TObjectPtr>(mMergedObject)) {
     auto target = std::get<TObjectPtr>(mMergedObject);
+    std::vector<TObject*> others;
+    others.reserve(mCache.size());
     for (auto& [name, entry] : mCache) {
       (void)name;
-      auto other = std::get<TObjectPtr>(entry);
-      algorithm::merge(target.get(), other.get());
-      mObjectsMerged++;
+      others.push_back(std::get<TObjectPtr>(entry).get());
     }
+    algorithm::mergeBatch(target.get(), others, mConfig.mergingThreads);
+    mObjectsMerged += others.size();
 
   } else if (std::holds_alternative<MergeInterfacePtr>(mMergedObject)) {
     auto target = std::get<MergeInterfacePtr>(mMergedObject);
@@ -168,12 +170,14 @@ void FullHistoryMerger::mergeCache()
     }
 
   } else if (std::holds_alternative<VectorOfTObjectPtrs>(mMergedObject)) {
-    auto target = std::get<VectorOfTObjectPtrs>(mMergedObject);
+    auto& target = std::get<VectorOfTObjectPtrs>(mMergedObject);
+    std::vector<const VectorOfTObjectPtrs*> others;
+    others.reserve(mCache.size());
     for (auto& [_, entry] : mCache) {
-      auto other = std::get<VectorOfTObjectPtrs>(entry);
-      algorithm::merge(target, other);
-      mObjectsMerged += target.size();
+      others.push_back(&std::get<VectorOfTObjectPtrs>(entry));
     }
+    algorithm::mergeBatch(target, others, mConfig.mergingThreads);
+    mObjectsMerged += target.size() * others.size();
   }
 }
 
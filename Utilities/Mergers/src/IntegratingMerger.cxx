@@ -60,15 +60,22 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
   // we have to avoid mistaking the timer input with data inputs.
   auto* timerHeader = ctx.inputs().get("timer-publish").header;
 
+  // the deltas are buffered until the publication, so that histograms with the same binning are summed in one pass.
+  // with the consumeWhenAny completion policy, each call usually brings only one of them.
   for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
     if (ref.header != timerHeader) {
-      auto other = object_store_helpers::extractObjectFrom(ref);
-      merge(mMergedObjectLastCycle, std::move(other));
+      mPendingDeltas.push_back(object_store_helpers::extractObjectFrom(ref));
       mDeltasMerged++;
     }
   }
 
-  if (ctx.inputs().isValid("timer-publish")) {
+  const bool publish = ctx.inputs().isValid("timer-publish");
+  if (publish || (mConfig.maxBufferedDeltas > 0 && mPendingDeltas.size() >= static_cast<size_t>(mConfig.maxBufferedDeltas))) {
+    mergeBatch(mMergedObjectLastCycle, std::move(mPendingDeltas));
+    mPendingDeltas.clear();
+  }
+
+  if (publish) {
     mCyclesSinceReset++;
 
     if (mConfig.publishMovingWindow.value == PublishMovingWindow::Yes) {
@@ -119,6 +126,37 @@ void IntegratingMerger::merge(ObjectStore& target, ObjectStore&& other)
   }
 }
 
+void IntegratingMerger::mergeBatch(ObjectStore& target, std::vector<ObjectStore>&& others)
+{
+  if (others.empty()) {
+    return;
+  }
+  size_t first = 0;
+  if (std::holds_alternative<std::monostate>(target)) {
+    merge(target, std::move(others[first++]));
+  }
+
+  if (std::holds_alternative<TObjectPtr>(target)) {
+    // We expect that if the first object was TObject, then all should.
+    std::vector<TObject*> othersAsTObjects;
+    for (size_t i = first; i < others.size(); i++) {
+      othersAsTObjects.push_back(std::get<TObjectPtr>(others[i]).get());
+    }
+    algorithm::mergeBatch(std::get<TObjectPtr>(target).get(), othersAsTObjects, mConfig.mergingThreads);
+  } else if (std::holds_alternative<VectorOfTObjectPtrs>(target)) {
+    // We expect that if the first object was Vector of TObjects, then all should.
+    std::vector<const VectorOfTObjectPtrs*> othersAsVectors;
+    for (size_t i = first; i < others.size(); i++) {
+      othersAsVectors.push_back(&std::get<VectorOfTObjectPtrs>(others[i]));
+    }
+    algorithm::mergeBatch(std::get<VectorOfTObjectPtrs>(target), othersAsVectors, mConfig.mergingThreads);
+  } else {
+    for (size_t i = first; i < others.size(); i++) {
+      merge(target, std::move(others[i]));
+    }
+  }
+}
+
 void IntegratingMerger::endOfStream(framework::EndOfStreamContext& eosContext)
 {
   publishIntegral(eosContext.outputs());
@@ -127,6 +165,7 @@ void IntegratingMerger::endOfStream(framework::EndOfStreamContext& eosContext)
 // I am not calling it reset(), because it does not have to be performed during the FairMQs reset.
 void IntegratingMerger::clear()
 {
+  mPendingDeltas.clear();
   mMergedObjectLastCycle = std::monostate{};
   mMergedObjectIntegral = std::monostate{};
   mCyclesSinceReset = 0;
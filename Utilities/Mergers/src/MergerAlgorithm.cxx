@@ -20,6 +20,8 @@
 #include "Mergers/MergeInterface.h"
 #include "Mergers/ObjectStore.h"
 
+#include <TArrayD.h>
+#include <TArrayF.h>
 #include <TEfficiency.h>
 #include <TGraph.h>
 #include <TH1.h>
@@ -30,6 +32,10 @@
 #include <TObjArray.h>
 #include <TTree.h>
 
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
 namespace o2::mergers::algorithm
 {
 
@@ -143,6 +149,174 @@ void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others)
   }
 }
 
+namespace
+{
+
+bool hasFixedBinsWithoutLabels(const TAxis* axis)
+{
+  return axis->GetXbins()->GetSize() == 0 && axis->GetLabels() == nullptr;
+}
+
+bool haveSameBins(const TAxis* a, const TAxis* b)
+{
+  return a->GetNbins() == b->GetNbins() && a->GetXmin() == b->GetXmin() && a->GetXmax() == b->GetXmax();
+}
+
+// Histograms which Merge() would sum bin by bin, i.e. the standard types with fixed binning, without labels
+// (they may be reordered by Merge()), without an unprocessed fill buffer and not representing averages.
+bool isSummableHistogram(const TH1* histo)
+{
+  const auto* cl = histo->IsA();
+  if (cl != TH1D::Class() && cl != TH1F::Class() && cl != TH2D::Class() && cl != TH2F::Class() && cl != TH3D::Class() && cl != TH3F::Class()) {
+    return false;
+  }
+  if (histo->TestBit(TH1::kIsAverage) || histo->GetBuffer() != nullptr) {
+    return false;
+  }
+  return hasFixedBinsWithoutLabels(histo->GetXaxis()) && hasFixedBinsWithoutLabels(histo->GetYaxis()) && hasFixedBinsWithoutLabels(histo->GetZaxis());
+}
+
+bool canBeSummed(const TH1* target, const TH1* other)
+{
+  return target->IsA() == other->IsA() && isSummableHistogram(other) &&
+         haveSameBins(target->GetXaxis(), other->GetXaxis()) && haveSameBins(target->GetYaxis(), other->GetYaxis()) &&
+         haveSameBins(target->GetZaxis(), other->GetZaxis()) && (target->GetSumw2N() > 0) == (other->GetSumw2N() > 0);
+}
+
+// Adds the arrays of others to the target array. The bins are processed in chunks which stay in cache while all
+// the others are added, the chunks are distributed among the threads. Each bin is summed in the order of others.
+template <typename T>
+void sumArrays(T* target, const std::vector<const T*>& others, long nBins, int nThreads)
+{
+  constexpr long chunkSize = 16384;
+  const long nChunks = (nBins + chunkSize - 1) / chunkSize;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) num_threads(nThreads) if (nThreads > 1 && nChunks > 1)
+#endif
+  for (long chunk = 0; chunk < nChunks; ++chunk) {
+    const long begin = chunk * chunkSize;
+    const long end = std::min(nBins, begin + chunkSize);
+    T* __restrict__ sum = target;
+    for (const T* other : others) {
+      const T* __restrict__ bins = other;
+      for (long bin = begin; bin < end; ++bin) {
+        sum[bin] += bins[bin];
+      }
+    }
+  }
+}
+
+template <typename T, typename Array>
+void sumBinContents(TH1* target, const std::vector<TH1*>& others, int nThreads)
+{
+  std::vector<const T*> otherBins;
+  otherBins.reserve(others.size());
+  for (auto* other : others) {
+    otherBins.push_back(dynamic_cast<const Array*>(other)->GetArray());
+  }
+  auto* targetArray = dynamic_cast<Array*>(target);
+  sumArrays(targetArray->GetArray(), otherBins, targetArray->GetSize(), nThreads);
+}
+
+// Equivalent to target->Merge(others) for histograms accepted by canBeSummed().
+void sumHistograms(TH1* target, const std::vector<TH1*>& others, int nThreads)
+{
+  if (others.empty()) {
+    return;
+  }
+
+  // The statistics have to be retrieved before the bins change, since GetStats() may compute them from the bin contents.
+  Double_t stats[TH1::kNstat] = {0};
+  target->GetStats(stats);
+  Double_t entries = target->GetEntries();
+  for (auto* other : others) {
+    Double_t otherStats[TH1::kNstat] = {0};
+    other->GetStats(otherStats);
+    for (int i = 0; i < TH1::kNstat; i++) {
+      stats[i] += otherStats[i];
+    }
+    entries += other->GetEntries();
+  }
+
+  if (dynamic_cast<TArrayD*>(target) != nullptr) {
+    sumBinContents<Double_t, TArrayD>(target, others, nThreads);
+  } else {
+    sumBinContents<Float_t, TArrayF>(target, others, nThreads);
+  }
+  if (target->GetSumw2N() > 0) {
+    std::vector<const Double_t*> otherSumw2;
+    otherSumw2.reserve(others.size());
+    for (auto* other : others) {
+      otherSumw2.push_back(other->GetSumw2()->GetArray());
+    }
+    sumArrays(target->GetSumw2()->GetArray(), otherSumw2, target->GetSumw2N(), nThreads);
+  }
+
+  target->PutStats(stats);
+  target->SetEntries(entries);
+}
+
+} // namespace
+
+void mergeBatch(TObject* const target, const std::vector<TObject*>& others, int nThreads)
+{
+  if (target == nullptr) {
+    throw std::runtime_error("Merging target is nullptr");
+  }
+
+  auto* targetTH1 = dynamic_cast<TH1*>(target);
+  if (targetTH1 == nullptr || !isSummableHistogram(targetTH1)) {
+    for (auto* other : others) {
+      merge(target, other);
+    }
+    return;
+  }
+
+  std::vector<TH1*> summable;
+  std::vector<TObject*> remaining;
+  summable.reserve(others.size());
+  for (auto* other : others) {
+    auto* otherTH1 = dynamic_cast<TH1*>(other);
+    if (otherTH1 != nullptr && otherTH1 != targetTH1 && canBeSummed(targetTH1, otherTH1)) {
+      summable.push_back(otherTH1);
+    } else {
+      remaining.push_back(other);
+    }
+  }
+  // The histograms with the same binning are summed first, merging the others might change the binning of the target.
+  sumHistograms(targetTH1, summable, nThreads);
+  for (auto* other : remaining) {
+    merge(target, other);
+  }
+}
+
+void mergeBatch(VectorOfTObjectPtrs& targets, const std::vector<const VectorOfTObjectPtrs*>& others, int nThreads)
+{
+  std::unordered_map<std::string_view, size_t> targetIndices;
+  for (size_t i = 0; i < targets.size(); i++) {
+    targetIndices.emplace(targets[i]->GetName(), i);
+  }
+
+  std::vector<std::vector<TObject*>> batches(targets.size());
+  for (const auto* otherVector : others) {
+    for (const auto& other : *otherVector) {
+      if (auto targetSameName = targetIndices.find(other->GetName()); targetSameName != targetIndices.end()) {
+        batches[targetSameName->second].push_back(other.get());
+      } else {
+        targets.push_back(std::shared_ptr<TObject>(other->Clone(), deleteTCollections));
+        targetIndices.emplace(targets.back()->GetName(), targets.size() - 1);
+        batches.emplace_back();
+      }
+    }
+  }
+
+  for (size_t i = 0; i < targets.size(); i++) {
+    if (!batches[i].empty()) {
+      mergeBatch(targets[i].get(), batches[i], nThreads);
+    }
+  }
+}
+
 void deleteRecursive(TCollection* Coll)
 {
   // I can iterate a collection
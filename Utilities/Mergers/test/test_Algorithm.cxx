@@ -17,6 +17,7 @@
 #include <boost/test/tools/interface.hpp>
 #include <gsl/span>
 #include <memory>
+#include <random>
 #define BOOST_TEST_MODULE Test Utilities MergerAlgorithm
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
@@ -352,6 +353,78 @@ BOOST_AUTO_TEST_CASE(AverageHisto)
   delete other;
 }
 
+BOOST_AUTO_TEST_CASE(MergerBatchOfHistograms)
+{
+  std::mt19937 gen(1234);
+  std::normal_distribution<double> dist(0, 1);
+  auto makeHisto = [&](const char* name, int nBins, int nEntries) {
+    auto* histo = new TH2F(name, name, nBins, -3, 3, nBins, -3, 3);
+    histo->Sumw2();
+    for (int i = 0; i < nEntries; i++) {
+      histo->Fill(dist(gen), dist(gen), 0.5 + i % 3);
+    }
+    return histo;
+  };
+
+  std::vector<TObject*> others;
+  for (int i = 0; i < 20; i++) {
+    others.push_back(makeHisto("histo", 200, 1000));
+  }
+  // a different binning is merged with Merge()
+  others.push_back(makeHisto("histo", 100, 1000));
+
+  auto* expected = makeHisto("histo", 200, 1000);
+  std::unique_ptr<TH2F> target1Thread(dynamic_cast<TH2F*>(expected->Clone()));
+  std::unique_ptr<TH2F> target4Threads(dynamic_cast<TH2F*>(expected->Clone()));
+  for (auto* other : others) {
+    algorithm::merge(expected, other);
+  }
+  BOOST_REQUIRE_NO_THROW(algorithm::mergeBatch(target1Thread.get(), others, 1));
+  BOOST_REQUIRE_NO_THROW(algorithm::mergeBatch(target4Threads.get(), others, 4));
+
+  BOOST_CHECK_EQUAL(target1Thread->GetEntries(), expected->GetEntries());
+  BOOST_CHECK_CLOSE(target1Thread->GetMean(1), expected->GetMean(1), 0.001);
+  BOOST_CHECK_CLOSE(target1Thread->GetStdDev(2), expected->GetStdDev(2), 0.001);
+  BOOST_CHECK_CLOSE(target1Thread->GetCorrelationFactor(), expected->GetCorrelationFactor(), 0.001);
+  for (int bin = 0; bin < expected->GetNcells(); bin++) {
+    BOOST_CHECK_CLOSE(target1Thread->GetBinContent(bin), expected->GetBinContent(bin), 0.001);
+    BOOST_CHECK_CLOSE(target1Thread->GetBinError(bin), expected->GetBinError(bin), 0.001);
+    // the bins are always summed in the same order
+    BOOST_CHECK_EQUAL(target4Threads->GetBinContent(bin), target1Thread->GetBinContent(bin));
+  }
+
+  for (auto* other : others) {
+    delete other;
+  }
+  delete expected;
+}
+
+BOOST_AUTO_TEST_CASE(MergerBatchOfVectors)
+{
+  auto makeVector = [](std::vector<const char*> names) {
+    VectorOfTObjectPtrs vector;
+    for (auto* name : names) {
+      auto histo = std::make_shared<TH1D>(name, name, bins, min, max);
+      histo->Fill(5);
+      vector.push_back(histo);
+    }
+    return vector;
+  };
+
+  auto targets = makeVector({"a", "b"});
+  const auto others1 = makeVector({"b", "c"});
+  const auto others2 = makeVector({"c", "a", "b"});
+  algorithm::mergeBatch(targets, {&others1, &others2});
+
+  BOOST_REQUIRE_EQUAL(targets.size(), size_t(3));
+  BOOST_CHECK_EQUAL(std::string(targets[0]->GetName()), "a");
+  BOOST_CHECK_EQUAL(std::string(targets[1]->GetName()), "b");
+  BOOST_CHECK_EQUAL(std::string(targets[2]->GetName()), "c");
+  BOOST_CHECK_EQUAL(dynamic_cast<TH1D*>(targets[0].get())->GetEntries(), 2);
+  BOOST_CHECK_EQUAL(dynamic_cast<TH1D*>(targets[1].get())->GetEntries(), 3);
+  BOOST_CHECK_EQUAL(dynamic_cast<TH1D*>(targets[2].get())->GetEntries(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE(VectorOfHistos)
 
 gsl::span<float> to_span(std::shared_ptr<TH1F>& histo)